@@ -458,9 +458,20 @@ static bf_status_t bf_switchd_init_device_profile(
           p4_pipeline->p4_pipeline_name ? p4_pipeline->p4_pipeline_name : "");
       if (switchd_ctx->asic[dev_id].chip_family == BF_DEV_FAMILY_DPDK) {
          dev_profile_pipeline->core_id   = p4_pipeline->core_id;
+         dev_profile_pipeline->instr_quanta = p4_pipeline->instr_quanta;
+         dev_profile_pipeline->instr_quanta_adaptive =
+             p4_pipeline->instr_quanta_adaptive;
+         dev_profile_pipeline->num_instances = p4_pipeline->num_instances;
+         dev_profile_pipeline->num_reserved_ports =
+             p4_pipeline->num_reserved_ports;
+         dev_profile_pipeline->balance_cfg = p4_pipeline->balance_cfg;
          dev_profile_pipeline->numa_node = p4_pipeline->numa_node;
 	 memcpy(&dev_profile_pipeline->mir_cfg, &p4_pipeline->mir_cfg,
 		sizeof(struct mirror_config_s));
+	 memcpy(&dev_profile_pipeline->digest_cfg, &p4_pipeline->digest_cfg,
+		sizeof(struct digest_config_s));
+	 memcpy(&dev_profile_pipeline->idle_cfg, &p4_pipeline->idle_cfg,
+		sizeof(struct idle_config_s));
       }
 
       // configuration file
@@ -59,6 +59,13 @@ typedef struct switch_asic_s {
 #define DEFAULT_MIRROR_N_SESSIONS     64
 #define DEFAULT_MIRROR_FAST_CLONE      0
 
+/* This is the pipeline learn digest configuration.
+ * These are taken as input from user from config file.
+ */
+#define DEFAULT_DIGEST_BATCH_SIZE         64
+#define DEFAULT_DIGEST_FLUSH_TIMEOUT_US 1000
+#define DEFAULT_DIGEST_DEDUP_WINDOW_US  1000000
+
 #define BF_SWITCHD_MAX_PIPES 4
 #define BF_SWITCHD_MAX_MEMPOOL_OBJS 2
 #define BF_SWITCHD_MAX_CT_TIMER_PROFILES 8
@@ -72,11 +79,18 @@ typedef struct p4_pipeline_config_s {
   char pi_native_config_path[BF_SWITCHD_MAX_FILE_NAME];
   int core_id;
   int numa_node;
+  int instr_quanta;
+  int instr_quanta_adaptive;
+  int num_instances;
+  int num_reserved_ports;
+  struct balance_config_s balance_cfg;
   int num_pipes_in_scope;
   int pipe_scope[BF_SWITCHD_MAX_PIPES];
   struct mirror_config_s mir_cfg;
   int num_ct_timer_profiles;
   int ct_timeout[BF_SWITCHD_MAX_CT_TIMER_PROFILES];
+  struct digest_config_s digest_cfg;
+  struct idle_config_s idle_cfg;
 } p4_pipeline_config_t;
 
 typedef struct p4_programs_s {
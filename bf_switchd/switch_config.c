@@ -387,6 +387,33 @@ static void switch_p4_pipeline_config_init(const char *install_dir,
 	if (self->asic[0].chip_family == BF_DEV_FAMILY_DPDK) {
 		p4_pipeline->core_id = get_int(p4_pipeline_obj, "core_id");
 		p4_pipeline->numa_node = get_int(p4_pipeline_obj, "numa_node");
+		/* Instruction quanta of the pipeline, 0 for the default. */
+		p4_pipeline->instr_quanta = check_and_get_int(p4_pipeline_obj,
+							      "instr_quanta", 0);
+		p4_pipeline->instr_quanta_adaptive = check_and_get_int(p4_pipeline_obj,
+								       "instr_quanta_adaptive", 0);
+		/* Instances of the pipeline sharing the link ports through
+		 * RSS, instance i runs on core core_id + i.
+		 */
+		p4_pipeline->num_instances = check_and_get_int(p4_pipeline_obj,
+							       "num_instances", 1);
+		assert(p4_pipeline->num_instances >= 1);
+		/* Spare ports the pipeline is built with, so that ports can be
+		 * added once it runs.
+		 */
+		p4_pipeline->num_reserved_ports = check_and_get_int(p4_pipeline_obj,
+								    "num_reserved_ports", 0);
+		assert(p4_pipeline->num_reserved_ports >= 0);
+		/* Core load (percent) above which the pipeline may be moved off
+		 * core_id by the load balancer, 0 to keep it there.
+		 */
+		p4_pipeline->balance_cfg.threshold = check_and_get_int(p4_pipeline_obj,
+								       "balance_threshold", 0);
+		p4_pipeline->balance_cfg.hysteresis = check_and_get_int(p4_pipeline_obj,
+									"balance_hysteresis", 0);
+		p4_pipeline->balance_cfg.hold = check_and_get_int(p4_pipeline_obj,
+								  "balance_hold", 0);
+		assert(p4_pipeline->balance_cfg.threshold <= 100);
 		cJSON *mir_cfg = cJSON_GetObjectItem(p4_pipeline_obj, "mirror_config");
 		/* Provide default params for mirror config, if not provided.
 		 */
@@ -412,6 +439,59 @@ static void switch_p4_pipeline_config_init(const char *install_dir,
 				assert(0);
 			}
 		}
+		cJSON *digest_cfg = cJSON_GetObjectItem(p4_pipeline_obj, "digest_config");
+		p4_pipeline->digest_cfg.batch_size = DEFAULT_DIGEST_BATCH_SIZE;
+		p4_pipeline->digest_cfg.flush_timeout_us = DEFAULT_DIGEST_FLUSH_TIMEOUT_US;
+		p4_pipeline->digest_cfg.dedup_window_us = DEFAULT_DIGEST_DEDUP_WINDOW_US;
+		p4_pipeline->digest_cfg.num_lists = 0;
+		if (digest_cfg) {
+			p4_pipeline->digest_cfg.batch_size = check_and_get_int(digest_cfg,
+									       "batch_size",
+									       DEFAULT_DIGEST_BATCH_SIZE);
+			p4_pipeline->digest_cfg.flush_timeout_us = check_and_get_int(digest_cfg,
+										     "flush_timeout_us",
+										     DEFAULT_DIGEST_FLUSH_TIMEOUT_US);
+			p4_pipeline->digest_cfg.dedup_window_us = check_and_get_int(digest_cfg,
+										    "dedup_window_us",
+										    DEFAULT_DIGEST_DEDUP_WINDOW_US);
+			assert(p4_pipeline->digest_cfg.batch_size);
+			cJSON *digest_arr = cJSON_GetObjectItem(digest_cfg, "digests");
+			if (digest_arr) {
+				p4_pipeline->digest_cfg.num_lists = cJSON_GetArraySize(digest_arr);
+				assert(p4_pipeline->digest_cfg.num_lists <= MAX_DIGEST_LISTS);
+			}
+			for (int d = 0; d < p4_pipeline->digest_cfg.num_lists; ++d) {
+				cJSON *digest_obj = cJSON_GetArrayItem(digest_arr, d);
+				struct digest_list_config_s *list = &p4_pipeline->digest_cfg.lists[d];
+
+				list->handle = get_int(digest_obj, "handle");
+				snprintf(list->ring, sizeof(list->ring), "%s",
+					 get_string(digest_obj, "ring"));
+				list->entry_size = get_int(digest_obj, "entry_size");
+				assert(list->entry_size);
+			}
+		}
+		cJSON *idle_cfg = cJSON_GetObjectItem(p4_pipeline_obj, "idle_config");
+		/* Keep polling at full speed, if not provided. */
+		memset(&p4_pipeline->idle_cfg, 0, sizeof(p4_pipeline->idle_cfg));
+		if (idle_cfg) {
+			const char *policy = check_and_get_string(idle_cfg, "policy");
+
+			if (!strcmp(policy, "pause"))
+				p4_pipeline->idle_cfg.policy = 1;
+			else if (!strcmp(policy, "tpause"))
+				p4_pipeline->idle_cfg.policy = 2;
+			else if (!strcmp(policy, "sleep"))
+				p4_pipeline->idle_cfg.policy = 3;
+			else if (strlen(policy) && strcmp(policy, "none")) {
+				printf("idle policy can be none, pause, tpause or sleep only, invalid value provided.");
+				assert(0);
+			}
+			p4_pipeline->idle_cfg.threshold = check_and_get_int(idle_cfg,
+									    "threshold", 0);
+			p4_pipeline->idle_cfg.backoff_us = check_and_get_int(idle_cfg,
+									     "backoff_us", 0);
+		}
 	}
           to_abs_path(p4_pipeline->table_config,
                       p4_pipeline_obj,
@@ -492,6 +572,12 @@ static void switch_p4_pipeline_config_init(const char *install_dir,
 	  printf("  p4_pipeline_name: %s\n", p4_pipeline->p4_pipeline_name);
 	  printf("  core_id: %d\n", p4_pipeline->core_id);
 	  printf("  numa_node: %d\n", p4_pipeline->numa_node);
+	  printf("  instr_quanta: %d%s\n", p4_pipeline->instr_quanta,
+		 p4_pipeline->instr_quanta_adaptive ? " (adaptive)" : "");
+	  printf("  num_instances: %d\n", p4_pipeline->num_instances);
+	  printf("  num_reserved_ports: %d\n",
+		 p4_pipeline->num_reserved_ports);
+	  printf("  balance_threshold: %u\n", p4_pipeline->balance_cfg.threshold);
           printf("    context: %s\n", p4_pipeline->table_config);
           printf("    config: %s\n", p4_pipeline->cfg_file);
           if (p4_pipeline->num_pipes_in_scope > 0) {
@@ -510,6 +596,20 @@ static void switch_p4_pipeline_config_init(const char *install_dir,
 	  printf("    n_slots: %u \n", p4_pipeline->mir_cfg.n_slots);
 	  printf("    n_sessions: %u \n", p4_pipeline->mir_cfg.n_sessions);
 	  printf("    fast_clone: %d \n", p4_pipeline->mir_cfg.fast_clone);
+	  printf("  Digest Config\n");
+	  printf("    batch_size: %u \n", p4_pipeline->digest_cfg.batch_size);
+	  printf("    flush_timeout_us: %u \n", p4_pipeline->digest_cfg.flush_timeout_us);
+	  printf("    dedup_window_us: %u \n", p4_pipeline->digest_cfg.dedup_window_us);
+	  for (s = 0; s < p4_pipeline->digest_cfg.num_lists; ++s) {
+		printf("    digest %u: ring %s entry_size %u\n",
+		       p4_pipeline->digest_cfg.lists[s].handle,
+		       p4_pipeline->digest_cfg.lists[s].ring,
+		       p4_pipeline->digest_cfg.lists[s].entry_size);
+	  }
+	  printf("  Idle Config\n");
+	  printf("    policy: %d \n", p4_pipeline->idle_cfg.policy);
+	  printf("    threshold: %u \n", p4_pipeline->idle_cfg.threshold);
+	  printf("    backoff_us: %u \n", p4_pipeline->idle_cfg.backoff_us);
           printf("  diag: %s\n", p4_program->diag);
           printf("  accton diag: %s\n", p4_program->accton_diag);
           if (strlen(self->board_port_map_conf_file)) {
@@ -0,0 +1,89 @@
+#!/bin/bash
+##
+## Copyright(c) 2022 Intel Corporation.
+##
+## Licensed under the Apache License, Version 2.0 (the "License");
+## you may not use this file except in compliance with the License.
+## You may obtain a copy of the License at
+##
+## http://www.apache.org/licenses/LICENSE-2.0
+##
+## Unless required by applicable law or agreed to in writing, software
+## distributed under the License is distributed on an "AS IS" BASIS,
+## WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+## See the License for the specific language governing permissions and
+## limitations under the License.
+##
+## Two process loopback through the Memif Ports of this example: a testpmd
+## sends to MEMIF0, a second one counts what the pipeline forwards to
+## MEMIF1. bf_switchd must already run with port_config.json and a program
+## forwarding port 0 to port 1.
+##
+## Prints the average Rx-pps of the receiver over the run. With MIN_PPS set,
+## exits non-zero when the rate is below it.
+##
+if [[ "$#" -ne 1 ]]; then
+	echo "Usage: $0 <SDE_INSTALL>" >&2
+	echo "Env: DURATION (s, default 20), WARMUP (s, default 5)," >&2
+	echo "     GEN_LCORES (default 2-3), RCV_LCORES (default 4-5)," >&2
+	echo "     MIN_PPS (default none)" >&2
+	exit 1
+fi
+
+SDE_INSTALL=$1
+DURATION=${DURATION:-20}
+WARMUP=${WARMUP:-5}
+GEN_LCORES=${GEN_LCORES:-2-3}
+RCV_LCORES=${RCV_LCORES:-4-5}
+SOCKET0=/run/memif0.sock
+SOCKET1=/run/memif1.sock
+export LD_LIBRARY_PATH="$LD_LIBRARY_PATH:$SDE_INSTALL/lib/x86_64-linux-gnu:$SDE_INSTALL/lib64:$SDE_INSTALL/lib"
+
+TESTPMD=$SDE_INSTALL/bin/dpdk-testpmd
+if [[ ! -x $TESTPMD ]]; then
+	echo "$TESTPMD not found" >&2
+	exit 1
+fi
+
+for sock in $SOCKET0 $SOCKET1; do
+	if [[ ! -S $sock ]]; then
+		echo "Memif socket $sock not found, is bf_switchd running?" >&2
+		exit 1
+	fi
+done
+
+LOG_DIR=$(mktemp -d)
+trap 'kill $GEN_PID $RCV_PID 2> /dev/null; rm -rf $LOG_DIR' EXIT
+
+# The receiver is started first, so that no packet is lost to a missing peer.
+$TESTPMD -l $RCV_LCORES --file-prefix=memif_rcv --no-pci \
+	--vdev=net_memif,role=client,socket=$SOCKET1,zero-copy=yes \
+	-- --forward-mode=rxonly --auto-start --stats-period 1 \
+	> $LOG_DIR/rcv.log 2>&1 &
+RCV_PID=$!
+
+$TESTPMD -l $GEN_LCORES --file-prefix=memif_gen --no-pci \
+	--vdev=net_memif,role=client,socket=$SOCKET0,zero-copy=yes \
+	-- --forward-mode=txonly --auto-start --stats-period 1 \
+	> $LOG_DIR/gen.log 2>&1 &
+GEN_PID=$!
+
+sleep $((WARMUP + DURATION))
+kill $GEN_PID $RCV_PID 2> /dev/null
+wait $GEN_PID $RCV_PID 2> /dev/null
+
+# One Rx-pps sample per second, the warm up ones are left out.
+PPS=$(grep -o "Rx-pps: *[0-9]*" $LOG_DIR/rcv.log | awk -v skip=$WARMUP \
+	'NR > skip { sum += $2; n++ } END { if (n) printf "%d", sum / n }')
+if [[ -z $PPS ]]; then
+	echo "No Rx-pps sample from the receiver, its log:" >&2
+	cat $LOG_DIR/rcv.log >&2
+	exit 1
+fi
+
+echo "Memif loopback: $PPS pps over ${DURATION}s"
+
+if [[ -n $MIN_PPS ]] && (( PPS < MIN_PPS )); then
+	echo "Below the expected $MIN_PPS pps" >&2
+	exit 1
+fi
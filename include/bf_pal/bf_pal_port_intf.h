@@ -76,6 +76,57 @@ bf_status_t bf_pal_port_all_stats_get(bf_dev_id_t dev_id,
 				      bf_dev_port_t dev_port,
 				      u64 *stats);
 
+/**
+ * @brief Get all the stats of the next n ports in ascending port order
+ * @param dev_id Device id
+ * @param dev_port Device port number to start after, ignored if first is set
+ * @param first Start from the first port
+ * @param n Max number of ports to read
+ * @param dev_ports Array of n entries to hold the ports read
+ * @param stats Array of n * BF_PORT_NUM_COUNTERS entries to hold the stats
+ * @param num_returned Number of ports read
+ * @return Status of the API call
+ */
+bf_status_t bf_pal_port_all_stats_get_next_n(bf_dev_id_t dev_id,
+					     bf_dev_port_t dev_port,
+					     bool first,
+					     u32 n,
+					     bf_dev_port_t *dev_ports,
+					     u64 *stats,
+					     u32 *num_returned);
+
+/**
+ * @brief Get the stats of one RX/TX queue of a port
+ * @param dev_id Device id
+ * @param dev_port Device port number
+ * @param queue_id Queue id
+ * @param stats Array of BF_PORT_NUM_COUNTERS entries to hold the stats
+ * @return Status of the API call
+ */
+bf_status_t bf_pal_port_queue_stats_get(bf_dev_id_t dev_id,
+					bf_dev_port_t dev_port,
+					u32 queue_id,
+					u64 *stats);
+
+/**
+ * @brief Set the interval at which the stats of all the ports are refreshed
+ * in the background, stats reads are then served from the last refresh
+ * @param dev_id Device id
+ * @param poll_intvl_ms Refresh interval in msecs, 0 to read stats live
+ * @return Status of the API call
+ */
+bf_status_t bf_pal_port_stats_poll_intvl_set(bf_dev_id_t dev_id,
+					     u32 poll_intvl_ms);
+
+/**
+ * @brief Get the interval at which the stats of all the ports are refreshed
+ * @param dev_id Device id
+ * @param poll_intvl_ms Refresh interval in msecs, 0 if stats are read live
+ * @return Status of the API call
+ */
+bf_status_t bf_pal_port_stats_poll_intvl_get(bf_dev_id_t dev_id,
+					     u32 *poll_intvl_ms);
+
 /**
  * @brief Get Port ID from MAC
  * @param dev_id Device id
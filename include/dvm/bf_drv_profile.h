@@ -38,6 +38,8 @@
 #define IOMMU_GRP_NUM_LEN 6
 #define MAX_EAL_LEN 512
 #define MAX_CT_TIMER_PROFILES 8
+#define MAX_DIGEST_LISTS 8
+#define DIGEST_RING_NAME_LEN 64
 
 struct mirror_config_s {
 	/* Number of packet mirroring slots. */
@@ -51,18 +53,68 @@ struct mirror_config_s {
 	int fast_clone;
 };
 
+struct digest_list_config_s {
+	/* Field list handle the digests are reported with. */
+	uint32_t handle;
+	/* Pipeline output ring port the digests are sent to. */
+	char ring[DIGEST_RING_NAME_LEN];
+	/* Size in bytes of a digest entry. */
+	uint32_t entry_size;
+};
+
+struct digest_config_s {
+	/* Max number of digest entries delivered in one notification. */
+	uint32_t batch_size;
+	/* Max time (usecs) a digest entry waits for its batch to fill. */
+	uint32_t flush_timeout_us;
+	/* Digest entries repeated within this time (usecs) are dropped. */
+	uint32_t dedup_window_us;
+	int num_lists;
+	struct digest_list_config_s lists[MAX_DIGEST_LISTS];
+};
+
+struct idle_config_s {
+	/* What the pipeline cores do while their ports are empty:
+	 * 0 keeps polling, 1 spins on pause bursts, 2 waits in TPAUSE,
+	 * 3 sleeps.
+	 */
+	int policy;
+	/* Empty dispatch loop iterations before backing off, 0 for default. */
+	uint32_t threshold;
+	/* Length (usecs) of a TPAUSE or sleep backoff, 0 for default. */
+	uint32_t backoff_us;
+};
+
+struct balance_config_s {
+	/* Load (percent) of the pipeline core above which the pipeline is
+	 * moved to a less loaded core, 0 to keep it on its core.
+	 */
+	uint32_t threshold;
+	/* Balancer periods over the threshold before moving, 0 for default. */
+	uint32_t hysteresis;
+	/* Balancer periods the pipeline stays after a move, 0 for default. */
+	uint32_t hold;
+};
+
 typedef struct bf_p4_pipeline {
   char p4_pipeline_name[PROG_NAME_LEN];
   char *cfg_file;
   char *runtime_context_file;        // json context
   char *pi_config_file;              // json PI config
   int core_id;                 // core on which pipeline run
+  int instr_quanta;            // pipeline instruction quanta, 0 for default
+  int instr_quanta_adaptive;   // adjust the quanta from the pipeline load
+  int num_instances;           // RSS-sharded instances, on core_id onwards
+  int num_reserved_ports;      // spare ports for ports added at run time
+  struct balance_config_s balance_cfg;  // move off core_id when overloaded
   int numa_node;         // pipeline uses mempool created this numa node
   int num_pipes_in_scope;            // num pipes in scope
   int pipe_scope[MAX_P4_PIPELINES];  // logical pipe list
   struct mirror_config_s mir_cfg;   // dpdk mirror profile cfg.
   int num_ct_timer_profiles;
   int bf_ct_timeout[MAX_CT_TIMER_PROFILES];
+  struct digest_config_s digest_cfg;  // dpdk learn digest cfg.
+  struct idle_config_s idle_cfg;      // dpdk idle polling cfg.
 } bf_p4_pipeline_t;
 
 typedef struct asic_fw_profile {
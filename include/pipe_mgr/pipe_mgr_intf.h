@@ -1139,6 +1139,15 @@ pipe_status_t pipe_mgr_flow_lrn_set_timeout(pipe_sess_hdl_t sess_hdl,
 pipe_status_t pipe_mgr_flow_lrn_get_timeout(bf_dev_id_t device_id,
                                             uint32_t *usecs);
 
+/* Flow learn notification set max number of entries per notification */
+pipe_status_t pipe_mgr_flow_lrn_set_batch_size(pipe_sess_hdl_t sess_hdl,
+                                               bf_dev_id_t device_id,
+                                               uint32_t batch_size);
+
+/* Flow learn notification get max number of entries per notification */
+pipe_status_t pipe_mgr_flow_lrn_get_batch_size(bf_dev_id_t device_id,
+                                               uint32_t *batch_size);
+
 pipe_status_t pipe_mgr_flow_lrn_set_network_order_digest(bf_dev_id_t device_id,
                                                          bool network_order);
 
@@ -1246,7 +1255,7 @@ pipe_status_t pipe_mgr_direct_stat_ent_database_sync(
 /* API to reset a meter table */
 pipe_status_t pipe_mgr_meter_reset(pipe_sess_hdl_t sess_hdl,
                                    dev_target_t dev_tgt,
-                                   pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                   const char *table_name,
                                    uint32_t pipe_api_flags);
 
 /* API to reset a lpf table */
@@ -1261,10 +1270,12 @@ pipe_status_t pipe_mgr_wred_reset(pipe_sess_hdl_t sess_hdl,
                                   pipe_wred_tbl_hdl_t wred_tbl_hdl,
                                   uint32_t pipe_api_flags);
 
-/* API to update a meter entry specification */
+/* API to update a meter entry specification. The rates of the spec are
+ * divided evenly between the instances of a pipeline.
+ */
 pipe_status_t pipe_mgr_meter_ent_set(pipe_sess_hdl_t sess_hdl,
                                      dev_target_t dev_tgt,
-                                     pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                     const char *table_name,
                                      pipe_meter_idx_t meter_idx,
                                      pipe_meter_spec_t *meter_spec,
                                      uint32_t pipe_api_flags);
@@ -1291,10 +1302,38 @@ pipe_status_t pipe_mgr_meter_read_entry(pipe_sess_hdl_t sess_hdl,
 
 pipe_status_t pipe_mgr_meter_read_entry_idx(pipe_sess_hdl_t sess_hdl,
                                             dev_target_t dev_tgt,
-                                            pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                            const char *table_name,
                                             pipe_meter_idx_t index,
                                             pipe_meter_spec_t *meter_spec);
 
+/* API to read the per color statistics of a meter entry */
+pipe_status_t pipe_mgr_meter_stats_read(pipe_sess_hdl_t sess_hdl,
+                                        dev_target_t dev_tgt,
+                                        const char *table_name,
+                                        pipe_meter_idx_t index,
+                                        pipe_meter_stats_t *meter_stats);
+
+/* API to apply one meter specification to the meter entries
+ * [start_idx, end_idx]
+ */
+pipe_status_t pipe_mgr_meter_ent_set_range(pipe_sess_hdl_t sess_hdl,
+                                           dev_target_t dev_tgt,
+                                           const char *table_name,
+                                           pipe_meter_idx_t start_idx,
+                                           pipe_meter_idx_t end_idx,
+                                           pipe_meter_spec_t *meter_spec);
+
+/* API to read the per color statistics of the meter entries
+ * [start_idx, end_idx]. meter_stats must have room for
+ * (end_idx - start_idx + 1) entries.
+ */
+pipe_status_t pipe_mgr_meter_stats_read_range(pipe_sess_hdl_t sess_hdl,
+                                              dev_target_t dev_tgt,
+                                              const char *table_name,
+                                              pipe_meter_idx_t start_idx,
+                                              pipe_meter_idx_t end_idx,
+                                              pipe_meter_stats_t *meter_stats);
+
 
 pipe_status_t pipe_mgr_exm_entry_activate(pipe_sess_hdl_t sess_hdl,
                                           bf_dev_id_t device_id,
@@ -1306,6 +1345,20 @@ pipe_status_t pipe_mgr_exm_entry_deactivate(pipe_sess_hdl_t sess_hdl,
                                             pipe_mat_tbl_hdl_t mat_tbl_hdl,
                                             pipe_mat_ent_hdl_t mat_ent_hdl);
 
+/* API to set a learner timer profile (timeout in seconds) on all the
+ * learner tables of a pipeline, while the pipeline is running.
+ */
+pipe_status_t pipe_mgr_learner_timeout_set(pipe_sess_hdl_t sess_hdl,
+                                           dev_target_t dev_tgt,
+                                           uint32_t timeout_id,
+                                           uint32_t timeout);
+
+/* API to get a learner timer profile (timeout in seconds) of a pipeline */
+pipe_status_t pipe_mgr_learner_timeout_get(pipe_sess_hdl_t sess_hdl,
+                                           dev_target_t dev_tgt,
+                                           uint32_t timeout_id,
+                                           uint32_t *timeout);
+
 /* Set the Idle timeout TTL for a given match entry */
 pipe_status_t pipe_mgr_mat_ent_set_idle_ttl(
     pipe_sess_hdl_t sess_hdl,
@@ -1432,6 +1485,10 @@ pipe_status_t pipe_stful_direct_query_get_sizes(pipe_sess_hdl_t sess_hdl,
                                                 pipe_mat_tbl_hdl_t mat_tbl_hdl,
                                                 int *num_pipes);
 
+/* API to read a register index. The value is read from the first instance
+ * of a pipeline, the writes of the data path of the other instances are not
+ * reflected.
+ */
 pipe_status_t pipe_stful_ent_query(pipe_sess_hdl_t sess_hdl,
                                    dev_target_t dev_tgt,
 				   const char *name,
@@ -1574,6 +1631,11 @@ pipe_status_t pipe_mgr_get_reserved_entry_count(pipe_sess_hdl_t sess_hdl,
 /**
  * Get entry count for the given table
  *
+ * The count is the number of entries added to the table. The default
+ * entry is not counted, so a full table reads as its size.
+ * Learner (add on miss) tables are filled by the pipeline itself and
+ * their entries can't be counted: BF_NOT_SUPPORTED is returned for them.
+ *
  * @param  sess_hdl              Session handle.
  * @param  dev_tgt               Device target.
  * @param  tbl_hdl               Table handle.
@@ -1679,6 +1741,51 @@ pipe_status_t pipe_mgr_enable_pipeline(bf_dev_id_t dev_id);
 pipe_status_t pipe_mgr_get_num_pipelines(bf_dev_id_t dev_id,
                                          uint32_t *num_pipes);
 
+/*! Cycle telemetry of a pipeline and of the core it runs on. Cycles are
+ * TSC cycles, counted since the core or the pipeline was started.
+ */
+typedef struct pipe_mgr_pipeline_thread_stats {
+  uint32_t thread_id;            /*< Core the pipeline runs on */
+  uint64_t tsc_hz;               /*< TSC frequency */
+  uint64_t thread_cycles;        /*< Cycles since the core was started */
+  uint64_t thread_iterations;    /*< Iterations of the core dispatch loop */
+  uint64_t thread_run_cycles;    /*< Cycles running all its pipelines */
+  uint64_t thread_ctrl_cycles;   /*< Cycles handling control messages */
+  uint64_t thread_ctrl_msgs;     /*< Control messages handled */
+  uint64_t pipeline_runs;        /*< Runs of this pipeline */
+  uint64_t pipeline_run_cycles;  /*< Cycles running this pipeline */
+  uint64_t pipeline_pkts_in;     /*< Packets received by this pipeline */
+  uint64_t pipeline_empty_polls; /*< Input port polls with no packet */
+} pipe_mgr_pipeline_thread_stats_t;
+
+/*
+ * This function is used to get the cycle telemetry of a pipeline
+ *
+ * @param  sess_hdl		Session handle
+ * @param  dev_tgt		Device target (device id, pipe id)
+ * @param  stats (out)		Telemetry of the pipeline and its core
+ * @return			Status of the API call
+ */
+pipe_status_t pipe_mgr_pipeline_thread_stats_get(
+    pipe_sess_hdl_t sess_hdl,
+    dev_target_t dev_tgt,
+    pipe_mgr_pipeline_thread_stats_t *stats);
+
+/*
+ * This function is used to move a running pipeline to another core
+ * without stopping its traffic. The instances of a pipeline run on
+ * consecutive cores from core_id and are moved together, either all of
+ * them move or none does.
+ *
+ * @param  sess_hdl		Session handle
+ * @param  dev_tgt		Device target (device id, pipe id)
+ * @param  core_id		Core the pipeline is moved to
+ * @return			Status of the API call
+ */
+pipe_status_t pipe_mgr_pipeline_migrate(pipe_sess_hdl_t sess_hdl,
+                                        dev_target_t dev_tgt,
+                                        uint32_t core_id);
+
 
 /*  ---- Table debug counter APIs start  ---- */
 
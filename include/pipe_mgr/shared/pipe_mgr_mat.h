@@ -115,6 +115,23 @@ struct pipe_meter_spec {
 	/*< Meter peak burst size */
 };
 
+/*!
+ * Enum to define meter colors
+ */
+enum pipe_meter_color {
+	METER_COLOR_GREEN,  /*< Traffic conforming to committed rate */
+	METER_COLOR_YELLOW, /*< Traffic exceeding committed rate only */
+	METER_COLOR_RED,    /*< Traffic exceeding peak rate */
+	METER_COLOR_MAX,
+};
+
+/*! Per color meter statistics
+ */
+struct pipe_meter_stats {
+	u64 pkts[METER_COLOR_MAX];  /*< Packets marked with each color */
+	u64 bytes[METER_COLOR_MAX]; /*< Bytes marked with each color */
+};
+
 /*! Statstics state data
  */
 struct pipe_stat_data {
@@ -251,6 +268,10 @@ typedef struct pipe_meter_rate pipe_meter_rate_t;
  */
 typedef struct pipe_meter_spec pipe_meter_spec_t;
 
+/*! Per color meter statistics
+ */
+typedef struct pipe_meter_stats pipe_meter_stats_t;
+
 /*! Statstics state data
  */
 typedef struct pipe_stat_data pipe_stat_data_t;
@@ -26,8 +26,11 @@ extern "C" {
 
 #include "port_mgr/dpdk/bf_dpdk_port_if.h"
 
+/* Pipelines are built from an iospec kept in memory. When SDE_IOSPEC_DUMP
+ * is set in the environment, the iospec of each pipeline is also written
+ * to IOSPEC_FILE_PATH.<pipeline name> for debugging.
+ */
 #define IOSPEC_FILE_PATH "/tmp/iospec.io"
-int write_to_iospec_file(char *buf);
 
 /**
  * @file bf_port_if.h
@@ -44,13 +47,7 @@ typedef enum {
   BF_PORT_DIR_MAX
 } bf_port_dir_e;
 
-/**
- * Port Info Structure
- */
-struct port_info_t {
-  bf_dev_port_t dev_port;               /*!< Port ID */
-  struct port_attributes_t port_attrib; /*!< Port Attributes */
-};
+struct pipeline;
 
 /**
  * Enum identifying Port Counters
@@ -74,6 +71,18 @@ enum port_counters_t {
 	BF_PORT_NUM_COUNTERS,    /*!< Total Number of Counters */
 };
 
+/**
+ * Port Info Structure
+ */
+struct port_info_t {
+  bf_dev_port_t dev_port;               /*!< Port ID */
+  struct port_attributes_t port_attrib; /*!< Port Attributes */
+  struct pipeline *pipe_in;   /*!< Ingress Pipeline, cached on stats read */
+  struct pipeline *pipe_out;  /*!< Egress Pipeline, cached on stats read */
+  uint64_t stats[BF_PORT_NUM_COUNTERS]; /*!< Stats as of the last refresh */
+  bool stats_valid;           /*!< Stats have been refreshed at least once */
+};
+
 bf_status_t bf_port_mgr_init(void);
 
 #ifdef __cplusplus
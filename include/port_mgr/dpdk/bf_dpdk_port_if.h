@@ -74,6 +74,8 @@ enum dpdk_port_type_t {
 	BF_DPDK_SOURCE,   /*!< DPDK Source Port */
 	BF_DPDK_SINK,   /*!< DPDK Sink Port */
 	BF_DPDK_RING,   /*!< DPDK Ring Port */
+	BF_DPDK_VIRTIO_USER,   /*!< DPDK Virtio-user Exception Port */
+	BF_DPDK_MEMIF,   /*!< DPDK Shared Memory Packet Interface Port */
 	BF_DPDK_PORT_MAX,   /*!< DPDK Invalid Port */
 };
 
@@ -91,6 +93,12 @@ struct link_port_attributes_t {
 	char pcie_domain_bdf[PCIE_BDF_LEN]; /*!< PCIE Domain BDF */
 	char dev_args[DEV_ARGS_LEN]; /*!< Device Arguments */
 	uint32_t dev_hotplug_enabled; /*!< Device Hotplug Enabled Flag */
+	uint32_t n_rxq;         /*!< Number of RX Queues, queue i is input
+				 *   port port_in_id + i, 0 for one queue */
+	uint32_t n_txq;         /*!< Number of TX Queues, queue i is output
+				 *   port port_out_id + i, 0 for one queue */
+	uint32_t rx_burst_size; /*!< RX Burst Size, 0 for the default */
+	uint32_t tx_burst_size; /*!< TX Burst Size, 0 for the default */
 };
 
 /**
@@ -112,6 +120,41 @@ struct sink_port_attributes_t {
  */
 struct ring_port_attributes_t {
 	uint32_t size; /*!< Size of the ring port */
+	uint32_t burst_size; /*!< Burst Size of a ring port between two
+			      *   pipelines, 0 for the default */
+	uint32_t pipeline_link; /*!< Pipeline Link Flag: a ring port between
+				 *   two pipelines is a pipeline link */
+};
+
+/**
+ * DPDK Virtio-user Port Attributes. The port is a virtio-user ethdev with
+ * a vhost-kernel backend: the kernel sees it as the interface port_name,
+ * and packets are exchanged in bursts over shared virtqueues instead of
+ * one syscall per packet as with Tap Ports.
+ */
+struct virtio_user_port_attributes_t {
+	uint32_t mtu;           /*!< Port MTU */
+	uint32_t queue_size;    /*!< Virtqueue Size, 0 for the default */
+	uint32_t burst_size;    /*!< RX/TX Burst Size, 0 for the default
+				 *   of PORT_IN_BURST_SIZE both ways */
+};
+
+/**
+ * DPDK Memif Port Attributes. The port is a memif ethdev: packets are
+ * exchanged with a peer process on the same host over rings in shared
+ * memory, negotiated through the control socket socket_path.
+ */
+struct memif_port_attributes_t {
+	char socket_path[SOCK_PATH_LEN]; /*!< Control Socket Path, empty for
+					  *   the default /run/memif.sock */
+	uint32_t id;            /*!< Interface ID on the Control Socket */
+	uint32_t client;        /*!< Client Role Flag, server otherwise */
+	uint32_t zero_copy;     /*!< Zero-copy Flag, client role only */
+	uint32_t ring_size;     /*!< Ring Size, a power of 2, 0 for the
+				 *   default */
+	uint32_t buffer_size;   /*!< Buffer Size, 0 for the default */
+	uint32_t burst_size;    /*!< RX/TX Burst Size, 0 for the default
+				 *   of PORT_IN_BURST_SIZE both ways */
 };
 
 /**
@@ -128,6 +171,8 @@ struct port_attributes_t {
 	uint32_t port_in_id;    /*!< Port ID for Pipeline in Input Direction */
 	uint32_t port_out_id;   /*!< Port ID for Pipeline in Output Direction */
 	uint8_t net_port;    /*!< if set port is network port else host port*/
+	uint8_t dev_created; /*!< Set by port create, the port add then only
+			      *   adds the port to its pipelines */
 	enum dpdk_port_type_t port_type;            /*!< Port Type */
 
 	union {
@@ -136,6 +181,10 @@ struct port_attributes_t {
 		struct source_port_attributes_t source; /*!< Source Port Attributes */
 		struct sink_port_attributes_t sink;     /*!< Sink Port Attributes */
 		struct ring_port_attributes_t ring;     /*!< Ring Port Attributes */
+		struct virtio_user_port_attributes_t virtio_user;
+					/*!< Virtio-user Port Attributes */
+		struct memif_port_attributes_t memif;
+					/*!< Memif Port Attributes */
 	};
 };
 
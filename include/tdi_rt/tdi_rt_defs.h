@@ -249,6 +249,11 @@ enum tdi_rt_attributes_ipsec_sadb_expire_table_field_type_e {
   TDI_RT_ATTRIBUTES_IPSEC_SADB_EXPIRE_TABLE_FIELD_TYPE_COOKIE,
 };
 
+enum tdi_rt_attributes_port_stat_poll_intvl_field_type_e {
+  /** Stats cache refresh interval in msecs, 0 to read stats live */
+  TDI_RT_ATTRIBUTES_PORT_STAT_POLL_INTVL_FIELD_TYPE_MS = TDI_ATTRIBUTES_FIELD_BEGIN,
+};
+
 typedef enum tdi_rt_attributes_type_e tdi_rt_attributes_type_e;
 
 enum tdi_rt_operations_type_e {
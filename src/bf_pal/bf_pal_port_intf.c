@@ -152,7 +152,7 @@ bf_status_t bf_pal_port_add(bf_dev_id_t dev_id, bf_dev_port_t dev_port,
 
 bf_status_t bf_pal_port_del(bf_dev_id_t dev_id, bf_dev_port_t dev_port)
 {
-	return BF_SUCCESS;
+	return port_mgr_port_del(dev_id, dev_port);
 }
 
 bf_status_t bf_pal_port_all_stats_get(bf_dev_id_t dev_id,
@@ -162,6 +162,40 @@ bf_status_t bf_pal_port_all_stats_get(bf_dev_id_t dev_id,
 	return port_mgr_port_all_stats_get(dev_id, dev_port, stats);
 }
 
+bf_status_t bf_pal_port_all_stats_get_next_n(bf_dev_id_t dev_id,
+					     bf_dev_port_t dev_port,
+					     bool first,
+					     u32 n,
+					     bf_dev_port_t *dev_ports,
+					     u64 *stats,
+					     u32 *num_returned)
+{
+	return port_mgr_port_all_stats_get_next_n(dev_id, dev_port, first, n,
+						  dev_ports, stats,
+						  num_returned);
+}
+
+bf_status_t bf_pal_port_queue_stats_get(bf_dev_id_t dev_id,
+					bf_dev_port_t dev_port,
+					u32 queue_id,
+					u64 *stats)
+{
+	return port_mgr_port_queue_stats_get(dev_id, dev_port, queue_id,
+					     stats);
+}
+
+bf_status_t bf_pal_port_stats_poll_intvl_set(bf_dev_id_t dev_id,
+					     u32 poll_intvl_ms)
+{
+	return port_mgr_port_stats_poll_intvl_set(dev_id, poll_intvl_ms);
+}
+
+bf_status_t bf_pal_port_stats_poll_intvl_get(bf_dev_id_t dev_id,
+					     u32 *poll_intvl_ms)
+{
+	return port_mgr_port_stats_poll_intvl_get(dev_id, poll_intvl_ms);
+}
+
 bf_status_t bf_pal_get_port_id_from_mac(bf_dev_id_t dev_id, char *mac,
 					u32 *port_id)
 {
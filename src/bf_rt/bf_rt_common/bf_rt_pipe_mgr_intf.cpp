@@ -781,12 +781,16 @@ pipe_status_t PipeMgrIntf::pipeMgrValueLookupMatchSpecToEntHdl(pipe_sess_hdl_t s
 pipe_status_t PipeMgrIntf::pipeMgrMeterEntSet(
     pipe_sess_hdl_t sess_hdl,
     dev_target_t dev_tgt,
-    pipe_meter_tbl_hdl_t meter_tbl_hdl,
+    const char *table_name,
     pipe_meter_idx_t meter_idx,
     pipe_meter_spec_t *meter_spec,
     uint32_t pipe_api_flags) {
-  return pipe_mgr_meter_ent_set(
-      sess_hdl, dev_tgt, meter_tbl_hdl, meter_idx, meter_spec, pipe_api_flags);
+  return pipe_mgr_meter_ent_set(sess_hdl,
+                                dev_tgt,
+                                table_name,
+                                meter_idx,
+                                meter_spec,
+                                pipe_api_flags);
 }
 
 pipe_status_t PipeMgrIntf::pipeMgrMeterByteCountSet(
@@ -809,9 +813,9 @@ pipe_status_t PipeMgrIntf::pipeMgrMeterByteCountGet(
 
 pipe_status_t PipeMgrIntf::pipeMgrMeterReset(pipe_sess_hdl_t sess_hdl,
                                              dev_target_t dev_tgt,
-                                             pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                             const char *table_name,
                                              uint32_t pipe_api_flags) {
-  return pipe_mgr_meter_reset(sess_hdl, dev_tgt, meter_tbl_hdl, pipe_api_flags);
+  return pipe_mgr_meter_reset(sess_hdl, dev_tgt, table_name, pipe_api_flags);
 }
 
 pipe_status_t PipeMgrIntf::pipeMgrMeterReadEntry(
@@ -827,11 +831,43 @@ pipe_status_t PipeMgrIntf::pipeMgrMeterReadEntry(
 pipe_status_t PipeMgrIntf::pipeMgrMeterReadEntryIdx(
     pipe_sess_hdl_t sess_hdl,
     dev_target_t dev_tgt,
-    pipe_meter_tbl_hdl_t meter_tbl_hdl,
+    const char *table_name,
     pipe_meter_idx_t index,
     pipe_meter_spec_t *meter_spec) {
   return pipe_mgr_meter_read_entry_idx(
-      sess_hdl, dev_tgt, meter_tbl_hdl, index, meter_spec);
+      sess_hdl, dev_tgt, table_name, index, meter_spec);
+}
+
+pipe_status_t PipeMgrIntf::pipeMgrMeterEntSetRange(
+    pipe_sess_hdl_t sess_hdl,
+    dev_target_t dev_tgt,
+    const char *table_name,
+    pipe_meter_idx_t start_idx,
+    pipe_meter_idx_t end_idx,
+    pipe_meter_spec_t *meter_spec) {
+  return pipe_mgr_meter_ent_set_range(
+      sess_hdl, dev_tgt, table_name, start_idx, end_idx, meter_spec);
+}
+
+pipe_status_t PipeMgrIntf::pipeMgrMeterStatsRead(
+    pipe_sess_hdl_t sess_hdl,
+    dev_target_t dev_tgt,
+    const char *table_name,
+    pipe_meter_idx_t index,
+    pipe_meter_stats_t *meter_stats) {
+  return pipe_mgr_meter_stats_read(
+      sess_hdl, dev_tgt, table_name, index, meter_stats);
+}
+
+pipe_status_t PipeMgrIntf::pipeMgrMeterStatsReadRange(
+    pipe_sess_hdl_t sess_hdl,
+    dev_target_t dev_tgt,
+    const char *table_name,
+    pipe_meter_idx_t start_idx,
+    pipe_meter_idx_t end_idx,
+    pipe_meter_stats_t *meter_stats) {
+  return pipe_mgr_meter_stats_read_range(
+      sess_hdl, dev_tgt, table_name, start_idx, end_idx, meter_stats);
 }
 
 
@@ -853,6 +889,20 @@ pipe_status_t PipeMgrIntf::pipeMgrExmEntryDeactivate(
       sess_hdl, device_id, mat_tbl_hdl, mat_ent_hdl);
 }
 
+pipe_status_t PipeMgrIntf::pipeMgrLearnerTimeoutSet(pipe_sess_hdl_t sess_hdl,
+                                                    dev_target_t dev_tgt,
+                                                    uint32_t timeout_id,
+                                                    uint32_t timeout) {
+  return pipe_mgr_learner_timeout_set(sess_hdl, dev_tgt, timeout_id, timeout);
+}
+
+pipe_status_t PipeMgrIntf::pipeMgrLearnerTimeoutGet(pipe_sess_hdl_t sess_hdl,
+                                                    dev_target_t dev_tgt,
+                                                    uint32_t timeout_id,
+                                                    uint32_t *timeout) {
+  return pipe_mgr_learner_timeout_get(sess_hdl, dev_tgt, timeout_id, timeout);
+}
+
 pipe_status_t PipeMgrIntf::pipeMgrMatEntSetIdleTtl(
     pipe_sess_hdl_t sess_hdl,
     bf_dev_id_t device_id,
@@ -884,7 +934,8 @@ pipe_status_t PipeMgrIntf::pipeMgrIdleTmoEnableSet(
     bf_dev_id_t device_id,
     pipe_mat_tbl_hdl_t mat_tbl_hdl,
     bool enable) {
-	return BF_SUCCESS;
+  return pipe_mgr_idle_tmo_set_enable(
+      sess_hdl, device_id, mat_tbl_hdl, enable);
 }
 
 pipe_status_t PipeMgrIntf::pipeMgrIdleRegisterTmoCb(
@@ -923,7 +974,8 @@ pipe_status_t PipeMgrIntf::pipeMgrIdleTimeSetHitState(
     pipe_mat_tbl_hdl_t mat_tbl_hdl,
     pipe_mat_ent_hdl_t mat_ent_hdl,
     pipe_idle_time_hit_state_e idle_time_data) {
-	return BF_SUCCESS;
+  return pipe_mgr_idle_time_set_hit_state(
+      sess_hdl, device_id, mat_tbl_hdl, mat_ent_hdl, idle_time_data);
 }
 
 pipe_status_t PipeMgrIntf::pipeMgrIdleTimeUpdateHitState(
@@ -951,7 +1003,7 @@ pipe_status_t PipeMgrIntf::pipeMgrIdleParamsGet(
     bf_dev_id_t device_id,
     pipe_mat_tbl_hdl_t mat_tbl_hdl,
     pipe_idle_time_params_t *params) {
-	return BF_SUCCESS;
+  return pipe_mgr_idle_get_params(sess_hdl, device_id, mat_tbl_hdl, params);
 }
 
 pipe_status_t PipeMgrIntf::pipeMgrIdleParamsSet(
@@ -959,7 +1011,7 @@ pipe_status_t PipeMgrIntf::pipeMgrIdleParamsSet(
     bf_dev_id_t device_id,
     pipe_mat_tbl_hdl_t mat_tbl_hdl,
     pipe_idle_time_params_t params) {
-	return BF_SUCCESS;
+  return pipe_mgr_idle_set_params(sess_hdl, device_id, mat_tbl_hdl, params);
 }
 
 pipe_status_t PipeMgrIntf::pipeStfulEntSet(pipe_sess_hdl_t sess_hdl,
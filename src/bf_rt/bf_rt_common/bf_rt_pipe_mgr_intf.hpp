@@ -494,14 +494,14 @@ class IPipeMgrIntf {
 
   virtual pipe_status_t pipeMgrMeterEntSet(pipe_sess_hdl_t sess_hdl,
                                            dev_target_t dev_tgt,
-                                           pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                           const char *table_name,
                                            pipe_meter_idx_t meter_idx,
                                            pipe_meter_spec_t *meter_spec,
                                            uint32_t pipe_api_flags) = 0;
 
   virtual pipe_status_t pipeMgrMeterReset(pipe_sess_hdl_t sess_hdl,
                                           dev_target_t dev_tgt,
-                                          pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                          const char *table_name,
                                           uint32_t pipe_api_flags) = 0;
 
   virtual pipe_status_t pipeMgrMeterReadEntry(
@@ -514,10 +514,33 @@ class IPipeMgrIntf {
   virtual pipe_status_t pipeMgrMeterReadEntryIdx(
       pipe_sess_hdl_t sess_hdl,
       dev_target_t dev_tgt,
-      pipe_meter_tbl_hdl_t meter_tbl_hdl,
+      const char *table_name,
       pipe_meter_idx_t index,
       pipe_meter_spec_t *meter_spec) = 0;
 
+  virtual pipe_status_t pipeMgrMeterEntSetRange(
+      pipe_sess_hdl_t sess_hdl,
+      dev_target_t dev_tgt,
+      const char *table_name,
+      pipe_meter_idx_t start_idx,
+      pipe_meter_idx_t end_idx,
+      pipe_meter_spec_t *meter_spec) = 0;
+
+  virtual pipe_status_t pipeMgrMeterStatsRead(
+      pipe_sess_hdl_t sess_hdl,
+      dev_target_t dev_tgt,
+      const char *table_name,
+      pipe_meter_idx_t index,
+      pipe_meter_stats_t *meter_stats) = 0;
+
+  virtual pipe_status_t pipeMgrMeterStatsReadRange(
+      pipe_sess_hdl_t sess_hdl,
+      dev_target_t dev_tgt,
+      const char *table_name,
+      pipe_meter_idx_t start_idx,
+      pipe_meter_idx_t end_idx,
+      pipe_meter_stats_t *meter_stats) = 0;
+
   virtual pipe_status_t pipeMgrMeterByteCountSet(
       pipe_sess_hdl_t sess_hdl,
       dev_target_t dev_tgt,
@@ -543,6 +566,16 @@ class IPipeMgrIntf {
       pipe_mat_tbl_hdl_t mat_tbl_hdl,
       pipe_mat_ent_hdl_t mat_ent_hdl) = 0;
 
+  virtual pipe_status_t pipeMgrLearnerTimeoutSet(pipe_sess_hdl_t sess_hdl,
+                                                 dev_target_t dev_tgt,
+                                                 uint32_t timeout_id,
+                                                 uint32_t timeout) = 0;
+
+  virtual pipe_status_t pipeMgrLearnerTimeoutGet(pipe_sess_hdl_t sess_hdl,
+                                                 dev_target_t dev_tgt,
+                                                 uint32_t timeout_id,
+                                                 uint32_t *timeout) = 0;
+
   virtual pipe_status_t pipeMgrMatEntSetIdleTtl(
       pipe_sess_hdl_t sess_hdl,
       bf_dev_id_t device_id,
@@ -1304,7 +1337,7 @@ class PipeMgrIntf : public IPipeMgrIntf {
 
   pipe_status_t pipeMgrMeterEntSet(pipe_sess_hdl_t sess_hdl,
                                    dev_target_t dev_tgt,
-                                   pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                   const char *table_name,
                                    pipe_meter_idx_t meter_idx,
                                    pipe_meter_spec_t *meter_spec,
                                    uint32_t pipe_api_flags);
@@ -1315,7 +1348,7 @@ class PipeMgrIntf : public IPipeMgrIntf {
 
   pipe_status_t pipeMgrMeterReset(pipe_sess_hdl_t sess_hdl,
                                   dev_target_t dev_tgt,
-                                  pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                  const char *table_name,
                                   uint32_t pipe_api_flags);
 
   pipe_status_t pipeMgrMeterReadEntry(pipe_sess_hdl_t sess_hdl,
@@ -1326,10 +1359,30 @@ class PipeMgrIntf : public IPipeMgrIntf {
 
   pipe_status_t pipeMgrMeterReadEntryIdx(pipe_sess_hdl_t sess_hdl,
                                          dev_target_t dev_tgt,
-                                         pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                         const char *table_name,
                                          pipe_meter_idx_t index,
                                          pipe_meter_spec_t *meter_spec);
 
+  pipe_status_t pipeMgrMeterEntSetRange(pipe_sess_hdl_t sess_hdl,
+                                        dev_target_t dev_tgt,
+                                        const char *table_name,
+                                        pipe_meter_idx_t start_idx,
+                                        pipe_meter_idx_t end_idx,
+                                        pipe_meter_spec_t *meter_spec);
+
+  pipe_status_t pipeMgrMeterStatsRead(pipe_sess_hdl_t sess_hdl,
+                                      dev_target_t dev_tgt,
+                                      const char *table_name,
+                                      pipe_meter_idx_t index,
+                                      pipe_meter_stats_t *meter_stats);
+
+  pipe_status_t pipeMgrMeterStatsReadRange(pipe_sess_hdl_t sess_hdl,
+                                           dev_target_t dev_tgt,
+                                           const char *table_name,
+                                           pipe_meter_idx_t start_idx,
+                                           pipe_meter_idx_t end_idx,
+                                           pipe_meter_stats_t *meter_stats);
+
   pipe_status_t pipeMgrMeterByteCountSet(pipe_sess_hdl_t sess_hdl,
                                          dev_target_t dev_tgt,
                                          pipe_meter_tbl_hdl_t meter_tbl_hdl,
@@ -1350,6 +1403,16 @@ class PipeMgrIntf : public IPipeMgrIntf {
                                           pipe_mat_tbl_hdl_t mat_tbl_hdl,
                                           pipe_mat_ent_hdl_t mat_ent_hdl);
 
+  pipe_status_t pipeMgrLearnerTimeoutSet(pipe_sess_hdl_t sess_hdl,
+                                         dev_target_t dev_tgt,
+                                         uint32_t timeout_id,
+                                         uint32_t timeout);
+
+  pipe_status_t pipeMgrLearnerTimeoutGet(pipe_sess_hdl_t sess_hdl,
+                                         dev_target_t dev_tgt,
+                                         uint32_t timeout_id,
+                                         uint32_t *timeout);
+
   pipe_status_t pipeMgrMatEntSetIdleTtl(pipe_sess_hdl_t sess_hdl,
                                         bf_dev_id_t device_id,
                                         pipe_mat_tbl_hdl_t mat_tbl_hdl,
@@ -1973,6 +1973,77 @@ bf_status_t BfRtMatchActionTable::tableAttributesSet(
       }
       return sts;
     }
+    case TableAttributesType::IDLE_TABLE_RUNTIME: {
+      TableAttributesIdleTableMode mode;
+      bool enable;
+      BfRtIdleTmoExpiryCb callback_cpp;
+      uint32_t ttl_query_interval, max_ttl, min_ttl;
+      void *cookie;
+      bf_status_t sts = tbl_attr_impl->idleTableGet(&mode,
+                                                    &enable,
+                                                    &callback_cpp,
+                                                    &ttl_query_interval,
+                                                    &max_ttl,
+                                                    &min_ttl,
+                                                    &cookie);
+      if (sts != BF_SUCCESS) {
+        return sts;
+      }
+      auto device_state =
+          BfRtDevMgrImpl::bfRtDeviceStateGet(dev_tgt.dev_id, prog_name);
+      if (device_state == nullptr) {
+        BF_RT_ASSERT(0);
+        return BF_OBJECT_NOT_FOUND;
+      }
+      auto attributes_state =
+          device_state->attributesState.getObjState(table_id_get());
+      auto *pipeMgr = PipeMgrIntf::getInstance();
+
+      // Aging has to be stopped before the params can be changed
+      sts = pipeMgr->pipeMgrIdleTmoEnableSet(
+          session.sessHandleGet(), dev_tgt.dev_id, pipe_tbl_hdl, false);
+      if (sts != BF_SUCCESS) {
+        return sts;
+      }
+      attributes_state->setAgingAttributeObj(
+          BfRtStateTableAttributesAging(enable,
+                                        callback_cpp,
+                                        tbl_attr_impl->getIdleTableCallbackC(),
+                                        this,
+                                        cookie));
+
+      pipe_idle_time_params_t params =
+          tbl_attr_impl->getIdleTableTtlParamsInternal();
+      if (mode == TableAttributesIdleTableMode::NOTIFY_MODE) {
+        params.u.notify.callback_fn2 = bfRtIdleTmoExpiryInternalCb;
+        params.u.notify.client_data =
+            &attributes_state->getAgingAttributeObj();
+        params.u.notify.default_callback_choice = 1;
+        idletimeCbThreadPoolReset(enable ? new BfRtThreadPool() : nullptr);
+      } else {
+        idletimeCbThreadPoolReset(nullptr);
+      }
+      sts = pipeMgr->pipeMgrIdleParamsSet(
+          session.sessHandleGet(), dev_tgt.dev_id, pipe_tbl_hdl, params);
+      if (sts != BF_SUCCESS) {
+        LOG_TRACE("%s:%d %s Failed to set idle table params",
+                  __func__,
+                  __LINE__,
+                  table_name_get().c_str());
+        return sts;
+      }
+      if (enable) {
+        sts = pipeMgr->pipeMgrIdleTmoEnableSet(
+            session.sessHandleGet(), dev_tgt.dev_id, pipe_tbl_hdl, true);
+        if (sts != BF_SUCCESS) {
+          return sts;
+        }
+      }
+      idle_table_state->setEnabled(enable);
+      idle_table_state->setPollMode(mode ==
+                                    TableAttributesIdleTableMode::POLL_MODE);
+      return BF_SUCCESS;
+    }
     case TableAttributesType::METER_BYTE_COUNT_ADJ: {
       int byte_count;
       bf_status_t sts = tbl_attr_impl->meterByteCountAdjGet(&byte_count);
@@ -6156,7 +6227,7 @@ bf_status_t BfRtMeterTable::tableEntryAdd(const BfRtSession &session,
 
   return pipeMgr->pipeMgrMeterEntSet(session.sessHandleGet(),
                                      pipe_dev_tgt,
-                                     pipe_tbl_hdl,
+                                     table_name_get().c_str(),
                                      meter_idx,
                                      (pipe_meter_spec_t *)meter_spec,
                                      0 /* Pipe API flags */);
@@ -6204,7 +6275,7 @@ bf_status_t BfRtMeterTable::tableEntryGet(const BfRtSession &session,
 
   status = pipeMgr->pipeMgrMeterReadEntryIdx(session.sessHandleGet(),
                                              pipe_dev_tgt,
-                                             pipe_tbl_hdl,
+                                             table_name_get().c_str(),
                                              meter_idx,
                                              &meter_spec);
 
@@ -6300,7 +6371,7 @@ bf_status_t BfRtMeterTable::tableClear(const BfRtSession &session,
 
   bf_status_t status = pipeMgr->pipeMgrMeterReset(session.sessHandleGet(),
                                                   pipe_dev_tgt,
-                                                  this->pipe_tbl_hdl,
+                                                  table_name_get().c_str(),
                                                   0 /* Pipe API flags */);
   if (status != BF_SUCCESS) {
     LOG_TRACE("%s:%d %s Error in CLearing Meter table, err %d",
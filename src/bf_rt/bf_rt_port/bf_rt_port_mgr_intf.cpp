@@ -32,6 +32,11 @@ bf_status_t PortMgrIntf::portMgrPortAdd(bf_dev_id_t dev_id,
   return bf_pal_port_add(dev_id, dev_port, port_attrib);
 }
 
+bf_status_t PortMgrIntf::portMgrPortDel(bf_dev_id_t dev_id,
+                                        bf_dev_port_t dev_port) {
+  return bf_pal_port_del(dev_id, dev_port);
+}
+
 // Port Stats
 bf_status_t PortMgrIntf::portMgrPortAllStatsGet(
     bf_dev_id_t dev_id,
@@ -40,4 +45,28 @@ bf_status_t PortMgrIntf::portMgrPortAllStatsGet(
   return bf_pal_port_all_stats_get(dev_id, dev_port, stats);
 }
 
+// Port Stats of the next n ports, in one pass
+bf_status_t PortMgrIntf::portMgrPortAllStatsGetNextN(
+    bf_dev_id_t dev_id,
+    bf_dev_port_t dev_port,
+    bool first,
+    uint32_t n,
+    bf_dev_port_t *dev_ports,
+    uint64_t *stats,
+    uint32_t *num_returned) {
+  return bf_pal_port_all_stats_get_next_n(
+      dev_id, dev_port, first, n, dev_ports, stats, num_returned);
+}
+
+// Port Stats refresh interval, 0 if stats are read live
+bf_status_t PortMgrIntf::portMgrPortStatsPollIntvlSet(bf_dev_id_t dev_id,
+                                                      uint32_t poll_intvl_ms) {
+  return bf_pal_port_stats_poll_intvl_set(dev_id, poll_intvl_ms);
+}
+
+bf_status_t PortMgrIntf::portMgrPortStatsPollIntvlGet(
+    bf_dev_id_t dev_id, uint32_t *poll_intvl_ms) {
+  return bf_pal_port_stats_poll_intvl_get(dev_id, poll_intvl_ms);
+}
+
 }  // namespace bfrt
@@ -38,10 +38,24 @@ class IPortMgrIntf {
   virtual bf_status_t portMgrPortAdd(bf_dev_id_t dev_id,
                                      bf_dev_port_t dev_port,
                                      struct port_attributes_t *port_attrib) = 0;
+  virtual bf_status_t portMgrPortDel(bf_dev_id_t dev_id,
+                                     bf_dev_port_t dev_port) = 0;
   virtual bf_status_t portMgrPortAllStatsGet(
       bf_dev_id_t dev_id,
       bf_dev_port_t dev_port,
       uint64_t *stats) = 0;
+  virtual bf_status_t portMgrPortAllStatsGetNextN(
+      bf_dev_id_t dev_id,
+      bf_dev_port_t dev_port,
+      bool first,
+      uint32_t n,
+      bf_dev_port_t *dev_ports,
+      uint64_t *stats,
+      uint32_t *num_returned) = 0;
+  virtual bf_status_t portMgrPortStatsPollIntvlSet(
+      bf_dev_id_t dev_id, uint32_t poll_intvl_ms) = 0;
+  virtual bf_status_t portMgrPortStatsPollIntvlGet(
+      bf_dev_id_t dev_id, uint32_t *poll_intvl_ms) = 0;
 
  protected:
   static std::unique_ptr<IPortMgrIntf> instance;
@@ -59,9 +73,21 @@ class PortMgrIntf : public IPortMgrIntf {
   bf_status_t portMgrPortAdd(bf_dev_id_t dev_id,
                              bf_dev_port_t dev_port,
                              struct port_attributes_t *port_attrib);
+  bf_status_t portMgrPortDel(bf_dev_id_t dev_id, bf_dev_port_t dev_port);
   bf_status_t portMgrPortAllStatsGet(bf_dev_id_t dev_id,
                                      bf_dev_port_t dev_port,
                                      uint64_t *stats);
+  bf_status_t portMgrPortAllStatsGetNextN(bf_dev_id_t dev_id,
+                                          bf_dev_port_t dev_port,
+                                          bool first,
+                                          uint32_t n,
+                                          bf_dev_port_t *dev_ports,
+                                          uint64_t *stats,
+                                          uint32_t *num_returned);
+  bf_status_t portMgrPortStatsPollIntvlSet(bf_dev_id_t dev_id,
+                                           uint32_t poll_intvl_ms);
+  bf_status_t portMgrPortStatsPollIntvlGet(bf_dev_id_t dev_id,
+                                           uint32_t *poll_intvl_ms);
 };
 }  // namespace bfrt
 
@@ -52,6 +52,8 @@ void BfRtPortCfgTable::mapInit() {
   portTypeMap["BF_DPDK_SOURCE"] = BF_DPDK_SOURCE;
   portTypeMap["BF_DPDK_SINK"] = BF_DPDK_SINK;
   portTypeMap["BF_DPDK_RING"] = BF_DPDK_RING;
+  portTypeMap["BF_DPDK_VIRTIO_USER"] = BF_DPDK_VIRTIO_USER;
+  portTypeMap["BF_DPDK_MEMIF"] = BF_DPDK_MEMIF;
 }
 
 bf_status_t BfRtPortCfgTable::tableEntryAdd(const BfRtSession & /*session*/,
@@ -256,6 +258,26 @@ bf_status_t BfRtPortCfgTable::tableEntryAdd(const BfRtSession & /*session*/,
           return BF_INVALID_ARG;
       }
       break;
+    case BF_DPDK_VIRTIO_USER:
+      if (u32Data.find(MTU_ID) != u32Data.end()) {
+          port_attrib.virtio_user.mtu =  u32Data.at(MTU_ID);
+      } else {
+          LOG_ERROR("%s:%d %s ERROR : Virtio-user Port needs mtu",
+                     __func__,
+                     __LINE__,
+                     table_name_get().c_str());
+          return BF_INVALID_ARG;
+      }
+      break;
+    case BF_DPDK_MEMIF:
+      // The file name is the memif control socket path, if any
+      if (strData.find(FILE_NAME_ID) != strData.end()) {
+          strncpy(port_attrib.memif.socket_path,
+                  strData.at(FILE_NAME_ID).c_str(),
+                  SOCK_PATH_LEN - 1);
+	  port_attrib.memif.socket_path[SOCK_PATH_LEN - 1] = '\0';
+      }
+      break;
     default:
       LOG_ERROR("%s:%d ERROR : Incorrect Port Type",
                  __func__,
@@ -279,7 +301,20 @@ bf_status_t BfRtPortCfgTable::tableEntryAdd(const BfRtSession & /*session*/,
 bf_status_t BfRtPortCfgTable::tableEntryDel(const BfRtSession & /*session*/,
                                             const bf_rt_target_t &dev_tgt,
                                             const BfRtTableKey &key) const {
-  return BF_SUCCESS;
+  const BfRtPortCfgTableKey &port_key =
+      static_cast<const BfRtPortCfgTableKey &>(key);
+  const uint32_t dev_port = port_key.getId();
+  auto *portMgr = PortMgrIntf::getInstance();
+
+  bf_status_t status = portMgr->portMgrPortDel(dev_tgt.dev_id, dev_port);
+  if (BF_SUCCESS != status) {
+      LOG_ERROR("%s:%d %s: Error in deleting port %d",
+              __func__,
+              __LINE__,
+              table_name_get().c_str(),
+              dev_port);
+  }
+  return status;
 }
 
 bf_status_t BfRtPortCfgTable::keyReset(BfRtTableKey *key) const {
@@ -516,4 +551,73 @@ bf_status_t BfRtPortStatTable::attributeAllocate(
       new BfRtTableAttributesImpl(this, type));
   return BF_SUCCESS;
 }
+
+bf_status_t BfRtPortStatTable::tableAttributesSet(
+    const BfRtSession & /*session*/,
+    const bf_rt_target_t &dev_tgt,
+    const BfRtTableAttributes &tableAttributes) const {
+  auto tbl_attr_impl =
+      static_cast<const BfRtTableAttributesImpl *>(&tableAttributes);
+  const auto attr_type = tbl_attr_impl->getAttributeType();
+  std::set<TableAttributesType> attribute_type_set;
+  auto bf_status = tableAttributesSupported(&attribute_type_set);
+  if (bf_status != BF_SUCCESS ||
+      (attribute_type_set.find(attr_type) == attribute_type_set.end())) {
+    LOG_ERROR("%s:%d Attribute %d is not supported",
+              __func__,
+              __LINE__,
+              static_cast<int>(attr_type));
+    return BF_NOT_SUPPORTED;
+  }
+  switch (attr_type) {
+    case TableAttributesType::PORT_STAT_POLL_INTVL_MS: {
+      uint32_t poll_intvl_ms = 0;
+      bf_status = tbl_attr_impl->portStatPollIntvlMsGet(&poll_intvl_ms);
+      if (bf_status != BF_SUCCESS) {
+        return bf_status;
+      }
+      auto *portMgr = PortMgrIntf::getInstance();
+      return portMgr->portMgrPortStatsPollIntvlSet(dev_tgt.dev_id,
+                                                   poll_intvl_ms);
+    }
+    default:
+      LOG_ERROR(
+          "%s:%d Invalid Attribute type (%d) encountered while trying to set "
+          "attributes",
+          __func__,
+          __LINE__,
+          static_cast<int>(attr_type));
+      return BF_NOT_SUPPORTED;
+  }
+  return BF_SUCCESS;
+}
+
+bf_status_t BfRtPortStatTable::tableAttributesGet(
+    const BfRtSession & /*session*/,
+    const bf_rt_target_t &dev_tgt,
+    BfRtTableAttributes *tableAttributes) const {
+  auto tbl_attr_impl = static_cast<BfRtTableAttributesImpl *>(tableAttributes);
+  const auto attr_type = tbl_attr_impl->getAttributeType();
+  switch (attr_type) {
+    case TableAttributesType::PORT_STAT_POLL_INTVL_MS: {
+      uint32_t poll_intvl_ms = 0;
+      auto *portMgr = PortMgrIntf::getInstance();
+      auto bf_status = portMgr->portMgrPortStatsPollIntvlGet(dev_tgt.dev_id,
+                                                             &poll_intvl_ms);
+      if (bf_status != BF_SUCCESS) {
+        return bf_status;
+      }
+      return tbl_attr_impl->portStatPollIntvlMsSet(poll_intvl_ms);
+    }
+    default:
+      LOG_ERROR(
+          "%s:%d Invalid Attribute type (%d) encountered while trying to get "
+          "attributes",
+          __func__,
+          __LINE__,
+          static_cast<int>(attr_type));
+      return BF_NOT_SUPPORTED;
+  }
+  return BF_SUCCESS;
+}
 }  // bfrt
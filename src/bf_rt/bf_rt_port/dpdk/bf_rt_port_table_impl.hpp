@@ -124,6 +124,15 @@ class BfRtPortStatTable : public BfRtTableObj {
   bf_status_t attributeAllocate(
       const TableAttributesType &type,
       std::unique_ptr<BfRtTableAttributes> *attr) const override;
+  bf_status_t tableAttributesSet(
+      const BfRtSession & /*session*/,
+      const bf_rt_target_t &dev_tgt,
+      const BfRtTableAttributes &tableAttributes) const override;
+  bf_status_t tableAttributesGet(
+      const BfRtSession & /*session*/,
+      const bf_rt_target_t &dev_tgt,
+      BfRtTableAttributes *tableAttributes) const override;
+
  private:
   bf_status_t tableEntryGet_internal(const bf_rt_target_t &dev_tgt,
                                      const uint32_t &dev_port,
@@ -0,0 +1,271 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_log.h>
+
+#include "dpdk_infra.h"
+
+#ifndef BALANCER_PERIOD_MS
+#define BALANCER_PERIOD_MS                                 1000
+#endif
+
+#ifndef BALANCER_HYSTERESIS
+#define BALANCER_HYSTERESIS                                3
+#endif
+
+#ifndef BALANCER_HOLD
+#define BALANCER_HOLD                                      10
+#endif
+
+/**
+ * Load balancer
+ *
+ * Once per period, the balancer estimates the cycles each pipeline spent
+ * on packets: the cycles spent running the pipeline, scaled by the share
+ * of its input port reads that returned packets rather than nothing. The
+ * load of a data plane thread is the sum over its pipelines.
+ *
+ * A pipeline whose thread stayed above the pipeline threshold for
+ * hysteresis periods is moved to the least loaded thread, provided that
+ * thread stays below the threshold with the pipeline added and ends up
+ * less loaded than the source thread was. A thread sheds at most one
+ * pipeline per period and a moved pipeline is not moved again for hold
+ * periods, so that pipelines don't flap between threads.
+ *
+ * A pass runs with the migration lock held: no other control thread moves
+ * a pipeline between the loads being read and the pipelines being moved,
+ * and the pipelines moved go through their migration hook like any other.
+ * The instances of a sharded pipeline are never moved on their own.
+ */
+static pthread_t balancer_thread_id;
+static uint32_t balancer_running; /* Atomic, read by any control thread. */
+
+/* Written by the balancer thread only. */
+static uint64_t balancer_load[RTE_MAX_LCORE]; /* Cycles, last period. */
+static uint32_t balancer_n_pipelines[RTE_MAX_LCORE];
+static uint64_t balancer_period;
+
+static int
+balancer_thread_is_running(uint32_t thread_id)
+{
+	struct thread_stats stats;
+
+	return rte_lcore_is_enabled(thread_id) &&
+		(thread_id != rte_get_main_lcore()) &&
+		(rte_eal_get_lcore_state(thread_id) == RUNNING) &&
+		!thread_stats_read(thread_id, &stats);
+}
+
+static void
+balancer_load_update(void)
+{
+	struct pipeline *p;
+
+	memset(balancer_load, 0, sizeof(balancer_load));
+	memset(balancer_n_pipelines, 0, sizeof(balancer_n_pipelines));
+
+	for (p = pipeline_next(NULL); p; p = pipeline_next(p)) {
+		struct thread_pipeline_stats stats;
+		uint64_t run_cycles, n_pkts, n_empty;
+
+		if (!p->enabled || thread_pipeline_stats_read(p->name, &stats))
+			continue;
+
+		/* The run counters restart when the pipeline is moved. */
+		run_cycles = stats.run_cycles;
+		if (run_cycles >= p->balance_run_cycles)
+			run_cycles -= p->balance_run_cycles;
+		n_pkts = stats.n_pkts_in - p->balance_n_pkts;
+		n_empty = stats.n_empty_polls - p->balance_n_empty;
+
+		p->balance_load = (n_pkts + n_empty) ?
+			(uint64_t)((double)run_cycles * n_pkts /
+				(n_pkts + n_empty)) : 0;
+		p->balance_run_cycles = stats.run_cycles;
+		p->balance_n_pkts = stats.n_pkts_in;
+		p->balance_n_empty = stats.n_empty_polls;
+
+		if (stats.thread_id < RTE_MAX_LCORE) {
+			balancer_load[stats.thread_id] += p->balance_load;
+			balancer_n_pipelines[stats.thread_id]++;
+		}
+	}
+}
+
+static uint64_t
+balancer_threshold_cycles(struct pipeline *p)
+{
+	return balancer_period * p->balance.threshold / 100;
+}
+
+static void
+balancer_run(void)
+{
+	uint8_t shed[RTE_MAX_LCORE];
+	struct pipeline *p;
+
+	balancer_load_update();
+	memset(shed, 0, sizeof(shed));
+
+	for (p = pipeline_next(NULL); p; p = pipeline_next(p)) {
+		uint64_t threshold, src_load, dst_load = UINT64_MAX;
+		uint32_t src, dst = RTE_MAX_LCORE, i;
+
+		if (!p->enabled || !p->balance.threshold ||
+			(p->n_instances > 1))
+			continue;
+
+		if (p->balance_n_hold) {
+			p->balance_n_hold--;
+			continue;
+		}
+
+		src = p->thread_id;
+		threshold = balancer_threshold_cycles(p);
+		src_load = balancer_load[src];
+		if (src_load <= threshold) {
+			p->balance_n_over = 0;
+			continue;
+		}
+
+		if (++p->balance_n_over < p->balance.hysteresis)
+			continue;
+
+		/* Moving the only pipeline of a thread doesn't help. */
+		if (shed[src] || (balancer_n_pipelines[src] < 2))
+			continue;
+
+		RTE_LCORE_FOREACH_WORKER(i) {
+			if ((i == src) || !balancer_thread_is_running(i))
+				continue;
+
+			if (balancer_load[i] < dst_load) {
+				dst = i;
+				dst_load = balancer_load[i];
+			}
+		}
+
+		if ((dst == RTE_MAX_LCORE) ||
+			(dst_load + p->balance_load > threshold) ||
+			(dst_load + p->balance_load >= src_load))
+			continue;
+
+		if (thread_pipeline_migrate(p->name, dst)) {
+			RTE_LOG(ERR, USER1, "Balancer: failed to move pipeline "
+				"%s from thread %u to thread %u\n",
+				p->name, src, dst);
+			continue;
+		}
+
+		RTE_LOG(INFO, USER1, "Balancer: moved pipeline %s from "
+			"thread %u to thread %u\n", p->name, src, dst);
+
+		balancer_load[src] -= p->balance_load;
+		balancer_load[dst] += p->balance_load;
+		balancer_n_pipelines[src]--;
+		balancer_n_pipelines[dst]++;
+		shed[src] = 1;
+		p->balance_n_over = 0;
+		p->balance_n_hold = p->balance.hold;
+	}
+}
+
+static void *
+balancer_thread(void *arg __rte_unused)
+{
+	for ( ; ; ) {
+		usleep(BALANCER_PERIOD_MS * 1000);
+
+		thread_pipeline_migrate_lock();
+		balancer_run();
+		thread_pipeline_migrate_unlock();
+	}
+
+	return NULL;
+}
+
+static int
+balancer_start(void)
+{
+	uint32_t expected = 0;
+	int status;
+
+	/* Only the caller flipping the flag starts the thread. */
+	if (!__atomic_compare_exchange_n(&balancer_running, &expected, 1, 0,
+		__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		return 0;
+
+	balancer_period = (rte_get_tsc_hz() * BALANCER_PERIOD_MS) / 1000;
+
+	status = pthread_create(&balancer_thread_id, NULL, balancer_thread,
+		NULL);
+	if (status) {
+		__atomic_store_n(&balancer_running, 0, __ATOMIC_RELEASE);
+		return -1;
+	}
+
+	pthread_setname_np(balancer_thread_id, "dpdk_balancer");
+
+	return 0;
+}
+
+int
+pipeline_balance_set(const char *pipeline_name,
+	struct pipeline_balance_params *params)
+{
+	struct pipeline *p = pipeline_find(pipeline_name);
+
+	/* Check input params */
+	if ((p == NULL) ||
+		(params == NULL) ||
+		(params->threshold > 100))
+		return -1;
+
+	thread_pipeline_migrate_lock();
+	p->balance.threshold = params->threshold;
+	p->balance.hysteresis = params->hysteresis ?
+		params->hysteresis : BALANCER_HYSTERESIS;
+	p->balance.hold = params->hold ? params->hold : BALANCER_HOLD;
+	thread_pipeline_migrate_unlock();
+
+	if (!p->balance.threshold)
+		return 0;
+
+	return balancer_start();
+}
+
+int
+balancer_thread_load_get(uint32_t thread_id,
+	uint32_t *load)
+{
+	if ((thread_id >= RTE_MAX_LCORE) ||
+		(load == NULL) ||
+		!__atomic_load_n(&balancer_running, __ATOMIC_ACQUIRE) ||
+		!balancer_period)
+		return -1;
+
+	*load = (uint32_t)(balancer_load[thread_id] * 100 / balancer_period);
+
+	return 0;
+}
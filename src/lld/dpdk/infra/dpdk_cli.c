@@ -173,7 +173,8 @@ static const char cmd_mempool_help[] =
 "   buffer <buffer_size>\n"
 "   pool <pool_size>\n"
 "   cache <cache_size>\n"
-"   cpu <cpu_id>\n";
+"   cpu <cpu_id>\n"
+"mempool show [<mempool_name>]\n";
 
 static void
 cmd_mempool(char **tokens,
@@ -239,6 +240,72 @@ cmd_mempool(char **tokens,
 	}
 }
 
+/* Print the mempool usage */
+static void
+print_mempool_info(struct mempool *mempool, char *out, size_t out_size)
+{
+	struct mempool_stats stats;
+
+	if (mempool_stats_read(mempool, &stats)) {
+		snprintf(out, out_size, "\n%s: stats read failed\n",
+			 mempool->name);
+		return;
+	}
+
+	snprintf(out, out_size,
+		"\n"
+		"%s: buffer %u socket %d\n"
+		"\tmbufs %u  in use %u  available %u\n"
+		"\tcache size %u  cached %u\n"
+		"\treserved by port queues %u\n",
+		mempool->name,
+		mempool->buffer_size,
+		stats.socket_id,
+		stats.n_mbufs,
+		stats.n_in_use,
+		stats.n_available,
+		stats.cache_size,
+		stats.n_cached,
+		stats.n_reserved);
+}
+
+/*
+ * mempool show [<mempool_name>]
+ */
+static void
+cmd_mempool_show(char **tokens,
+		 uint32_t n_tokens,
+		 char *out,
+		 size_t out_size)
+{
+	struct mempool *mempool;
+
+	if (n_tokens != 2 && n_tokens != 3) {
+		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
+		return;
+	}
+
+	if (n_tokens == 2) {
+		mempool = mempool_next(NULL);
+
+		while (mempool != NULL) {
+			out_size = out_size - strlen(out);
+			out = &out[strlen(out)];
+
+			print_mempool_info(mempool, out, out_size);
+			mempool = mempool_next(mempool);
+		}
+	} else {
+		mempool = mempool_find(tokens[2]);
+		if (mempool == NULL) {
+			snprintf(out, out_size, MSG_ARG_INVALID,
+					"Mempool does not exist");
+			return;
+		}
+		print_mempool_info(mempool, out, out_size);
+	}
+}
+
 static const char cmd_link_help[] =
 "link <link_name>\n"
 "   dev <device_name> | port <port_id>\n"
@@ -456,6 +523,76 @@ cmd_link_show(char **tokens,
 	}
 }
 
+/* Print the pipeline link stats */
+static void
+print_pipeline_link_info(struct pipeline_link *link, char *out,
+			 size_t out_size)
+{
+	struct pipeline_link_stats stats;
+
+	if (pipeline_link_stats_read(link, &stats)) {
+		snprintf(out, out_size, "\n%s: %s port out %u -> %s port in %u"
+			 " (not built)\n", link->name, link->src->name,
+			 link->port_out_id, link->dst->name, link->port_in_id);
+		return;
+	}
+
+	snprintf(out, out_size,
+		"\n"
+		"%s: %s port out %u -> %s port in %u\n"
+		"\tburst %u  ring size %u  queued %u\n"
+		"\tTX packets %" PRIu64"  RX packets %" PRIu64
+		"  held runs %" PRIu64"\n",
+		link->name,
+		link->src->name,
+		link->port_out_id,
+		link->dst->name,
+		link->port_in_id,
+		link->burst_size,
+		stats.ring_size,
+		stats.n_pkts_queued,
+		stats.n_pkts_tx,
+		stats.n_pkts_rx,
+		stats.n_runs_held);
+}
+
+/*
+ * pipeline link show [<link_name>]
+ */
+static void
+cmd_pipeline_link_show(char **tokens,
+		       uint32_t n_tokens,
+		       char *out,
+		       size_t out_size)
+{
+	struct pipeline_link *link;
+
+	if (n_tokens != 3 && n_tokens != 4) {
+		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
+		return;
+	}
+
+	if (n_tokens == 3) {
+		link = pipeline_link_next(NULL);
+
+		while (link != NULL) {
+			out_size = out_size - strlen(out);
+			out = &out[strlen(out)];
+
+			print_pipeline_link_info(link, out, out_size);
+			link = pipeline_link_next(link);
+		}
+	} else {
+		link = pipeline_link_find(tokens[3]);
+		if (link == NULL) {
+			snprintf(out, out_size, MSG_ARG_INVALID,
+					"Pipeline link does not exist");
+			return;
+		}
+		print_pipeline_link_info(link, out, out_size);
+	}
+}
+
 static const char cmd_ring_help[] =
 "ring <ring_name> size <size> numa <numa_node>\n";
 
@@ -2711,7 +2848,8 @@ cmd_pipeline_stats(char **tokens,
 }
 
 static const char cmd_thread_pipeline_enable_help[] =
-"thread <thread_id> pipeline <pipeline_name> enable\n";
+"thread <thread_id> pipeline <pipeline_name> enable "
+"[quanta <instr_quanta>] [adaptive]\n";
 
 static void
 cmd_thread_pipeline_enable(char **tokens,
@@ -2719,12 +2857,14 @@ cmd_thread_pipeline_enable(char **tokens,
 	char *out,
 	size_t out_size)
 {
+	uint32_t instr_quanta = 0;
+	int instr_quanta_adaptive = 0;
 	char *pipeline_name;
 	struct pipeline *p;
 	uint32_t thread_id;
 	int status;
 
-	if (n_tokens != 5) {
+	if ((n_tokens < 5) || (n_tokens > 8)) {
 		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
 		return;
 	}
@@ -2751,7 +2891,34 @@ cmd_thread_pipeline_enable(char **tokens,
 		return;
 	}
 
-	status = thread_pipeline_enable(thread_id, pipeline_name);
+	tokens += 5;
+	n_tokens -= 5;
+
+	if (n_tokens && (strcmp(tokens[0], "quanta") == 0)) {
+		if ((n_tokens < 2) ||
+		    parser_read_uint32(&instr_quanta, tokens[1]) ||
+		    !instr_quanta) {
+			snprintf(out, out_size, MSG_ARG_INVALID, "instr_quanta");
+			return;
+		}
+
+		tokens += 2;
+		n_tokens -= 2;
+	}
+
+	if (n_tokens && (strcmp(tokens[0], "adaptive") == 0)) {
+		instr_quanta_adaptive = 1;
+		tokens++;
+		n_tokens--;
+	}
+
+	if (n_tokens) {
+		snprintf(out, out_size, MSG_ARG_MISMATCH, "thread pipeline enable");
+		return;
+	}
+
+	status = thread_pipeline_enable(thread_id, pipeline_name,
+		instr_quanta, instr_quanta_adaptive);
 	if (status) {
 		snprintf(out, out_size, MSG_CMD_FAIL, "thread pipeline enable");
 		return;
@@ -2807,6 +2974,301 @@ cmd_thread_pipeline_disable(char **tokens,
 	}
 }
 
+static const char cmd_thread_pipeline_migrate_help[] =
+"thread <thread_id> pipeline <pipeline_name> migrate\n";
+
+static void
+cmd_thread_pipeline_migrate(char **tokens,
+	uint32_t n_tokens,
+	char *out,
+	size_t out_size)
+{
+	struct pipeline *p;
+	char *pipeline_name;
+	uint32_t thread_id;
+	int status;
+
+	if (n_tokens != 5) {
+		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
+		return;
+	}
+
+	if (parser_read_uint32(&thread_id, tokens[1]) != 0) {
+		snprintf(out, out_size, MSG_ARG_INVALID, "thread_id");
+		return;
+	}
+
+	if (strcmp(tokens[2], "pipeline") != 0) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "pipeline");
+		return;
+	}
+
+	pipeline_name = tokens[3];
+	p = pipeline_find(pipeline_name);
+	if (!p || !p->ctl || !p->enabled) {
+		snprintf(out, out_size, MSG_ARG_INVALID, "pipeline_name");
+		return;
+	}
+
+	if (strcmp(tokens[4], "migrate") != 0) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "migrate");
+		return;
+	}
+
+	status = thread_pipeline_migrate(pipeline_name, thread_id);
+	if (status) {
+		snprintf(out, out_size, MSG_CMD_FAIL,
+			"thread pipeline migrate");
+		return;
+	}
+}
+
+static const char cmd_thread_pipelines_help[] =
+"thread <thread_id> pipelines <pipeline_name> [<pipeline_name> ...]\n"
+"   enable | disable\n";
+
+static void
+cmd_thread_pipelines(char **tokens,
+	uint32_t n_tokens,
+	char *out,
+	size_t out_size)
+{
+	struct thread_pipeline_op *ops;
+	uint32_t thread_id, n_ops, i;
+	int enable;
+
+	if (n_tokens < 5) {
+		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
+		return;
+	}
+
+	if (parser_read_uint32(&thread_id, tokens[1]) != 0) {
+		snprintf(out, out_size, MSG_ARG_INVALID, "thread_id");
+		return;
+	}
+
+	if (strcmp(tokens[2], "pipelines") != 0) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "pipelines");
+		return;
+	}
+
+	if (strcmp(tokens[n_tokens - 1], "enable") == 0)
+		enable = 1;
+	else if (strcmp(tokens[n_tokens - 1], "disable") == 0)
+		enable = 0;
+	else {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "enable or disable");
+		return;
+	}
+
+	n_ops = n_tokens - 4;
+	ops = calloc(n_ops, sizeof(*ops));
+	if (ops == NULL) {
+		snprintf(out, out_size, MSG_OUT_OF_MEMORY);
+		return;
+	}
+
+	for (i = 0; i < n_ops; i++) {
+		ops[i].pipeline_name = tokens[3 + i];
+		ops[i].enable = enable;
+	}
+
+	if (thread_pipelines_update(thread_id, ops, n_ops)) {
+		for (i = 0; i < n_ops; i++) {
+			size_t len;
+
+			if (!ops[i].status)
+				continue;
+
+			snprintf(out, out_size, "Pipeline %s: %s failed.\n",
+				ops[i].pipeline_name,
+				enable ? "enable" : "disable");
+			len = strlen(out);
+			out += len;
+			out_size -= len;
+		}
+	}
+
+	free(ops);
+}
+
+static const char cmd_thread_idle_help[] =
+"thread <thread_id> idle none | pause | tpause | sleep\n"
+"   [threshold <n_iterations>] [backoff <usecs>]\n";
+
+static void
+cmd_thread_idle(char **tokens,
+	uint32_t n_tokens,
+	char *out,
+	size_t out_size)
+{
+	struct thread_idle_params params;
+	uint32_t thread_id, t;
+
+	if ((n_tokens < 4) || (n_tokens > 8) || (n_tokens % 2)) {
+		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
+		return;
+	}
+
+	if (parser_read_uint32(&thread_id, tokens[1]) != 0) {
+		snprintf(out, out_size, MSG_ARG_INVALID, "thread_id");
+		return;
+	}
+
+	if (strcmp(tokens[2], "idle") != 0) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "idle");
+		return;
+	}
+
+	memset(&params, 0, sizeof(params));
+	if (strcmp(tokens[3], "none") == 0)
+		params.mode = THREAD_IDLE_NONE;
+	else if (strcmp(tokens[3], "pause") == 0)
+		params.mode = THREAD_IDLE_PAUSE;
+	else if (strcmp(tokens[3], "tpause") == 0)
+		params.mode = THREAD_IDLE_TPAUSE;
+	else if (strcmp(tokens[3], "sleep") == 0)
+		params.mode = THREAD_IDLE_SLEEP;
+	else {
+		snprintf(out, out_size, MSG_ARG_INVALID, "idle mode");
+		return;
+	}
+
+	for (t = 4; t < n_tokens; t += 2) {
+		if (strcmp(tokens[t], "threshold") == 0) {
+			if (parser_read_uint32(&params.threshold,
+				tokens[t + 1]) != 0) {
+				snprintf(out, out_size, MSG_ARG_INVALID,
+					"n_iterations");
+				return;
+			}
+		} else if (strcmp(tokens[t], "backoff") == 0) {
+			if (parser_read_uint32(&params.backoff_us,
+				tokens[t + 1]) != 0) {
+				snprintf(out, out_size, MSG_ARG_INVALID,
+					"usecs");
+				return;
+			}
+		} else {
+			snprintf(out, out_size, MSG_ARG_NOT_FOUND,
+				"threshold or backoff");
+			return;
+		}
+	}
+
+	if (thread_idle_set(thread_id, &params)) {
+		snprintf(out, out_size, MSG_CMD_FAIL, "thread idle");
+		return;
+	}
+}
+
+static const char cmd_thread_stats_help[] =
+"thread <thread_id> stats\n";
+
+static void
+cmd_thread_stats(char **tokens,
+	uint32_t n_tokens,
+	char *out,
+	size_t out_size)
+{
+	static const char * const idle_modes[] = {
+		[THREAD_IDLE_NONE] = "none",
+		[THREAD_IDLE_PAUSE] = "pause",
+		[THREAD_IDLE_TPAUSE] = "tpause",
+		[THREAD_IDLE_SLEEP] = "sleep",
+	};
+	struct thread_idle_params idle;
+	struct thread_stats stats;
+	struct pipeline *p;
+	uint32_t thread_id, load;
+	double hz;
+
+	if (n_tokens != 3) {
+		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
+		return;
+	}
+
+	if (parser_read_uint32(&thread_id, tokens[1]) != 0) {
+		snprintf(out, out_size, MSG_ARG_INVALID, "thread_id");
+		return;
+	}
+
+	if (strcmp(tokens[2], "stats") != 0) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "stats");
+		return;
+	}
+
+	if (thread_stats_read(thread_id, &stats) ||
+		thread_idle_get(thread_id, &idle)) {
+		snprintf(out, out_size, MSG_ARG_INVALID, "thread_id");
+		return;
+	}
+
+	hz = stats.tsc_hz ? (double)stats.tsc_hz : 1;
+	snprintf(out, out_size, "Thread %u:\n"
+		"\tuptime (sec): %.3f\n"
+		"\titerations: %" PRIu64 "\n"
+		"\tpipeline run cycles: %" PRIu64 " (%.2f%%)\n"
+		"\tcontrol cycles: %" PRIu64 " (%.2f%%)\n"
+		"\tcontrol messages: %" PRIu64 "\n"
+		"\tidle policy: %s (threshold %u, backoff %u us)\n"
+		"\tidle backoffs: %" PRIu64 "\n"
+		"\tidle cycles: %" PRIu64 " (%.2f%%)\n"
+		"\tpipelines: %u\n",
+		thread_id,
+		stats.cycles / hz,
+		stats.n_iterations,
+		stats.run_cycles,
+		stats.cycles ? 100.0 * stats.run_cycles / stats.cycles : 0,
+		stats.ctrl_cycles,
+		stats.cycles ? 100.0 * stats.ctrl_cycles / stats.cycles : 0,
+		stats.n_ctrl_msgs,
+		idle_modes[idle.mode],
+		idle.threshold,
+		idle.backoff_us,
+		stats.n_idle_backoffs,
+		stats.idle_cycles,
+		stats.cycles ? 100.0 * stats.idle_cycles / stats.cycles : 0,
+		stats.n_pipelines);
+	out_size -= strlen(out);
+	out += strlen(out);
+
+	if (!balancer_thread_load_get(thread_id, &load)) {
+		snprintf(out, out_size, "\tbalancer load: %u%%\n", load);
+		out_size -= strlen(out);
+		out += strlen(out);
+	}
+
+	for (p = pipeline_next(NULL); p; p = pipeline_next(p)) {
+		struct thread_pipeline_stats p_stats;
+
+		if (!p->enabled || (p->thread_id != thread_id))
+			continue;
+
+		if (thread_pipeline_stats_read(p->name, &p_stats))
+			continue;
+
+		snprintf(out, out_size, "\tPipeline %s:\n"
+			"\t\truns: %" PRIu64 "\n"
+			"\t\trun cycles: %" PRIu64 "\n"
+			"\t\tpackets in: %" PRIu64 "\n"
+			"\t\tempty polls: %" PRIu64 "\n"
+			"\t\tcycles per packet: %" PRIu64 "\n"
+			"\t\tinstruction quanta: %u%s\n",
+			p->name,
+			p_stats.n_runs,
+			p_stats.run_cycles,
+			p_stats.n_pkts_in,
+			p_stats.n_empty_polls,
+			p_stats.n_pkts_in ?
+				p_stats.run_cycles / p_stats.n_pkts_in : 0,
+			p_stats.instr_quanta,
+			p_stats.instr_quanta_adaptive ? " (adaptive)" : "");
+		out_size -= strlen(out);
+		out += strlen(out);
+	}
+}
+
 static void
 cmd_help(char **tokens,
 	 uint32_t n_tokens,
@@ -2847,8 +3309,13 @@ cmd_help(char **tokens,
 			"\tpipeline meter set\n"
 			"\tpipeline meter stats\n"
 			"\tpipeline stats\n"
+			"\tpipeline link show\n"
 			"\tthread pipeline enable\n"
-			"\tthread pipeline disable\n\n");
+			"\tthread pipeline disable\n"
+			"\tthread pipeline migrate\n"
+			"\tthread pipelines\n"
+			"\tthread idle\n"
+			"\tthread stats\n\n");
 		return;
 	}
 
@@ -3080,6 +3547,33 @@ cmd_help(char **tokens,
 				cmd_thread_pipeline_disable_help);
 			return;
 		}
+
+		if (strcmp(tokens[2], "migrate") == 0) {
+			snprintf(out, out_size, "\n%s\n",
+				cmd_thread_pipeline_migrate_help);
+			return;
+		}
+	}
+
+	if ((n_tokens == 2) &&
+		(strcmp(tokens[0], "thread") == 0) &&
+		(strcmp(tokens[1], "pipelines") == 0)) {
+		snprintf(out, out_size, "\n%s\n", cmd_thread_pipelines_help);
+		return;
+	}
+
+	if ((n_tokens == 2) &&
+		(strcmp(tokens[0], "thread") == 0) &&
+		(strcmp(tokens[1], "idle") == 0)) {
+		snprintf(out, out_size, "\n%s\n", cmd_thread_idle_help);
+		return;
+	}
+
+	if ((n_tokens == 2) &&
+		(strcmp(tokens[0], "thread") == 0) &&
+		(strcmp(tokens[1], "stats") == 0)) {
+		snprintf(out, out_size, "\n%s\n", cmd_thread_stats_help);
+		return;
 	}
 
 	snprintf(out, out_size, "Invalid command\n");
@@ -3109,10 +3603,15 @@ cli_process(char *in, char *out, size_t out_size)
 		return;
 	}
 
-    if (strcmp(tokens[0], "mempool") == 0) {
-        cmd_mempool(tokens, n_tokens, out, out_size);
-        return;
-    }
+	if (strcmp(tokens[0], "mempool") == 0) {
+		if ((n_tokens >= 2) && (strcmp(tokens[1], "show") == 0)) {
+			cmd_mempool_show(tokens, n_tokens, out, out_size);
+			return;
+		}
+
+		cmd_mempool(tokens, n_tokens, out, out_size);
+		return;
+	}
 
 	if (strcmp(tokens[0], "link") == 0) {
 		if ((n_tokens >= 2) && (strcmp(tokens[1], "show") == 0)) {
@@ -3135,6 +3634,14 @@ cli_process(char *in, char *out, size_t out_size)
 	}
 
 	if (strcmp(tokens[0], "pipeline") == 0) {
+		if ((n_tokens >= 3) &&
+			(strcmp(tokens[1], "link") == 0) &&
+			(strcmp(tokens[2], "show") == 0)) {
+			cmd_pipeline_link_show(tokens, n_tokens, out,
+				out_size);
+			return;
+		}
+
         if ((n_tokens >= 3) &&
             (strcmp(tokens[2], "create") == 0)) {
             cmd_pipeline_create(tokens, n_tokens, out, out_size);
@@ -3318,6 +3825,12 @@ cli_process(char *in, char *out, size_t out_size)
 	}
 
 	if (strcmp(tokens[0], "thread") == 0) {
+		if ((n_tokens >= 3) &&
+			(strcmp(tokens[2], "pipelines") == 0)) {
+			cmd_thread_pipelines(tokens, n_tokens, out, out_size);
+			return;
+		}
+
 		if ((n_tokens >= 5) &&
 			(strcmp(tokens[4], "enable") == 0)) {
 			cmd_thread_pipeline_enable(tokens, n_tokens,
@@ -3331,6 +3844,25 @@ cli_process(char *in, char *out, size_t out_size)
 				out, out_size);
 			return;
 		}
+
+		if ((n_tokens >= 5) &&
+			(strcmp(tokens[4], "migrate") == 0)) {
+			cmd_thread_pipeline_migrate(tokens, n_tokens,
+				out, out_size);
+			return;
+		}
+
+		if ((n_tokens >= 3) &&
+			(strcmp(tokens[2], "idle") == 0)) {
+			cmd_thread_idle(tokens, n_tokens, out, out_size);
+			return;
+		}
+
+		if ((n_tokens >= 3) &&
+			(strcmp(tokens[2], "stats") == 0)) {
+			cmd_thread_stats(tokens, n_tokens, out, out_size);
+			return;
+		}
 	}
 
 	snprintf(out, out_size, MSG_CMD_UNKNOWN, tokens[0]);
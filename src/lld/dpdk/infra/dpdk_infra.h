@@ -18,6 +18,7 @@
 #define _INCLUDE_DPDK_INFRA_H_
 
 #include <stdint.h>
+#include <stdio.h>
 #include <sys/queue.h>
 #include <endian.h>
 
@@ -69,6 +70,17 @@ struct mempool {
 	char name[NAME_SIZE];
 	struct rte_mempool *m;
 	uint32_t buffer_size;
+	uint32_t n_mbufs_reserved; /* Held by the queues of the ports. */
+};
+
+struct mempool_stats {
+	uint32_t n_mbufs;
+	uint32_t n_in_use;
+	uint32_t n_available; /* Includes the cached mbufs. */
+	uint32_t n_cached;
+	uint32_t n_reserved;
+	uint32_t cache_size;
+	int socket_id;
 };
 
 struct mempool *
@@ -78,6 +90,17 @@ mempool_create(const char *name,
 struct mempool *
 mempool_find(const char *name);
 
+struct mempool *
+mempool_next(struct mempool *mempool);
+
+int
+mempool_mbufs_reserve(struct mempool *mempool,
+	uint32_t n_mbufs);
+
+int
+mempool_stats_read(struct mempool *mempool,
+	struct mempool_stats *stats);
+
 /*
  * link
  */
@@ -153,6 +176,78 @@ ring_create(const char *name,
 struct ring *
 ring_find(const char *name);
 
+/*
+ * pipeline link
+ */
+struct pipeline_link_params {
+	const char *src; /* Upstream pipeline. */
+	uint32_t port_out_id;
+	const char *dst; /* Downstream pipeline. */
+	uint32_t port_in_id;
+	uint32_t ring_size; /* 0 for the default. */
+	uint32_t burst_size; /* 0 for the default. */
+};
+
+struct pipeline_link {
+	char name[NAME_SIZE];
+	struct pipeline *src;
+	uint32_t port_out_id;
+	struct pipeline *dst;
+	uint32_t port_in_id;
+	struct rte_ring *r;
+	uint32_t burst_size;
+	/* Runs of the upstream pipeline held back for lack of room in the
+	 * ring, written by the data plane thread of src only.
+	 */
+	uint64_t n_runs_held;
+};
+
+struct pipeline_link_stats {
+	uint64_t n_pkts_tx; /* Sent by the upstream pipeline. */
+	uint64_t n_pkts_rx; /* Received by the downstream pipeline. */
+	uint64_t n_runs_held; /* Upstream runs held back by a full ring. */
+	uint32_t n_pkts_queued; /* Ring occupancy. */
+	uint32_t ring_size;
+};
+
+#ifndef PIPELINE_LINKS_OUT_MAX
+#define PIPELINE_LINKS_OUT_MAX                             8
+#endif
+
+/* Wire output port port_out_id of pipeline src to input port port_in_id of
+ * pipeline dst through a ring named after the link. Both pipelines must
+ * have a single instance and not be built yet, and src can feed at most
+ * PIPELINE_LINKS_OUT_MAX links.
+ */
+struct pipeline_link *
+pipeline_link_create(const char *name,
+	struct pipeline_link_params *params);
+
+struct pipeline_link *
+pipeline_link_find(const char *name);
+
+struct pipeline_link *
+pipeline_link_next(struct pipeline_link *link);
+
+int
+pipeline_link_stats_read(struct pipeline_link *link,
+	struct pipeline_link_stats *stats);
+
+/* Fill out with up to n_max links fed by pipeline src and return their
+ * number. Safe to call from the data plane threads.
+ */
+uint32_t
+pipeline_links_out(struct rte_swx_pipeline *src,
+	struct pipeline_link **out,
+	uint32_t n_max);
+
+/* Non-zero when a link goes from src to dst, or from src to any pipeline
+ * when dst is NULL. Safe to call from the data plane threads.
+ */
+int
+pipeline_link_is_upstream(struct rte_swx_pipeline *src,
+	struct rte_swx_pipeline *dst);
+
 /*
  * tap
  */
@@ -174,6 +269,37 @@ tap_create(const char *name);
 /*
  * pipeline
  */
+#ifndef PIPELINE_INSTANCES_MAX
+#define PIPELINE_INSTANCES_MAX                             8
+#endif
+
+/* Load balancer settings of a pipeline. The load of a core is the share of
+ * its cycles its pipelines spend on packets, as estimated once per balancer
+ * period.
+ */
+struct pipeline_balance_params {
+	/* Load (percent) of the pipeline core above which the pipeline is
+	 * moved to a less loaded core, 0 to never move it.
+	 */
+	uint32_t threshold;
+	/* Periods the core has to stay above the threshold before the
+	 * pipeline is moved.
+	 */
+	uint32_t hysteresis;
+	/* Periods the pipeline then stays on the core it was moved to. */
+	uint32_t hold;
+};
+
+struct pipeline;
+
+/* Called once a pipeline has been moved to another data plane thread,
+ * whoever moved it.
+ */
+typedef void
+(*pipeline_migrate_cb)(struct pipeline *pipeline,
+	uint32_t thread_id,
+	void *arg);
+
 struct pipeline {
 	TAILQ_ENTRY(pipeline) node;
 	char name[NAME_SIZE];
@@ -182,11 +308,49 @@ struct pipeline {
 	struct rte_swx_ctl_pipeline *ctl;
 
 	uint32_t timer_period_ms;
+	/* Instruction quanta given when the pipeline was last enabled,
+	 * 0 for the default quanta.
+	 */
+	uint32_t instr_quanta;
+	int instr_quanta_adaptive;
+	/* Set while the pipeline is handed over between two threads. */
+	uint32_t migrate_hold;
 	int enabled;
 	uint32_t thread_id;
 	uint32_t cpu_id;
 	uint32_t numa_node;
 	uint64_t net_port_mask[4];
+
+	/* Instances running the same program, each on its own thread and on
+	 * its own queue of the link ports, which RSS spreads the traffic
+	 * over. instance[0] is this pipeline.
+	 */
+	uint32_t n_instances;
+	struct pipeline *instance[PIPELINE_INSTANCES_MAX];
+
+	/* I/O spec (ports, mirroring) the pipeline is built with, in the text
+	 * format of rte_swx_pipeline_build_from_lib(). Filled in as ports are
+	 * added.
+	 */
+	char *iospec;
+	size_t iospec_len;
+	size_t iospec_size;
+
+	/* Spare ports the pipeline is built with, for ports added later. */
+	uint32_t n_slots;
+
+	/* Load balancer settings, and state kept by the balancer thread. */
+	struct pipeline_balance_params balance;
+	uint32_t balance_n_over;
+	uint32_t balance_n_hold;
+	uint64_t balance_load; /* Cycles spent on packets last period. */
+	uint64_t balance_run_cycles;
+	uint64_t balance_n_pkts;
+	uint64_t balance_n_empty;
+
+	/* Migration hook, called with the migration lock held. */
+	pipeline_migrate_cb migrate_cb;
+	void *migrate_cb_arg;
 };
 
 struct pipeline *
@@ -196,29 +360,236 @@ pipeline_create(const char *name,
 struct pipeline *
 pipeline_find(const char *name);
 
+int
+pipeline_instances_create(struct pipeline *pipeline,
+	uint32_t n_instances);
+
+struct pipeline *
+pipeline_next(struct pipeline *pipeline);
+
 int
 pipeline_port_is_valid(struct pipeline *pipe);
 
+/* Append a line to the I/O spec of a pipeline. */
+int
+pipeline_iospec_add(struct pipeline *pipeline,
+	const char *line);
+
+/* Open the I/O spec of a pipeline for reading, to be closed with fclose(). */
+FILE *
+pipeline_iospec_open(struct pipeline *pipeline);
+
+/* Write the I/O spec of a pipeline to a file, for debugging. */
+int
+pipeline_iospec_dump(struct pipeline *pipeline,
+	const char *file_name);
+
+/* Ports can't be added to a built pipeline, so it can be built with
+ * n_slots spare input/output port pairs, numbered after its other ports,
+ * that ports created later are bound to. To be called once all the ports
+ * known upfront are in the I/O spec and before the pipeline is built.
+ */
+int
+pipeline_slots_reserve(struct pipeline *pipeline);
+
+/* Bind the input port created by ops from params to the spare input port
+ * port_id of a built pipeline, or the output port to the spare output
+ * port port_id. The pipeline keeps running meanwhile.
+ */
+int
+pipeline_slot_in_bind(struct pipeline *pipeline,
+	uint32_t port_id,
+	struct rte_swx_port_in_ops *ops,
+	void *params);
+
+int
+pipeline_slot_out_bind(struct pipeline *pipeline,
+	uint32_t port_id,
+	struct rte_swx_port_out_ops *ops,
+	void *params);
+
+/* Free the port bound to a spare port, which is then idle again. */
+int
+pipeline_slot_in_unbind(struct pipeline *pipeline,
+	uint32_t port_id);
+
+int
+pipeline_slot_out_unbind(struct pipeline *pipeline,
+	uint32_t port_id);
+
+/* Packets of the port bound to the spare input port port_id which were
+ * dropped because the pipeline didn't keep up.
+ */
+int
+pipeline_slot_in_drops_read(struct pipeline *pipeline,
+	uint32_t port_id,
+	uint64_t *n_drops);
+
 /* Infra related functions */
 int
 dpdk_infra_init(int count, char **arr, bool debug_cli_enable);
 
 
 /* Thread related functions */
+/* Run a pipeline on a data plane thread. The pipeline executes instr_quanta
+ * instructions (the default quanta if 0) each time it gets the thread. When
+ * instr_quanta_adaptive is set, the quanta is adjusted at run time from the
+ * share of input port polls that find a packet. A pipeline runs before the
+ * pipelines it feeds through pipeline links on the same thread.
+ */
 int
 thread_pipeline_enable(uint32_t thread_id,
-	const char *pipeline_name);
+	const char *pipeline_name,
+	uint32_t instr_quanta,
+	int instr_quanta_adaptive);
 
 int
 thread_pipeline_disable(uint32_t thread_id,
 	const char *pipeline_name);
 
+/* Pipeline enable or disable operation of a batch. */
+struct thread_pipeline_op {
+	const char *pipeline_name;
+	/* Enable the pipeline when set, disable it otherwise. */
+	int enable;
+	/* Instruction quanta settings of an enabled pipeline. */
+	uint32_t instr_quanta;
+	int instr_quanta_adaptive;
+	/* Set by thread_pipelines_update: 0 on success, -1 otherwise. */
+	int status;
+};
+
+/* Enable and disable several pipelines of a data plane thread at once, in
+ * a single control message. Returns -1 if any of the operations failed.
+ * A batch with two operations on a pipeline is refused as a whole: none of
+ * its operations is done.
+ */
+int
+thread_pipelines_update(uint32_t thread_id,
+	struct thread_pipeline_op *ops,
+	uint32_t n_ops);
+
+/* Move an enabled pipeline to another data plane thread without stopping
+ * it, keeping its instruction quanta settings. Migrations are serialized
+ * by the migration lock and the migration hook of the pipeline is called
+ * once it has moved.
+ */
+int
+thread_pipeline_migrate(const char *pipeline_name,
+	uint32_t thread_id);
+
+/* Migration lock, recursive: held across a walk of the pipelines deciding
+ * the migrations, so that no other migration changes them meanwhile.
+ */
+void
+thread_pipeline_migrate_lock(void);
+
+void
+thread_pipeline_migrate_unlock(void);
+
+int
+pipeline_migrate_cb_set(const char *pipeline_name,
+	pipeline_migrate_cb cb,
+	void *arg);
+
 int
 thread_init(void);
 
+/* Idle policy of a data plane thread: what the thread does once all the
+ * input ports of its pipelines have been found empty for threshold
+ * consecutive dispatch loop iterations. The thread goes back to full speed
+ * as soon as a packet is received.
+ */
+enum thread_idle_mode {
+	/* Keep polling at full speed. */
+	THREAD_IDLE_NONE = 0,
+	/* Spin on rte_pause() bursts. */
+	THREAD_IDLE_PAUSE,
+	/* Wait in TPAUSE light sleep for backoff_us, falls back to PAUSE on
+	 * CPUs without it.
+	 */
+	THREAD_IDLE_TPAUSE,
+	/* Sleep for backoff_us. */
+	THREAD_IDLE_SLEEP,
+};
+
+struct thread_idle_params {
+	enum thread_idle_mode mode;
+	/* Empty iterations before backing off, 0 for the default. */
+	uint32_t threshold;
+	/* Length of a TPAUSE or sleep backoff in usecs, 0 for the default. */
+	uint32_t backoff_us;
+};
+
+int
+thread_idle_set(uint32_t thread_id,
+	struct thread_idle_params *params);
+
+int
+thread_idle_get(uint32_t thread_id,
+	struct thread_idle_params *params);
+
+/* Telemetry of a data plane thread. Cycles are TSC cycles. */
+struct thread_stats {
+	uint64_t tsc_hz;
+	/* Cycles elapsed since the thread was initialized. */
+	uint64_t cycles;
+	/* Iterations of the dispatch loop. */
+	uint64_t n_iterations;
+	/* Cycles spent running the pipelines. */
+	uint64_t run_cycles;
+	/* Cycles spent handling the control messages. */
+	uint64_t ctrl_cycles;
+	uint64_t n_ctrl_msgs;
+	/* Idle backoffs and cycles spent in them. */
+	uint64_t n_idle_backoffs;
+	uint64_t idle_cycles;
+	uint32_t n_pipelines;
+};
+
+int
+thread_stats_read(uint32_t thread_id,
+	struct thread_stats *stats);
+
+/* Telemetry of a pipeline on its data plane thread. Run counters are
+ * reset each time the pipeline is enabled, port counters are not.
+ */
+struct thread_pipeline_stats {
+	uint32_t thread_id;
+	int enabled;
+	/* Calls to rte_swx_pipeline_run and cycles spent in them. */
+	uint64_t n_runs;
+	uint64_t run_cycles;
+	/* Current instruction quanta and whether it is adaptive. */
+	uint32_t instr_quanta;
+	int instr_quanta_adaptive;
+	/* Packets received and polls of an input port that found none. */
+	uint64_t n_pkts_in;
+	uint64_t n_empty_polls;
+};
+
+int
+thread_pipeline_stats_read(const char *pipeline_name,
+	struct thread_pipeline_stats *stats);
+
 int
 thread_main(void *arg);
 
+/* Balancer related functions */
+/* Set the load balancer settings of a pipeline. The balancer thread is
+ * started the first time a pipeline gets a non-zero threshold.
+ */
+int
+pipeline_balance_set(const char *pipeline_name,
+	struct pipeline_balance_params *params);
+
+/* Load of the data plane threads over the last balancer period, in
+ * percent of their cycles.
+ */
+int
+balancer_thread_load_get(uint32_t thread_id,
+	uint32_t *load);
+
 void
 table_entry_free(struct rte_swx_table_entry *entry);
 uint64_t
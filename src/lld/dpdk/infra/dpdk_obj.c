@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <errno.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include <netinet/in.h>
@@ -28,6 +30,9 @@
 #include <rte_mempool.h>
 #include <rte_mbuf.h>
 #include <rte_ethdev.h>
+#include <rte_hash.h>
+#include <rte_jhash.h>
+#include <rte_spinlock.h>
 #include <rte_swx_pipeline.h>
 #include <rte_swx_ctl.h>
 
@@ -43,6 +48,18 @@ TAILQ_HEAD(mempool_list, mempool);
  */
 TAILQ_HEAD(link_list, link);
 
+/* A link being set up: its name and device are taken until it is added or
+ * its creation failed, so that a concurrent creation of the same link fails
+ * before touching the device.
+ */
+struct link_claim {
+	TAILQ_ENTRY(link_claim) node;
+	char name[NAME_SIZE];
+	uint16_t port_id;
+};
+
+TAILQ_HEAD(link_claim_list, link_claim);
+
 /*
  * ring
  */
@@ -61,15 +78,114 @@ TAILQ_HEAD(pipeline_list, pipeline);
 /*
  * obj
  */
+
+/* Most objects of each type, e.g. rings. Creating one more fails with an
+ * error, build with -DOBJ_INDEX_SIZE=<n> for larger configs.
+ */
+#ifndef OBJ_INDEX_SIZE
+#define OBJ_INDEX_SIZE                                     4096
+#endif
+
 struct obj {
 	struct mempool_list mempool_list;
 	struct link_list link_list;
+	struct link_claim_list link_claim_list;
 	struct ring_list ring_list;
 	struct pipeline_list pipeline_list;
 	struct tap_list tap_list;
+
+	/* Serializes the node additions, as ports may be created from
+	 * several threads at once.
+	 */
+	rte_spinlock_t lock;
+
+	/* Serializes the device probing of the links: EAL hotplug and the
+	 * device list are not thread safe. Probing takes milliseconds, so it
+	 * is a mutex, and the queue setup of the links stays parallel.
+	 */
+	pthread_mutex_t probe_lock;
+
+	/* Name to node indexes, the lists are kept for iteration. */
+	struct rte_hash *mempool_index;
+	struct rte_hash *link_index;
+	struct rte_hash *ring_index;
+	struct rte_hash *pipeline_index;
+	struct rte_hash *tap_index;
 };
 
 struct obj *obj;
+
+/*
+ * The index keys are the node names zero padded to NAME_SIZE bytes. Nodes
+ * are only added, one at a time under the obj lock, so lookups are lock
+ * free against the single writer.
+ */
+static struct rte_hash *
+obj_index_create(const char *name)
+{
+	struct rte_hash_parameters params = {
+		.name = name,
+		.entries = OBJ_INDEX_SIZE,
+		.key_len = NAME_SIZE,
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = SOCKET_ID_ANY,
+		/* Colliding buckets spill into the extendable table, so
+		 * that all the OBJ_INDEX_SIZE entries can be used.
+		 */
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF |
+			RTE_HASH_EXTRA_FLAGS_EXT_TABLE,
+	};
+
+	return rte_hash_create(&params);
+}
+
+static int
+obj_index_key(const char *name, char *key)
+{
+	size_t len = strnlen(name, NAME_SIZE);
+
+	/* Names that don't fit a node can't match one. */
+	if (len == NAME_SIZE)
+		return -1;
+
+	memset(key, 0, NAME_SIZE);
+	memcpy(key, name, len);
+
+	return 0;
+}
+
+static int
+obj_index_add(struct rte_hash *index, const char *name, void *node)
+{
+	char key[NAME_SIZE];
+	int status;
+
+	if (obj_index_key(name, key))
+		return -1;
+
+	status = rte_hash_add_key_data(index, key, node);
+	if (status == -ENOSPC)
+		printf("Error: object %s not added, the index has room for "
+			"%u objects of its type only\n", name, OBJ_INDEX_SIZE);
+
+	return status;
+}
+
+static void *
+obj_index_find(struct rte_hash *index, const char *name)
+{
+	char key[NAME_SIZE];
+	void *node;
+
+	if (!name || obj_index_key(name, key))
+		return NULL;
+
+	if (rte_hash_lookup_data(index, key, &node) < 0)
+		return NULL;
+
+	return node;
+}
 /*
  * mempool
  */
@@ -113,8 +229,17 @@ mempool_create(const char *name, struct mempool_params *params)
 	mempool->m = m;
 	mempool->buffer_size = params->buffer_size;
 
-	/* Node add to list */
+	/* Node add to index and list */
+	rte_spinlock_lock(&obj->lock);
+	if (obj_index_add(obj->mempool_index, mempool->name, mempool)) {
+		rte_spinlock_unlock(&obj->lock);
+		free(mempool);
+		rte_mempool_free(m);
+		return NULL;
+	}
+
 	TAILQ_INSERT_TAIL(&obj->mempool_list, mempool, node);
+	rte_spinlock_unlock(&obj->lock);
 
 	return mempool;
 }
@@ -122,16 +247,57 @@ mempool_create(const char *name, struct mempool_params *params)
 struct mempool *
 mempool_find(const char *name)
 {
-	struct mempool *mempool;
+	return obj_index_find(obj->mempool_index, name);
+}
 
-	if (!name)
-		return NULL;
+struct mempool *
+mempool_next(struct mempool *mempool)
+{
+	return (mempool == NULL) ?
+		TAILQ_FIRST(&obj->mempool_list) : TAILQ_NEXT(mempool, node);
+}
 
-	TAILQ_FOREACH(mempool, &obj->mempool_list, node)
-		if (strcmp(mempool->name, name) == 0)
-			return mempool;
+/* Mbufs sitting in the per lcore caches are out of reach of the ports, so
+ * the pool is too small once the reserved mbufs and the full caches of all
+ * the lcores exceed its size.
+ */
+int
+mempool_mbufs_reserve(struct mempool *mempool, uint32_t n_mbufs)
+{
+	uint32_t n_cached_max;
 
-	return NULL;
+	if (mempool == NULL)
+		return -1;
+
+	n_mbufs = __atomic_add_fetch(&mempool->n_mbufs_reserved, n_mbufs,
+		__ATOMIC_RELAXED);
+	n_cached_max = mempool->m->cache_size * rte_lcore_count();
+
+	return (n_mbufs + n_cached_max > mempool->m->size) ? -1 : 0;
+}
+
+int
+mempool_stats_read(struct mempool *mempool, struct mempool_stats *stats)
+{
+	struct rte_mempool *m;
+	uint32_t i;
+
+	if ((mempool == NULL) || (stats == NULL))
+		return -1;
+
+	m = mempool->m;
+	stats->n_mbufs = m->size;
+	stats->n_in_use = rte_mempool_in_use_count(m);
+	stats->n_available = rte_mempool_avail_count(m);
+	stats->n_cached = 0;
+	if (m->cache_size)
+		for (i = 0; i < RTE_MAX_LCORE; i++)
+			stats->n_cached += m->local_cache[i].len;
+	stats->n_reserved = mempool->n_mbufs_reserved;
+	stats->cache_size = m->cache_size;
+	stats->socket_id = m->socket_id;
+
+	return 0;
 }
 
 /*
@@ -190,6 +356,60 @@ rss_setup(uint16_t port_id,
 	return status;
 }
 
+static int
+link_claim(struct link_claim *claim, const char *name)
+{
+	struct link_claim *c;
+	int status = 0;
+
+	if (strnlen(name, NAME_SIZE) == NAME_SIZE)
+		return -1;
+
+	strlcpy(claim->name, name, sizeof(claim->name));
+	claim->port_id = RTE_MAX_ETHPORTS;
+
+	rte_spinlock_lock(&obj->lock);
+	if (link_find(name))
+		status = -1;
+	TAILQ_FOREACH(c, &obj->link_claim_list, node)
+		if (strcmp(c->name, name) == 0)
+			status = -1;
+	if (!status)
+		TAILQ_INSERT_TAIL(&obj->link_claim_list, claim, node);
+	rte_spinlock_unlock(&obj->lock);
+
+	return status;
+}
+
+static int
+link_claim_port(struct link_claim *claim, uint16_t port_id)
+{
+	struct link_claim *c;
+	struct link *link;
+	int status = 0;
+
+	rte_spinlock_lock(&obj->lock);
+	TAILQ_FOREACH(link, &obj->link_list, node)
+		if (link->port_id == port_id)
+			status = -1;
+	TAILQ_FOREACH(c, &obj->link_claim_list, node)
+		if (c->port_id == port_id)
+			status = -1;
+	if (!status)
+		claim->port_id = port_id;
+	rte_spinlock_unlock(&obj->lock);
+
+	return status;
+}
+
+static void
+link_claim_release(struct link_claim *claim)
+{
+	rte_spinlock_lock(&obj->lock);
+	TAILQ_REMOVE(&obj->link_claim_list, claim, node);
+	rte_spinlock_unlock(&obj->lock);
+}
+
 struct link *
 link_create(const char *name, struct link_params *params)
 {
@@ -197,6 +417,7 @@ link_create(const char *name, struct link_params *params)
 	struct rte_eth_conf port_conf;
 	struct link *link;
 	struct link_params_rss *rss;
+	struct link_claim claim;
 	struct mempool *mempool;
 	uint32_t cpu_id, i;
 	int status;
@@ -204,7 +425,6 @@ link_create(const char *name, struct link_params *params)
 
 	/* Check input params */
 	if ((name == NULL) ||
-		link_find(name) ||
 		(params == NULL) ||
 		(params->rx.n_queues == 0) ||
 		(params->rx.queue_size == 0) ||
@@ -212,52 +432,63 @@ link_create(const char *name, struct link_params *params)
 		(params->tx.queue_size == 0))
 		return NULL;
 
+	if (link_claim(&claim, name))
+		return NULL;
+
 	printf("LINK CREATE: Dev:%s Args:%s dev_hotplug_enabled: %d\n",
 		params->dev_name, params->dev_args, params->dev_hotplug_enabled);
 
+	pthread_mutex_lock(&obj->probe_lock);
+
 	/* Performing Device Hotplug and valid for only VDEVs */
 	if (params->dev_hotplug_enabled) {
 		if (rte_eal_hotplug_add("vdev", params->dev_name,
 					 params->dev_args)) {
+			pthread_mutex_unlock(&obj->probe_lock);
 			printf("LINK CREATE: Dev:%s probing failed\n",
 				params->dev_name);
-			return NULL;
+			goto error;
 		}
 		printf("LINK CREATE: Dev:%s probing successful\n",
 			params->dev_name);
 	}
 
 	port_id = params->port_id;
-	if (params->dev_name) {
+	if (params->dev_name)
 		status = rte_eth_dev_get_port_by_name(params->dev_name,
 			&port_id);
+	else
+		status = rte_eth_dev_is_valid_port(port_id) ? 0 : -1;
 
-		if (status)
-			return NULL;
-	} else
-		if (!rte_eth_dev_is_valid_port(port_id))
-			return NULL;
+	pthread_mutex_unlock(&obj->probe_lock);
+
+	if (status)
+		goto error;
+
+	/* A device is driven by a single link. */
+	if (link_claim_port(&claim, port_id))
+		goto error;
 
 	if (rte_eth_dev_info_get(port_id, &port_info) != 0)
-		return NULL;
+		goto error;
 
 	mempool = mempool_find(params->rx.mempool_name);
 	if (mempool == NULL)
-		return NULL;
+		goto error;
 
 	rss = params->rx.rss;
 	if (rss) {
 		if ((port_info.reta_size == 0) ||
 			(port_info.reta_size > RTE_ETH_RSS_RETA_SIZE_512))
-			return NULL;
+			goto error;
 
 		if ((rss->n_queues == 0) ||
-			(rss->n_queues >= LINK_RXQ_RSS_MAX))
-			return NULL;
+			(rss->n_queues > LINK_RXQ_RSS_MAX))
+			goto error;
 
 		for (i = 0; i < rss->n_queues; i++)
 			if (rss->queue_id[i] >= port_info.max_rx_queues)
-				return NULL;
+				goto error;
 	}
 
 	/**
@@ -283,12 +514,12 @@ link_create(const char *name, struct link_params *params)
 		&port_conf);
 
 	if (status < 0)
-		return NULL;
+		goto error;
 
 	if (params->promiscuous) {
 		status = rte_eth_promiscuous_enable(port_id);
 		if (status != 0)
-			return NULL;
+			goto error;
 	}
 
 	/* Port RX */
@@ -302,7 +533,7 @@ link_create(const char *name, struct link_params *params)
 			mempool->m);
 
 		if (status < 0)
-			return NULL;
+			goto error;
 	}
 
 	/* Port TX */
@@ -315,36 +546,30 @@ link_create(const char *name, struct link_params *params)
 			NULL);
 
 		if (status < 0)
-			return NULL;
+			goto error;
 	}
 
 	/* Port start */
 	status = rte_eth_dev_start(port_id);
 	if (status < 0)
-		return NULL;
+		goto error;
 
 	if (rss) {
 		status = rss_setup(port_id, port_info.reta_size, rss);
 
-		if (status) {
-			rte_eth_dev_stop(port_id);
-			return NULL;
-		}
+		if (status)
+			goto error_stop;
 	}
 
 	/* Port link up */
 	status = rte_eth_dev_set_link_up(port_id);
-	if ((status < 0) && (status != -ENOTSUP)) {
-		rte_eth_dev_stop(port_id);
-		return NULL;
-	}
+	if ((status < 0) && (status != -ENOTSUP))
+		goto error_stop;
 
 	/* Node allocation */
 	link = calloc(1, sizeof(struct link));
-	if (link == NULL) {
-		rte_eth_dev_stop(port_id);
-		return NULL;
-	}
+	if (link == NULL)
+		goto error_stop;
 
 	/* Node fill in */
 	strlcpy(link->name, name, sizeof(link->name));
@@ -353,10 +578,25 @@ link_create(const char *name, struct link_params *params)
 	link->n_rxq = params->rx.n_queues;
 	link->n_txq = params->tx.n_queues;
 
-	/* Node add to list */
+	/* Node add to index and list, the claim goes with the same lock */
+	rte_spinlock_lock(&obj->lock);
+	if (obj_index_add(obj->link_index, link->name, link)) {
+		rte_spinlock_unlock(&obj->lock);
+		free(link);
+		goto error_stop;
+	}
+
 	TAILQ_INSERT_TAIL(&obj->link_list, link, node);
+	TAILQ_REMOVE(&obj->link_claim_list, &claim, node);
+	rte_spinlock_unlock(&obj->lock);
 
 	return link;
+
+error_stop:
+	rte_eth_dev_stop(port_id);
+error:
+	link_claim_release(&claim);
+	return NULL;
 }
 
 int
@@ -383,16 +623,7 @@ link_is_up(const char *name)
 struct link *
 link_find(const char *name)
 {
-	struct link *link;
-
-	if (!name)
-		return NULL;
-
-	TAILQ_FOREACH(link, &obj->link_list, node)
-		if (strcmp(link->name, name) == 0)
-			return link;
-
-	return NULL;
+	return obj_index_find(obj->link_index, name);
 }
 
 struct link *
@@ -437,8 +668,17 @@ ring_create(const char *name, struct ring_params *params)
 	/* Node fill in */
 	strlcpy(ring->name, name, sizeof(ring->name));
 
-	/* Node add to list */
+	/* Node add to index and list */
+	rte_spinlock_lock(&obj->lock);
+	if (obj_index_add(obj->ring_index, ring->name, ring)) {
+		rte_spinlock_unlock(&obj->lock);
+		free(ring);
+		rte_ring_free(r);
+		return NULL;
+	}
+
 	TAILQ_INSERT_TAIL(&obj->ring_list, ring, node);
+	rte_spinlock_unlock(&obj->lock);
 
 	return ring;
 }
@@ -446,16 +686,7 @@ ring_create(const char *name, struct ring_params *params)
 struct ring *
 ring_find(const char *name)
 {
-	struct ring *ring;
-
-	if (!name)
-		return NULL;
-
-	TAILQ_FOREACH(ring, &obj->ring_list, node)
-		if (strcmp(ring->name, name) == 0)
-			return ring;
-
-	return NULL;
+	return obj_index_find(obj->ring_index, name);
 }
 
 /*
@@ -466,16 +697,7 @@ ring_find(const char *name)
 struct tap *
 tap_find(const char *name)
 {
-	struct tap *tap;
-
-	if (!name)
-		return NULL;
-
-	TAILQ_FOREACH(tap, &obj->tap_list, node)
-		if (strcmp(tap->name, name) == 0)
-			return tap;
-
-	return NULL;
+	return obj_index_find(obj->tap_index, name);
 }
 
 struct tap *
@@ -532,8 +754,17 @@ tap_create(const char *name)
 	strlcpy(tap->name, name, sizeof(tap->name));
 	tap->fd = fd;
 
-	/* Node add to list */
+	/* Node add to index and list */
+	rte_spinlock_lock(&obj->lock);
+	if (obj_index_add(obj->tap_index, tap->name, tap)) {
+		rte_spinlock_unlock(&obj->lock);
+		free(tap);
+		close(fd);
+		return NULL;
+	}
+
 	TAILQ_INSERT_TAIL(&obj->tap_list, tap, node);
+	rte_spinlock_unlock(&obj->lock);
 
 	return tap;
 }
@@ -569,9 +800,19 @@ pipeline_create(const char *name, int numa_node)
 	pipeline->p = p;
 	pipeline->timer_period_ms = 10;
 	pipeline->numa_node = numa_node;
+	pipeline->n_instances = 1;
+	pipeline->instance[0] = pipeline;
+
+	/* Node add to index and list */
+	rte_spinlock_lock(&obj->lock);
+	if (obj_index_add(obj->pipeline_index, pipeline->name, pipeline)) {
+		rte_spinlock_unlock(&obj->lock);
+		free(pipeline);
+		goto error;
+	}
 
-	/* Node add to list */
 	TAILQ_INSERT_TAIL(&obj->pipeline_list, pipeline, node);
+	rte_spinlock_unlock(&obj->lock);
 
 	return pipeline;
 
@@ -583,16 +824,118 @@ error:
 struct pipeline *
 pipeline_find(const char *name)
 {
-	struct pipeline *pipeline;
+	return obj_index_find(obj->pipeline_index, name);
+}
 
-	if (!name)
+int
+pipeline_instances_create(struct pipeline *pipeline,
+	uint32_t n_instances)
+{
+	char name[NAME_SIZE];
+	uint32_t i;
+
+	/* Check input params */
+	if ((pipeline == NULL) ||
+		(n_instances == 0) ||
+		(n_instances > PIPELINE_INSTANCES_MAX) ||
+		(pipeline->n_instances != 1))
+		return -1;
+
+	for (i = 1; i < n_instances; i++) {
+		struct pipeline *instance;
+
+		snprintf(name, sizeof(name), "%s_%u", pipeline->name, i);
+		instance = pipeline_create(name, pipeline->numa_node);
+		if (instance == NULL)
+			return -1;
+
+		pipeline->instance[i] = instance;
+		pipeline->n_instances = i + 1;
+	}
+
+	return 0;
+}
+
+struct pipeline *
+pipeline_next(struct pipeline *pipeline)
+{
+	return (pipeline == NULL) ?
+		TAILQ_FIRST(&obj->pipeline_list) : TAILQ_NEXT(pipeline, node);
+}
+
+#ifndef PIPELINE_IOSPEC_SIZE
+#define PIPELINE_IOSPEC_SIZE                               4096
+#endif
+
+int
+pipeline_iospec_add(struct pipeline *pipeline,
+	const char *line)
+{
+	size_t len, size;
+	char *iospec;
+
+	/* Check input params */
+	if ((pipeline == NULL) ||
+		(line == NULL))
+		return -1;
+
+	len = strlen(line);
+	size = pipeline->iospec_size ?
+		pipeline->iospec_size : PIPELINE_IOSPEC_SIZE;
+	while (pipeline->iospec_len + len + 1 > size)
+		size *= 2;
+
+	if (size != pipeline->iospec_size) {
+		iospec = realloc(pipeline->iospec, size);
+		if (iospec == NULL)
+			return -1;
+
+		pipeline->iospec = iospec;
+		pipeline->iospec_size = size;
+	}
+
+	memcpy(&pipeline->iospec[pipeline->iospec_len], line, len + 1);
+	pipeline->iospec_len += len;
+
+	return 0;
+}
+
+FILE *
+pipeline_iospec_open(struct pipeline *pipeline)
+{
+	if (pipeline == NULL)
 		return NULL;
 
-	TAILQ_FOREACH(pipeline, &obj->pipeline_list, node)
-		if (strcmp(name, pipeline->name) == 0)
-			return pipeline;
+	/* fmemopen() rejects empty buffers. */
+	if (!pipeline->iospec_len)
+		return fopen("/dev/null", "r");
 
-	return NULL;
+	return fmemopen(pipeline->iospec, pipeline->iospec_len, "r");
+}
+
+int
+pipeline_iospec_dump(struct pipeline *pipeline,
+	const char *file_name)
+{
+	FILE *f;
+	int status = 0;
+
+	/* Check input params */
+	if ((pipeline == NULL) ||
+		(file_name == NULL))
+		return -1;
+
+	f = fopen(file_name, "w");
+	if (f == NULL)
+		return -1;
+
+	if (pipeline->iospec_len &&
+		(fwrite(pipeline->iospec, 1, pipeline->iospec_len, f) !=
+			pipeline->iospec_len))
+		status = -1;
+
+	fclose(f);
+	return status;
 }
 
 /**
@@ -630,9 +973,33 @@ obj_init(void)
 
 	TAILQ_INIT(&obj->mempool_list);
 	TAILQ_INIT(&obj->link_list);
+	TAILQ_INIT(&obj->link_claim_list);
 	TAILQ_INIT(&obj->ring_list);
 	TAILQ_INIT(&obj->pipeline_list);
 	TAILQ_INIT(&obj->tap_list);
+	rte_spinlock_init(&obj->lock);
+	pthread_mutex_init(&obj->probe_lock, NULL);
+
+	obj->mempool_index = obj_index_create("obj_mempool_index");
+	obj->link_index = obj_index_create("obj_link_index");
+	obj->ring_index = obj_index_create("obj_ring_index");
+	obj->pipeline_index = obj_index_create("obj_pipeline_index");
+	obj->tap_index = obj_index_create("obj_tap_index");
+	if (!obj->mempool_index ||
+		!obj->link_index ||
+		!obj->ring_index ||
+		!obj->pipeline_index ||
+		!obj->tap_index) {
+		rte_hash_free(obj->mempool_index);
+		rte_hash_free(obj->link_index);
+		rte_hash_free(obj->ring_index);
+		rte_hash_free(obj->pipeline_index);
+		rte_hash_free(obj->tap_index);
+		pthread_mutex_destroy(&obj->probe_lock);
+		free(obj);
+		obj = NULL;
+		return -1;
+	}
 
 	return 0;
 }
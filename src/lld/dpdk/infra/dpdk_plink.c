@@ -0,0 +1,228 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_ring.h>
+#include <rte_swx_ctl.h>
+
+#include "dpdk_infra.h"
+
+#ifndef PIPELINE_LINKS_MAX
+#define PIPELINE_LINKS_MAX                                 256
+#endif
+
+#ifndef PIPELINE_LINK_RING_SIZE
+#define PIPELINE_LINK_RING_SIZE                            1024
+#endif
+
+#ifndef PIPELINE_LINK_BURST_SIZE
+#define PIPELINE_LINK_BURST_SIZE                           32
+#endif
+
+/**
+ * Pipeline links
+ *
+ * A link is a ring written by an output port of the upstream pipeline and
+ * read by an input port of the downstream pipeline, both with the burst
+ * size of the link. The ring writer waits for room in the ring rather than
+ * dropping, so the data plane threads only run the upstream pipeline for as
+ * many instructions as the ring has room left, and hold it back while the
+ * ring has less than a burst of room. The writer then never waits, and the
+ * two ends of a link can share a thread: the upstream pipeline runs first
+ * and the downstream one gets its packets in the same dispatch loop
+ * iteration. Links are never freed and only added before the pipelines are
+ * built, so the data plane threads read them without lock: a link is filled
+ * in before n_links is bumped.
+ */
+static struct pipeline_link links[PIPELINE_LINKS_MAX];
+static uint32_t n_links;
+
+struct pipeline_link *
+pipeline_link_create(const char *name,
+	struct pipeline_link_params *params)
+{
+	struct ring_params ring_params;
+	struct pipeline_link *link;
+	struct pipeline *src, *dst;
+	uint32_t n_out = 0, i;
+	char line[256];
+
+	/* Check input params */
+	if ((name == NULL) ||
+		pipeline_link_find(name) ||
+		(params == NULL) ||
+		(n_links == PIPELINE_LINKS_MAX))
+		return NULL;
+
+	src = pipeline_find(params->src);
+	dst = pipeline_find(params->dst);
+
+	/* A ring has a single writer and a single reader, it can't be shared
+	 * by the instances of a pipeline.
+	 */
+	if ((src == NULL) ||
+		(dst == NULL) ||
+		(src == dst) ||
+		src->p ||
+		dst->p ||
+		(src->n_instances > 1) ||
+		(dst->n_instances > 1))
+		return NULL;
+
+	for (i = 0; i < n_links; i++)
+		if (links[i].src == src)
+			n_out++;
+	if (n_out == PIPELINE_LINKS_OUT_MAX)
+		return NULL;
+
+	link = &links[n_links];
+	memset(link, 0, sizeof(*link));
+
+	ring_params.size = params->ring_size ?
+		params->ring_size : PIPELINE_LINK_RING_SIZE;
+	ring_params.numa_node = src->numa_node;
+
+	link->burst_size = params->burst_size ?
+		params->burst_size :
+		RTE_MIN(PIPELINE_LINK_BURST_SIZE, ring_params.size / 2);
+	if (!link->burst_size || (link->burst_size >= ring_params.size))
+		return NULL;
+
+	/* Resource create */
+	if (!ring_create(name, &ring_params))
+		return NULL;
+
+	link->r = rte_ring_lookup(name);
+	if (link->r == NULL)
+		return NULL;
+
+	/* Node fill in */
+	strlcpy(link->name, name, sizeof(link->name));
+	link->src = src;
+	link->port_out_id = params->port_out_id;
+	link->dst = dst;
+	link->port_in_id = params->port_in_id;
+
+	snprintf(line, sizeof(line), "port out %u ring %s bsz %u\n",
+		link->port_out_id, link->name, link->burst_size);
+	if (pipeline_iospec_add(src, line))
+		return NULL;
+
+	snprintf(line, sizeof(line), "port in %u ring %s bsz %u\n",
+		link->port_in_id, link->name, link->burst_size);
+	if (pipeline_iospec_add(dst, line))
+		return NULL;
+
+	__atomic_store_n(&n_links, n_links + 1, __ATOMIC_RELEASE);
+
+	return link;
+}
+
+struct pipeline_link *
+pipeline_link_find(const char *name)
+{
+	uint32_t i;
+
+	if (name == NULL)
+		return NULL;
+
+	for (i = 0; i < n_links; i++)
+		if (strcmp(links[i].name, name) == 0)
+			return &links[i];
+
+	return NULL;
+}
+
+struct pipeline_link *
+pipeline_link_next(struct pipeline_link *link)
+{
+	uint32_t i = link ? (uint32_t)(link - links) + 1 : 0;
+
+	return (i < n_links) ? &links[i] : NULL;
+}
+
+int
+pipeline_link_is_upstream(struct rte_swx_pipeline *src,
+	struct rte_swx_pipeline *dst)
+{
+	uint32_t n = __atomic_load_n(&n_links, __ATOMIC_ACQUIRE);
+	uint32_t i;
+
+	for (i = 0; i < n; i++)
+		if ((links[i].src->p == src) &&
+			((dst == NULL) || (links[i].dst->p == dst)))
+			return 1;
+
+	return 0;
+}
+
+uint32_t
+pipeline_links_out(struct rte_swx_pipeline *src,
+	struct pipeline_link **out,
+	uint32_t n_max)
+{
+	uint32_t n = __atomic_load_n(&n_links, __ATOMIC_ACQUIRE);
+	uint32_t n_out = 0, i;
+
+	for (i = 0; (i < n) && (n_out < n_max); i++)
+		if (links[i].src->p == src)
+			out[n_out++] = &links[i];
+
+	return n_out;
+}
+
+int
+pipeline_link_stats_read(struct pipeline_link *link,
+	struct pipeline_link_stats *stats)
+{
+	struct rte_swx_port_out_stats out_stats;
+	struct rte_swx_port_in_stats in_stats;
+
+	/* Check input params */
+	if ((link == NULL) ||
+		(stats == NULL) ||
+		!link->src->p ||
+		!link->dst->p)
+		return -1;
+
+	memset(&out_stats, 0, sizeof(out_stats));
+	memset(&in_stats, 0, sizeof(in_stats));
+
+	/* The counters are read while the pipelines run: reading them from
+	 * the upstream end to the downstream end counts a packet moving
+	 * meanwhile twice rather than never.
+	 */
+	if (rte_swx_ctl_pipeline_port_out_stats_read(link->src->p,
+			link->port_out_id, &out_stats))
+		return -1;
+
+	stats->n_pkts_queued = rte_ring_count(link->r);
+
+	if (rte_swx_ctl_pipeline_port_in_stats_read(link->dst->p,
+			link->port_in_id, &in_stats))
+		return -1;
+
+	stats->n_pkts_tx = out_stats.n_pkts;
+	stats->n_pkts_rx = in_stats.n_pkts;
+	stats->n_runs_held = __atomic_load_n(&link->n_runs_held,
+		__ATOMIC_RELAXED);
+	stats->ring_size = rte_ring_get_capacity(link->r);
+
+	return 0;
+}
@@ -0,0 +1,549 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <rte_common.h>
+#include <rte_mbuf.h>
+#include <rte_pause.h>
+#include <rte_ring.h>
+#include <rte_spinlock.h>
+#include <rte_swx_port_ring.h>
+
+#include "dpdk_infra.h"
+
+#ifndef SLOTS_MAX
+#define SLOTS_MAX                                          1024
+#endif
+
+#ifndef SLOT_RING_SIZE
+#define SLOT_RING_SIZE                                     1024
+#endif
+
+#ifndef SLOT_BURST_SIZE
+#define SLOT_BURST_SIZE                                    32
+#endif
+
+#ifndef SLOT_IDLE_US
+#define SLOT_IDLE_US                                       100
+#endif
+
+#ifndef SLOT_IDLE_POLLS
+#define SLOT_IDLE_POLLS                                    1024
+#endif
+
+/**
+ * Reserved pipeline ports
+ *
+ * Each slot is a pair of spare pipeline ports: an input port reading the
+ * slot in ring and an output port writing the slot out ring. Once a port
+ * is bound to the slot, the slot thread moves its received packets to the
+ * in ring and the packets found in the out ring to the port. The other
+ * ports of the pipeline and its tables are not touched.
+ *
+ * The slot thread never waits on the pipeline: packets that don't fit the
+ * in ring are dropped and counted. It takes the slot lock only to copy the
+ * bound ports of the slots, then moves the packets without it. A port
+ * unbound from a slot is freed once the pass that may have copied it is
+ * over, which the pass counter tells.
+ */
+struct slot {
+	struct pipeline *pipeline;
+	uint32_t port_in_id;
+	uint32_t port_out_id;
+
+	/* The in ring and the reader of the out ring. */
+	struct rte_ring *in_ring;
+	void *ring_reader;
+
+	/* Bound ports, NULL while the slot is free. */
+	struct rte_swx_port_in_ops *in_ops;
+	void *in;
+	struct rte_swx_port_out_ops *out_ops;
+	void *out;
+
+	/* Packets of the in port dropped on a full in ring, atomic. */
+	uint64_t n_in_drops;
+};
+
+/* The bound ports of a slot, as copied by the slot thread for a pass. */
+struct slot_ports {
+	struct slot *s;
+	struct rte_swx_port_in_ops *in_ops;
+	void *in;
+	struct rte_swx_port_out_ops *out_ops;
+	void *out;
+};
+
+static struct slot slots[SLOTS_MAX];
+static uint32_t n_slots;
+
+/* Protects the bound ports of the slots and n_slots. */
+static rte_spinlock_t slot_lock = RTE_SPINLOCK_INITIALIZER;
+
+/* Passes of the slot thread, odd while one is moving packets. Atomic. */
+static uint64_t slot_pass;
+
+static pthread_t slot_thread_id;
+static int slot_thread_running;
+
+/* Ring objects are never freed: the rings of a failed reservation are kept
+ * and reused by the next one, which numbers its slots the same way.
+ */
+static int
+slot_ring_create(const char *name, uint32_t numa_node)
+{
+	struct ring_params params = {
+		.size = SLOT_RING_SIZE,
+		.numa_node = numa_node,
+	};
+
+	if (ring_find(name))
+		return 0;
+
+	return ring_create(name, &params) ? 0 : -1;
+}
+
+/* Ports numbered from 0 to the highest port ID of the I/O spec. */
+static void
+slot_iospec_n_ports(struct pipeline *p,
+	uint32_t *n_ports_in,
+	uint32_t *n_ports_out)
+{
+	const char *line;
+	uint32_t id;
+
+	*n_ports_in = 0;
+	*n_ports_out = 0;
+
+	line = p->iospec;
+	while (line && *line) {
+		if ((sscanf(line, "port in %u", &id) == 1) &&
+			(id >= *n_ports_in))
+			*n_ports_in = id + 1;
+
+		if ((sscanf(line, "port out %u", &id) == 1) &&
+			(id >= *n_ports_out))
+			*n_ports_out = id + 1;
+
+		line = strchr(line, '\n');
+		if (line)
+			line++;
+	}
+}
+
+static void
+slot_free(struct slot *s)
+{
+	if (s->ring_reader)
+		rte_swx_port_ring_reader_ops.free(s->ring_reader);
+	memset(s, 0, sizeof(*s));
+}
+
+int
+pipeline_slots_reserve(struct pipeline *p)
+{
+	char in_name[NAME_SIZE], out_name[NAME_SIZE], line[256];
+	uint32_t n_ports_in, n_ports_out, i;
+	size_t iospec_len;
+
+	/* Check input params */
+	if ((p == NULL) ||
+		p->p ||
+		(p->n_slots > SLOTS_MAX - n_slots))
+		return -1;
+
+	slot_iospec_n_ports(p, &n_ports_in, &n_ports_out);
+	iospec_len = p->iospec_len;
+
+	/* The slots of the pipeline are all set up before the slot thread
+	 * gets to see any of them, or none is.
+	 */
+	for (i = 0; i < p->n_slots; i++) {
+		struct rte_swx_port_ring_reader_params reader_params;
+		struct slot *s = &slots[n_slots + i];
+
+		/* Ring names are global, they are numbered over all slots. */
+		snprintf(in_name, sizeof(in_name), "slot%u_in", n_slots + i);
+		snprintf(out_name, sizeof(out_name), "slot%u_out", n_slots + i);
+		if (slot_ring_create(in_name, p->numa_node) ||
+			slot_ring_create(out_name, p->numa_node))
+			goto error;
+
+		s->in_ring = rte_ring_lookup(in_name);
+
+		reader_params.name = out_name;
+		reader_params.burst_size = SLOT_BURST_SIZE;
+		s->ring_reader = rte_swx_port_ring_reader_ops.create(
+			&reader_params);
+
+		if (!s->in_ring || !s->ring_reader)
+			goto error;
+
+		s->pipeline = p;
+		s->port_in_id = n_ports_in + i;
+		s->port_out_id = n_ports_out + i;
+
+		snprintf(line, sizeof(line), "port in %u ring %s bsz %u\n",
+			s->port_in_id, in_name, SLOT_BURST_SIZE);
+		if (pipeline_iospec_add(p, line))
+			goto error;
+
+		snprintf(line, sizeof(line), "port out %u ring %s bsz %u\n",
+			s->port_out_id, out_name, SLOT_BURST_SIZE);
+		if (pipeline_iospec_add(p, line))
+			goto error;
+	}
+
+	/* The slot thread may be running the slots of other pipelines */
+	rte_spinlock_lock(&slot_lock);
+	n_slots += p->n_slots;
+	rte_spinlock_unlock(&slot_lock);
+
+	return 0;
+
+error:
+	for (i = 0; i < p->n_slots; i++)
+		slot_free(&slots[n_slots + i]);
+
+	/* Drop the lines of the slots from the I/O spec. */
+	p->iospec_len = iospec_len;
+	if (p->iospec)
+		p->iospec[iospec_len] = '\0';
+
+	return -1;
+}
+
+static struct slot *
+slot_in_find(struct pipeline *p, uint32_t port_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < n_slots; i++)
+		if ((slots[i].pipeline == p) &&
+			(slots[i].port_in_id == port_id))
+			return &slots[i];
+
+	return NULL;
+}
+
+static struct slot *
+slot_out_find(struct pipeline *p, uint32_t port_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < n_slots; i++)
+		if ((slots[i].pipeline == p) &&
+			(slots[i].port_out_id == port_id))
+			return &slots[i];
+
+	return NULL;
+}
+
+/* Packets the pipeline sent to a slot without an output port are dropped,
+ * at most a ring worth per pass.
+ */
+static uint32_t
+slot_drain(struct slot *s)
+{
+	struct rte_swx_pkt pkt;
+	uint32_t n_pkts;
+
+	for (n_pkts = 0; n_pkts < SLOT_RING_SIZE; n_pkts++) {
+		if (!rte_swx_port_ring_reader_ops.pkt_rx(s->ring_reader, &pkt))
+			break;
+
+		rte_pktmbuf_free(pkt.handle);
+	}
+
+	return n_pkts;
+}
+
+/* Copy the bound ports of the slots for a pass, which starts there. */
+static uint32_t
+slot_snapshot(struct slot_ports *run)
+{
+	uint32_t n, i;
+
+	rte_spinlock_lock(&slot_lock);
+	n = n_slots;
+	for (i = 0; i < n; i++) {
+		run[i].s = &slots[i];
+		run[i].in_ops = slots[i].in_ops;
+		run[i].in = slots[i].in;
+		run[i].out_ops = slots[i].out_ops;
+		run[i].out = slots[i].out;
+	}
+	__atomic_add_fetch(&slot_pass, 1, __ATOMIC_RELEASE);
+	rte_spinlock_unlock(&slot_lock);
+
+	return n;
+}
+
+static void
+slot_pass_end(void)
+{
+	__atomic_add_fetch(&slot_pass, 1, __ATOMIC_RELEASE);
+}
+
+/* Wait for the pass in progress, if any, to be over. Once a port is no
+ * longer in the slots, it is unused after that.
+ */
+static void
+slot_pass_wait(void)
+{
+	uint64_t pass = __atomic_load_n(&slot_pass, __ATOMIC_ACQUIRE);
+
+	if (!(pass & 1))
+		return;
+
+	while (__atomic_load_n(&slot_pass, __ATOMIC_ACQUIRE) == pass)
+		usleep(1);
+}
+
+static uint32_t
+slot_run(struct slot_ports *r)
+{
+	struct rte_mbuf *mbufs[SLOT_BURST_SIZE];
+	struct slot *s = r->s;
+	struct rte_swx_pkt pkt;
+	uint32_t n_in = 0, n_out = 0, n_enq, i;
+
+	if (r->in) {
+		for ( ; n_in < SLOT_BURST_SIZE; n_in++) {
+			struct rte_mbuf *m;
+
+			if (!r->in_ops->pkt_rx(r->in, &pkt))
+				break;
+
+			/* As the SWX ring writer does. */
+			m = pkt.handle;
+			m->data_len = (uint16_t)(pkt.length + m->data_len -
+				m->pkt_len);
+			m->pkt_len = pkt.length;
+			m->data_off = (uint16_t)pkt.offset;
+			mbufs[n_in] = m;
+		}
+
+		n_enq = n_in ? rte_ring_sp_enqueue_burst(s->in_ring,
+			(void **)mbufs, n_in, NULL) : 0;
+		if (n_enq < n_in) {
+			for (i = n_enq; i < n_in; i++)
+				rte_pktmbuf_free(mbufs[i]);
+
+			__atomic_add_fetch(&s->n_in_drops, n_in - n_enq,
+				__ATOMIC_RELAXED);
+		}
+	}
+
+	if (r->out) {
+		for ( ; n_out < SLOT_BURST_SIZE; n_out++) {
+			if (!rte_swx_port_ring_reader_ops.pkt_rx(
+				s->ring_reader, &pkt))
+				break;
+
+			r->out_ops->pkt_tx(r->out, &pkt);
+		}
+
+		if (n_out && r->out_ops->flush)
+			r->out_ops->flush(r->out);
+	} else {
+		/* Nothing else empties the out ring. */
+		n_out = slot_drain(s);
+	}
+
+	return n_in + n_out;
+}
+
+/* The thread polls while there are packets, and sleeps between polls only
+ * after SLOT_IDLE_POLLS passes in a row found none.
+ */
+static void *
+slot_thread(void *arg __rte_unused)
+{
+	static struct slot_ports run[SLOTS_MAX];
+	uint32_t n_idle = 0;
+
+	for ( ; ; ) {
+		uint32_t n_pkts = 0, n, i;
+
+		n = slot_snapshot(run);
+		for (i = 0; i < n; i++)
+			n_pkts += slot_run(&run[i]);
+		slot_pass_end();
+
+		if (n_pkts) {
+			n_idle = 0;
+			continue;
+		}
+
+		if (n_idle < SLOT_IDLE_POLLS) {
+			n_idle++;
+			rte_pause();
+		} else
+			usleep(SLOT_IDLE_US);
+	}
+
+	return NULL;
+}
+
+static int
+slot_thread_start(void)
+{
+	int status;
+
+	if (slot_thread_running)
+		return 0;
+
+	status = pthread_create(&slot_thread_id, NULL, slot_thread, NULL);
+	if (status)
+		return -1;
+
+	pthread_setname_np(slot_thread_id, "dpdk_slots");
+	slot_thread_running = 1;
+
+	return 0;
+}
+
+int
+pipeline_slot_in_bind(struct pipeline *p,
+	uint32_t port_id,
+	struct rte_swx_port_in_ops *ops,
+	void *params)
+{
+	struct slot *s = slot_in_find(p, port_id);
+	void *port;
+
+	/* Check input params */
+	if ((s == NULL) ||
+		s->in ||
+		(ops == NULL) ||
+		(params == NULL))
+		return -1;
+
+	if (slot_thread_start())
+		return -1;
+
+	port = ops->create(params);
+	if (port == NULL)
+		return -1;
+
+	rte_spinlock_lock(&slot_lock);
+	s->in_ops = ops;
+	s->in = port;
+	rte_spinlock_unlock(&slot_lock);
+
+	return 0;
+}
+
+int
+pipeline_slot_out_bind(struct pipeline *p,
+	uint32_t port_id,
+	struct rte_swx_port_out_ops *ops,
+	void *params)
+{
+	struct slot *s = slot_out_find(p, port_id);
+	void *port;
+
+	/* Check input params */
+	if ((s == NULL) ||
+		s->out ||
+		(ops == NULL) ||
+		(params == NULL))
+		return -1;
+
+	if (slot_thread_start())
+		return -1;
+
+	port = ops->create(params);
+	if (port == NULL)
+		return -1;
+
+	rte_spinlock_lock(&slot_lock);
+	s->out_ops = ops;
+	s->out = port;
+	rte_spinlock_unlock(&slot_lock);
+
+	return 0;
+}
+
+int
+pipeline_slot_in_unbind(struct pipeline *p,
+	uint32_t port_id)
+{
+	struct slot *s = slot_in_find(p, port_id);
+	struct rte_swx_port_in_ops *ops;
+	void *port;
+
+	if ((s == NULL) || !s->in)
+		return -1;
+
+	rte_spinlock_lock(&slot_lock);
+	ops = s->in_ops;
+	port = s->in;
+	s->in_ops = NULL;
+	s->in = NULL;
+	rte_spinlock_unlock(&slot_lock);
+
+	slot_pass_wait();
+	ops->free(port);
+
+	return 0;
+}
+
+int
+pipeline_slot_out_unbind(struct pipeline *p,
+	uint32_t port_id)
+{
+	struct slot *s = slot_out_find(p, port_id);
+	struct rte_swx_port_out_ops *ops;
+	void *port;
+
+	if ((s == NULL) || !s->out)
+		return -1;
+
+	rte_spinlock_lock(&slot_lock);
+	ops = s->out_ops;
+	port = s->out;
+	s->out_ops = NULL;
+	s->out = NULL;
+	rte_spinlock_unlock(&slot_lock);
+
+	slot_pass_wait();
+	if (ops->flush)
+		ops->flush(port);
+	ops->free(port);
+
+	return 0;
+}
+
+int
+pipeline_slot_in_drops_read(struct pipeline *p,
+	uint32_t port_id,
+	uint64_t *n_drops)
+{
+	struct slot *s = slot_in_find(p, port_id);
+
+	if ((s == NULL) || (n_drops == NULL))
+		return -1;
+
+	*n_drops = __atomic_load_n(&s->n_in_drops, __ATOMIC_RELAXED);
+
+	return 0;
+}
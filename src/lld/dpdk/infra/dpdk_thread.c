@@ -14,12 +14,17 @@
  * limitations under the License.
  */
 
+#include <pthread.h>
 #include <stdlib.h>
 
 #include <rte_common.h>
+#include <rte_cpuflags.h>
 #include <rte_cycles.h>
 #include <rte_lcore.h>
+#include <rte_pause.h>
+#include <rte_power_intrinsics.h>
 #include <rte_ring.h>
+#include <rte_spinlock.h>
 
 #include <rte_table_acl.h>
 #include <rte_table_array.h>
@@ -50,18 +55,64 @@
 #define PIPELINE_INSTR_QUANTA                              1000
 #endif
 
+/* Adaptive instruction quanta: the quanta of a pipeline is halved when most
+ * of its input port polls find no packet, so that an idle pipeline yields
+ * the thread to its neighbours quickly, and doubled when nearly all of its
+ * polls find a packet, so that a busy pipeline processes bigger batches. The
+ * decision is taken every PIPELINE_QUANTA_ADAPT_RUNS runs of the pipeline.
+ */
+#ifndef PIPELINE_INSTR_QUANTA_MIN
+#define PIPELINE_INSTR_QUANTA_MIN                          64
+#endif
+
+#ifndef PIPELINE_INSTR_QUANTA_MAX
+#define PIPELINE_INSTR_QUANTA_MAX                          16384
+#endif
+
+#ifndef PIPELINE_QUANTA_ADAPT_RUNS
+#define PIPELINE_QUANTA_ADAPT_RUNS                         1024
+#endif
+
+/* Idle policy: while busy, the thread looks for received packets every 16
+ * dispatch loop iterations. Once no packet was received for the threshold
+ * number of iterations, it looks on every iteration and backs off in
+ * between, so that the first packet brings it back to full speed.
+ */
+#ifndef THREAD_IDLE_THRESHOLD
+#define THREAD_IDLE_THRESHOLD                              1024
+#endif
+
+#ifndef THREAD_IDLE_BACKOFF_US
+#define THREAD_IDLE_BACKOFF_US                             10
+#endif
+
+#ifndef THREAD_IDLE_PAUSE_BURST
+#define THREAD_IDLE_PAUSE_BURST                            64
+#endif
+
 /**
  * Control thread: data plane thread context
  */
 struct thread {
 	struct rte_ring *msgq_req;
 	struct rte_ring *msgq_rsp;
+	/* Serializes the requests of the control threads, e.g. the CLI and
+	 * the balancer, on the single producer/consumer MSGQs.
+	 */
+	rte_spinlock_t lock;
 
 	uint32_t enabled;
 };
 
 static struct thread thread[RTE_MAX_LCORE];
 
+/* Serializes the pipeline migrations of the control threads. A mutex
+ * rather than a spinlock: the holder waits on thread message round-trips
+ * and runs the migration hooks.
+ */
+static pthread_mutex_t thread_migrate_lock;
+static pthread_once_t thread_migrate_lock_once = PTHREAD_ONCE_INIT;
+
 /**
  * Data plane threads: context
  */
@@ -69,6 +120,31 @@ struct pipeline_data {
 	struct rte_swx_pipeline *p;
 	uint64_t timer_period; /* Measured in CPU cycles. */
 	uint64_t time_next;
+
+	/* Instruction quanta, adjusted at run time when adaptive is set. */
+	uint32_t instr_quanta;
+	int adaptive;
+	uint32_t n_ports_in;
+	uint32_t adapt_runs;
+	uint64_t adapt_n_pkts;
+	uint64_t adapt_n_empty;
+
+	/* Pipeline links fed by the pipeline. Its runs are cut to the room
+	 * left in their rings, and its output ports are flushed after each
+	 * run, so that a downstream pipeline gets the packets in the same
+	 * dispatch loop iteration when on this thread.
+	 */
+	struct pipeline_link *links[PIPELINE_LINKS_OUT_MAX];
+	uint32_t n_links;
+
+	/* Set while the pipeline is being migrated to this thread: the
+	 * pipeline is not run until the source thread clears *hold.
+	 */
+	uint32_t *hold;
+
+	/* Telemetry, written by the data plane thread only. */
+	uint64_t n_runs;
+	uint64_t run_cycles;
 };
 
 struct thread_data {
@@ -81,10 +157,246 @@ struct thread_data {
 	uint64_t timer_period; /* Measured in CPU cycles. */
 	uint64_t time_next;
 	uint64_t time_next_min;
+
+	/* Idle policy. */
+	struct thread_idle_params idle;
+	int idle_tpause; /* TPAUSE supported by the CPU. */
+	uint64_t idle_backoff_cycles;
+	uint64_t idle_n_pkts;
+	uint32_t idle_n_empty; /* Iterations without any packet received. */
+
+	/* Telemetry, written by the data plane thread only. */
+	uint64_t tsc_start;
+	uint64_t n_iterations;
+	uint64_t run_cycles;
+	uint64_t ctrl_cycles;
+	uint64_t n_ctrl_msgs;
+	uint64_t n_idle_backoffs;
+	uint64_t idle_cycles;
+
+	/* Rung by the control thread after posting a request, on a cache
+	 * line of its own as it is read on every dispatch loop iteration.
+	 */
+	uint32_t doorbell __rte_cache_aligned;
 } __rte_cache_aligned;
 
 static struct thread_data thread_data[RTE_MAX_LCORE];
 
+static void
+pipeline_port_in_stats_sum(struct rte_swx_pipeline *p,
+	uint32_t n_ports_in,
+	uint64_t *n_pkts,
+	uint64_t *n_empty)
+{
+	uint32_t i;
+
+	*n_pkts = 0;
+	*n_empty = 0;
+	for (i = 0; i < n_ports_in; i++) {
+		struct rte_swx_port_in_stats stats;
+
+		rte_swx_ctl_pipeline_port_in_stats_read(p, i, &stats);
+		*n_pkts += stats.n_pkts;
+		*n_empty += stats.n_empty;
+	}
+}
+
+static void
+pipeline_data_init(struct pipeline_data *pd,
+	struct rte_swx_pipeline *p,
+	uint32_t timer_period_ms,
+	uint32_t instr_quanta,
+	int adaptive,
+	uint32_t *hold)
+{
+	struct rte_swx_ctl_pipeline_info info;
+
+	pd->p = p;
+	pd->n_links = pipeline_links_out(p, pd->links, PIPELINE_LINKS_OUT_MAX);
+	pd->hold = hold;
+	pd->timer_period = (rte_get_tsc_hz() * timer_period_ms) / 1000;
+	pd->time_next = rte_get_tsc_cycles() + pd->timer_period;
+	pd->n_runs = 0;
+	pd->run_cycles = 0;
+
+	pd->instr_quanta = instr_quanta ? instr_quanta : PIPELINE_INSTR_QUANTA;
+	pd->adaptive = adaptive;
+	pd->n_ports_in = 0;
+	if (!rte_swx_ctl_pipeline_info_get(p, &info))
+		pd->n_ports_in = info.n_ports_in;
+	pd->adapt_runs = 0;
+	pipeline_port_in_stats_sum(p, pd->n_ports_in,
+		&pd->adapt_n_pkts, &pd->adapt_n_empty);
+}
+
+static void
+pipeline_data_quanta_adapt(struct pipeline_data *pd)
+{
+	uint64_t n_pkts, n_empty, n_polls;
+	uint32_t quanta = pd->instr_quanta;
+
+	pipeline_port_in_stats_sum(pd->p, pd->n_ports_in, &n_pkts, &n_empty);
+	n_polls = (n_pkts - pd->adapt_n_pkts) + (n_empty - pd->adapt_n_empty);
+
+	if (n_polls) {
+		uint64_t n_idle = n_empty - pd->adapt_n_empty;
+
+		/* Mostly idle: give the thread back sooner. */
+		if (n_idle * 2 > n_polls)
+			quanta /= 2;
+		/* Nearly always busy: process bigger batches. */
+		else if (n_idle * 16 < n_polls)
+			quanta *= 2;
+	}
+
+	pd->instr_quanta = RTE_MIN(RTE_MAX(quanta,
+		(uint32_t)PIPELINE_INSTR_QUANTA_MIN),
+		(uint32_t)PIPELINE_INSTR_QUANTA_MAX);
+	pd->adapt_n_pkts = n_pkts;
+	pd->adapt_n_empty = n_empty;
+	pd->adapt_runs = 0;
+}
+
+/* Instructions the pipeline can run without its ring writers waiting for
+ * room: a run sends at most a packet per instruction, all of them flushed
+ * by the end of the run, so it is cut to the room left in the rings of its
+ * links. It is held back, returning 0, while a ring has less than a burst
+ * of room. A packet mirrored to a link port is not accounted for.
+ */
+static uint32_t
+pipeline_data_link_quanta(struct pipeline_data *pd)
+{
+	uint32_t quanta = pd->instr_quanta;
+	uint32_t i;
+
+	for (i = 0; i < pd->n_links; i++) {
+		struct pipeline_link *link = pd->links[i];
+		uint32_t room = rte_ring_free_count(link->r);
+
+		if (room < link->burst_size) {
+			__atomic_store_n(&link->n_runs_held,
+				link->n_runs_held + 1, __ATOMIC_RELAXED);
+			return 0;
+		}
+
+		quanta = RTE_MIN(quanta, room);
+	}
+
+	return quanta;
+}
+
+static void
+thread_data_idle_set(struct thread_data *t,
+	struct thread_idle_params *params)
+{
+	t->idle.mode = params->mode;
+	t->idle.threshold = params->threshold ?
+		params->threshold : THREAD_IDLE_THRESHOLD;
+	t->idle.backoff_us = params->backoff_us ?
+		params->backoff_us : THREAD_IDLE_BACKOFF_US;
+	t->idle_backoff_cycles =
+		(rte_get_tsc_hz() * t->idle.backoff_us) / 1000000;
+	t->idle_n_empty = 0;
+}
+
+/* Control thread operation of a pipeline batch request. The pipeline field
+ * is only used by the control thread.
+ */
+struct thread_msg_pipeline_op {
+	struct pipeline *pipeline;
+	struct rte_swx_pipeline *p; /* NULL to skip the operation. */
+	int enable;
+	uint32_t timer_period_ms;
+	uint32_t instr_quanta;
+	int instr_quanta_adaptive;
+	int status;
+};
+
+static int
+thread_data_pipeline_add(struct thread_data *t,
+	struct rte_swx_pipeline *p,
+	uint32_t timer_period_ms,
+	uint32_t instr_quanta,
+	int instr_quanta_adaptive,
+	uint32_t *hold)
+{
+	uint32_t pos, i;
+
+	if (t->n_pipelines >= THREAD_PIPELINES_MAX)
+		return -1;
+
+	/* Run the pipeline before the first pipeline it feeds through a
+	 * pipeline link, the others keep their order.
+	 */
+	for (pos = 0; pos < t->n_pipelines; pos++)
+		if (pipeline_link_is_upstream(p, t->p[pos]))
+			break;
+
+	for (i = t->n_pipelines; i > pos; i--) {
+		t->p[i] = t->p[i - 1];
+		memcpy(&t->pipeline_data[i], &t->pipeline_data[i - 1],
+			sizeof(t->pipeline_data[i]));
+	}
+
+	t->p[pos] = p;
+
+	pipeline_data_init(&t->pipeline_data[pos], p,
+		timer_period_ms, instr_quanta, instr_quanta_adaptive, hold);
+
+	t->n_pipelines++;
+
+	return 0;
+}
+
+static void
+thread_data_pipeline_remove(struct thread_data *t,
+	struct rte_swx_pipeline *pipeline)
+{
+	uint32_t n_pipelines = t->n_pipelines;
+	uint32_t i;
+
+	/* find pipeline */
+	for (i = 0; i < n_pipelines; i++)
+		if (t->pipeline_data[i].p == pipeline)
+			break;
+
+	if (i == n_pipelines)
+		return;
+
+	/* The pipelines after it keep their run order. */
+	memmove(&t->p[i], &t->p[i + 1],
+		(n_pipelines - i - 1) * sizeof(t->p[0]));
+	memmove(&t->pipeline_data[i], &t->pipeline_data[i + 1],
+		(n_pipelines - i - 1) * sizeof(t->pipeline_data[0]));
+
+	t->n_pipelines--;
+}
+
+static void
+thread_data_pipeline_ops_apply(struct thread_data *t,
+	struct thread_msg_pipeline_op *ops,
+	uint32_t n_ops)
+{
+	uint32_t i;
+
+	for (i = 0; i < n_ops; i++) {
+		struct thread_msg_pipeline_op *op = &ops[i];
+
+		if (op->p == NULL)
+			continue;
+
+		if (op->enable) {
+			op->status = thread_data_pipeline_add(t, op->p,
+				op->timer_period_ms, op->instr_quanta,
+				op->instr_quanta_adaptive, NULL);
+			continue;
+		}
+
+		thread_data_pipeline_remove(t, op->p);
+		op->status = 0;
+	}
+}
+
 /**
  * Control thread: data plane thread init
  */
@@ -148,6 +460,7 @@ thread_init(void)
 		/* Control thread records */
 		t->msgq_req = msgq_req;
 		t->msgq_rsp = msgq_rsp;
+		rte_spinlock_init(&t->lock);
 		t->enabled = 1;
 
 		/* Data plane thread records */
@@ -158,6 +471,18 @@ thread_init(void)
 			(rte_get_tsc_hz() * THREAD_TIMER_PERIOD_MS) / 1000;
 		t_data->time_next = rte_get_tsc_cycles() + t_data->timer_period;
 		t_data->time_next_min = t_data->time_next;
+		t_data->tsc_start = rte_get_tsc_cycles();
+
+		{
+			struct rte_cpu_intrinsics intrinsics;
+			struct thread_idle_params idle = {
+				.mode = THREAD_IDLE_NONE,
+			};
+
+			rte_cpu_get_intrinsics_support(&intrinsics);
+			t_data->idle_tpause = intrinsics.power_pause;
+			thread_data_idle_set(t_data, &idle);
+		}
 	}
 
 	return 0;
@@ -178,6 +503,8 @@ thread_is_running(uint32_t thread_id)
 enum thread_req_type {
 	THREAD_REQ_PIPELINE_ENABLE = 0,
 	THREAD_REQ_PIPELINE_DISABLE,
+	THREAD_REQ_PIPELINE_BATCH,
+	THREAD_REQ_IDLE_SET,
 	THREAD_REQ_MAX
 };
 
@@ -188,11 +515,22 @@ struct thread_msg_req {
 		struct {
 			struct rte_swx_pipeline *p;
 			uint32_t timer_period_ms;
+			uint32_t instr_quanta;
+			int instr_quanta_adaptive;
+			uint32_t *hold;
 		} pipeline_enable;
 
 		struct {
 			struct rte_swx_pipeline *p;
+			uint32_t *release;
 		} pipeline_disable;
+
+		struct {
+			struct thread_msg_pipeline_op *ops;
+			uint32_t n_ops;
+		} pipeline_batch;
+
+		struct thread_idle_params idle_set;
 	};
 };
 
@@ -228,22 +566,31 @@ thread_msg_send_recv(uint32_t thread_id,
 	struct thread_msg_rsp *rsp;
 	int status;
 
+	rte_spinlock_lock(&t->lock);
+
 	/* send */
 	do {
 		status = rte_ring_sp_enqueue(msgq_req, req);
 	} while (status == -ENOBUFS);
 
+	__atomic_store_n(&thread_data[thread_id].doorbell, 1,
+		__ATOMIC_RELEASE);
+
 	/* recv */
 	do {
 		status = rte_ring_sc_dequeue(msgq_rsp, (void **) &rsp);
 	} while (status != 0);
 
+	rte_spinlock_unlock(&t->lock);
+
 	return rsp;
 }
 
 int
 thread_pipeline_enable(uint32_t thread_id,
-	const char *pipeline_name)
+	const char *pipeline_name,
+	uint32_t instr_quanta,
+	int instr_quanta_adaptive)
 {
 	struct pipeline *p = pipeline_find(pipeline_name);
 	struct thread *t;
@@ -262,22 +609,15 @@ thread_pipeline_enable(uint32_t thread_id,
 
 	if (!thread_is_running(thread_id)) {
 		struct thread_data *td = &thread_data[thread_id];
-		struct pipeline_data *tdp = &td->pipeline_data[td->n_pipelines];
-
-		if (td->n_pipelines >= THREAD_PIPELINES_MAX)
-			return -1;
 
 		/* Data plane thread */
-		td->p[td->n_pipelines] = p->p;
-
-		tdp->p = p->p;
-		tdp->timer_period =
-			(rte_get_tsc_hz() * p->timer_period_ms) / 1000;
-		tdp->time_next = rte_get_tsc_cycles() + tdp->timer_period;
-
-		td->n_pipelines++;
+		if (thread_data_pipeline_add(td, p->p, p->timer_period_ms,
+			instr_quanta, instr_quanta_adaptive, NULL))
+			return -1;
 
 		/* Pipeline */
+		p->instr_quanta = instr_quanta;
+		p->instr_quanta_adaptive = instr_quanta_adaptive;
 		p->thread_id = thread_id;
 		p->enabled = 1;
 
@@ -293,6 +633,8 @@ thread_pipeline_enable(uint32_t thread_id,
 	req->type = THREAD_REQ_PIPELINE_ENABLE;
 	req->pipeline_enable.p = p->p;
 	req->pipeline_enable.timer_period_ms = p->timer_period_ms;
+	req->pipeline_enable.instr_quanta = instr_quanta;
+	req->pipeline_enable.instr_quanta_adaptive = instr_quanta_adaptive;
 
 	/* Send request and wait for response */
 	rsp = thread_msg_send_recv(thread_id, req);
@@ -307,6 +649,8 @@ thread_pipeline_enable(uint32_t thread_id,
 	if (status)
 		return status;
 
+	p->instr_quanta = instr_quanta;
+	p->instr_quanta_adaptive = instr_quanta_adaptive;
 	p->thread_id = thread_id;
 	p->enabled = 1;
 
@@ -339,34 +683,349 @@ thread_pipeline_disable(uint32_t thread_id,
 		return -1;
 
 	if (!thread_is_running(thread_id)) {
-		struct thread_data *td = &thread_data[thread_id];
-		uint32_t i;
+		/* Data plane thread */
+		thread_data_pipeline_remove(&thread_data[thread_id], p->p);
 
-		for (i = 0; i < td->n_pipelines; i++) {
-			struct pipeline_data *tdp = &td->pipeline_data[i];
+		/* Pipeline */
+		p->enabled = 0;
+
+		return 0;
+	}
+
+	/* Allocate request */
+	req = thread_msg_alloc();
+	if (req == NULL)
+		return -1;
+
+	/* Write request */
+	req->type = THREAD_REQ_PIPELINE_DISABLE;
+	req->pipeline_disable.p = p->p;
+
+	/* Send request and wait for response */
+	rsp = thread_msg_send_recv(thread_id, req);
+
+	/* Read response */
+	status = rsp->status;
+
+	/* Free response */
+	thread_msg_free(rsp);
+
+	/* Request completion */
+	if (status)
+		return status;
+
+	p->enabled = 0;
+
+	return 0;
+}
 
-			if (tdp->p != p->p)
+/* A batch is refused as a whole when it has several operations on the same
+ * pipeline.
+ */
+static int
+thread_pipelines_update_check(struct thread_msg_pipeline_op *msg_ops,
+	uint32_t n_ops)
+{
+	uint32_t i, j;
+
+	for (i = 0; i < n_ops; i++)
+		for (j = 0; j < i; j++)
+			if (msg_ops[i].pipeline &&
+				(msg_ops[j].pipeline == msg_ops[i].pipeline))
+				return -1;
+
+	return 0;
+}
+
+/**
+ * Control thread: batch of pipeline enable and disable operations, all
+ * handled by the data plane thread in a single message.
+ */
+int
+thread_pipelines_update(uint32_t thread_id,
+	struct thread_pipeline_op *ops,
+	uint32_t n_ops)
+{
+	struct thread_msg_pipeline_op *msg_ops;
+	struct thread_msg_req *req;
+	struct thread_msg_rsp *rsp;
+	uint32_t i;
+	int status = 0;
+
+	/* Check input params */
+	if ((thread_id >= RTE_MAX_LCORE) ||
+		(thread[thread_id].enabled == 0) ||
+		(ops == NULL) ||
+		(n_ops == 0))
+		return -1;
+
+	msg_ops = calloc(n_ops, sizeof(*msg_ops));
+	if (msg_ops == NULL)
+		return -1;
+
+	for (i = 0; i < n_ops; i++) {
+		ops[i].status = -1;
+		msg_ops[i].pipeline = pipeline_find(ops[i].pipeline_name);
+		msg_ops[i].status = -1;
+	}
+
+	/* Nothing is applied unless the whole batch is valid. */
+	if (thread_pipelines_update_check(msg_ops, n_ops)) {
+		free(msg_ops);
+		return -1;
+	}
+
+	for (i = 0; i < n_ops; i++) {
+		struct thread_msg_pipeline_op *op = &msg_ops[i];
+		struct pipeline *p = op->pipeline;
+
+		if (p == NULL)
+			continue;
+
+		if (ops[i].enable) {
+			/* Already enabled, possibly on another thread */
+			if (p->enabled)
 				continue;
+		} else if (!p->enabled || (p->thread_id != thread_id)) {
+			if (!p->enabled)
+				op->status = 0;
+			continue;
+		}
 
-			/* Data plane thread */
-			if (i < td->n_pipelines - 1) {
-				struct rte_swx_pipeline *pipeline_last =
-					td->p[td->n_pipelines - 1];
-				struct pipeline_data *tdp_last =
-					&td->pipeline_data[td->n_pipelines - 1];
+		op->p = p->p;
+		op->enable = ops[i].enable;
+		op->timer_period_ms = p->timer_period_ms;
+		op->instr_quanta = ops[i].instr_quanta;
+		op->instr_quanta_adaptive = ops[i].instr_quanta_adaptive;
+	}
 
-				td->p[i] = pipeline_last;
-				memcpy(tdp, tdp_last, sizeof(*tdp));
-			}
+	if (!thread_is_running(thread_id)) {
+		thread_data_pipeline_ops_apply(&thread_data[thread_id],
+			msg_ops, n_ops);
+	} else {
+		/* Allocate request */
+		req = thread_msg_alloc();
+		if (req == NULL) {
+			free(msg_ops);
+			return -1;
+		}
+
+		/* Write request */
+		req->type = THREAD_REQ_PIPELINE_BATCH;
+		req->pipeline_batch.ops = msg_ops;
+		req->pipeline_batch.n_ops = n_ops;
 
-			td->n_pipelines--;
+		/* Send request and wait for response */
+		rsp = thread_msg_send_recv(thread_id, req);
+		thread_msg_free(rsp);
+	}
 
-			/* Pipeline */
-			p->enabled = 0;
+	/* Request completion */
+	for (i = 0; i < n_ops; i++) {
+		struct thread_msg_pipeline_op *op = &msg_ops[i];
 
-			break;
+		ops[i].status = op->status;
+		if (op->status)
+			status = -1;
+
+		if ((op->p == NULL) || op->status)
+			continue;
+
+		if (op->enable) {
+			op->pipeline->instr_quanta = op->instr_quanta;
+			op->pipeline->instr_quanta_adaptive =
+				op->instr_quanta_adaptive;
+			op->pipeline->thread_id = thread_id;
+			op->pipeline->enabled = 1;
+		} else {
+			op->pipeline->enabled = 0;
 		}
+	}
+
+	free(msg_ops);
+
+	return status;
+}
+
+/**
+ * Control thread: live migration
+ */
+static void
+thread_migrate_lock_init(void)
+{
+	pthread_mutexattr_t attr;
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&thread_migrate_lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+}
+
+void
+thread_pipeline_migrate_lock(void)
+{
+	pthread_once(&thread_migrate_lock_once, thread_migrate_lock_init);
+	pthread_mutex_lock(&thread_migrate_lock);
+}
+
+void
+thread_pipeline_migrate_unlock(void)
+{
+	pthread_mutex_unlock(&thread_migrate_lock);
+}
+
+int
+pipeline_migrate_cb_set(const char *pipeline_name,
+	pipeline_migrate_cb cb,
+	void *arg)
+{
+	struct pipeline *p = pipeline_find(pipeline_name);
+
+	if (p == NULL)
+		return -1;
+
+	thread_pipeline_migrate_lock();
+	p->migrate_cb = cb;
+	p->migrate_cb_arg = arg;
+	thread_pipeline_migrate_unlock();
+
+	return 0;
+}
+
+/* The pipeline is first added to the destination thread on hold, then
+ * removed from the source thread, which releases the hold from its message
+ * handler. The source keeps running the pipeline until that point and the
+ * destination starts running it on its next iteration, so the pipeline is
+ * never run by both threads at once and is never left without a thread for
+ * longer than a dispatch loop iteration.
+ */
+static int
+thread_pipeline_handover(struct pipeline *p,
+	uint32_t thread_id)
+{
+	struct thread_msg_req *req_enable, *req_disable;
+	struct thread_msg_rsp *rsp;
+	uint32_t src_thread_id;
+	int status;
+
+	/* Check input params */
+	if ((thread_id >= RTE_MAX_LCORE) ||
+		(p->enabled == 0) ||
+		(thread[thread_id].enabled == 0))
+		return -1;
+
+	src_thread_id = p->thread_id;
+	if (src_thread_id == thread_id)
+		return 0;
+
+	/* No traffic to preserve when the source thread is not running. */
+	if (!thread_is_running(src_thread_id)) {
+		status = thread_pipeline_disable(src_thread_id, p->name);
+		if (status)
+			return status;
+
+		status = thread_pipeline_enable(thread_id, p->name,
+			p->instr_quanta, p->instr_quanta_adaptive);
+		if (status)
+			thread_pipeline_enable(src_thread_id, p->name,
+				p->instr_quanta, p->instr_quanta_adaptive);
+
+		return status;
+	}
+
+	/* The pipeline would stop running on a thread that is not. */
+	if (!thread_is_running(thread_id))
+		return -1;
+
+	/* Allocate both requests upfront, so that the handover can't fail
+	 * once the destination thread runs the pipeline.
+	 */
+	req_enable = thread_msg_alloc();
+	req_disable = thread_msg_alloc();
+	if ((req_enable == NULL) || (req_disable == NULL)) {
+		free(req_enable);
+		free(req_disable);
+		return -1;
+	}
+
+	__atomic_store_n(&p->migrate_hold, 1, __ATOMIC_RELEASE);
+
+	/* Destination thread: add the pipeline on hold */
+	req_enable->type = THREAD_REQ_PIPELINE_ENABLE;
+	req_enable->pipeline_enable.p = p->p;
+	req_enable->pipeline_enable.timer_period_ms = p->timer_period_ms;
+	req_enable->pipeline_enable.instr_quanta = p->instr_quanta;
+	req_enable->pipeline_enable.instr_quanta_adaptive =
+		p->instr_quanta_adaptive;
+	req_enable->pipeline_enable.hold = &p->migrate_hold;
+
+	rsp = thread_msg_send_recv(thread_id, req_enable);
+	status = rsp->status;
+	thread_msg_free(rsp);
+
+	/* Only the enable can fail, the destination thread being full. */
+	if (status) {
+		__atomic_store_n(&p->migrate_hold, 0, __ATOMIC_RELEASE);
+		free(req_disable);
+		return status;
+	}
+
+	/* Source thread: remove the pipeline and release the hold. The
+	 * removal always succeeds.
+	 */
+	req_disable->type = THREAD_REQ_PIPELINE_DISABLE;
+	req_disable->pipeline_disable.p = p->p;
+	req_disable->pipeline_disable.release = &p->migrate_hold;
+
+	rsp = thread_msg_send_recv(src_thread_id, req_disable);
+	thread_msg_free(rsp);
 
+	p->thread_id = thread_id;
+
+	return 0;
+}
+
+int
+thread_pipeline_migrate(const char *pipeline_name,
+	uint32_t thread_id)
+{
+	struct pipeline *p = pipeline_find(pipeline_name);
+	int status;
+
+	if (p == NULL)
+		return -1;
+
+	thread_pipeline_migrate_lock();
+
+	status = thread_pipeline_handover(p, thread_id);
+	if (!status && p->migrate_cb)
+		p->migrate_cb(p, thread_id, p->migrate_cb_arg);
+
+	thread_pipeline_migrate_unlock();
+
+	return status;
+}
+
+/**
+ * Control thread: idle policy
+ */
+int
+thread_idle_set(uint32_t thread_id,
+	struct thread_idle_params *params)
+{
+	struct thread_msg_req *req;
+	struct thread_msg_rsp *rsp;
+	int status;
+
+	/* Check input params */
+	if ((thread_id >= RTE_MAX_LCORE) ||
+		(thread[thread_id].enabled == 0) ||
+		(params == NULL) ||
+		(params->mode > THREAD_IDLE_SLEEP))
+		return -1;
+
+	if (!thread_is_running(thread_id)) {
+		thread_data_idle_set(&thread_data[thread_id], params);
 		return 0;
 	}
 
@@ -376,8 +1035,8 @@ thread_pipeline_disable(uint32_t thread_id,
 		return -1;
 
 	/* Write request */
-	req->type = THREAD_REQ_PIPELINE_DISABLE;
-	req->pipeline_disable.p = p->p;
+	req->type = THREAD_REQ_IDLE_SET;
+	req->idle_set = *params;
 
 	/* Send request and wait for response */
 	rsp = thread_msg_send_recv(thread_id, req);
@@ -388,11 +1047,97 @@ thread_pipeline_disable(uint32_t thread_id,
 	/* Free response */
 	thread_msg_free(rsp);
 
-	/* Request completion */
-	if (status)
-		return status;
+	return status;
+}
 
-	p->enabled = 0;
+int
+thread_idle_get(uint32_t thread_id,
+	struct thread_idle_params *params)
+{
+	if ((thread_id >= RTE_MAX_LCORE) ||
+		(thread[thread_id].enabled == 0) ||
+		(params == NULL))
+		return -1;
+
+	*params = thread_data[thread_id].idle;
+
+	return 0;
+}
+
+/**
+ * Control thread: telemetry
+ *
+ * The counters are written by the data plane threads only and read here
+ * without synchronization, so a read racing with a pipeline being enabled
+ * or disabled on the same thread may be slightly off.
+ */
+int
+thread_stats_read(uint32_t thread_id,
+	struct thread_stats *stats)
+{
+	struct thread_data *td;
+
+	if ((thread_id >= RTE_MAX_LCORE) ||
+		!thread[thread_id].enabled ||
+		(stats == NULL))
+		return -1;
+
+	td = &thread_data[thread_id];
+	stats->tsc_hz = rte_get_tsc_hz();
+	stats->cycles = rte_get_tsc_cycles() - td->tsc_start;
+	stats->n_iterations = td->n_iterations;
+	stats->run_cycles = td->run_cycles;
+	stats->ctrl_cycles = td->ctrl_cycles;
+	stats->n_ctrl_msgs = td->n_ctrl_msgs;
+	stats->n_idle_backoffs = td->n_idle_backoffs;
+	stats->idle_cycles = td->idle_cycles;
+	stats->n_pipelines = td->n_pipelines;
+
+	return 0;
+}
+
+int
+thread_pipeline_stats_read(const char *pipeline_name,
+	struct thread_pipeline_stats *stats)
+{
+	struct pipeline *p = pipeline_find(pipeline_name);
+	struct rte_swx_ctl_pipeline_info info;
+	struct thread_data *td;
+	uint32_t i;
+
+	if ((p == NULL) || (stats == NULL))
+		return -1;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->thread_id = p->thread_id;
+	stats->enabled = p->enabled;
+	stats->instr_quanta_adaptive = p->instr_quanta_adaptive;
+
+	if (p->enabled && (p->thread_id < RTE_MAX_LCORE)) {
+		td = &thread_data[p->thread_id];
+		for (i = 0; i < td->n_pipelines; i++) {
+			struct pipeline_data *pd = &td->pipeline_data[i];
+
+			if (pd->p != p->p)
+				continue;
+
+			stats->n_runs = pd->n_runs;
+			stats->run_cycles = pd->run_cycles;
+			stats->instr_quanta = pd->instr_quanta;
+			break;
+		}
+	}
+
+	if (rte_swx_ctl_pipeline_info_get(p->p, &info))
+		return 0;
+
+	for (i = 0; i < info.n_ports_in; i++) {
+		struct rte_swx_port_in_stats port_stats;
+
+		rte_swx_ctl_pipeline_port_in_stats_read(p->p, i, &port_stats);
+		stats->n_pkts_in += port_stats.n_pkts;
+		stats->n_empty_polls += port_stats.n_empty;
+	}
 
 	return 0;
 }
@@ -429,68 +1174,66 @@ thread_msg_handle_pipeline_enable(struct thread_data *t,
 	struct thread_msg_req *req)
 {
 	struct thread_msg_rsp *rsp = (struct thread_msg_rsp *) req;
-	struct pipeline_data *p = &t->pipeline_data[t->n_pipelines];
 
-	/* Request */
-	if (t->n_pipelines >= THREAD_PIPELINES_MAX) {
-		rsp->status = -1;
-		return rsp;
-	}
+	rsp->status = thread_data_pipeline_add(t,
+		req->pipeline_enable.p,
+		req->pipeline_enable.timer_period_ms,
+		req->pipeline_enable.instr_quanta,
+		req->pipeline_enable.instr_quanta_adaptive,
+		req->pipeline_enable.hold);
+
+	return rsp;
+}
 
-	t->p[t->n_pipelines] = req->pipeline_enable.p;
+static struct thread_msg_rsp *
+thread_msg_handle_pipeline_disable(struct thread_data *t,
+	struct thread_msg_req *req)
+{
+	struct thread_msg_rsp *rsp = (struct thread_msg_rsp *) req;
 
-	p->p = req->pipeline_enable.p;
-	p->timer_period = (rte_get_tsc_hz() *
-		req->pipeline_enable.timer_period_ms) / 1000;
-	p->time_next = rte_get_tsc_cycles() + p->timer_period;
+	thread_data_pipeline_remove(t, req->pipeline_disable.p);
 
-	t->n_pipelines++;
+	/* The pipeline is no longer run by this thread, let the thread it is
+	 * migrated to start running it.
+	 */
+	if (req->pipeline_disable.release)
+		__atomic_store_n(req->pipeline_disable.release, 0,
+			__ATOMIC_RELEASE);
 
-	/* Response */
 	rsp->status = 0;
 	return rsp;
 }
 
 static struct thread_msg_rsp *
-thread_msg_handle_pipeline_disable(struct thread_data *t,
+thread_msg_handle_pipeline_batch(struct thread_data *t,
 	struct thread_msg_req *req)
 {
 	struct thread_msg_rsp *rsp = (struct thread_msg_rsp *) req;
-	uint32_t n_pipelines = t->n_pipelines;
-	struct rte_swx_pipeline *pipeline = req->pipeline_disable.p;
-	uint32_t i;
-
-	/* find pipeline */
-	for (i = 0; i < n_pipelines; i++) {
-		struct pipeline_data *p = &t->pipeline_data[i];
 
-		if (p->p != pipeline)
-			continue;
-
-		if (i < n_pipelines - 1) {
-			struct rte_swx_pipeline *pipeline_last =
-				t->p[n_pipelines - 1];
-			struct pipeline_data *p_last =
-				&t->pipeline_data[n_pipelines - 1];
+	thread_data_pipeline_ops_apply(t, req->pipeline_batch.ops,
+		req->pipeline_batch.n_ops);
 
-			t->p[i] = pipeline_last;
-			memcpy(p, p_last, sizeof(*p));
-		}
+	rsp->status = 0;
+	return rsp;
+}
 
-		t->n_pipelines--;
+static struct thread_msg_rsp *
+thread_msg_handle_idle_set(struct thread_data *t,
+	struct thread_msg_req *req)
+{
+	struct thread_msg_rsp *rsp = (struct thread_msg_rsp *) req;
 
-		rsp->status = 0;
-		return rsp;
-	}
+	thread_data_idle_set(t, &req->idle_set);
 
-	/* should not get here */
 	rsp->status = 0;
 	return rsp;
 }
 
-static void
+static uint32_t
 thread_msg_handle(struct thread_data *t)
 {
+	uint32_t n_msgs = 0;
+
 	for ( ; ; ) {
 		struct thread_msg_req *req;
 		struct thread_msg_rsp *rsp;
@@ -508,13 +1251,79 @@ thread_msg_handle(struct thread_data *t)
 			rsp = thread_msg_handle_pipeline_disable(t, req);
 			break;
 
+		case THREAD_REQ_PIPELINE_BATCH:
+			rsp = thread_msg_handle_pipeline_batch(t, req);
+			break;
+
+		case THREAD_REQ_IDLE_SET:
+			rsp = thread_msg_handle_idle_set(t, req);
+			break;
+
 		default:
 			rsp = (struct thread_msg_rsp *) req;
 			rsp->status = -1;
 		}
 
 		thread_msg_send(t->msgq_rsp, rsp);
+		n_msgs++;
 	}
+
+	return n_msgs;
+}
+
+/**
+ * Data plane threads: idle policy
+ */
+static void
+thread_idle_check(struct thread_data *t,
+	uint32_t n_iterations)
+{
+	uint64_t n_pkts = 0, start;
+	uint32_t j;
+
+	for (j = 0; j < t->n_pipelines; j++) {
+		uint64_t pkts, empty;
+
+		pipeline_port_in_stats_sum(t->p[j],
+			t->pipeline_data[j].n_ports_in, &pkts, &empty);
+		n_pkts += pkts;
+	}
+
+	if (n_pkts != t->idle_n_pkts) {
+		t->idle_n_pkts = n_pkts;
+		t->idle_n_empty = 0;
+		return;
+	}
+
+	if (t->idle_n_empty < t->idle.threshold) {
+		t->idle_n_empty += n_iterations;
+		return;
+	}
+
+	/* Back off */
+	start = rte_rdtsc();
+	switch (t->idle.mode) {
+	case THREAD_IDLE_TPAUSE:
+		if (t->idle_tpause) {
+			rte_power_pause(start + t->idle_backoff_cycles);
+			break;
+		}
+		/* fall through */
+	case THREAD_IDLE_PAUSE:
+		for (j = 0; j < THREAD_IDLE_PAUSE_BURST; j++)
+			rte_pause();
+		break;
+
+	case THREAD_IDLE_SLEEP:
+		rte_delay_us_sleep(t->idle.backoff_us);
+		break;
+
+	default:
+		return;
+	}
+
+	t->idle_cycles += rte_rdtsc() - start;
+	t->n_idle_backoffs++;
 }
 
 /**
@@ -531,13 +1340,65 @@ thread_main(void *arg __rte_unused)
 
 	/* Dispatch loop */
 	for (i = 0; ; i++) {
+		uint64_t run_start, run_end, tsc;
 		uint32_t j;
 
 		/* Data Plane */
-		for (j = 0; j < t->n_pipelines; j++)
-			rte_swx_pipeline_run(t->p[j], PIPELINE_INSTR_QUANTA);
+		run_start = rte_rdtsc();
+		tsc = run_start;
+		for (j = 0; j < t->n_pipelines; j++) {
+			struct pipeline_data *pd = &t->pipeline_data[j];
+
+			if (unlikely(pd->hold != NULL)) {
+				if (__atomic_load_n(pd->hold, __ATOMIC_ACQUIRE))
+					continue;
+				pd->hold = NULL;
+			}
+
+			if (pd->n_links) {
+				uint32_t quanta = pipeline_data_link_quanta(pd);
+
+				if (!quanta)
+					continue;
+
+				rte_swx_pipeline_run(t->p[j], quanta);
+				rte_swx_pipeline_flush(t->p[j]);
+			} else {
+				rte_swx_pipeline_run(t->p[j], pd->instr_quanta);
+			}
+
+			run_end = rte_rdtsc();
+			pd->run_cycles += run_end - tsc;
+			pd->n_runs++;
+			tsc = run_end;
+
+			if (pd->adaptive &&
+			    (++pd->adapt_runs >= PIPELINE_QUANTA_ADAPT_RUNS)) {
+				pipeline_data_quanta_adapt(pd);
+				tsc = rte_rdtsc();
+			}
+		}
+		t->run_cycles += tsc - run_start;
+		t->n_iterations++;
+
+		/* Idle policy */
+		if (t->idle.mode != THREAD_IDLE_NONE) {
+			if (t->idle_n_empty >= t->idle.threshold)
+				thread_idle_check(t, 1);
+			else if ((i & 0xF) == 0)
+				thread_idle_check(t, 16);
+		}
+
+		/* Control Plane: doorbell */
+		if (unlikely(__atomic_load_n(&t->doorbell, __ATOMIC_RELAXED)) &&
+		    __atomic_exchange_n(&t->doorbell, 0, __ATOMIC_ACQ_REL)) {
+			uint64_t time = rte_rdtsc();
+
+			t->n_ctrl_msgs += thread_msg_handle(t);
+			t->ctrl_cycles += rte_rdtsc() - time;
+		}
 
-		/* Control Plane */
+		/* Control Plane: timer, in case the doorbell was missed */
 		if ((i & 0xF) == 0) {
 			uint64_t time = rte_get_tsc_cycles();
 			uint64_t time_next_min = UINT64_MAX;
@@ -550,7 +1411,8 @@ thread_main(void *arg __rte_unused)
 				uint64_t time_next = t->time_next;
 
 				if (time_next <= time) {
-					thread_msg_handle(t);
+					t->n_ctrl_msgs += thread_msg_handle(t);
+					t->ctrl_cycles += rte_rdtsc() - time;
 					time_next = time + t->timer_period;
 					t->time_next = time_next;
 				}
@@ -69,7 +69,7 @@ static size_t parse(char *arr)
 }
 
 static int
-lld_dpdk_pipeline_mirror_config(struct rte_swx_pipeline *p, void *mir_cfg)
+lld_dpdk_pipeline_mirror_config(struct pipeline *pipe, void *mir_cfg)
 {
 	int rc = BF_SUCCESS;
 	struct rte_swx_pipeline_mirroring_params mir_params;
@@ -81,16 +81,42 @@ lld_dpdk_pipeline_mirror_config(struct rte_swx_pipeline *p, void *mir_cfg)
 	memset(buffer, 0, sizeof(buffer));
 	snprintf(buffer, sizeof(buffer), "mirroring slots %d sessions %d\n",
 		 mir_params.n_slots, mir_params.n_sessions);
-	rc = write_to_iospec_file(buffer);
+	rc = pipeline_iospec_add(pipe, buffer);
 	if (rc) {
-		LOG_ERROR("%s line:%d fail to write to %s file\n"
-			  , __func__, __LINE__, IOSPEC_FILE_PATH);
+		LOG_ERROR("%s line:%d fail to add to iospec of %s\n"
+			  , __func__, __LINE__, pipe->name);
 		return BF_INTERNAL_ERROR;
 	}
 
 	return 0;
 }
 
+/* A mempool with a negative NUMA node is placed on the node of the first
+ * pipeline of the first P4 program which has one. The pools are created
+ * before the ports, which tie a pool to its pipelines, are known.
+ */
+static uint32_t lld_dpdk_mempool_numa_node(bf_device_profile_t *profile,
+					   struct bf_mempool_obj_s *mempool_obj)
+{
+	bf_p4_program_t *p4_program;
+	int i;
+
+	if (mempool_obj->numa_node >= 0)
+		return mempool_obj->numa_node;
+
+	for (i = 0; i < profile->num_p4_programs; i++) {
+		p4_program = &profile->p4_programs[i];
+		if (p4_program->num_p4_pipelines) {
+			LOG_TRACE("%s:%d Mempool %s placed on NUMA node %d",
+				  __func__, __LINE__, mempool_obj->name,
+				  p4_program->p4_pipelines[0].numa_node);
+			return p4_program->p4_pipelines[0].numa_node;
+		}
+	}
+
+	return DEFAULT_NUMA_NODE;
+}
+
 int lld_dpdk_init(bf_device_profile_t *profile)
 {
 	size_t arr_size = sizeof(dpdk_args) / sizeof(*dpdk_args);
@@ -133,7 +159,8 @@ int lld_dpdk_init(bf_device_profile_t *profile)
 		mempool_p.buffer_size = mempool_obj->buffer_size;
 		mempool_p.pool_size   = mempool_obj->pool_size;
 		mempool_p.cache_size  = mempool_obj->cache_size;
-		mempool_p.cpu_id      = mempool_obj->numa_node;
+		mempool_p.cpu_id      = lld_dpdk_mempool_numa_node(profile,
+							mempool_obj);
 		LOG_TRACE("%s:%d Creating Mempool %s",
 			  __func__, __LINE__, mempool_obj->name);
 
@@ -165,7 +192,18 @@ int lld_dpdk_init(bf_device_profile_t *profile)
 				return BF_UNEXPECTED;
 			}
 
-			if (lld_dpdk_pipeline_mirror_config(pipe->p, &p4_pipeline->mir_cfg)) {
+			if ((p4_pipeline->num_instances > 1) &&
+			    pipeline_instances_create(pipe,
+					p4_pipeline->num_instances)) {
+				LOG_ERROR("Error in Creating %d Instances of Pipeline %s",
+					  p4_pipeline->num_instances,
+					  pipeline_name);
+				return BF_UNEXPECTED;
+			}
+
+			pipe->n_slots = p4_pipeline->num_reserved_ports;
+
+			if (lld_dpdk_pipeline_mirror_config(pipe, &p4_pipeline->mir_cfg)) {
 				LOG_ERROR("Error in Setting Mirror Config for pipeline %s",
 					  pipeline_name);
 				return BF_UNEXPECTED;
@@ -27,31 +27,9 @@
 #include <net/if.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
+#include <rte_ethdev.h>
 #define BUF_SIZE 512
 
-int write_to_iospec_file(char *buf)
-{
-	FILE *io_file = NULL;
-	int status;
-
-	io_file = fopen(IOSPEC_FILE_PATH, "a+");
-	if (!io_file) {
-		LOG_ERROR("%s line:%d  Can't open %s file\n"
-			  , __func__, __LINE__, IOSPEC_FILE_PATH);
-		return BF_INTERNAL_ERROR;
-	}
-
-	status = fwrite(buf, 1, strlen(buf), io_file);
-	if (!status) {
-		LOG_ERROR("%s line:%d  Can't write to %s file\n"
-			  , __func__, __LINE__, IOSPEC_FILE_PATH);
-		fclose(io_file);
-		return BF_INTERNAL_ERROR;
-	}
-	fclose(io_file);
-
-	return 0;
-}
 int lld_dpdk_tap_port_create(struct port_attributes_t *port_attrib)
 {
 	if (!tap_create(port_attrib->port_name)) {
@@ -63,6 +41,32 @@ int lld_dpdk_tap_port_create(struct port_attributes_t *port_attrib)
 	return BF_SUCCESS;
 }
 
+/* Set the MTU of the kernel interface of a Tap or Virtio-user Port. */
+static int lld_dpdk_kernel_mtu_set(const char *port_name, uint32_t mtu)
+{
+	struct ifreq ifr;
+	int sfd = -1;
+
+	if (mtu > PORT_MTU_MAX) {
+		LOG_ERROR("MTU for Port %s is greater than max limit\n",
+			  port_name);
+		return BF_INVALID_ARG;
+	}
+	sfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+	if (sfd == -1) {
+		LOG_ERROR("Socket creation failed\n");
+		return BF_INVALID_ARG;
+	}
+	memset(&ifr, 0, sizeof(ifr));
+	strncpy(ifr.ifr_name, port_name, sizeof(ifr.ifr_name) - 1);
+	ifr.ifr_mtu = mtu;
+	if (ioctl(sfd, SIOCSIFMTU, &ifr) < 0)
+		LOG_ERROR("ioctl SIOCSIFMTU Failed...\n");
+	close(sfd);
+
+	return BF_SUCCESS;
+}
+
 int lld_dpdk_pipeline_tap_port_add(bf_dev_port_t dev_port,
 				   struct port_attributes_t *port_attrib,
 				   struct pipeline *pipe_in,
@@ -72,8 +76,6 @@ int lld_dpdk_pipeline_tap_port_add(bf_dev_port_t dev_port,
 	struct rte_swx_port_fd_reader_params params_in;
 	struct rte_swx_port_fd_writer_params params_out;
 	struct tap *tap = NULL;
-	struct ifreq ifr;
-	int sfd = -1;
 	int status;
 	char buffer[BUF_SIZE];
 	memset(&params_in, 0, sizeof(params_in));
@@ -91,22 +93,10 @@ int lld_dpdk_pipeline_tap_port_add(bf_dev_port_t dev_port,
 		params_in.mempool = mp->m;
 		params_in.mtu = port_attrib->tap.mtu + ETH_HDR;
 		params_in.burst_size = PORT_IN_BURST_SIZE;
-		if (port_attrib->tap.mtu > PORT_MTU_MAX) {
-			LOG_ERROR("MTU for Tap Port %s is greater than max limit\n",
-				   port_attrib->port_name);
-			return BF_INVALID_ARG;
-		}
-		sfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
-		if (sfd == -1) {
-			LOG_ERROR("Socket creation failed\n");
-			return BF_INVALID_ARG;
-		}
-		memset(&ifr, 0, sizeof(ifr));
-		strncpy(ifr.ifr_name, port_attrib->port_name, sizeof(ifr.ifr_name) - 1);
-		ifr.ifr_mtu = port_attrib->tap.mtu;
-		if (ioctl(sfd, SIOCSIFMTU, &ifr) < 0)
-			LOG_ERROR("ioctl SIOCSIFMTU Failed...\n");
-		close(sfd);
+		status = lld_dpdk_kernel_mtu_set(port_attrib->port_name,
+						 port_attrib->tap.mtu);
+		if (status)
+			return status;
 
 		memset(buffer, 0, sizeof(buffer));
 		snprintf(buffer, sizeof(buffer),
@@ -114,10 +104,10 @@ int lld_dpdk_pipeline_tap_port_add(bf_dev_port_t dev_port,
 			 port_attrib->port_in_id, params_in.fd,
 			 params_in.mtu, params_in.mempool->name,
 			 params_in.burst_size);
-		status = write_to_iospec_file(buffer);
+		status = pipeline_iospec_add(pipe_in, buffer);
 		if (status) {
-			LOG_ERROR("%s line:%d fail to write to %s file\n"
-				  , __func__, __LINE__, IOSPEC_FILE_PATH);
+			LOG_ERROR("%s line:%d fail to add to iospec of %s\n"
+				  , __func__, __LINE__, pipe_in->name);
 			return BF_INTERNAL_ERROR;
 		}
 	}
@@ -131,10 +121,10 @@ int lld_dpdk_pipeline_tap_port_add(bf_dev_port_t dev_port,
 		snprintf(buffer, sizeof(buffer), "port out %d fd %d bsz %d\n",
 			 port_attrib->port_out_id,  params_out.fd,
 			 params_out.burst_size);
-		status = write_to_iospec_file(buffer);
+		status = pipeline_iospec_add(pipe_out, buffer);
 		if (status) {
-			LOG_ERROR("%s line:%d fail to write to %s file\n"
-				  , __func__, __LINE__, IOSPEC_FILE_PATH);
+			LOG_ERROR("%s line:%d fail to add to iospec of %s\n"
+				  , __func__, __LINE__, pipe_out->name);
 			return BF_INTERNAL_ERROR;
 		}
 	}
@@ -148,7 +138,8 @@ int lld_dpdk_tap_port_add(bf_dev_port_t dev_port,
 			  struct pipeline *pipe_out,
 			  struct mempool *mp)
 {
-	if (lld_dpdk_tap_port_create(port_attrib) != BF_SUCCESS)
+	if (!port_attrib->dev_created &&
+	    (lld_dpdk_tap_port_create(port_attrib) != BF_SUCCESS))
 		return BF_INVALID_ARG;
 
 	if (lld_dpdk_pipeline_tap_port_add(dev_port, port_attrib, pipe_in,
@@ -158,12 +149,90 @@ int lld_dpdk_tap_port_add(bf_dev_port_t dev_port,
 	return BF_SUCCESS;
 }
 
+/* Number of RX/TX queues of a port, each one is a pipeline port of its
+ * own. Only link ports have more than one.
+ */
+static uint32_t lld_dpdk_port_n_rxq(struct port_attributes_t *port_attrib)
+{
+	if ((port_attrib->port_type != BF_DPDK_LINK) ||
+	    !port_attrib->link.n_rxq)
+		return 1;
+
+	return port_attrib->link.n_rxq;
+}
+
+static uint32_t lld_dpdk_port_n_txq(struct port_attributes_t *port_attrib)
+{
+	if ((port_attrib->port_type != BF_DPDK_LINK) ||
+	    !port_attrib->link.n_txq)
+		return 1;
+
+	return port_attrib->link.n_txq;
+}
+
+/* Warn about a mempool that can run dry once the queues of a new link port
+ * hold their mbufs, or that lives on another NUMA node than the device or
+ * the pipelines of the port.
+ */
+static void lld_dpdk_link_mempool_check(struct port_attributes_t *port_attrib,
+					struct link *link,
+					struct link_params *p)
+{
+	struct mempool *mempool;
+	struct pipeline *pipe;
+	uint32_t rx_burst_size, tx_burst_size, n_mbufs;
+	int socket_id;
+
+	mempool = mempool_find(port_attrib->mempool_name);
+	if (!mempool)
+		return;
+
+	rx_burst_size = port_attrib->link.rx_burst_size ?
+		port_attrib->link.rx_burst_size : PORT_IN_BURST_SIZE;
+	tx_burst_size = port_attrib->link.tx_burst_size ?
+		port_attrib->link.tx_burst_size : PORT_OUT_BURST_SIZE;
+
+	/* Full descriptor rings plus one burst in flight per queue */
+	n_mbufs = p->rx.n_queues * (p->rx.queue_size + rx_burst_size) +
+		  p->tx.n_queues * (p->tx.queue_size + tx_burst_size);
+	if (mempool_mbufs_reserve(mempool, n_mbufs))
+		LOG_WARN("Mempool %s: %u mbufs with the per lcore caches are "
+			 "too few for the queues of its ports, %u needed "
+			 "after Link Port %s\n",
+			 mempool->name, mempool->m->size,
+			 mempool->n_mbufs_reserved +
+			 mempool->m->cache_size * rte_lcore_count(),
+			 port_attrib->port_name);
+
+	socket_id = rte_eth_dev_socket_id(link->port_id);
+	if ((socket_id != SOCKET_ID_ANY) &&
+	    (socket_id != mempool->m->socket_id))
+		LOG_WARN("Link Port %s is on NUMA node %d but its mempool %s "
+			 "is on node %d\n",
+			 port_attrib->port_name, socket_id, mempool->name,
+			 mempool->m->socket_id);
+
+	pipe = pipeline_find(port_attrib->pipe_in);
+	if (pipe && ((int)pipe->numa_node != mempool->m->socket_id))
+		LOG_WARN("Pipeline %s is on NUMA node %u but the mempool %s "
+			 "of its Link Port %s is on node %d\n",
+			 pipe->name, pipe->numa_node, mempool->name,
+			 port_attrib->port_name, mempool->m->socket_id);
+}
+
 int lld_dpdk_link_port_create(struct port_attributes_t *port_attrib)
 {
+	struct link_params_rss rss;
 	struct link_params p;
+	struct pipeline *pipe;
+	struct link *link;
+	uint32_t i, n_rxq, n_txq;
 
 	memset(&p, 0, sizeof(p));
 
+	n_rxq = lld_dpdk_port_n_rxq(port_attrib);
+	n_txq = lld_dpdk_port_n_txq(port_attrib);
+
 	p.dev_name = port_attrib->link.pcie_domain_bdf;
 	p.dev_args = port_attrib->link.dev_args;
 	p.dev_hotplug_enabled = port_attrib->link.dev_hotplug_enabled;
@@ -175,12 +244,63 @@ int lld_dpdk_link_port_create(struct port_attributes_t *port_attrib)
 	p.promiscuous = 1;
 	p.rx.rss = NULL;
 
-	if (!link_create(port_attrib->port_name, &p)) {
+	/* Either the port has a pipeline input port per rx queue, or each
+	 * instance of the pipelines gets its own rx and tx queue. RSS
+	 * spreads the traffic over the rx queues.
+	 */
+	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
+	    (port_attrib->port_dir == PM_PORT_DIR_RX_ONLY)) {
+		pipe = pipeline_find(port_attrib->pipe_in);
+		if (pipe && (pipe->n_instances > 1)) {
+			if (n_rxq > 1) {
+				LOG_ERROR("Link Port %s: rx queues can't be "
+					  "shared by pipeline instances\n",
+					  port_attrib->port_name);
+				return BF_INVALID_ARG;
+			}
+			n_rxq = pipe->n_instances;
+		}
+
+		if (n_rxq > LINK_RXQ_RSS_MAX) {
+			LOG_ERROR("Link Port %s: too many rx queues (%u)\n",
+				  port_attrib->port_name, n_rxq);
+			return BF_INVALID_ARG;
+		}
+
+		if (n_rxq > 1) {
+			memset(&rss, 0, sizeof(rss));
+			rss.n_queues = n_rxq;
+			for (i = 0; i < rss.n_queues; i++)
+				rss.queue_id[i] = i;
+			p.rx.n_queues = rss.n_queues;
+			p.rx.rss = &rss;
+		}
+	}
+
+	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
+	    (port_attrib->port_dir == PM_PORT_DIR_TX_ONLY)) {
+		pipe = pipeline_find(port_attrib->pipe_out);
+		if (pipe && (pipe->n_instances > 1)) {
+			if (n_txq > 1) {
+				LOG_ERROR("Link Port %s: tx queues can't be "
+					  "shared by pipeline instances\n",
+					  port_attrib->port_name);
+				return BF_INVALID_ARG;
+			}
+			n_txq = pipe->n_instances;
+		}
+		p.tx.n_queues = n_txq;
+	}
+
+	link = link_create(port_attrib->port_name, &p);
+	if (!link) {
 		LOG_ERROR("Creation of Link Port %s failed\n",
 			  port_attrib->port_name);
 		return BF_INVALID_ARG;
 	}
 
+	lld_dpdk_link_mempool_check(port_attrib, link, &p);
+
 	return BF_SUCCESS;
 }
 
@@ -192,6 +312,7 @@ int lld_dpdk_pipeline_link_port_add(bf_dev_port_t dev_port,
 	struct rte_swx_port_ethdev_reader_params params_in;
 	struct rte_swx_port_ethdev_writer_params params_out;
 	struct link *link = NULL;
+	uint32_t q;
 	int status;
 	char buffer[BUF_SIZE];
 
@@ -204,41 +325,51 @@ int lld_dpdk_pipeline_link_port_add(bf_dev_port_t dev_port,
 		return BF_INVALID_ARG;
 	}
 
+	/* Queue q of the port is pipeline port port_in_id + q */
 	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
 	    (port_attrib->port_dir == PM_PORT_DIR_RX_ONLY)) {
 		params_in.dev_name = link->dev_name;
-		params_in.queue_id = 0;
-		params_in.burst_size = PORT_IN_BURST_SIZE;
-
-		memset(buffer, 0, sizeof(buffer));
-		snprintf(buffer, sizeof(buffer),
-			"port in %d ethdev %s rxq %d bsz %d\n",
-			port_attrib->port_in_id, params_in.dev_name,
-			params_in.queue_id, params_in.burst_size);
-		status = write_to_iospec_file(buffer);
-		if (status) {
-			LOG_ERROR("%s line:%d fail to write to %s file\n"
-				  , __func__, __LINE__, IOSPEC_FILE_PATH);
-			return BF_INTERNAL_ERROR;
+		params_in.burst_size = port_attrib->link.rx_burst_size ?
+			port_attrib->link.rx_burst_size : PORT_IN_BURST_SIZE;
+
+		for (q = 0; q < lld_dpdk_port_n_rxq(port_attrib); q++) {
+			params_in.queue_id = q;
+
+			memset(buffer, 0, sizeof(buffer));
+			snprintf(buffer, sizeof(buffer),
+				"port in %d ethdev %s rxq %d bsz %d\n",
+				port_attrib->port_in_id + q, params_in.dev_name,
+				params_in.queue_id, params_in.burst_size);
+			status = pipeline_iospec_add(pipe_in, buffer);
+			if (status) {
+				LOG_ERROR("%s line:%d fail to add to iospec of %s\n"
+					  , __func__, __LINE__, pipe_in->name);
+				return BF_INTERNAL_ERROR;
+			}
 		}
 	}
 
 	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
 	    (port_attrib->port_dir == PM_PORT_DIR_TX_ONLY)) {
 		params_out.dev_name = link->dev_name;
-		params_out.queue_id = 0;
-		params_out.burst_size = PORT_OUT_BURST_SIZE;
-
-		memset(buffer, 0, sizeof(buffer));
-		snprintf(buffer, sizeof(buffer),
-			"port out %d ethdev %s txq %d bsz %d\n",
-			port_attrib->port_out_id, params_out.dev_name,
-			params_out.queue_id, params_out.burst_size);
-		status = write_to_iospec_file(buffer);
-		if (status) {
-			LOG_ERROR("%s line:%d fail to write to %s file\n"
-				  , __func__, __LINE__, IOSPEC_FILE_PATH);
-			return BF_INTERNAL_ERROR;
+		params_out.burst_size = port_attrib->link.tx_burst_size ?
+			port_attrib->link.tx_burst_size : PORT_OUT_BURST_SIZE;
+
+		for (q = 0; q < lld_dpdk_port_n_txq(port_attrib); q++) {
+			params_out.queue_id = q;
+
+			memset(buffer, 0, sizeof(buffer));
+			snprintf(buffer, sizeof(buffer),
+				"port out %d ethdev %s txq %d bsz %d\n",
+				port_attrib->port_out_id + q,
+				params_out.dev_name, params_out.queue_id,
+				params_out.burst_size);
+			status = pipeline_iospec_add(pipe_out, buffer);
+			if (status) {
+				LOG_ERROR("%s line:%d fail to add to iospec of %s\n"
+					  , __func__, __LINE__, pipe_out->name);
+				return BF_INTERNAL_ERROR;
+			}
 		}
 	}
 
@@ -250,7 +381,8 @@ int lld_dpdk_link_port_add(bf_dev_port_t dev_port,
 			   struct pipeline *pipe_in,
 			   struct pipeline *pipe_out)
 {
-	if (lld_dpdk_link_port_create(port_attrib) != BF_SUCCESS)
+	if (!port_attrib->dev_created &&
+	    (lld_dpdk_link_port_create(port_attrib) != BF_SUCCESS))
 		return BF_INVALID_ARG;
 
 	if (lld_dpdk_pipeline_link_port_add(dev_port, port_attrib, pipe_in,
@@ -260,6 +392,180 @@ int lld_dpdk_link_port_add(bf_dev_port_t dev_port,
 	return BF_SUCCESS;
 }
 
+#define VIRTIO_USER_QUEUE_SIZE 1024
+
+/* A Virtio-user Port is a link port on a virtio-user vdev backed by
+ * vhost-net, which makes the kernel interface port_name.
+ */
+static int lld_dpdk_virtio_user_link_attrib(bf_dev_port_t dev_port,
+				struct port_attributes_t *port_attrib,
+				struct port_attributes_t *link_attrib)
+{
+	struct virtio_user_port_attributes_t *virtio_user =
+		&port_attrib->virtio_user;
+	uint32_t queue_size, burst_size;
+
+	queue_size = virtio_user->queue_size ?
+		virtio_user->queue_size : VIRTIO_USER_QUEUE_SIZE;
+	burst_size = virtio_user->burst_size;
+
+	memcpy(link_attrib, port_attrib, sizeof(*link_attrib));
+	link_attrib->port_type = BF_DPDK_LINK;
+	memset(&link_attrib->link, 0, sizeof(link_attrib->link));
+	snprintf(link_attrib->link.pcie_domain_bdf, PCIE_BDF_LEN,
+		 "virtio_user%u", dev_port);
+	snprintf(link_attrib->link.dev_args, DEV_ARGS_LEN,
+		 "path=/dev/vhost-net,queues=1,queue_size=%u,iface=%s",
+		 queue_size, port_attrib->port_name);
+	link_attrib->link.dev_hotplug_enabled = 1;
+	link_attrib->link.rx_burst_size = burst_size;
+	link_attrib->link.tx_burst_size = burst_size ?
+		burst_size : PORT_IN_BURST_SIZE;
+
+	return BF_SUCCESS;
+}
+
+int lld_dpdk_virtio_user_port_add(bf_dev_port_t dev_port,
+				  struct port_attributes_t *port_attrib,
+				  struct pipeline *pipe_in,
+				  struct pipeline *pipe_out)
+{
+	struct port_attributes_t link_attrib;
+	int status;
+
+	status = lld_dpdk_virtio_user_link_attrib(dev_port, port_attrib,
+						  &link_attrib);
+	if (status != BF_SUCCESS)
+		return status;
+
+	status = lld_dpdk_link_port_add(dev_port, &link_attrib, pipe_in,
+					pipe_out);
+	if (status != BF_SUCCESS)
+		return status;
+
+	return lld_dpdk_kernel_mtu_set(port_attrib->port_name,
+				       port_attrib->virtio_user.mtu);
+}
+
+#define MEMIF_SOCKET_PATH "/run/memif.sock"
+#define MEMIF_RING_SIZE 1024
+#define MEMIF_BUFFER_SIZE 2048
+
+/* A Memif Port is a link port on a memif vdev, connected to a peer process
+ * through the control socket.
+ */
+static int lld_dpdk_memif_link_attrib(bf_dev_port_t dev_port,
+				      struct port_attributes_t *port_attrib,
+				      struct port_attributes_t *link_attrib)
+{
+	struct memif_port_attributes_t *memif = &port_attrib->memif;
+	uint32_t ring_size, buffer_size, burst_size;
+	const char *socket_path;
+
+	socket_path = memif->socket_path[0] ?
+		memif->socket_path : MEMIF_SOCKET_PATH;
+	ring_size = memif->ring_size ? memif->ring_size : MEMIF_RING_SIZE;
+	buffer_size = memif->buffer_size ?
+		memif->buffer_size : MEMIF_BUFFER_SIZE;
+	burst_size = memif->burst_size;
+
+	if (!rte_is_power_of_2(ring_size)) {
+		LOG_ERROR("Memif Port %s ring size %u is not a power of 2\n",
+			  port_attrib->port_name, ring_size);
+		return BF_INVALID_ARG;
+	}
+
+	/* The server cannot map the buffers of its peer, only the client
+	 * can receive and send packets in place.
+	 */
+	if (memif->zero_copy && !memif->client) {
+		LOG_ERROR("Memif Port %s zero-copy needs the client role\n",
+			  port_attrib->port_name);
+		return BF_INVALID_ARG;
+	}
+
+	memcpy(link_attrib, port_attrib, sizeof(*link_attrib));
+	link_attrib->port_type = BF_DPDK_LINK;
+	memset(&link_attrib->link, 0, sizeof(link_attrib->link));
+	snprintf(link_attrib->link.pcie_domain_bdf, PCIE_BDF_LEN,
+		 "net_memif%u", dev_port);
+	if (snprintf(link_attrib->link.dev_args, DEV_ARGS_LEN,
+		     "id=%u,role=%s,socket=%s,rsize=%u,bsize=%u,zero-copy=%s",
+		     memif->id, memif->client ? "client" : "server",
+		     socket_path, rte_log2_u32(ring_size), buffer_size,
+		     memif->zero_copy ? "yes" : "no") >= DEV_ARGS_LEN) {
+		LOG_ERROR("Memif Port %s socket path too long\n",
+			  port_attrib->port_name);
+		return BF_INVALID_ARG;
+	}
+	link_attrib->link.dev_hotplug_enabled = 1;
+	link_attrib->link.rx_burst_size = burst_size;
+	link_attrib->link.tx_burst_size = burst_size ?
+		burst_size : PORT_IN_BURST_SIZE;
+
+	return BF_SUCCESS;
+}
+
+int lld_dpdk_memif_port_add(bf_dev_port_t dev_port,
+			    struct port_attributes_t *port_attrib,
+			    struct pipeline *pipe_in,
+			    struct pipeline *pipe_out)
+{
+	struct port_attributes_t link_attrib;
+	int status;
+
+	status = lld_dpdk_memif_link_attrib(dev_port, port_attrib,
+					    &link_attrib);
+	if (status != BF_SUCCESS)
+		return status;
+
+	return lld_dpdk_link_port_add(dev_port, &link_attrib, pipe_in,
+				      pipe_out);
+}
+
+/* Create the device of a port ahead of lld_dpdk_port_add(), which then
+ * only adds it to its pipelines as dev_created is set. Ports without a
+ * device to create are left to lld_dpdk_port_add().
+ */
+int lld_dpdk_port_create(bf_dev_port_t dev_port,
+			 struct port_attributes_t *port_attrib)
+{
+	struct port_attributes_t link_attrib;
+	int status;
+
+	switch (port_attrib->port_type) {
+	case BF_DPDK_TAP:
+		status = lld_dpdk_tap_port_create(port_attrib);
+		break;
+	case BF_DPDK_LINK:
+		status = lld_dpdk_link_port_create(port_attrib);
+		break;
+	case BF_DPDK_VIRTIO_USER:
+		status = lld_dpdk_virtio_user_link_attrib(dev_port,
+							  port_attrib,
+							  &link_attrib);
+		if (status == BF_SUCCESS)
+			status = lld_dpdk_link_port_create(&link_attrib);
+		break;
+	case BF_DPDK_MEMIF:
+		status = lld_dpdk_memif_link_attrib(dev_port, port_attrib,
+						    &link_attrib);
+		if (status == BF_SUCCESS)
+			status = lld_dpdk_link_port_create(&link_attrib);
+		break;
+	default:
+		return BF_SUCCESS;
+	}
+
+	/* The Virtio-user and Memif link attributes are copied from the port
+	 * ones, so the flag reaches lld_dpdk_link_port_add() too.
+	 */
+	if (status == BF_SUCCESS)
+		port_attrib->dev_created = 1;
+
+	return status;
+}
+
 int lld_dpdk_source_port_add(bf_dev_port_t dev_port,
 			     struct port_attributes_t *port_attrib,
 			     struct pipeline *pipe_in,
@@ -279,10 +585,10 @@ int lld_dpdk_source_port_add(bf_dev_port_t dev_port,
 		 "port in %d source mempool %s file %s loop %ld packets %d\n"
 		 , port_attrib->port_in_id, params.pool->name,
 		 params.file_name, params.n_loops, params.n_pkts_max);
-	status = write_to_iospec_file(buffer);
+	status = pipeline_iospec_add(pipe_in, buffer);
 	if (status) {
-		LOG_ERROR("%s line:%d fail to write to %s file\n"
-			  , __func__, __LINE__, IOSPEC_FILE_PATH);
+		LOG_ERROR("%s line:%d fail to add to iospec of %s\n"
+			  , __func__, __LINE__, pipe_in->name);
 		return BF_INTERNAL_ERROR;
 	}
 	return BF_SUCCESS;
@@ -311,10 +617,10 @@ int lld_dpdk_sink_port_add(bf_dev_port_t dev_port,
 		snprintf(buffer, sizeof(buffer), "port out %d sink file NULL\n",
 			 port_attrib->port_out_id);
 
-	status = write_to_iospec_file(buffer);
+	status = pipeline_iospec_add(pipe_out, buffer);
 	if (status) {
-		LOG_ERROR("%s line:%d fail to write to %s file\n"
-			  , __func__, __LINE__, IOSPEC_FILE_PATH);
+		LOG_ERROR("%s line:%d fail to add to iospec of %s\n"
+			  , __func__, __LINE__, pipe_out->name);
 		return BF_INTERNAL_ERROR;
 	}
 	return BF_SUCCESS;
@@ -367,10 +673,10 @@ int lld_dpdk_pipeline_ring_port_add(bf_dev_port_t dev_port,
 		snprintf(buffer, sizeof(buffer), "port in %d ring %s bsz %d\n",
 			 port_attrib->port_in_id, params_in.name,
 			 params_in.burst_size);
-		status = write_to_iospec_file(buffer);
+		status = pipeline_iospec_add(pipe_in, buffer);
 		if (status) {
-			LOG_ERROR("%s line:%d fail to write to %s file\n"
-				  , __func__, __LINE__, IOSPEC_FILE_PATH);
+			LOG_ERROR("%s line:%d fail to add to iospec of %s\n"
+				  , __func__, __LINE__, pipe_in->name);
 			return BF_INTERNAL_ERROR;
 		}
         }
@@ -384,10 +690,10 @@ int lld_dpdk_pipeline_ring_port_add(bf_dev_port_t dev_port,
 		snprintf(buffer, sizeof(buffer), "port out %d ring %s bsz %d\n"
 			 ,port_attrib->port_out_id, params_out.name,
 			 params_out.burst_size);
-		status = write_to_iospec_file(buffer);
+		status = pipeline_iospec_add(pipe_out, buffer);
 		if (status) {
-			LOG_ERROR("%s line:%d fail to write to %s file\n"
-				  , __func__, __LINE__, IOSPEC_FILE_PATH);
+			LOG_ERROR("%s line:%d fail to add to iospec of %s\n"
+				  , __func__, __LINE__, pipe_out->name);
 			return BF_INTERNAL_ERROR;
 		}
 	}
@@ -400,6 +706,33 @@ int lld_dpdk_ring_port_add(bf_dev_port_t dev_port,
                            struct pipeline *pipe_in,
                            struct pipeline *pipe_out)
 {
+	struct pipeline_link_params params;
+
+	/* A ring port between two pipelines made a pipeline link by its
+	 * config: the ring carries bursts at both ends, is on the node of the
+	 * upstream pipeline, and the data plane threads never let it fill
+	 * up, so the two pipelines can share a thread. Other ring ports keep
+	 * their plain ring.
+	 */
+	if (port_attrib->ring.pipeline_link &&
+	    (port_attrib->port_dir == PM_PORT_DIR_DEFAULT) &&
+	    pipe_in && pipe_out && (pipe_in != pipe_out)) {
+		params.src = pipe_out->name;
+		params.port_out_id = port_attrib->port_out_id;
+		params.dst = pipe_in->name;
+		params.port_in_id = port_attrib->port_in_id;
+		params.ring_size = port_attrib->ring.size;
+		params.burst_size = port_attrib->ring.burst_size;
+
+		if (!pipeline_link_create(port_attrib->port_name, &params)) {
+			LOG_ERROR("Creation of Pipeline Link %s failed\n",
+				  port_attrib->port_name);
+			return BF_INVALID_ARG;
+		}
+
+		return BF_SUCCESS;
+	}
+
 	if (lld_dpdk_ring_port_create(port_attrib) != BF_SUCCESS)
 		return BF_INVALID_ARG;
 
@@ -410,63 +743,485 @@ int lld_dpdk_ring_port_add(bf_dev_port_t dev_port,
 	return BF_SUCCESS;
 }
 
-int lld_dpdk_port_stats_get(bf_dev_port_t dev_port,
-			struct port_attributes_t *port_attrib,
-			u64 *stats)
+/* Extended stats of the link ports, read when the PMD provides them. */
+static const struct {
+	const char *name;
+	enum port_counters_t counter;
+} lld_dpdk_link_xstats[] = {
+	{"rx_unicast_packets", RX_UNICAST},
+	{"rx_multicast_packets", RX_MULTICAST},
+	{"rx_broadcast_packets", RX_BROADCAST},
+	{"tx_unicast_packets", TX_UNICAST},
+	{"tx_multicast_packets", TX_MULTICAST},
+	{"tx_broadcast_packets", TX_BROADCAST},
+};
+
+static int lld_dpdk_link_stats_get(struct port_info_t *port_info,
+				   u64 *stats)
 {
-	struct pipeline *pipe_in = NULL, *pipe_out = NULL;
-	struct rte_swx_port_in_stats in_stats;
-	struct rte_swx_port_out_stats out_stats;
-	int status;
+	struct port_attributes_t *port_attrib = &port_info->port_attrib;
+	struct rte_eth_stats eth_stats;
+	struct link *link;
+	uint64_t id, value;
+	uint32_t i;
 
-	memset(&in_stats, 0, sizeof(in_stats));
-	memset(&out_stats, 0, sizeof(out_stats));
+	link = link_find(port_attrib->port_name);
+	if (!link) {
+		LOG_ERROR("Link Port %s not found\n", port_attrib->port_name);
+		return BF_INVALID_ARG;
+	}
+
+	if (rte_eth_stats_get(link->port_id, &eth_stats)) {
+		LOG_ERROR("Failed to Read Device Stats for Port %s\n",
+			  port_attrib->port_name);
+		return BF_INVALID_ARG;
+	}
+
+	stats[RX_DISCARDS] = eth_stats.imissed + eth_stats.rx_nombuf;
+	stats[RX_ERRORS] = eth_stats.ierrors;
+	stats[TX_ERRORS] = eth_stats.oerrors;
+
+	for (i = 0; i < RTE_DIM(lld_dpdk_link_xstats); i++) {
+		if (rte_eth_xstats_get_id_by_name(link->port_id,
+						  lld_dpdk_link_xstats[i].name,
+						  &id))
+			continue;
+
+		if (rte_eth_xstats_get_by_id(link->port_id, &id, &value, 1)
+		    != 1)
+			continue;
+
+		stats[lld_dpdk_link_xstats[i].counter] = value;
+	}
+
+	return BF_SUCCESS;
+}
+
+/* Look up the pipelines of a port, they are never freed so a usable one
+ * is cached in the port info.
+ */
+static int lld_dpdk_port_pipes_get(struct port_info_t *port_info,
+				   struct pipeline **pipe_in,
+				   struct pipeline **pipe_out)
+{
+	struct port_attributes_t *port_attrib = &port_info->port_attrib;
+	struct pipeline *pipe;
+
+	*pipe_in = NULL;
+	*pipe_out = NULL;
 
 	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
 	    (port_attrib->port_dir == PM_PORT_DIR_RX_ONLY)) {
-		pipe_in = pipeline_find(port_attrib->pipe_in);
-		if (!pipe_in || !pipe_in->ctl) {
-			LOG_ERROR("Ingress Pipeline %s is not valid\n",
-				  port_attrib->pipe_in);
-			return BF_INVALID_ARG;
+		if (!port_info->pipe_in) {
+			pipe = pipeline_find(port_attrib->pipe_in);
+			if (!pipe || !pipe->ctl) {
+				LOG_ERROR("Ingress Pipeline %s is not valid\n",
+					  port_attrib->pipe_in);
+				return BF_INVALID_ARG;
+			}
+			port_info->pipe_in = pipe;
+		}
+		*pipe_in = port_info->pipe_in;
+	}
+
+	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
+	    (port_attrib->port_dir == PM_PORT_DIR_TX_ONLY)) {
+		if (!port_info->pipe_out) {
+			pipe = pipeline_find(port_attrib->pipe_out);
+			if (!pipe || !pipe->ctl) {
+				LOG_ERROR("Egress Pipeline %s is not valid\n",
+					  port_attrib->pipe_out);
+				return BF_INVALID_ARG;
+			}
+			port_info->pipe_out = pipe;
 		}
+		*pipe_out = port_info->pipe_out;
+	}
 
-		status = rte_swx_ctl_pipeline_port_in_stats_read(pipe_in->p,
-						    port_attrib->port_in_id,
-						    &in_stats);
+	return BF_SUCCESS;
+}
 
-		if (status) {
-			LOG_ERROR("Failed to Read Input Stats for Port %s\n",
-				  port_attrib->port_name);
+/* Add the stats of input port port_id of all the instances of a pipeline */
+static int lld_dpdk_port_in_stats_add(struct pipeline *pipe,
+				      uint32_t port_id,
+				      u64 *stats)
+{
+	struct rte_swx_port_in_stats in_stats;
+	uint32_t i;
+
+	for (i = 0; i < pipe->n_instances; i++) {
+		memset(&in_stats, 0, sizeof(in_stats));
+		if (rte_swx_ctl_pipeline_port_in_stats_read(
+					pipe->instance[i]->p,
+					port_id,
+					&in_stats))
 			return BF_INVALID_ARG;
+
+		stats[RX_PACKETS] += in_stats.n_pkts;
+		stats[RX_BYTES] += in_stats.n_bytes;
+		stats[RX_EMPTY_POLLS] += in_stats.n_empty;
+	}
+
+	return BF_SUCCESS;
+}
+
+/* Add the stats of output port port_id of all the instances of a pipeline */
+static int lld_dpdk_port_out_stats_add(struct pipeline *pipe,
+				       uint32_t port_id,
+				       u64 *stats)
+{
+	struct rte_swx_port_out_stats out_stats;
+	uint32_t i;
+
+	for (i = 0; i < pipe->n_instances; i++) {
+		memset(&out_stats, 0, sizeof(out_stats));
+		if (rte_swx_ctl_pipeline_port_out_stats_read(
+					pipe->instance[i]->p,
+					port_id,
+					&out_stats))
+			return BF_INVALID_ARG;
+
+		stats[TX_PACKETS] += out_stats.n_pkts;
+		stats[TX_BYTES] += out_stats.n_bytes;
+	}
+
+	return BF_SUCCESS;
+}
+
+int lld_dpdk_port_stats_get(struct port_info_t *port_info,
+			u64 *stats)
+{
+	struct port_attributes_t *port_attrib = &port_info->port_attrib;
+	struct pipeline *pipe_in = NULL, *pipe_out = NULL;
+	uint32_t q;
+	int status;
+
+	status = lld_dpdk_port_pipes_get(port_info, &pipe_in, &pipe_out);
+	if (status)
+		return status;
+
+	/* The stats of a port add up the stats of all its queues */
+	if (pipe_in) {
+		stats[RX_PACKETS] = 0;
+		stats[RX_BYTES] = 0;
+		stats[RX_EMPTY_POLLS] = 0;
+		for (q = 0; q < lld_dpdk_port_n_rxq(port_attrib); q++) {
+			status = lld_dpdk_port_in_stats_add(
+						pipe_in,
+						port_attrib->port_in_id + q,
+						stats);
+			if (status) {
+				LOG_ERROR("Failed to Read Input Stats for Port %s\n",
+					  port_attrib->port_name);
+				return status;
+			}
 		}
+	}
 
-		stats[RX_PACKETS] = in_stats.n_pkts;
-		stats[RX_BYTES] = in_stats.n_bytes;
-		stats[RX_EMPTY_POLLS] = in_stats.n_empty;
+	if (pipe_out) {
+		stats[TX_PACKETS] = 0;
+		stats[TX_BYTES] = 0;
+		for (q = 0; q < lld_dpdk_port_n_txq(port_attrib); q++) {
+			status = lld_dpdk_port_out_stats_add(
+						pipe_out,
+						port_attrib->port_out_id + q,
+						stats);
+			if (status) {
+				LOG_ERROR("Failed to Read Output Stats for Port %s\n",
+					  port_attrib->port_name);
+				return status;
+			}
+		}
 	}
 
-	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
-	    (port_attrib->port_dir == PM_PORT_DIR_TX_ONLY)) {
-                pipe_out = pipeline_find(port_attrib->pipe_out);
-                if (!pipe_out || !pipe_out->ctl) {
-                        LOG_ERROR("Egress Pipeline %s is not valid\n",
-                                  port_attrib->pipe_out);
-                        return BF_INVALID_ARG;
-                }
+	/* The pipeline only sees the packets the device handed over, the
+	 * drops and errors of link ports come from the device itself.
+	 */
+	if ((port_attrib->port_type == BF_DPDK_LINK) ||
+	    (port_attrib->port_type == BF_DPDK_VIRTIO_USER) ||
+	    (port_attrib->port_type == BF_DPDK_MEMIF))
+		return lld_dpdk_link_stats_get(port_info, stats);
 
-		status = rte_swx_ctl_pipeline_port_out_stats_read(pipe_out->p,
-						    port_attrib->port_out_id,
-						    &out_stats);
+	return BF_SUCCESS;
+}
 
+int lld_dpdk_port_queue_stats_get(struct port_info_t *port_info,
+				  u32 queue_id,
+				  u64 *stats)
+{
+	struct port_attributes_t *port_attrib = &port_info->port_attrib;
+	struct pipeline *pipe_in = NULL, *pipe_out = NULL;
+	int status;
+
+	if ((queue_id >= lld_dpdk_port_n_rxq(port_attrib)) &&
+	    (queue_id >= lld_dpdk_port_n_txq(port_attrib)))
+		return BF_INVALID_ARG;
+
+	status = lld_dpdk_port_pipes_get(port_info, &pipe_in, &pipe_out);
+	if (status)
+		return status;
+
+	memset(stats, 0, BF_PORT_NUM_COUNTERS * sizeof(u64));
+
+	if (pipe_in && (queue_id < lld_dpdk_port_n_rxq(port_attrib))) {
+		status = lld_dpdk_port_in_stats_add(pipe_in,
+						    port_attrib->port_in_id +
+						    queue_id,
+						    stats);
 		if (status) {
-			LOG_ERROR("Failed to Read Output Stats for Port %s\n",
-				  port_attrib->port_name);
-			return BF_INVALID_ARG;
+			LOG_ERROR("Failed to Read Input Stats for Port %s rxq %u\n",
+				  port_attrib->port_name, queue_id);
+			return status;
 		}
+	}
 
-		stats[TX_PACKETS] = out_stats.n_pkts;
-		stats[TX_BYTES] = out_stats.n_bytes;
+	if (pipe_out && (queue_id < lld_dpdk_port_n_txq(port_attrib))) {
+		status = lld_dpdk_port_out_stats_add(pipe_out,
+						     port_attrib->port_out_id +
+						     queue_id,
+						     stats);
+		if (status) {
+			LOG_ERROR("Failed to Read Output Stats for Port %s txq %u\n",
+				  port_attrib->port_name, queue_id);
+			return status;
+		}
+	}
+
+	return BF_SUCCESS;
+}
+
+/* Set whether a spare port of a running pipeline is a network port, in
+ * the direction register of PNA programs. Other programs have no such
+ * register, hence failures are not errors.
+ */
+static void lld_dpdk_port_dir_set(struct pipeline *pipe, uint32_t id,
+				  bool net_port)
+{
+	if (id >= DIR_REG_ARRAY_SIZE)
+		return;
+
+	if (net_port)
+		pipe->net_port_mask[id / 64] |= 1ULL << (id % 64);
+	else
+		pipe->net_port_mask[id / 64] &= ~(1ULL << (id % 64));
+
+	if (rte_swx_ctl_pipeline_regarray_write(pipe->p, PNA_DIR_REG_NAME, id,
+						net_port ? 0 : 1))
+		LOG_TRACE("%s: no direction register in pipeline %s\n",
+			  __func__, pipe->name);
+}
+
+/* Add a port to pipelines which are already built: the port is bound to
+ * the spare ports given by its port IDs, which the pipelines reserved
+ * when they were built.
+ */
+static int lld_dpdk_port_hot_add(struct port_attributes_t *port_attrib,
+				 struct pipeline *pipe_in,
+				 struct pipeline *pipe_out,
+				 struct mempool *mp)
+{
+	struct rte_swx_port_in_ops *in_ops = NULL;
+	struct rte_swx_port_out_ops *out_ops = NULL;
+	union {
+		struct rte_swx_port_fd_reader_params fd;
+		struct rte_swx_port_ring_reader_params ring;
+		struct rte_swx_port_source_params source;
+	} params_in;
+	union {
+		struct rte_swx_port_fd_writer_params fd;
+		struct rte_swx_port_ring_writer_params ring;
+		struct rte_swx_port_sink_params sink;
+	} params_out;
+	struct tap *tap;
+	struct ring *ring;
+	int status;
+
+	memset(&params_in, 0, sizeof(params_in));
+	memset(&params_out, 0, sizeof(params_out));
+
+	switch (port_attrib->port_type) {
+	case BF_DPDK_TAP:
+		/* A Tap Port removed earlier is reused */
+		tap = tap_find(port_attrib->port_name);
+		if (!tap) {
+			status = lld_dpdk_tap_port_create(port_attrib);
+			if (status)
+				return status;
+			tap = tap_find(port_attrib->port_name);
+		}
+		status = lld_dpdk_kernel_mtu_set(port_attrib->port_name,
+						 port_attrib->tap.mtu);
+		if (status)
+			return status;
+
+		in_ops = &rte_swx_port_fd_reader_ops;
+		params_in.fd.fd = tap->fd;
+		params_in.fd.mempool = mp->m;
+		params_in.fd.mtu = port_attrib->tap.mtu + ETH_HDR;
+		params_in.fd.burst_size = PORT_IN_BURST_SIZE;
+
+		out_ops = &rte_swx_port_fd_writer_ops;
+		params_out.fd.fd = tap->fd;
+		params_out.fd.burst_size = PORT_OUT_BURST_SIZE;
+		break;
+	case BF_DPDK_RING:
+		/* A Ring Port removed earlier is reused */
+		ring = ring_find(port_attrib->port_name);
+		if (!ring) {
+			status = lld_dpdk_ring_port_create(port_attrib);
+			if (status)
+				return status;
+			ring = ring_find(port_attrib->port_name);
+		}
+
+		in_ops = &rte_swx_port_ring_reader_ops;
+		params_in.ring.name = ring->name;
+		params_in.ring.burst_size = PORT_IN_BURST_SIZE;
+
+		out_ops = &rte_swx_port_ring_writer_ops;
+		params_out.ring.name = ring->name;
+		params_out.ring.burst_size = PORT_OUT_BURST_SIZE;
+		break;
+	case BF_DPDK_SOURCE:
+		in_ops = &rte_swx_port_source_ops;
+		params_in.source.pool = mp->m;
+		params_in.source.file_name = port_attrib->source.file_name;
+		break;
+	case BF_DPDK_SINK:
+		out_ops = &rte_swx_port_sink_ops;
+		if (strcmp(port_attrib->sink.file_name, "none"))
+			params_out.sink.file_name = port_attrib->sink.file_name;
+		break;
+	default:
+		LOG_ERROR("Port %s can't be added to a running pipeline\n",
+			  port_attrib->port_name);
+		return BF_NOT_SUPPORTED;
+	}
+
+	if (pipe_in && in_ops &&
+	    pipeline_slot_in_bind(pipe_in, port_attrib->port_in_id, in_ops,
+				  &params_in)) {
+		LOG_ERROR("Port in %d of pipeline %s is not a free reserved "
+			  "port\n", port_attrib->port_in_id, pipe_in->name);
+		return BF_INVALID_ARG;
+	}
+
+	if (pipe_out && out_ops &&
+	    pipeline_slot_out_bind(pipe_out, port_attrib->port_out_id,
+				   out_ops, &params_out)) {
+		LOG_ERROR("Port out %d of pipeline %s is not a free reserved "
+			  "port\n", port_attrib->port_out_id, pipe_out->name);
+		if (pipe_in && in_ops)
+			pipeline_slot_in_unbind(pipe_in,
+						port_attrib->port_in_id);
+		return BF_INVALID_ARG;
+	}
+
+	if (pipe_in)
+		lld_dpdk_port_dir_set(pipe_in, port_attrib->port_in_id,
+				      port_attrib->net_port);
+	if (pipe_out)
+		lld_dpdk_port_dir_set(pipe_out, port_attrib->port_out_id,
+				      port_attrib->net_port);
+
+	return BF_SUCCESS;
+}
+
+int lld_dpdk_port_del(bf_dev_port_t dev_port,
+		      struct port_attributes_t *port_attrib)
+{
+	struct pipeline *pipe_in = NULL, *pipe_out = NULL;
+	bool bound = false;
+
+	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
+	    (port_attrib->port_dir == PM_PORT_DIR_RX_ONLY))
+		pipe_in = pipeline_find(port_attrib->pipe_in);
+
+	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
+	    (port_attrib->port_dir == PM_PORT_DIR_TX_ONLY))
+		pipe_out = pipeline_find(port_attrib->pipe_out);
+
+	/* Only the ports bound to reserved ports can be removed, the
+	 * others are part of their pipeline for good.
+	 */
+	if (pipe_in && pipe_in->ctl &&
+	    !pipeline_slot_in_unbind(pipe_in, port_attrib->port_in_id)) {
+		lld_dpdk_port_dir_set(pipe_in, port_attrib->port_in_id, false);
+		bound = true;
+	}
+
+	if (pipe_out && pipe_out->ctl &&
+	    !pipeline_slot_out_unbind(pipe_out, port_attrib->port_out_id)) {
+		lld_dpdk_port_dir_set(pipe_out, port_attrib->port_out_id,
+				      false);
+		bound = true;
+	}
+
+	if (!bound) {
+		LOG_ERROR("Port %s is not bound to reserved pipeline ports\n",
+			  port_attrib->port_name);
+		return BF_NOT_SUPPORTED;
+	}
+
+	return BF_SUCCESS;
+}
+
+/* Check whether one of the pipeline ports first to first + n - 1 is already
+ * in the iospec of a pipeline, dir being "in" or "out".
+ */
+static bool lld_dpdk_iospec_port_used(struct pipeline *pipe, const char *dir,
+				      uint32_t first, uint32_t n)
+{
+	char fmt[16];
+	const char *line;
+	uint32_t id;
+
+	snprintf(fmt, sizeof(fmt), "port %s %%u", dir);
+
+	line = pipe->iospec;
+	while (line && *line) {
+		if ((sscanf(line, fmt, &id) == 1) &&
+		    (id >= first) && (id - first < n))
+			return true;
+
+		line = strchr(line, '\n');
+		if (line)
+			line++;
+	}
+
+	return false;
+}
+
+/* Check that the pipeline ports of a port, one per queue, are not taken
+ * by a port added to the pipelines before. A pipeline port given twice
+ * would only be caught when the pipeline is built, if at all.
+ */
+static int lld_dpdk_port_ids_check(struct port_attributes_t *port_attrib,
+				   struct pipeline *pipe_in,
+				   struct pipeline *pipe_out)
+{
+	uint32_t n_rxq = lld_dpdk_port_n_rxq(port_attrib);
+	uint32_t n_txq = lld_dpdk_port_n_txq(port_attrib);
+
+	if (pipe_in && (port_attrib->port_type != BF_DPDK_SINK) &&
+	    lld_dpdk_iospec_port_used(pipe_in, "in", port_attrib->port_in_id,
+				      n_rxq)) {
+		LOG_ERROR("Port %s: input ports %u to %u of pipeline %s "
+			  "overlap another port\n",
+			  port_attrib->port_name, port_attrib->port_in_id,
+			  port_attrib->port_in_id + n_rxq - 1, pipe_in->name);
+		return BF_INVALID_ARG;
+	}
+
+	if (pipe_out && (port_attrib->port_type != BF_DPDK_SOURCE) &&
+	    lld_dpdk_iospec_port_used(pipe_out, "out",
+				      port_attrib->port_out_id, n_txq)) {
+		LOG_ERROR("Port %s: output ports %u to %u of pipeline %s "
+			  "overlap another port\n",
+			  port_attrib->port_name, port_attrib->port_out_id,
+			  port_attrib->port_out_id + n_txq - 1,
+			  pipe_out->name);
+		return BF_INVALID_ARG;
 	}
 
 	return BF_SUCCESS;
@@ -478,11 +1233,13 @@ int lld_dpdk_port_add(bf_dev_port_t dev_port,
 	int status = BF_SUCCESS;
 	struct pipeline *pipe_in = NULL, *pipe_out = NULL;
 	struct mempool *mp = NULL;
+	uint32_t q, id;
+	bool built;
 
 	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
             (port_attrib->port_dir == PM_PORT_DIR_RX_ONLY)) {
 		pipe_in = pipeline_find(port_attrib->pipe_in);
-		if (!pipe_in || pipe_in->ctl) {
+		if (!pipe_in) {
 			LOG_ERROR("Pipeline %s is not valid\n",
 				  port_attrib->pipe_in);
 			return BF_INVALID_ARG;
@@ -492,13 +1249,22 @@ int lld_dpdk_port_add(bf_dev_port_t dev_port,
 	if ((port_attrib->port_dir == PM_PORT_DIR_DEFAULT) ||
             (port_attrib->port_dir == PM_PORT_DIR_TX_ONLY)) {
 		pipe_out = pipeline_find(port_attrib->pipe_out);
-		if (!pipe_out || pipe_out->ctl) {
+		if (!pipe_out) {
 			LOG_ERROR("Pipeline %s is not valid\n",
 				  port_attrib->pipe_out);
 			return BF_INVALID_ARG;
 		}
 	}
 
+	/* Ports join built pipelines through their reserved ports */
+	built = (pipe_in && pipe_in->ctl) || (pipe_out && pipe_out->ctl);
+	if (built && ((pipe_in && !pipe_in->ctl) ||
+		      (pipe_out && !pipe_out->ctl))) {
+		LOG_ERROR("Pipelines of port %s are not both built or both "
+			  "not built\n", port_attrib->port_name);
+		return BF_NOT_SUPPORTED;
+	}
+
 	if ((port_attrib->port_type != BF_DPDK_SINK) &&
 	    (port_attrib->port_type != BF_DPDK_RING)) {
 		mp = mempool_find(port_attrib->mempool_name);
@@ -509,13 +1275,28 @@ int lld_dpdk_port_add(bf_dev_port_t dev_port,
 		}
 	}
 
+	if (built)
+		return lld_dpdk_port_hot_add(port_attrib, pipe_in, pipe_out,
+					     mp);
+
+	status = lld_dpdk_port_ids_check(port_attrib, pipe_in, pipe_out);
+	if (status != BF_SUCCESS)
+		return status;
+
+	/* Every queue of a network port is a network port of the pipeline */
 	if (port_attrib->net_port) {
-		if (pipe_in && port_attrib->port_in_id < DIR_REG_ARRAY_SIZE)
-			pipe_in->net_port_mask[port_attrib->port_in_id / 64] |=
-				1ULL << port_attrib->port_in_id;
-		if (pipe_out && port_attrib->port_out_id < DIR_REG_ARRAY_SIZE)
-			pipe_out->net_port_mask[port_attrib->port_out_id / 64]
-				|= 1ULL << port_attrib->port_out_id;
+		for (q = 0; q < lld_dpdk_port_n_rxq(port_attrib); q++) {
+			id = port_attrib->port_in_id + q;
+			if (pipe_in && id < DIR_REG_ARRAY_SIZE)
+				pipe_in->net_port_mask[id / 64] |=
+					1ULL << (id % 64);
+		}
+		for (q = 0; q < lld_dpdk_port_n_txq(port_attrib); q++) {
+			id = port_attrib->port_out_id + q;
+			if (pipe_out && id < DIR_REG_ARRAY_SIZE)
+				pipe_out->net_port_mask[id / 64] |=
+					1ULL << (id % 64);
+		}
 	}
 
 	switch (port_attrib->port_type) {
@@ -549,6 +1330,18 @@ int lld_dpdk_port_add(bf_dev_port_t dev_port,
 						pipe_out);
 		break;
 	}
+	case BF_DPDK_VIRTIO_USER:
+	{
+		status = lld_dpdk_virtio_user_port_add(dev_port, port_attrib,
+						       pipe_in, pipe_out);
+		break;
+	}
+	case BF_DPDK_MEMIF:
+	{
+		status = lld_dpdk_memif_port_add(dev_port, port_attrib,
+						 pipe_in, pipe_out);
+		break;
+	}
 	default:
 		LOG_TRACE("%s:%d Incorrect Port Type", __func__, __LINE__);
 		status = BF_INVALID_ARG;
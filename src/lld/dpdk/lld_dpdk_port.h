@@ -107,6 +107,34 @@ int lld_dpdk_link_port_add(bf_dev_port_t dev_port,
 			   struct pipeline *pipe_in,
 			   struct pipeline *pipe_out);
 
+/**
+ * Add a New DPDK Virtio-user Port, a Link Port on a virtio-user device with
+ * a vhost-kernel backend
+ * @param dev_port The Port ID
+ * @param port_attrib The Port Attributes Eg. Port Name, Port Type etc
+ * @param pipe DPDK Pipeline
+ * @return Status of the API call
+ */
+
+int lld_dpdk_virtio_user_port_add(bf_dev_port_t dev_port,
+				  struct port_attributes_t *port_attrib,
+				  struct pipeline *pipe_in,
+				  struct pipeline *pipe_out);
+
+/**
+ * Add a New DPDK Memif Port, a Link Port on a memif device shared with a
+ * peer process on the same host
+ * @param dev_port The Port ID
+ * @param port_attrib The Port Attributes Eg. Port Name, Port Type etc
+ * @param pipe DPDK Pipeline
+ * @return Status of the API call
+ */
+
+int lld_dpdk_memif_port_add(bf_dev_port_t dev_port,
+			    struct port_attributes_t *port_attrib,
+			    struct pipeline *pipe_in,
+			    struct pipeline *pipe_out);
+
 /**
  * Add a New DPDK Source Port
  * @param dev_port The Port ID
@@ -168,17 +196,40 @@ int lld_dpdk_ring_port_add(bf_dev_port_t dev_port,
 			   struct pipeline *pipe_out);
 
 /**
- * Get All Port Statistics for DPDK Port
- * @param dev_port The Port ID
- * @param port_attrib The Port Attributes
+ * Get All Port Statistics for DPDK Port. The pipelines of the port are
+ * looked up on the first call and cached in the port info.
+ * @param port_info The Port Info
  * @param stats Array to hold all the stats read from DPDK Target
  * @return Status of the API call
  */
 
-int lld_dpdk_port_stats_get(bf_dev_port_t dev_port,
-			    struct port_attributes_t *port_attrib,
+int lld_dpdk_port_stats_get(struct port_info_t *port_info,
 			    u64 *stats);
 
+/**
+ * Get the Statistics of one RX/TX Queue of a DPDK Port, as seen by the
+ * pipeline port of the queue.
+ * @param port_info The Port Info
+ * @param queue_id The Queue ID
+ * @param stats Array to hold all the stats read from DPDK Target
+ * @return Status of the API call
+ */
+int lld_dpdk_port_queue_stats_get(struct port_info_t *port_info,
+				  u32 queue_id,
+				  u64 *stats);
+
+/**
+ * Create the Device of a DPDK Port (Tap, Link, Virtio-user or Memif) ahead
+ * of lld_dpdk_port_add, and set port_attrib->dev_created so that the add
+ * does not create it again. Safe to call concurrently for different ports.
+ * @param dev_port The Port ID
+ * @param port_attrib The Port Attributes Eg. Port Name, Port Type etc
+ * @return Status of the API call
+ */
+
+int lld_dpdk_port_create(bf_dev_port_t dev_port,
+			 struct port_attributes_t *port_attrib);
+
 /**
  * Add a New DPDK Port
  * @param dev_port The Port ID
@@ -189,4 +240,14 @@ int lld_dpdk_port_stats_get(bf_dev_port_t dev_port,
 int lld_dpdk_port_add(bf_dev_port_t dev_port,
 		      struct port_attributes_t *port_attrib);
 
+/**
+ * Remove a DPDK Port added to running pipelines, which keep running
+ * @param dev_port The Port ID
+ * @param port_attrib The Port Attributes Eg. Port Name, Port Type etc
+ * @return Status of the API call
+ */
+
+int lld_dpdk_port_del(bf_dev_port_t dev_port,
+		      struct port_attributes_t *port_attrib);
+
 #endif
@@ -20,8 +20,12 @@
  * @description ucli utilities for pipe mgr
  */
 
+#include <stdlib.h>
+#include <getopt.h>
+
 #include <bf_types/bf_types.h>
 #include <osdep/p4_sde_osdep.h>
+#include <pipe_mgr/pipe_mgr_intf.h>
 
 #include <target-utils/target_utils.h>
 #include <target-utils/uCli/ucli.h>
@@ -29,9 +33,212 @@
 #include <target-utils/uCli/ucli_argparse.h>
 #include <target-utils/uCli/ucli_handler_macros.h>
 
+#include "../shared/pipe_mgr_shared_intf.h"
+
+static ucli_status_t pipe_mgr_ucli_ucli__learner_timeout__(ucli_context_t *uc)
+{
+	UCLI_COMMAND_INFO(uc, "learner-timeout", -1,
+			  "Get or set a learner timer profile of a pipeline");
+	char help_str[] = "learner-timeout -d <device> [-p <pipe>] "
+			  "-i <timer profile> [-t <timeout in seconds>]";
+
+	extern char *optarg;
+	extern int optind;
+	optind = 0;
+	int argc = uc->pargs->count + 1;
+	char *const *argv = (char *const *)&(uc->pargs->args__[0]);
+
+	struct bf_dev_target_t dev_tgt = {0};
+	bool got_dev_id = false;
+	bool got_id = false;
+	bool got_timeout = false;
+	uint32_t timeout_id = 0;
+	uint32_t timeout = 0;
+	pipe_status_t sts;
+	int sess_hdl;
+	int x;
+
+	while (-1 != (x = getopt(argc, argv, "d:p:i:t:"))) {
+		switch (x) {
+		case 'd':
+			dev_tgt.device_id = strtoul(optarg, NULL, 0);
+			got_dev_id = true;
+			break;
+		case 'p':
+			dev_tgt.dev_pipe_id = strtoul(optarg, NULL, 0);
+			break;
+		case 'i':
+			timeout_id = strtoul(optarg, NULL, 0);
+			got_id = true;
+			break;
+		case 't':
+			timeout = strtoul(optarg, NULL, 0);
+			got_timeout = true;
+			break;
+		default:
+			aim_printf(&uc->pvs, "%s\n", help_str);
+			return UCLI_STATUS_OK;
+		}
+	}
+
+	if (!got_dev_id || !got_id) {
+		aim_printf(&uc->pvs, "%s\n", help_str);
+		return UCLI_STATUS_OK;
+	}
+
+	sts = pipe_mgr_get_int_sess_hdl(&sess_hdl);
+	if (sts) {
+		aim_printf(&uc->pvs, "No pipe mgr session, status %d\n", sts);
+		return UCLI_STATUS_OK;
+	}
+
+	if (got_timeout) {
+		sts = pipe_mgr_learner_timeout_set(sess_hdl, dev_tgt,
+						   timeout_id, timeout);
+		aim_printf(&uc->pvs, "Set timer profile %u to %us, status %d\n",
+			   timeout_id, timeout, sts);
+		return UCLI_STATUS_OK;
+	}
+
+	sts = pipe_mgr_learner_timeout_get(sess_hdl, dev_tgt,
+					   timeout_id, &timeout);
+	if (sts)
+		aim_printf(&uc->pvs, "Get timer profile %u failed, status %d\n",
+			   timeout_id, sts);
+	else
+		aim_printf(&uc->pvs, "Timer profile %u: %us\n",
+			   timeout_id, timeout);
+	return UCLI_STATUS_OK;
+}
+
+static ucli_status_t pipe_mgr_ucli_ucli__thread_stats__(ucli_context_t *uc)
+{
+	UCLI_COMMAND_INFO(uc, "thread-stats", -1,
+			  "Show the cycle telemetry of a pipeline and its core");
+	char help_str[] = "thread-stats -d <device> [-p <pipe>]";
+
+	extern char *optarg;
+	extern int optind;
+	optind = 0;
+	int argc = uc->pargs->count + 1;
+	char *const *argv = (char *const *)&(uc->pargs->args__[0]);
+
+	struct bf_dev_target_t dev_tgt = {0};
+	pipe_mgr_pipeline_thread_stats_t stats = {0};
+	bool got_dev_id = false;
+	pipe_status_t sts;
+	int sess_hdl;
+	int x;
+
+	while (-1 != (x = getopt(argc, argv, "d:p:"))) {
+		switch (x) {
+		case 'd':
+			dev_tgt.device_id = strtoul(optarg, NULL, 0);
+			got_dev_id = true;
+			break;
+		case 'p':
+			dev_tgt.dev_pipe_id = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			aim_printf(&uc->pvs, "%s\n", help_str);
+			return UCLI_STATUS_OK;
+		}
+	}
+
+	if (!got_dev_id) {
+		aim_printf(&uc->pvs, "%s\n", help_str);
+		return UCLI_STATUS_OK;
+	}
+
+	sts = pipe_mgr_get_int_sess_hdl(&sess_hdl);
+	if (sts) {
+		aim_printf(&uc->pvs, "No pipe mgr session, status %d\n", sts);
+		return UCLI_STATUS_OK;
+	}
+
+	sts = pipe_mgr_pipeline_thread_stats_get(sess_hdl, dev_tgt, &stats);
+	if (sts) {
+		aim_printf(&uc->pvs, "Get thread stats failed, status %d\n",
+			   sts);
+		return UCLI_STATUS_OK;
+	}
+
+	aim_printf(&uc->pvs, "Thread %u (TSC %lu Hz)\n",
+		   stats.thread_id, stats.tsc_hz);
+	aim_printf(&uc->pvs, "  cycles: %lu, iterations: %lu\n",
+		   stats.thread_cycles, stats.thread_iterations);
+	aim_printf(&uc->pvs, "  run cycles: %lu, ctrl cycles: %lu, "
+		   "ctrl msgs: %lu\n", stats.thread_run_cycles,
+		   stats.thread_ctrl_cycles, stats.thread_ctrl_msgs);
+	aim_printf(&uc->pvs, "Pipeline\n");
+	aim_printf(&uc->pvs, "  runs: %lu, run cycles: %lu\n",
+		   stats.pipeline_runs, stats.pipeline_run_cycles);
+	aim_printf(&uc->pvs, "  pkts in: %lu, empty polls: %lu\n",
+		   stats.pipeline_pkts_in, stats.pipeline_empty_polls);
+	return UCLI_STATUS_OK;
+}
+
+static ucli_status_t pipe_mgr_ucli_ucli__pipeline_migrate__(ucli_context_t *uc)
+{
+	UCLI_COMMAND_INFO(uc, "pipeline-migrate", -1,
+			  "Move a running pipeline to another core");
+	char help_str[] = "pipeline-migrate -d <device> [-p <pipe>] -c <core>";
+
+	extern char *optarg;
+	extern int optind;
+	optind = 0;
+	int argc = uc->pargs->count + 1;
+	char *const *argv = (char *const *)&(uc->pargs->args__[0]);
+
+	struct bf_dev_target_t dev_tgt = {0};
+	bool got_dev_id = false;
+	bool got_core_id = false;
+	uint32_t core_id = 0;
+	pipe_status_t sts;
+	int sess_hdl;
+	int x;
+
+	while (-1 != (x = getopt(argc, argv, "d:p:c:"))) {
+		switch (x) {
+		case 'd':
+			dev_tgt.device_id = strtoul(optarg, NULL, 0);
+			got_dev_id = true;
+			break;
+		case 'p':
+			dev_tgt.dev_pipe_id = strtoul(optarg, NULL, 0);
+			break;
+		case 'c':
+			core_id = strtoul(optarg, NULL, 0);
+			got_core_id = true;
+			break;
+		default:
+			aim_printf(&uc->pvs, "%s\n", help_str);
+			return UCLI_STATUS_OK;
+		}
+	}
+
+	if (!got_dev_id || !got_core_id) {
+		aim_printf(&uc->pvs, "%s\n", help_str);
+		return UCLI_STATUS_OK;
+	}
+
+	sts = pipe_mgr_get_int_sess_hdl(&sess_hdl);
+	if (sts) {
+		aim_printf(&uc->pvs, "No pipe mgr session, status %d\n", sts);
+		return UCLI_STATUS_OK;
+	}
+
+	sts = pipe_mgr_pipeline_migrate(sess_hdl, dev_tgt, core_id);
+	aim_printf(&uc->pvs, "Move pipeline to core %u, status %d\n",
+		   core_id, sts);
+	return UCLI_STATUS_OK;
+}
 
 /* Add new pipe mgr ucli methods here. */
 static ucli_command_handler_f pipe_mgr_ucli_handlers__[] = {
+	pipe_mgr_ucli_ucli__learner_timeout__,
+	pipe_mgr_ucli_ucli__thread_stats__,
+	pipe_mgr_ucli_ucli__pipeline_migrate__,
 	NULL
 };
 
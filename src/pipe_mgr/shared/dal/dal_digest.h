@@ -0,0 +1,56 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file dal_digest.h
+ *
+ * @description Utilities for learn digests
+ */
+
+#ifndef __DAL_DIGEST_H__
+#define __DAL_DIGEST_H__
+
+#include <bf_types/bf_types.h>
+#include "../infra/pipe_mgr_int.h"
+
+/*!
+ * Find the ring the pipeline sends the digests of a field list to.
+ *
+ * @param ring_name name of the pipeline output ring port
+ * @param ring filled with the ring handle
+ * @return Status of the API call, BF_OBJECT_NOT_FOUND if the ring port
+ *	   is not created yet
+ */
+int dal_digest_ring_attach(const char *ring_name, void **ring);
+
+/*!
+ * Read a burst of digests from a ring. Each digest is copied into
+ * entry_size bytes of the buffer, zero padded if it is shorter.
+ *
+ * @param ring ring handle returned by dal_digest_ring_attach
+ * @param entries buffer of max * entry_size bytes
+ * @param entry_size size in bytes of a digest entry
+ * @param max max number of digests to read
+ * @param num filled with the number of digests read
+ * @return Status of the API call
+ */
+int dal_digest_read(void *ring,
+		    u8 *entries,
+		    u32 entry_size,
+		    u32 max,
+		    u32 *num);
+
+#endif /* __DAL_DIGEST_H__ */
@@ -15,6 +15,7 @@
  */
 #include <dvm/bf_drv_intf.h>
 #include "pipe_mgr/shared/pipe_mgr_infra.h"
+#include <pipe_mgr/pipe_mgr_intf.h>
 
 int dal_add_device(int dev_id,
 		enum bf_dev_family_t dev_family,
@@ -27,3 +28,8 @@ int dal_enable_pipeline(bf_dev_id_t dev_id,
 			int profile_id,
 			void *spec_file,
 			enum bf_dev_init_mode_s warm_init_mode);
+
+int dal_pipeline_thread_stats_get(struct bf_dev_target_t dev_tgt,
+				  pipe_mgr_pipeline_thread_stats_t *stats);
+
+int dal_pipeline_migrate(struct bf_dev_target_t dev_tgt, uint32_t core_id);
@@ -265,3 +265,51 @@ int dal_mat_get_next_n_by_key(u32 sess_hdl,
 			       u32 *act_fn_hdls,
 			       u32 *num,
 		               struct pipe_mgr_mat_ctx *mat_ctx);
+
+/**
+ * Read the hit counts of a batch of MatchAction table entries from the
+ * target. The hit count of an entry keeps increasing while the entry
+ * is being matched, so a change between two reads marks the entry active.
+ *
+ * @param  dev_tgt               Target device.
+ * @param  mat_ctx	 	 Pointer to table context information.
+ * @param  n			 Number of entries in the batch.
+ * @param  match_specs		 Match specs of the entries to be read.
+ * @param  hit_cnts		 Array of n hit counts to be returned.
+ * @return                       Status of the API call. BF_NOT_SUPPORTED
+ *				 if the target can not report hits for
+ *				 the table.
+ */
+int dal_mat_ent_hit_cnt_read(struct bf_dev_target_t dev_tgt,
+			     struct pipe_mgr_mat_ctx *mat_ctx,
+			     int n,
+			     struct pipe_tbl_match_spec **match_specs,
+			     u64 *hit_cnts);
+
+/**
+ * Set a learner timer profile on all the learner tables of a pipeline.
+ * Entries already learnt pick up the new timeout the next time they
+ * are re-armed. The profile is checked on all the learners first and
+ * is either set on all of them or on none. Called with the profile
+ * write locked.
+ *
+ * @param  dev_tgt               Target device.
+ * @param  timeout_id		 Timer profile to be set.
+ * @param  timeout		 Timeout in seconds.
+ * @return                       Status of the API call
+ */
+int dal_learner_timeout_set(struct bf_dev_target_t dev_tgt,
+			    u32 timeout_id,
+			    u32 timeout);
+
+/**
+ * Get a learner timer profile of a pipeline.
+ *
+ * @param  dev_tgt               Target device.
+ * @param  timeout_id		 Timer profile to be read.
+ * @param  timeout		 Timeout in seconds to be returned.
+ * @return                       Status of the API call
+ */
+int dal_learner_timeout_get(struct bf_dev_target_t dev_tgt,
+			    u32 timeout_id,
+			    u32 *timeout);
@@ -0,0 +1,149 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file dal_meters.h
+ *
+ * @description Utilities for meters
+ */
+
+#ifndef __DAL_METERS_H__
+#define __DAL_METERS_H__
+
+#include <bf_types/bf_types.h>
+#include <pipe_mgr/pipe_mgr_intf.h>
+#include "../../core/pipe_mgr_log.h"
+#include "../infra/pipe_mgr_int.h"
+
+/*!
+ * Initialize the meter profile pool of a pipeline.
+ *
+ * @param pipe_ctx pipe mgr pipeline ctx info.
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_init(struct pipe_mgr_p4_pipeline *pipe_ctx);
+
+/*!
+ * Release the meter profile pool of a pipeline.
+ *
+ * @param pipe_ctx pipe mgr pipeline ctx info.
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_destroy(struct pipe_mgr_p4_pipeline *pipe_ctx);
+
+/*!
+ * Program a meter index with the given spec. Meter entries with
+ * identical specs share a single meter profile.
+ *
+ * On a pipeline with several instances, each instance meters the traffic
+ * RSS spreads to it: the committed and peak rates are divided evenly
+ * between the instances, the burst sizes are not. Uneven traffic is
+ * policed below the spec on the instances getting more than their share.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx meter index to be programmed
+ * @param spec meter spec to be applied
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_ent_set(bf_dev_target_t dev_tgt,
+		  const char *table_name,
+		  uint32_t idx,
+		  pipe_meter_spec_t *spec);
+
+/*!
+ * Program a range of meter indexes with the same spec. All the
+ * indexes of the range are bound to a single meter profile. On failure
+ * no index of the range is changed.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx_start first meter index to be programmed
+ * @param idx_end last meter index to be programmed
+ * @param spec meter spec to be applied
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_ent_set_range(bf_dev_target_t dev_tgt,
+			const char *table_name,
+			uint32_t idx_start,
+			uint32_t idx_end,
+			pipe_meter_spec_t *spec);
+
+/*!
+ * Reset all the meter indexes of a meter table to the default
+ * profile and release the profiles held by them.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_reset(bf_dev_target_t dev_tgt,
+		const char *table_name);
+
+/*!
+ * Read back the meter spec programmed on a meter index.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx meter index to be read
+ * @param spec buffer to fill the meter spec
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_ent_get(bf_dev_target_t dev_tgt,
+		  const char *table_name,
+		  uint32_t idx,
+		  pipe_meter_spec_t *spec);
+
+/*!
+ * Read the per color statistics of a meter index, summed over the
+ * instances of the pipeline.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx meter index to be read
+ * @param stats buffer to fill the meter stats
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_stats_read(bf_dev_target_t dev_tgt,
+		     const char *table_name,
+		     uint32_t idx,
+		     pipe_meter_stats_t *stats);
+
+/*!
+ * Read the per color statistics of a range of meter indexes.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx_start first meter index to be read
+ * @param idx_end last meter index to be read
+ * @param stats array of (idx_end - idx_start + 1) entries to fill
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_stats_read_range(bf_dev_target_t dev_tgt,
+			   const char *table_name,
+			   uint32_t idx_start,
+			   uint32_t idx_end,
+			   pipe_meter_stats_t *stats);
+
+#endif /* __DAL_METERS_H__ */
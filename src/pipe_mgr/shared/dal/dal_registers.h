@@ -28,11 +28,32 @@
 #include "../infra/pipe_mgr_int.h"
 #include <pipe_mgr/pipe_mgr_intf.h>
 
+/*!
+ * Read a register index. On a pipeline with several instances, the value
+ * is read from the first instance only: the values written by the data
+ * path of the other instances are not reflected.
+ *
+ * @param dev_tgt device target
+ * @param table_name register name
+ * @param id register index to be read
+ * @param stats buffer to fill the register value
+ * @return Status of the API call
+ */
 bf_status_t
 dal_reg_read_indirect_register_set(bf_dev_target_t dev_tgt,
 				   const char *table_name,
 				   int id,
 				   pipe_stful_mem_query_t *stats);
+/*!
+ * Write a register index of all the instances of the pipeline. On
+ * failure no instance is changed.
+ *
+ * @param dev_tgt device target
+ * @param name register name
+ * @param id register index to be written
+ * @param stats value to be written
+ * @return Status of the API call
+ */
 bf_status_t
 dal_reg_write_assignable_register_set(bf_dev_target_t dev_tgt,
 				      const char *name,
@@ -122,20 +122,9 @@ int dal_table_adt_ent_add(u32 sess_hdl,
 		goto error;
 	}
 
-	status = rte_swx_ctl_pipeline_table_entry_add(ctl, mat_ctx->target_table_name,
-						      entry);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_table_entry_add");
-		status = BF_UNEXPECTED;
-		goto error;
-	}
-
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		status = BF_UNEXPECTED;
-		goto error;
-	}
+	status = dal_dpdk_table_entry_write(stage_table->table_meta->pipe,
+					    mat_ctx->target_table_name, entry,
+					    DAL_DPDK_TABLE_ENTRY_ADD);
 
 error:
 	table_entry_free(entry);
@@ -238,20 +227,9 @@ int dal_table_adt_default_ent_add(u32 sess_hdl,
 		goto error;
 	}
 
-	status = rte_swx_ctl_pipeline_table_default_entry_add(ctl, mat_ctx->name
-							      , entry);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_table_entry_add");
-		status = BF_UNEXPECTED;
-		goto error;
-	}
-
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		status = BF_UNEXPECTED;
-		goto error;
-	}
+	status = dal_dpdk_table_entry_write(stage_table->table_meta->pipe,
+					    mat_ctx->name, entry,
+					    DAL_DPDK_TABLE_DEFAULT_ENTRY_ADD);
 
 error:
 	table_entry_free(entry);
@@ -307,21 +285,10 @@ int dal_table_adt_ent_del
 	/*encode the match key*/
 	memcpy(&entry->key[0], (uint8_t *)&tbl_ent_hdl, sizeof(tbl_ent_hdl));
 
-	status = rte_swx_ctl_pipeline_table_entry_delete(ctl, mat_ctx->name,
-			entry);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_table_entry_add");
-		status = BF_UNEXPECTED;
-		goto exit;
-	}
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		status = BF_UNEXPECTED;
-		goto exit;
-	}
+	status = dal_dpdk_table_entry_write(stage_table->table_meta->pipe,
+					    mat_ctx->name, entry,
+					    DAL_DPDK_TABLE_ENTRY_DELETE);
 
-exit:
 	table_entry_free(entry);
 	return status;
 }
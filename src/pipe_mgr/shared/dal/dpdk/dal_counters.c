@@ -25,6 +25,76 @@
 #include <pipe_mgr/shared/pipe_mgr_mat.h>
 #include <pipe_mgr/core/pipe_mgr_ctx_json.h>
 #include <pipe_mgr/pipe_mgr_intf.h>
+#include "pipe_mgr_dpdk_int.h"
+#include "dal_tbl.h"
+/*
+ * Counters of a sharded pipeline are kept by each of its instances, the
+ * value of a counter is the sum of the values of the instances.
+ */
+static int
+dal_cnt_regarray_read(struct pipeline *pipe, const char *regarray_name,
+		      uint32_t id, uint64_t *value)
+{
+	uint64_t instance_value;
+	uint32_t i;
+	int status;
+
+	*value = 0;
+	for (i = 0; i < pipe->n_instances; i++) {
+		status = rte_swx_ctl_pipeline_regarray_read(pipe->instance[i]->p,
+							    regarray_name, id,
+							    &instance_value);
+		if (status)
+			return status;
+		*value += instance_value;
+	}
+
+	return 0;
+}
+
+int
+dal_dpdk_regarray_read_with_key(struct pipeline *pipe,
+				const char *regarray_name,
+				const char *table_name,
+				const uint8_t *table_key,
+				uint64_t *value)
+{
+	uint64_t instance_value;
+	uint32_t i;
+	int status;
+
+	*value = 0;
+	for (i = 0; i < pipe->n_instances; i++) {
+		status = rte_swx_ctl_pipeline_regarray_read_with_key(
+				pipe->instance[i]->p, regarray_name,
+				table_name, table_key, &instance_value);
+		if (status)
+			return status;
+		*value += instance_value;
+	}
+
+	return 0;
+}
+
+/* The first instance takes the value, the others are cleared. */
+static int
+dal_cnt_regarray_write(struct pipeline *pipe, const char *regarray_name,
+		       uint32_t id, uint64_t value)
+{
+	uint32_t i;
+	int status;
+
+	for (i = 0; i < pipe->n_instances; i++) {
+		status = rte_swx_ctl_pipeline_regarray_write(pipe->instance[i]->p,
+							     regarray_name, id,
+							     i ? 0 : value);
+		if (status)
+			return status;
+	}
+
+	return 0;
+}
+
 /*!
  * Initialize the global counter pool.
  *
@@ -189,7 +259,7 @@ dal_cnt_read_flow_indirect_counter_set(bf_dev_target_t dev_tgt,
 	case EXTERNS_ATTR_TYPE_PACKETS:
 
 		/* read counter stats from dpdk pipeline */
-		status = rte_swx_ctl_pipeline_regarray_read(pipe->p,
+		status = dal_cnt_regarray_read(pipe,
 							    externs_entry->target_name,
 							    id,
 							    &value);
@@ -214,7 +284,7 @@ dal_cnt_read_flow_indirect_counter_set(bf_dev_target_t dev_tgt,
 			 externs_entry->target_name, "packets");
 
 		/* read counter stats from dpdk pipeline */
-		status = rte_swx_ctl_pipeline_regarray_read(pipe->p,
+		status = dal_cnt_regarray_read(pipe,
 							    target_name,
 							    id,
 							    &value);
@@ -234,7 +304,7 @@ dal_cnt_read_flow_indirect_counter_set(bf_dev_target_t dev_tgt,
 			 externs_entry->target_name, "bytes");
 
 		/* read counter stats from dpdk pipeline */
-		status = rte_swx_ctl_pipeline_regarray_read(pipe->p,
+		status = dal_cnt_regarray_read(pipe,
 							    target_name,
 							    id,
 							    &value);
@@ -341,7 +411,7 @@ dal_cnt_read_flow_direct_counter_set(void *dal_data, void *res_data,
         case EXTERNS_ATTR_TYPE_PACKETS:
 
 	/* read counter stats from dpdk pipeline */
-                status = rte_swx_ctl_pipeline_regarray_read_with_key(pipe->p,
+                status = dal_dpdk_regarray_read_with_key(pipe,
                                       externs_entry->target_name,
                                       profile->pipe_ctx.mat_tables->ctx.name,
                                       match_spec->match_value_bits,
@@ -430,8 +500,8 @@ dal_cnt_write_assignable_counter_set(bf_dev_target_t dev_tgt,
 	switch (externs_entry->attr_type) {
 	  case EXTERNS_ATTR_TYPE_BYTES:
 	  case EXTERNS_ATTR_TYPE_PACKETS:
-		  status = rte_swx_ctl_pipeline_regarray_write(
-				  pipe->p,
+		  status = dal_cnt_regarray_write(
+				  pipe,
 				  externs_entry->target_name,
 				  id,
 				  value);
@@ -448,8 +518,8 @@ dal_cnt_write_assignable_counter_set(bf_dev_target_t dev_tgt,
 		  snprintf(target_name, sizeof(target_name), "%s_%s",
 				  externs_entry->target_name, "packets");
 
-		  status = rte_swx_ctl_pipeline_regarray_write(
-				  pipe->p,
+		  status = dal_cnt_regarray_write(
+				  pipe,
 				  target_name,
 				  id,
 				  value);
@@ -462,8 +532,8 @@ dal_cnt_write_assignable_counter_set(bf_dev_target_t dev_tgt,
 		  snprintf(target_name, sizeof(target_name), "%s_%s",
 				  externs_entry->target_name, "bytes");
 
-		  status = rte_swx_ctl_pipeline_regarray_write(
-				  pipe->p,
+		  status = dal_cnt_regarray_write(
+				  pipe,
 				  target_name,
 				  id,
 				  value);
@@ -0,0 +1,85 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file dal_digest.c
+ *
+ * @description Utilities for learn digests (DPDK). The pipeline sends
+ * a digest as a packet on an output ring port, whose payload is the
+ * digest entry.
+ */
+
+#include <string.h>
+
+#include <rte_mbuf.h>
+#include <rte_ring.h>
+
+#include "../dal_digest.h"
+#include "../../../core/pipe_mgr_log.h"
+
+/* Max number of packets dequeued from a digest ring at once. */
+#define DAL_DIGEST_BURST 64
+
+int dal_digest_ring_attach(const char *ring_name, void **ring)
+{
+	struct rte_ring *r;
+
+	r = rte_ring_lookup(ring_name);
+	if (!r)
+		return BF_OBJECT_NOT_FOUND;
+
+	*ring = r;
+	return BF_SUCCESS;
+}
+
+int dal_digest_read(void *ring,
+		    u8 *entries,
+		    u32 entry_size,
+		    u32 max,
+		    u32 *num)
+{
+	struct rte_mbuf *pkts[DAL_DIGEST_BURST];
+	const void *data;
+	u32 n, len, i;
+	u8 *entry;
+
+	*num = 0;
+	while (*num < max) {
+		n = max - *num;
+		if (n > DAL_DIGEST_BURST)
+			n = DAL_DIGEST_BURST;
+		n = rte_ring_dequeue_burst(ring, (void **)pkts, n, NULL);
+		if (!n)
+			break;
+
+		for (i = 0; i < n; i++) {
+			entry = entries + (size_t)(*num + i) * entry_size;
+			len = rte_pktmbuf_pkt_len(pkts[i]);
+			if (len > entry_size)
+				len = entry_size;
+			data = rte_pktmbuf_read(pkts[i], 0, len, entry);
+			if (data && data != entry)
+				memcpy(entry, data, len);
+			else if (!data)
+				len = 0;
+			memset(entry + len, 0, entry_size - len);
+			rte_pktmbuf_free(pkts[i]);
+		}
+		*num += n;
+	}
+
+	return BF_SUCCESS;
+}
@@ -13,10 +13,23 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <dirent.h>
+#include <errno.h>
+#include <glob.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rte_common.h>
+#include <rte_version.h>
+
 #include <osdep/p4_sde_osdep.h>
 #include <port_mgr/dpdk/bf_dpdk_port_if.h>
 
 #include "../dal_init.h"
+#include "../dal_meters.h"
 #include "../../infra/pipe_mgr_int.h"
 #include "../../../core/pipe_mgr_log.h"
 #include <lld_dpdk_port.h>
@@ -27,6 +40,10 @@
 #define BUF_SIZE 2048
 #define PATH_SIZE 512
 #define P4_OBJ_FILE_PATH "/tmp/p4"
+#ifndef P4_OBJ_CACHE_PATH
+#define P4_OBJ_CACHE_PATH "/tmp/p4_cache"
+#endif
+#define P4_OBJ_CFLAGS "-O3 -fpic -Wno-deprecated-declarations"
 
 int dal_add_device(int dev_id,
 		   enum bf_dev_family_t dev_family,
@@ -44,6 +61,643 @@ int dal_remove_device(int dev_id)
 	return BF_SUCCESS;
 }
 
+/**
+ * Write the iospec of the pipeline to IOSPEC_FILE_PATH.<pipeline name> when
+ * SDE_IOSPEC_DUMP is set. Debugging aid only, the pipeline is built from
+ * the iospec in memory.
+ */
+static void dal_iospec_dump(struct pipeline *pipe)
+{
+	char path[PATH_SIZE];
+
+	if (!getenv("SDE_IOSPEC_DUMP"))
+		return;
+
+	snprintf(path, sizeof(path), "%s.%s", IOSPEC_FILE_PATH, pipe->name);
+	if (pipeline_iospec_dump(pipe, path))
+		LOG_ERROR("%s: cannot dump iospec of %s to %s",
+			  __func__, pipe->name, path);
+}
+
+/**
+ * Fill in the iospec of a secondary pipeline instance: it is the iospec of
+ * the pipeline with each ethdev port bound to the rx/tx queue of the
+ * instance. Other port types can't be shared between the instances.
+ */
+static int dal_iospec_instance_write(struct pipeline *pipe,
+				     uint32_t instance_id)
+{
+	struct pipeline *inst = pipe->instance[instance_id];
+	char line[BUF_SIZE], out[BUF_SIZE];
+	const char *cur, *eol;
+	char *q, *end;
+	size_t len;
+
+	/* The instance iospec is rebuilt from scratch on every build */
+	inst->iospec_len = 0;
+
+	for (cur = pipe->iospec; cur && *cur; cur = eol) {
+		eol = strchr(cur, '\n');
+		eol = eol ? eol + 1 : cur + strlen(cur);
+		len = eol - cur;
+		if (len >= sizeof(line)) {
+			LOG_ERROR("%s: iospec line too long", __func__);
+			return BF_INVALID_ARG;
+		}
+		memcpy(line, cur, len);
+		line[len] = '\0';
+
+		if (strncmp(line, "port ", 5)) {
+			if (pipeline_iospec_add(inst, line))
+				return BF_NO_SYS_RESOURCES;
+			continue;
+		}
+
+		q = strstr(line, " rxq ");
+		if (!q)
+			q = strstr(line, " txq ");
+		if (!strstr(line, " ethdev ") || !q) {
+			LOG_ERROR("%s: only link ports can be shared by "
+				  "pipeline instances: %s", __func__, line);
+			return BF_NOT_SUPPORTED;
+		}
+
+		q += strlen(" rxq ");
+		end = q + strspn(q, "0123456789");
+		snprintf(out, sizeof(out), "%.*s%u%s", (int)(q - line), line,
+			 instance_id, end);
+		if (pipeline_iospec_add(inst, out))
+			return BF_NO_SYS_RESOURCES;
+	}
+
+	return BF_SUCCESS;
+}
+
+/**
+ * Migration hook of a pipeline: the profile records the core the pipeline
+ * runs on, whether it was moved through the API or by the load balancer.
+ */
+static void dal_pipeline_migrated(struct pipeline *pipe, uint32_t thread_id,
+				  void *arg)
+{
+	struct pipe_mgr_profile *profile = arg;
+
+	profile->core_id = thread_id;
+}
+
+static uint64_t dal_time_ms(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/**
+ * Generate the C code of the program from its spec and compile it into
+ * the shared library so_filepath. The intermediate files are c_filepath
+ * and o_filepath.
+ */
+static int dal_pipeline_lib_compile(FILE *spec_file,
+				    const char *include_dir,
+				    const char *c_filepath,
+				    const char *o_filepath,
+				    const char *so_filepath)
+{
+	char buffer[BUF_SIZE];
+	const char *err_msg;
+	uint32_t err_line;
+	FILE *fd = NULL;
+	int status;
+
+	fd = fopen(c_filepath, "w");
+	if (!fd) {
+		LOG_ERROR("%s line:%d  Cannot open file %s\n", __func__,
+			  __LINE__, c_filepath);
+		return BF_INTERNAL_ERROR;
+	}
+
+	status = rte_swx_pipeline_codegen(spec_file, fd, &err_line, &err_msg);
+	if (status) {
+		LOG_ERROR("%s line:%d Error %d at line %u: %s\n", __func__,
+			  __LINE__, status, err_line, err_msg);
+		fclose(fd);
+		return BF_UNEXPECTED;
+	}
+	fclose(fd);
+
+	memset(buffer, 0, sizeof(buffer));
+	snprintf(buffer, sizeof(buffer), "gcc -c " P4_OBJ_CFLAGS
+		 " -o %s %s -I %s", o_filepath, c_filepath, include_dir);
+	LOG_TRACE("Running command: %s\n", buffer);
+	status = system(buffer);
+	if (status) {
+		LOG_ERROR("%s line:%d  Command (%s) failed with exit code: %d, with errno: %d\n",
+			  __func__, __LINE__, buffer, status, errno);
+	}
+	// TODO: Ideally, we should check whether status is 0 below. But
+	// sometimes the returned status code is -1, even when the .o file is
+	// generated properly. Checking file existence is a temporary
+	// workaround. Need to further investigate and solve this issue.
+	fd = fopen(o_filepath, "r");
+	if (!fd) {
+		LOG_ERROR("%s line:%d  Cannot generate %s file\n",
+			  __func__, __LINE__, o_filepath);
+		return BF_INTERNAL_ERROR;
+	}
+	fclose(fd);
+
+	memset(buffer, 0, sizeof(buffer));
+	snprintf(buffer, sizeof(buffer), "gcc -shared %s -o %s",
+		 o_filepath, so_filepath);
+	LOG_TRACE("Running command: %s\n", buffer);
+	status = system(buffer);
+	if (status) {
+		LOG_ERROR("%s line:%d  Command (%s) failed with exit code: %d, with errno: %d\n",
+			  __func__, __LINE__, buffer, status, errno);
+	}
+	// TODO: Ideally, we should check whether status is 0 below. But
+	// sometimes we have the same issue like the one above for the .so
+	fd = fopen(so_filepath, "r");
+	if (!fd) {
+		LOG_ERROR("%s line:%d  Cannot generate %s file\n",
+			  __func__, __LINE__, so_filepath);
+		return BF_INTERNAL_ERROR;
+	}
+	fclose(fd);
+
+	return BF_SUCCESS;
+}
+
+/**
+ * Cache of the compiled programs
+ *
+ * The shared library of a program is kept in P4_OBJ_CACHE_PATH as
+ * <pipeline>-<hash>.so next to <pipeline>-<hash>.key, the hash being taken
+ * over the key: the DPDK version, the compiler flags, the include directory,
+ * the "gcc --version" output, a hash of the headers under the include
+ * directory and the spec. The compiler and the headers don't change under
+ * a running process, so their part of the key is computed by the first
+ * enable only. The I/O spec is not part of the key, the pipeline is built
+ * from it at run time and it doesn't change the generated code. A cache
+ * entry is used only when its key file matches the key byte for byte, so
+ * a hash collision or a truncated entry is a miss. Entries are written
+ * under temporary names then renamed, the library first, so that a reader
+ * never sees the key of a partially written library.
+ *
+ * The libraries are loaded into the process, hence the cache directory
+ * must belong to the current user and not be writable by others, otherwise
+ * the cache is not used. SDE_P4_NO_CACHE disables the cache.
+ */
+struct dal_lib_cache {
+	char *key;
+	size_t key_len;
+	char so_filepath[PATH_SIZE];
+	char key_filepath[PATH_SIZE];
+	char prefix[PATH_SIZE];
+};
+
+#define DAL_LIB_CACHE_HASH_INIT 0xcbf29ce484222325ULL
+
+/* 64-bit FNV-1a, hash is DAL_LIB_CACHE_HASH_INIT or the hash of the
+ * previous part of the buffer.
+ */
+static uint64_t dal_lib_cache_hash(uint64_t hash, const char *buf,
+				   size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		hash ^= (uint8_t)buf[i];
+		hash *= 0x100000001b3ULL;
+	}
+
+	return hash;
+}
+
+/* First lines of "gcc --version", which tell the compiler identity */
+static int dal_lib_cache_compiler_id(char *buf, size_t size)
+{
+	size_t len;
+	FILE *fd;
+
+	fd = popen("gcc --version 2>/dev/null", "r");
+	if (!fd)
+		return -1;
+
+	len = fread(buf, 1, size - 1, fd);
+	buf[len] = '\0';
+	if (pclose(fd) || !len)
+		return -1;
+
+	return 0;
+}
+
+/**
+ * Hash the path and content of the headers under dir, walked in name order
+ * so that the hash only changes with the headers.
+ */
+static int dal_lib_cache_headers_hash(const char *dir, uint64_t *hash)
+{
+	char path[PATH_SIZE], buf[BUF_SIZE];
+	struct dirent **names;
+	struct stat st;
+	int n, i, status = 0;
+	size_t len;
+	FILE *fd;
+
+	n = scandir(dir, &names, NULL, alphasort);
+	if (n < 0)
+		return -1;
+
+	for (i = 0; i < n; i++) {
+		len = strlen(names[i]->d_name);
+		if (status || names[i]->d_name[0] == '.')
+			goto next;
+
+		if (snprintf(path, sizeof(path), "%s/%s", dir,
+			     names[i]->d_name) >= (int)sizeof(path) ||
+		    lstat(path, &st)) {
+			status = -1;
+			goto next;
+		}
+
+		if (S_ISDIR(st.st_mode)) {
+			status = dal_lib_cache_headers_hash(path, hash);
+			goto next;
+		}
+
+		if (len < 2 || strcmp(&names[i]->d_name[len - 2], ".h") ||
+		    stat(path, &st) || !S_ISREG(st.st_mode))
+			goto next;
+
+		fd = fopen(path, "r");
+		if (!fd) {
+			status = -1;
+			goto next;
+		}
+
+		*hash = dal_lib_cache_hash(*hash, path, strlen(path) + 1);
+		while ((len = fread(buf, 1, sizeof(buf), fd)))
+			*hash = dal_lib_cache_hash(*hash, buf, len);
+		if (ferror(fd))
+			status = -1;
+		fclose(fd);
+next:
+		free(names[i]);
+	}
+	free(names);
+
+	return status;
+}
+
+/* Compiler identity and headers hash of the last include directory */
+struct dal_lib_cache_toolchain {
+	int valid;
+	char include_dir[PATH_SIZE];
+	char compiler_id[BUF_SIZE];
+	uint64_t headers_hash;
+};
+
+static struct dal_lib_cache_toolchain dal_lib_cache_toolchain;
+static pthread_mutex_t dal_lib_cache_toolchain_lock =
+	PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Get the compiler identity and the headers hash of include_dir, which
+ * fork gcc and read every header: they are only computed once.
+ */
+static int dal_lib_cache_toolchain_get(const char *include_dir,
+				       char *compiler_id,
+				       size_t size,
+				       uint64_t *hash)
+{
+	struct dal_lib_cache_toolchain *tc = &dal_lib_cache_toolchain;
+	int status = 0;
+
+	pthread_mutex_lock(&dal_lib_cache_toolchain_lock);
+
+	if (!tc->valid || strcmp(tc->include_dir, include_dir)) {
+		tc->valid = 0;
+		tc->headers_hash = DAL_LIB_CACHE_HASH_INIT;
+		if (strlen(include_dir) >= sizeof(tc->include_dir) ||
+		    dal_lib_cache_compiler_id(tc->compiler_id,
+					      sizeof(tc->compiler_id)) ||
+		    dal_lib_cache_headers_hash(include_dir,
+					       &tc->headers_hash)) {
+			status = -1;
+		} else {
+			strcpy(tc->include_dir, include_dir);
+			tc->valid = 1;
+		}
+	}
+
+	if (!status) {
+		snprintf(compiler_id, size, "%s", tc->compiler_id);
+		*hash = tc->headers_hash;
+	}
+
+	pthread_mutex_unlock(&dal_lib_cache_toolchain_lock);
+
+	return status;
+}
+
+static int dal_lib_cache_dir_check(void)
+{
+	struct stat st;
+
+	if (mkdir(P4_OBJ_CACHE_PATH, 0700) && errno != EEXIST)
+		return -1;
+
+	if (lstat(P4_OBJ_CACHE_PATH, &st) ||
+	    !S_ISDIR(st.st_mode) ||
+	    st.st_uid != geteuid() ||
+	    (st.st_mode & (S_IWGRP | S_IWOTH)))
+		return -1;
+
+	return 0;
+}
+
+/**
+ * Build the cache key of the program and the paths of its cache entry.
+ * The spec file is rewound for the code generator.
+ */
+static int dal_lib_cache_init(struct dal_lib_cache *cache,
+			      const char *pipeline_name,
+			      FILE *spec_file,
+			      const char *include_dir)
+{
+	char header[BUF_SIZE], compiler_id[BUF_SIZE];
+	uint64_t hash = DAL_LIB_CACHE_HASH_INIT;
+	size_t header_len;
+	long spec_len;
+
+	memset(cache, 0, sizeof(*cache));
+
+	if (getenv("SDE_P4_NO_CACHE") || dal_lib_cache_dir_check())
+		return -1;
+
+	/* The program is built against the compiler and the headers of the
+	 * install, a new toolchain or SDE install is a miss for the processes
+	 * started after it.
+	 */
+	if (dal_lib_cache_toolchain_get(include_dir, compiler_id,
+					sizeof(compiler_id), &hash))
+		return -1;
+
+	header_len = snprintf(header, sizeof(header),
+			      "%s\n%s\n%s\n%s\n%016" PRIx64 "\n",
+			      rte_version(), P4_OBJ_CFLAGS, include_dir,
+			      compiler_id, hash);
+	if (header_len >= sizeof(header))
+		return -1;
+
+	if (fseek(spec_file, 0, SEEK_END))
+		return -1;
+	spec_len = ftell(spec_file);
+	rewind(spec_file);
+	if (spec_len < 0)
+		return -1;
+
+	cache->key = P4_SDE_MALLOC(header_len + spec_len);
+	if (!cache->key)
+		return -1;
+
+	memcpy(cache->key, header, header_len);
+	if (fread(cache->key + header_len, 1, spec_len, spec_file) !=
+	    (size_t)spec_len) {
+		rewind(spec_file);
+		P4_SDE_FREE(cache->key);
+		cache->key = NULL;
+		return -1;
+	}
+	rewind(spec_file);
+	cache->key_len = header_len + spec_len;
+
+	hash = dal_lib_cache_hash(DAL_LIB_CACHE_HASH_INIT, cache->key,
+				  cache->key_len);
+	snprintf(cache->prefix, sizeof(cache->prefix), "%s/%s-",
+		 P4_OBJ_CACHE_PATH, pipeline_name);
+	snprintf(cache->so_filepath, sizeof(cache->so_filepath),
+		 "%s%016" PRIx64 ".so", cache->prefix, hash);
+	snprintf(cache->key_filepath, sizeof(cache->key_filepath),
+		 "%s%016" PRIx64 ".key", cache->prefix, hash);
+
+	return 0;
+}
+
+static void dal_lib_cache_free(struct dal_lib_cache *cache)
+{
+	P4_SDE_FREE(cache->key);
+	cache->key = NULL;
+}
+
+static int dal_lib_cache_lookup(struct dal_lib_cache *cache)
+{
+	char *key = NULL;
+	FILE *fd;
+	int hit = 0;
+
+	if (access(cache->so_filepath, R_OK))
+		return 0;
+
+	fd = fopen(cache->key_filepath, "r");
+	if (!fd)
+		return 0;
+
+	/* One more byte to catch a longer key */
+	key = P4_SDE_MALLOC(cache->key_len + 1);
+	if (key &&
+	    fread(key, 1, cache->key_len + 1, fd) == cache->key_len &&
+	    !memcmp(key, cache->key, cache->key_len))
+		hit = 1;
+
+	P4_SDE_FREE(key);
+	fclose(fd);
+	return hit;
+}
+
+static void dal_lib_cache_invalidate(struct dal_lib_cache *cache)
+{
+	unlink(cache->key_filepath);
+	unlink(cache->so_filepath);
+}
+
+/**
+ * Remove the entries of the other versions of the program. The temporary
+ * files of the entries being written don't match the patterns.
+ */
+static void dal_lib_cache_prune(struct dal_lib_cache *cache)
+{
+	static const char * const suffix[] = {".so", ".key"};
+	char pattern[PATH_SIZE];
+	glob_t g;
+	size_t i, k;
+
+	for (k = 0; k < RTE_DIM(suffix); k++) {
+		snprintf(pattern, sizeof(pattern), "%s*%s", cache->prefix,
+			 suffix[k]);
+		if (glob(pattern, 0, NULL, &g))
+			continue;
+
+		for (i = 0; i < g.gl_pathc; i++)
+			if (strcmp(g.gl_pathv[i], cache->so_filepath) &&
+			    strcmp(g.gl_pathv[i], cache->key_filepath))
+				unlink(g.gl_pathv[i]);
+
+		globfree(&g);
+	}
+}
+
+/**
+ * Compile the program into the cache entry. On failure, the program is
+ * not cached but the library may still be in so_tmp_filepath.
+ */
+static int dal_lib_cache_store(struct dal_lib_cache *cache,
+			       FILE *spec_file,
+			       const char *include_dir,
+			       char *so_tmp_filepath)
+{
+	char c_filepath[PATH_SIZE], o_filepath[PATH_SIZE];
+	char key_tmp_filepath[PATH_SIZE];
+	FILE *fd;
+	int status;
+
+	/* Other processes may be filling in the same entry */
+	snprintf(c_filepath, PATH_SIZE, "%s.%d.c", cache->so_filepath,
+		 getpid());
+	snprintf(o_filepath, PATH_SIZE, "%s.%d.o", cache->so_filepath,
+		 getpid());
+	snprintf(so_tmp_filepath, PATH_SIZE, "%s.%d", cache->so_filepath,
+		 getpid());
+	snprintf(key_tmp_filepath, PATH_SIZE, "%s.%d", cache->key_filepath,
+		 getpid());
+
+	status = dal_pipeline_lib_compile(spec_file, include_dir, c_filepath,
+					  o_filepath, so_tmp_filepath);
+	unlink(c_filepath);
+	unlink(o_filepath);
+	if (status)
+		return status;
+
+	fd = fopen(key_tmp_filepath, "w");
+	if (!fd)
+		return BF_SUCCESS;
+
+	if (fwrite(cache->key, 1, cache->key_len, fd) != cache->key_len) {
+		fclose(fd);
+		unlink(key_tmp_filepath);
+		return BF_SUCCESS;
+	}
+	fclose(fd);
+
+	if (rename(so_tmp_filepath, cache->so_filepath)) {
+		unlink(key_tmp_filepath);
+		return BF_SUCCESS;
+	}
+	snprintf(so_tmp_filepath, PATH_SIZE, "%s", cache->so_filepath);
+
+	if (rename(key_tmp_filepath, cache->key_filepath)) {
+		unlink(key_tmp_filepath);
+		return BF_SUCCESS;
+	}
+
+	dal_lib_cache_prune(cache);
+	return BF_SUCCESS;
+}
+
+/**
+ * Get the shared library of the program of a pipeline into so_filepath,
+ * from the cache when the program was already compiled.
+ */
+static int dal_pipeline_lib_get(struct pipeline *pipe,
+				struct dal_lib_cache *cache,
+				FILE *spec_file,
+				const char *include_dir,
+				char *so_filepath,
+				int *cached)
+{
+	char c_filepath[PATH_SIZE], o_filepath[PATH_SIZE];
+	uint64_t start = dal_time_ms();
+	int status;
+
+	*cached = 0;
+
+	if (!cache->key) {
+		snprintf(c_filepath, PATH_SIZE, "%s.c", P4_OBJ_FILE_PATH);
+		snprintf(o_filepath, PATH_SIZE, "%s.o", P4_OBJ_FILE_PATH);
+		snprintf(so_filepath, PATH_SIZE, "%s.so", P4_OBJ_FILE_PATH);
+		status = dal_pipeline_lib_compile(spec_file, include_dir,
+						  c_filepath, o_filepath,
+						  so_filepath);
+	} else if (dal_lib_cache_lookup(cache)) {
+		snprintf(so_filepath, PATH_SIZE, "%s", cache->so_filepath);
+		*cached = 1;
+		status = BF_SUCCESS;
+	} else {
+		status = dal_lib_cache_store(cache, spec_file, include_dir,
+					     so_filepath);
+	}
+
+	if (status)
+		return status;
+
+	LOG_TRACE("Pipeline %s: program %s %s in %" PRIu64 " ms",
+		  pipe->name, so_filepath,
+		  *cached ? "found in cache" : "compiled",
+		  dal_time_ms() - start);
+	return BF_SUCCESS;
+}
+
+/**
+ * Build a pipeline from the shared library of its program and its iospec.
+ */
+static int dal_pipeline_build(struct pipeline *pipe,
+			      const char *so_filepath)
+{
+	FILE *fd = NULL;
+	int status;
+
+	fd = pipeline_iospec_open(pipe);
+	if (!fd) {
+		LOG_ERROR("%s line:%d  Cannot open iospec of %s\n",
+			  __func__, __LINE__, pipe->name);
+		return BF_INTERNAL_ERROR;
+	}
+
+	status = rte_swx_pipeline_build_from_lib(&pipe->p, pipe->name,
+						 so_filepath, fd,
+						 pipe->numa_node);
+	fclose(fd);
+	if (status) {
+		LOG_ERROR("%s line:%d  Pipeline %s build failed\n",
+			  __func__, __LINE__, pipe->name);
+		return BF_INTERNAL_ERROR;
+	}
+
+	return BF_SUCCESS;
+}
+
+/**
+ * Build a secondary instance of a pipeline from the shared library of the
+ * program.
+ */
+static int dal_pipeline_instance_build(struct pipeline *pipe,
+				       uint32_t instance_id,
+				       const char *so_filepath)
+{
+	struct pipeline *inst = pipe->instance[instance_id];
+	int status;
+
+	status = dal_iospec_instance_write(pipe, instance_id);
+	if (status)
+		return status;
+
+	dal_iospec_dump(inst);
+
+	return dal_pipeline_build(inst, so_filepath);
+}
+
 /**
  * Trigger from bf_shell which call bf-rt api at runtime.
  */
@@ -53,17 +707,15 @@ int dal_enable_pipeline(bf_dev_id_t dev_id,
 		enum bf_dev_init_mode_s warm_init_mode)
 {
 	struct pipe_mgr_profile *profile;
-	struct pipeline *pipe;
-	const char *err_msg;
-	uint32_t err_line;
+	struct pipeline *pipe, *inst;
 	int status, j;
-	uint32_t i, n_ports;
+	uint32_t i, k, n_ports;
 	struct rte_swx_ctl_pipeline_info pipeline;
-	uint64_t net_port_mask;
-	char c_filepath[PATH_SIZE], o_filepath[PATH_SIZE];
+	uint64_t net_port_mask, start = dal_time_ms();
 	char i_filepath[PATH_SIZE], so_filepath[PATH_SIZE];
-	char buffer[BUF_SIZE], *install_dir;
-	FILE *fd = NULL;
+	struct dal_lib_cache cache;
+	char *install_dir;
+	int cached;
 
 	LOG_TRACE("Entering %s dev_id %d init_mode %d",
 			__func__, dev_id, warm_init_mode);
@@ -84,148 +736,284 @@ int dal_enable_pipeline(bf_dev_id_t dev_id,
 		return BF_OBJECT_NOT_FOUND;
 	}
 
-	snprintf(c_filepath, sizeof(c_filepath), "%s.c", P4_OBJ_FILE_PATH);
-	snprintf(o_filepath, sizeof(o_filepath), "%s.o", P4_OBJ_FILE_PATH);
-	snprintf(so_filepath, sizeof(so_filepath), "%s.so", P4_OBJ_FILE_PATH);
-
-	fd = fopen(c_filepath, "w");
-	if (!fd) {
-		LOG_ERROR("%s line:%d  Cannot open file %s\n", __func__,
-			  __LINE__, c_filepath);
-		return BF_INTERNAL_ERROR;
-	}
-
-	status = rte_swx_pipeline_codegen(spec_file, fd, &err_line, &err_msg);
-	if (status) {
-		LOG_ERROR("%s line:%d Error %d at line %u: %s\n", __func__,
-			  __LINE__, status, err_line, err_msg);
-		fclose(fd);
-		return BF_UNEXPECTED;
-	}
-	fclose(fd);
-
 	install_dir = getenv("SDE_INSTALL");
 	if (install_dir) {
 		memset(i_filepath, 0, sizeof(i_filepath));
 		snprintf(i_filepath, sizeof(i_filepath), "%s/include/"
 			 , install_dir);
 
-		memset(buffer, 0, sizeof(buffer));
-		snprintf(buffer, sizeof(buffer), "gcc -c -O3 -fpic "
-			 "-Wno-deprecated-declarations -o %s %s -I %s",
-			 o_filepath, c_filepath, i_filepath);
-		LOG_TRACE("Running command: %s\n", buffer);
-		status = system(buffer);
-		if (status) {
-			LOG_ERROR("%s line:%d  Command (%s) failed with exit code: %d, with errno: %d\n",
-				  __func__, __LINE__, buffer, status, errno);
-		}
-		// TODO: Ideally, we should check whether status is 0 below. But
-		// sometimes the returned status code is -1, even when the .o file is
-		// generated properly. Checking file existence is a temporary
-		// workaround. Need to further investigate and solve this issue.
-		fd = fopen(o_filepath, "r");
-		if (!fd) {
-			LOG_ERROR("%s line:%d  Cannot generate %s file\n",
-				  __func__, __LINE__, o_filepath);
-			return BF_INTERNAL_ERROR;
+		/* Spare ports for the ports added once the pipeline runs */
+		if (pipe->n_slots) {
+			if (pipe->n_instances > 1) {
+				LOG_ERROR("%s: pipeline %s can't have both "
+					  "instances and reserved ports",
+					  __func__, pipe->name);
+				return BF_NOT_SUPPORTED;
+			}
+
+			if (pipeline_slots_reserve(pipe)) {
+				LOG_ERROR("%s: cannot reserve %u ports of "
+					  "pipeline %s", __func__,
+					  pipe->n_slots, pipe->name);
+				return BF_NO_SYS_RESOURCES;
+			}
 		}
 
-		memset(buffer, 0, sizeof(buffer));
-		snprintf(buffer, sizeof(buffer), "gcc -shared %s -o %s",
-			 o_filepath, so_filepath);
-		LOG_TRACE("Running command: %s\n", buffer);
-		status = system(buffer);
+		dal_lib_cache_init(&cache, pipe->name, spec_file, i_filepath);
+		status = dal_pipeline_lib_get(pipe, &cache, spec_file,
+					      i_filepath, so_filepath,
+					      &cached);
 		if (status) {
-			LOG_ERROR("%s line:%d  Command (%s) failed with exit code: %d, with errno: %d\n",
-				  __func__, __LINE__, buffer, status, errno);
+			dal_lib_cache_free(&cache);
+			return status;
 		}
-		// TODO: Ideally, we should check whether status is 0 below. But
-		// sometimes we have the same issue like the one above for the .so
-		fd = fopen(so_filepath, "r");
-		if (!fd) {
-			LOG_ERROR("%s line:%d  Cannot generate %s file\n",
-				  __func__, __LINE__, so_filepath);
-			return BF_INTERNAL_ERROR;
+
+		dal_iospec_dump(pipe);
+
+		status = dal_pipeline_build(pipe, so_filepath);
+
+		/* A cached library that no longer loads is compiled again */
+		if (status && cached) {
+			LOG_WARN("%s: dropping cached program %s of pipeline %s",
+				 __func__, so_filepath, pipe->name);
+			dal_lib_cache_invalidate(&cache);
+			status = dal_pipeline_lib_get(pipe, &cache, spec_file,
+						      i_filepath, so_filepath,
+						      &cached);
+			if (!status)
+				status = dal_pipeline_build(pipe, so_filepath);
 		}
-		fclose(fd);
+		dal_lib_cache_free(&cache);
+		if (status)
+			return status;
 
-		fd = fopen(IOSPEC_FILE_PATH, "r");
-		if (!fd) {
-			LOG_ERROR("%s line:%d  Cannot open %s file\n",
-				  __func__, __LINE__, IOSPEC_FILE_PATH);
-			return BF_INTERNAL_ERROR;
-		}
-		status = rte_swx_pipeline_build_from_lib(&pipe->p,
-							 profile->pipeline_name,
-							 so_filepath, fd,
-							 pipe->numa_node);
-		if (status) {
-			LOG_ERROR("%s line:%d  Pipeline build failed\n",
-				  __func__, __LINE__);
-			fclose(fd);
-			return BF_INTERNAL_ERROR;
+		/* Secondary instances run the same program on their own
+		 * queues of the link ports.
+		 */
+		for (k = 1; k < pipe->n_instances; k++) {
+			status = dal_pipeline_instance_build(pipe, k,
+							     so_filepath);
+			if (status)
+				return status;
 		}
-		fclose(fd);
+	} else if (pipe->n_instances > 1) {
+		LOG_ERROR("%s: pipeline %s instances need SDE_INSTALL",
+			  __func__, profile->pipeline_name);
+		return BF_NOT_SUPPORTED;
 	}
 
-	rte_swx_ctl_pipeline_info_get(pipe->p, &pipeline);
-	if (strncmp(profile->pipe_ctx.arch_name, "pna", 3))
-		goto create_pipeline;
+	status = dal_meter_init(&profile->pipe_ctx);
+	if (status) {
+		LOG_ERROR("meter profile pool init failed");
+		return status;
+	}
+
+	for (k = 0; k < pipe->n_instances; k++) {
+		inst = pipe->instance[k];
+
+		rte_swx_ctl_pipeline_info_get(inst->p, &pipeline);
+		if (strncmp(profile->pipe_ctx.arch_name, "pna", 3))
+			goto create_pipeline;
+
+		n_ports = pipeline.n_ports_in > pipeline.n_ports_out ?
+			pipeline.n_ports_in : pipeline.n_ports_out;
+		for (i = 0; i < n_ports; i++) {
+			net_port_mask = pipe->net_port_mask[i / 64];
+			if (net_port_mask & (1ULL << (i % 64))) {
+				status = rte_swx_ctl_pipeline_regarray_write
+					(inst->p, PNA_DIR_REG_NAME, i, 0);
+				if (status)
+					LOG_ERROR("set 0 to dir_reg failed Err:%d\n",
+						  status);
+			} else {
+				status = rte_swx_ctl_pipeline_regarray_write
+					(inst->p, PNA_DIR_REG_NAME, i, 1);
+				if (status)
+					LOG_ERROR("set 1 to dir_reg failed Err:%d\n",
+						  status);
+			}
+		}
+
+create_pipeline:
+		inst->ctl = rte_swx_ctl_pipeline_create(inst->p);
+		if (!inst->ctl) {
+			LOG_ERROR("Pipeline control create failed.");
+			rte_swx_pipeline_free(inst->p);
+			inst->p = NULL;
+			return BF_UNEXPECTED;
+		}
 
-	n_ports = pipeline.n_ports_in > pipeline.n_ports_out ?
-		pipeline.n_ports_in : pipeline.n_ports_out;
-	for (i = 0; i < n_ports; i++) {
-		net_port_mask = pipe->net_port_mask[i / 64];
-		if (net_port_mask & (1 << i)) {
-			status = rte_swx_ctl_pipeline_regarray_write
-				(pipe->p, PNA_DIR_REG_NAME, i, 0);
+		/* Instance k runs on the k-th core after the pipeline core. */
+		status = thread_pipeline_enable(profile->core_id + k,
+						inst->name,
+						profile->instr_quanta,
+						profile->instr_quanta_adaptive);
+		if (status) {
+			LOG_ERROR("error :thread pipeline enable");
+			return BF_UNEXPECTED;
+		}
+
+		if (!k)
+			pipeline_migrate_cb_set(inst->name,
+						dal_pipeline_migrated, profile);
+
+		/* Cross-socket accesses to the pipeline tables and mbufs */
+		if (rte_lcore_to_socket_id(profile->core_id + k) !=
+		    pipe->numa_node)
+			LOG_WARN("Pipeline %s is on NUMA node %u but runs on "
+				 "core %d of node %u\n", inst->name,
+				 pipe->numa_node, profile->core_id + k,
+				 rte_lcore_to_socket_id(profile->core_id + k));
+
+		if (profile->idle_cfg.policy != THREAD_IDLE_NONE) {
+			struct thread_idle_params idle = {
+				.mode = profile->idle_cfg.policy,
+				.threshold = profile->idle_cfg.threshold,
+				.backoff_us = profile->idle_cfg.backoff_us,
+			};
+
+			status = thread_idle_set(profile->core_id + k, &idle);
 			if (status)
-				LOG_ERROR("set 0 to dir_reg failed Err:%d\n",
-					  status);
-		} else {
-			status = rte_swx_ctl_pipeline_regarray_write
-				(pipe->p, PNA_DIR_REG_NAME, i, 1);
+				LOG_ERROR("set idle policy failed on core %d\n",
+					  profile->core_id + k);
+		}
+
+		/* The balancer moves pipelines one at a time, which would
+		 * break the core of each instance of a sharded pipeline.
+		 */
+		if (profile->balance_cfg.threshold && pipe->n_instances > 1) {
+			if (!k)
+				LOG_WARN("%s: sharded pipeline %s is not "
+					 "balanced", __func__, pipe->name);
+		} else if (profile->balance_cfg.threshold) {
+			struct pipeline_balance_params balance = {
+				.threshold = profile->balance_cfg.threshold,
+				.hysteresis = profile->balance_cfg.hysteresis,
+				.hold = profile->balance_cfg.hold,
+			};
+
+			status = pipeline_balance_set(inst->name, &balance);
 			if (status)
-				LOG_ERROR("set 1 to dir_reg failed Err:%d\n",
-					  status);
+				LOG_ERROR("set load balancing of %s failed\n",
+					  inst->name);
+		}
+		// SET the CT timer values from conf file
+		if (profile->num_ct_timer_profiles) {
+			for (i = 0; i < pipeline.n_learners; i++) {
+				for (j = 0; j < profile->num_ct_timer_profiles; j++ ) {
+					if (profile->bf_ct_timeout[j] <= 0) {
+						LOG_TRACE("Timer with Negative not allowed %d\n",
+								profile->bf_ct_timeout[j]);
+						continue;
+					}
+					status = rte_swx_ctl_pipeline_learner_timeout_set(inst->p,
+							i, j, profile->bf_ct_timeout[j]);
+					if (status) {
+						LOG_ERROR("set CT timer failed for id %d "
+								"value %d\n", j,
+								profile->bf_ct_timeout[j]);
+					}
+				}
+			}
 		}
 	}
 
-create_pipeline:
-	pipe->ctl = rte_swx_ctl_pipeline_create(pipe->p);
-	if (!pipe->ctl) {
-		LOG_ERROR("Pipeline control create failed.");
-		rte_swx_pipeline_free(pipe->p);
+	LOG_TRACE("Pipeline %s enabled in %" PRIu64 " ms",
+		  pipe->name, dal_time_ms() - start);
+	LOG_TRACE("Exit %s", __func__);
+	return BF_SUCCESS;
+}
+
+int dal_pipeline_thread_stats_get(struct bf_dev_target_t dev_tgt,
+				  pipe_mgr_pipeline_thread_stats_t *stats)
+{
+	struct thread_pipeline_stats p_stats;
+	struct pipe_mgr_profile *profile;
+	struct thread_stats t_stats;
+	int status;
+
+	status = pipe_mgr_get_profile(dev_tgt.device_id,
+				      dev_tgt.dev_pipe_id, &profile);
+	if (status) {
+		LOG_ERROR("not able find profile with device_id  %d",
+			  dev_tgt.device_id);
+		return status;
+	}
+
+	if (thread_pipeline_stats_read(profile->pipeline_name, &p_stats)) {
+		LOG_ERROR("%s: failed to find pipeline %s", __func__,
+			  profile->pipeline_name);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	if (!p_stats.enabled)
+		return BF_NOT_READY;
+
+	if (thread_stats_read(p_stats.thread_id, &t_stats)) {
+		LOG_ERROR("%s: failed to read thread %d", __func__,
+			  p_stats.thread_id);
 		return BF_UNEXPECTED;
 	}
 
-	status = thread_pipeline_enable(profile->core_id,
-					profile->pipeline_name);
+	stats->thread_id = p_stats.thread_id;
+	stats->tsc_hz = t_stats.tsc_hz;
+	stats->thread_cycles = t_stats.cycles;
+	stats->thread_iterations = t_stats.n_iterations;
+	stats->thread_run_cycles = t_stats.run_cycles;
+	stats->thread_ctrl_cycles = t_stats.ctrl_cycles;
+	stats->thread_ctrl_msgs = t_stats.n_ctrl_msgs;
+	stats->pipeline_runs = p_stats.n_runs;
+	stats->pipeline_run_cycles = p_stats.run_cycles;
+	stats->pipeline_pkts_in = p_stats.n_pkts_in;
+	stats->pipeline_empty_polls = p_stats.n_empty_polls;
+	return BF_SUCCESS;
+}
+
+int dal_pipeline_migrate(struct bf_dev_target_t dev_tgt, uint32_t core_id)
+{
+	struct pipe_mgr_profile *profile;
+	struct pipeline *pipe;
+	uint32_t src_core_id;
+	uint32_t k;
+	int status;
+
+	status = pipe_mgr_get_profile(dev_tgt.device_id,
+				      dev_tgt.dev_pipe_id, &profile);
 	if (status) {
-		LOG_ERROR("error :thread pipeline enable");
-		return BF_UNEXPECTED;
+		LOG_ERROR("not able find profile with device_id  %d",
+			  dev_tgt.device_id);
+		return status;
 	}
-	// SET the CT timer values from conf file
-	if (profile->num_ct_timer_profiles) {
-		for (i = 0; i < pipeline.n_learners; i++) {
-			for (j = 0; j < profile->num_ct_timer_profiles; j++ ) {
-				if (profile->bf_ct_timeout[j] <= 0) {
-					LOG_TRACE("Timer with Negative not allowed %d\n",
-							profile->bf_ct_timeout[j]);
-					continue;
-				}
-				status = rte_swx_ctl_pipeline_learner_timeout_set(pipe->p,
-						i, j, profile->bf_ct_timeout[j]);
-				if (status) {
-					LOG_ERROR("set CT timer failed for id %d "
-							"value %d\n", j,
-							profile->bf_ct_timeout[j]);
-				}
-			}
+
+	pipe = pipeline_find(profile->pipeline_name);
+	if (!pipe) {
+		LOG_ERROR("dpdk pipeline %s get failed",
+			  profile->pipeline_name);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	/* Instance k keeps running on the k-th core after the pipeline core,
+	 * the instances moved are moved back if one of them can't be. The
+	 * core of the profile follows the first instance, through its
+	 * migration hook.
+	 */
+	src_core_id = profile->core_id;
+	thread_pipeline_migrate_lock();
+	for (k = 0; k < pipe->n_instances; k++) {
+		status = thread_pipeline_migrate(pipe->instance[k]->name,
+						 core_id + k);
+		if (status) {
+			LOG_ERROR("%s: failed to move pipeline %s to core %u",
+				  __func__, pipe->instance[k]->name,
+				  core_id + k);
+			while (k--)
+				thread_pipeline_migrate(pipe->instance[k]->name,
+							src_core_id + k);
+			thread_pipeline_migrate_unlock();
+			return BF_UNEXPECTED;
 		}
 	}
+	thread_pipeline_migrate_unlock();
 
-	LOG_TRACE("Exit %s", __func__);
 	return BF_SUCCESS;
 }
@@ -155,21 +155,8 @@ int dal_table_ent_add(u32 sess_hdl,
 		}
 	}
 
-	status = rte_swx_ctl_pipeline_table_entry_add(pipe->ctl, mat_ctx->target_table_name
-						      , entry);
-
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_table_entry_add");
-		status = BF_UNEXPECTED;
-		goto error;
-	}
-
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		status = BF_UNEXPECTED;
-		goto error;
-	}
+	status = dal_dpdk_table_entry_write(pipe, mat_ctx->target_table_name,
+					    entry, DAL_DPDK_TABLE_ENTRY_ADD);
 
 error:
 	table_entry_free(entry);
@@ -285,22 +272,8 @@ int dal_table_default_ent_add(u32 sess_hdl,
 		}
 	}
 
-	status = rte_swx_ctl_pipeline_table_default_entry_add(pipe->ctl,
-							      mat_ctx->name,
-							      entry);
-
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_table_entry_add");
-		status = BF_UNEXPECTED;
-		goto error;
-	}
-
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		status = BF_UNEXPECTED;
-		goto error;
-	}
+	status = dal_dpdk_table_entry_write(pipe, mat_ctx->name, entry,
+					    DAL_DPDK_TABLE_DEFAULT_ENTRY_ADD);
 
 error:
 	table_entry_free(entry);
@@ -364,19 +337,9 @@ int dal_table_ent_del_by_match_spec(u32 sess_hdl,
 		goto exit;
 	}
 
-	status = rte_swx_ctl_pipeline_table_entry_delete(ctl, mat_ctx->name,
-							 entry);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_table_entry_add");
-		status = BF_UNEXPECTED;
-		goto exit;
-	}
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		status = BF_UNEXPECTED;
-		goto exit;
-	}
+	status = dal_dpdk_table_entry_write(stage_table->table_meta->pipe,
+					    mat_ctx->name, entry,
+					    DAL_DPDK_TABLE_ENTRY_DELETE);
 
 exit:
 	table_entry_free(entry);
@@ -420,6 +383,11 @@ int dal_mat_get_first_entry(u32 sess_hdl,
 			    u32 *act_fn_hdl,
 		            struct pipe_mgr_mat_ctx *mat_ctx)
 {
+	/* Only learner tables are read back from the target, and
+	 * rte_swx_ctl has no API to walk the entries the pipeline learnt.
+	 */
+	LOG_TRACE("table %s entries can not be read from the pipeline",
+		  mat_ctx->name);
 	return BF_NOT_SUPPORTED;
 }
 
@@ -434,5 +402,223 @@ int dal_mat_get_next_n_by_key(u32 sess_hdl,
 			       u32 *num,
 		               struct pipe_mgr_mat_ctx *mat_ctx)
 {
+	LOG_TRACE("table %s entries can not be read from the pipeline",
+		  mat_ctx->name);
 	return BF_NOT_SUPPORTED;
 }
+
+/* Find the counter extern bound to a MatchAction table. */
+static struct pipe_mgr_externs_ctx *
+dal_mat_hit_counter_get(struct pipe_mgr_p4_pipeline *ctx_obj,
+			struct pipe_mgr_mat_ctx *mat_ctx)
+{
+	struct pipe_mgr_externs_ctx *externs_entry;
+	int itr;
+
+	for (itr = 0; itr < ctx_obj->num_externs_tables; itr++) {
+		externs_entry =
+			bf_hashtbl_search(ctx_obj->bf_externs_htbl,
+					  ctx_obj->externs_tables_name[itr]);
+		if (!externs_entry ||
+		    externs_entry->externs_attr_table_id != mat_ctx->handle)
+			continue;
+		if (externs_entry->type != EXTERNS_COUNTER &&
+		    externs_entry->type != EXTERNS_DIRECT_COUNTER)
+			continue;
+		if (externs_entry->attr_type != EXTERNS_ATTR_TYPE_BYTES &&
+		    externs_entry->attr_type != EXTERNS_ATTR_TYPE_PACKETS)
+			continue;
+		return externs_entry;
+	}
+	return NULL;
+}
+
+int dal_mat_ent_hit_cnt_read(struct bf_dev_target_t dev_tgt,
+			     struct pipe_mgr_mat_ctx *mat_ctx,
+			     int n,
+			     struct pipe_tbl_match_spec **match_specs,
+			     u64 *hit_cnts)
+{
+	struct pipe_mgr_externs_ctx *externs_entry;
+	struct pipe_mgr_p4_pipeline *ctx_obj;
+	struct pipe_mgr_profile *profile;
+	struct pipeline *pipe;
+	int status;
+	int i;
+
+	status = pipe_mgr_get_profile(dev_tgt.device_id,
+				      dev_tgt.dev_pipe_id, &profile);
+	if (status) {
+		LOG_ERROR("profile not found with device_id  %d",
+			  dev_tgt.device_id);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	pipe = pipeline_find(profile->pipeline_name);
+	if (!pipe) {
+		LOG_ERROR("dpdk pipeline %s get failed",
+			  profile->pipeline_name);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	status = pipe_mgr_get_profile_ctx(dev_tgt, &ctx_obj);
+	if (status) {
+		LOG_ERROR("context object not found for a profile");
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	/* rte_swx tables have no per entry hit bits, the direct counter
+	 * of the table serves as the hit indication.
+	 */
+	externs_entry = dal_mat_hit_counter_get(ctx_obj, mat_ctx);
+	if (!externs_entry) {
+		LOG_TRACE("table %s has no direct counter to track hits",
+			  mat_ctx->name);
+		return BF_NOT_SUPPORTED;
+	}
+
+	/* An entry is hit when any instance of the pipeline hits it. */
+	for (i = 0; i < n; i++) {
+		status = dal_dpdk_regarray_read_with_key(
+				pipe, externs_entry->target_name,
+				mat_ctx->target_table_name,
+				match_specs[i]->match_value_bits,
+				&hit_cnts[i]);
+		if (status) {
+			LOG_ERROR("hit count read failed for table %s "
+				  "with error %d", mat_ctx->name, status);
+			return BF_UNEXPECTED;
+		}
+	}
+
+	return BF_SUCCESS;
+}
+
+int dal_learner_timeout_set(struct bf_dev_target_t dev_tgt,
+			    u32 timeout_id,
+			    u32 timeout)
+{
+	struct rte_swx_ctl_pipeline_info pipeline;
+	struct rte_swx_ctl_learner_info learner;
+	struct pipe_mgr_profile *profile;
+	struct pipeline *pipe;
+	int prev_timeout = 0;
+	int status;
+	u32 i, k;
+
+	if (timeout_id >= MAX_CT_TIMER_PROFILES || !timeout) {
+		LOG_ERROR("invalid learner timer profile %d timeout %d",
+			  timeout_id, timeout);
+		return BF_INVALID_ARG;
+	}
+
+	status = pipe_mgr_get_profile(dev_tgt.device_id,
+				      dev_tgt.dev_pipe_id, &profile);
+	if (status) {
+		LOG_ERROR("profile not found with device_id  %d",
+			  dev_tgt.device_id);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	pipe = pipeline_find(profile->pipeline_name);
+	if (!pipe || !pipe->p) {
+		LOG_ERROR("dpdk pipeline %s get failed",
+			  profile->pipeline_name);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	status = rte_swx_ctl_pipeline_info_get(pipe->p, &pipeline);
+	if (status) {
+		LOG_ERROR("dpdk pipeline %s info get failed",
+			  profile->pipeline_name);
+		return BF_UNEXPECTED;
+	}
+
+	/* Check every learner of every instance before changing any of
+	 * them, so that the timeout is set everywhere or nowhere.
+	 */
+	for (k = 0; k < pipe->n_instances; k++) {
+		for (i = 0; i < pipeline.n_learners; i++) {
+			status = rte_swx_ctl_learner_info_get(
+					pipe->instance[k]->p, i, &learner);
+			if (status) {
+				LOG_ERROR("learner %d info get failed", i);
+				return BF_UNEXPECTED;
+			}
+			if (timeout_id >= learner.n_key_timeouts) {
+				LOG_ERROR("learner %s has no timer profile %d",
+					  learner.name, timeout_id);
+				return BF_INVALID_ARG;
+			}
+		}
+	}
+
+	if ((int)timeout_id < profile->num_ct_timer_profiles)
+		prev_timeout = profile->bf_ct_timeout[timeout_id];
+
+	for (k = 0; k < pipe->n_instances; k++) {
+		for (i = 0; i < pipeline.n_learners; i++) {
+			status = rte_swx_ctl_pipeline_learner_timeout_set(
+					pipe->instance[k]->p,
+					i, timeout_id, timeout);
+			if (status) {
+				LOG_ERROR("set CT timer failed for learner %d "
+					  "id %d value %d", i, timeout_id,
+					  timeout);
+				goto rollback;
+			}
+		}
+	}
+
+	/* Keep the profile in sync, the pipeline is rebuilt from it. */
+	profile->bf_ct_timeout[timeout_id] = timeout;
+	if (profile->num_ct_timer_profiles <= (int)timeout_id)
+		profile->num_ct_timer_profiles = timeout_id + 1;
+
+	return BF_SUCCESS;
+
+rollback:
+	/* The learners still run with the timeout of the profile, put it
+	 * back on the ones already changed. Without one the timeout comes
+	 * from the spec file and can't be read back.
+	 */
+	if (prev_timeout <= 0) {
+		LOG_ERROR("learner timer profile %d left partially set",
+			  timeout_id);
+		return BF_UNEXPECTED;
+	}
+	for (k = 0; k < pipe->n_instances; k++)
+		for (i = 0; i < pipeline.n_learners; i++)
+			rte_swx_ctl_pipeline_learner_timeout_set(
+					pipe->instance[k]->p,
+					i, timeout_id, prev_timeout);
+	return BF_UNEXPECTED;
+}
+
+int dal_learner_timeout_get(struct bf_dev_target_t dev_tgt,
+			    u32 timeout_id,
+			    u32 *timeout)
+{
+	struct pipe_mgr_profile *profile;
+	int status;
+
+	if (timeout_id >= MAX_CT_TIMER_PROFILES) {
+		LOG_ERROR("invalid learner timer profile %d", timeout_id);
+		return BF_INVALID_ARG;
+	}
+
+	status = pipe_mgr_get_profile(dev_tgt.device_id,
+				      dev_tgt.dev_pipe_id, &profile);
+	if (status) {
+		LOG_ERROR("profile not found with device_id  %d",
+			  dev_tgt.device_id);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	if ((int)timeout_id >= profile->num_ct_timer_profiles ||
+	    profile->bf_ct_timeout[timeout_id] <= 0)
+		return BF_OBJECT_NOT_FOUND;
+
+	*timeout = profile->bf_ct_timeout[timeout_id];
+	return BF_SUCCESS;
+}
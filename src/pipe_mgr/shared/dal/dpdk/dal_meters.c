@@ -0,0 +1,695 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file dal_meters.c
+ *
+ * @description Utilities for meters
+ */
+#include <infra/dpdk_infra.h>
+#include "../dal_meters.h"
+#include "../../pipe_mgr_shared_intf.h"
+#include <pipe_mgr/shared/pipe_mgr_mat.h>
+#include <pipe_mgr/core/pipe_mgr_ctx_json.h>
+#include <pipe_mgr/pipe_mgr_intf.h>
+
+#define DAL_METER_PROFILE_NAME_LEN 64
+#define DAL_METER_PROFILE_PREFIX "pipe_mgr_mp"
+/* pipe_mgr meter rates are in kbps and bursts in kbits, the DPDK
+ * trTCM meter expects bytes/s and bytes respectively.
+ */
+#define DAL_METER_KBITS_TO_BYTES(k) ((k) * 1000 / 8)
+#define DAL_METER_BYTES_TO_KBITS(b) ((b) * 8 / 1000)
+
+/* Key used to dedup meter profiles, in DPDK units. */
+struct dal_meter_profile_key {
+	uint64_t cir;
+	uint64_t pir;
+	uint64_t cbs;
+	uint64_t pbs;
+};
+
+/* DPDK meter profile shared by all the meter indexes with same spec. */
+struct dal_meter_profile {
+	struct dal_meter_profile_key key;
+	char name[DAL_METER_PROFILE_NAME_LEN];
+	uint32_t ref_cnt;
+};
+
+/* Meter index to profile binding of a DPDK meter array. */
+struct dal_meter_array {
+	char name[P4_SDE_TABLE_NAME_LEN];
+	p4_sde_map idx_map;
+	struct dal_meter_array *next;
+};
+
+struct dal_meter_ctx {
+	/* Protects the profile pool and the meter array bindings. */
+	p4_sde_mutex lock;
+	bf_hashtable_t prof_htbl;
+	struct dal_meter_array *arrays;
+	uint32_t next_prof_id;
+};
+
+static int dal_meter_prof_key_cmp_fn(const void *arg, const void *key1)
+{
+	struct dal_meter_profile *prof = NULL;
+
+	if (!key1 || !arg)
+		return (-1);
+
+	prof = bf_hashtbl_get_cmp_data(key1);
+	if (!prof)
+		return (-1);
+
+	return memcmp(arg, &prof->key, sizeof(prof->key));
+}
+
+static void dal_meter_prof_free_htbl_node(void *node)
+{
+	P4_SDE_FREE(node);
+}
+
+/*!
+ * Initialize the meter profile pool of a pipeline.
+ *
+ * @param pipe_ctx pipe mgr pipeline ctx info.
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_init(struct pipe_mgr_p4_pipeline *pipe_ctx)
+{
+	struct dal_meter_ctx *meter_ctx;
+	bf_hashtbl_sts_t htbl_sts;
+
+	if (pipe_ctx->dal_meter_ctx)
+		return BF_SUCCESS;
+
+	meter_ctx = P4_SDE_CALLOC(1, sizeof(*meter_ctx));
+	if (!meter_ctx)
+		return BF_NO_SYS_RESOURCES;
+
+	htbl_sts = bf_hashtbl_init(&meter_ctx->prof_htbl,
+				   dal_meter_prof_key_cmp_fn,
+				   dal_meter_prof_free_htbl_node,
+				   sizeof(struct dal_meter_profile_key),
+				   sizeof(struct dal_meter_profile),
+				   0x98733423);
+	if (htbl_sts != BF_HASHTBL_OK) {
+		LOG_ERROR("%s:%d Error in initializing hashtable"
+			  " for meter profiles", __func__, __LINE__);
+		P4_SDE_FREE(meter_ctx);
+		return BF_UNEXPECTED;
+	}
+
+	P4_SDE_MUTEX_INIT(&meter_ctx->lock);
+	pipe_ctx->dal_meter_ctx = meter_ctx;
+	return BF_SUCCESS;
+}
+
+/*!
+ * Release the meter profile pool of a pipeline.
+ *
+ * @param pipe_ctx pipe mgr pipeline ctx info.
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_destroy(struct pipe_mgr_p4_pipeline *pipe_ctx)
+{
+	struct dal_meter_ctx *meter_ctx = pipe_ctx->dal_meter_ctx;
+	struct dal_meter_array *array;
+
+	if (!meter_ctx)
+		return BF_SUCCESS;
+
+	while (meter_ctx->arrays) {
+		array = meter_ctx->arrays;
+		meter_ctx->arrays = array->next;
+		P4_SDE_MAP_DESTROY(&array->idx_map);
+		P4_SDE_FREE(array);
+	}
+	bf_hashtbl_delete(&meter_ctx->prof_htbl);
+	P4_SDE_MUTEX_DESTROY(&meter_ctx->lock);
+	P4_SDE_FREE(meter_ctx);
+	pipe_ctx->dal_meter_ctx = NULL;
+	return BF_SUCCESS;
+}
+
+/* Resolve the DPDK pipeline, meter profile pool and meter extern
+ * associated with the given meter table.
+ */
+static bf_status_t
+dal_meter_lookup(bf_dev_target_t dev_tgt,
+		 const char *table_name,
+		 struct pipeline **pipe,
+		 struct dal_meter_ctx **meter_ctx,
+		 struct pipe_mgr_externs_ctx **externs_entry)
+{
+	struct pipe_mgr_p4_pipeline *ctx_obj = NULL;
+	char key_name[P4_SDE_TABLE_NAME_LEN] = {0};
+	struct pipe_mgr_profile *profile = NULL;
+	bf_status_t status = BF_SUCCESS;
+	const char *ptr = NULL;
+
+	status = pipe_mgr_get_profile(dev_tgt.device_id,
+				      dev_tgt.dev_pipe_id, &profile);
+	if (status) {
+		LOG_ERROR("not able find profile with device_id  %d",
+			  dev_tgt.device_id);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	/* get dpdk pipeline, table and action info */
+	*pipe = pipeline_find(profile->pipeline_name);
+	if (!*pipe) {
+		LOG_ERROR("dpdk pipeline %s get failed",
+			  profile->pipeline_name);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	/* retrieve context json object associated with dev_tgt */
+	status = pipe_mgr_get_profile_ctx(dev_tgt, &ctx_obj);
+	if (status) {
+		LOG_ERROR("context object not found for a profile");
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	*meter_ctx = ctx_obj->dal_meter_ctx;
+	if (!*meter_ctx) {
+		LOG_ERROR("meter profile pool not initialized for %s",
+			  profile->pipeline_name);
+		return BF_NOT_READY;
+	}
+
+	/* extract table name which is used as a key in hash map */
+	ptr = trim_classifier_str((char *)table_name);
+	strncpy(key_name, ptr, P4_SDE_TABLE_NAME_LEN - 1);
+
+	*externs_entry = bf_hashtbl_search(ctx_obj->bf_externs_htbl, key_name);
+	if (!*externs_entry) {
+		LOG_ERROR("externs object/entry get for table \"%s\" failed",
+			  table_name);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	if ((*externs_entry)->type != EXTERNS_METER) {
+		LOG_ERROR("table \"%s\" is not an indirect meter", table_name);
+		return BF_INVALID_ARG;
+	}
+
+	return BF_SUCCESS;
+}
+
+static struct dal_meter_array *
+dal_meter_array_get(struct dal_meter_ctx *meter_ctx,
+		    const char *name,
+		    bool create)
+{
+	struct dal_meter_array *array;
+
+	for (array = meter_ctx->arrays; array; array = array->next) {
+		if (!strncmp(array->name, name, P4_SDE_TABLE_NAME_LEN))
+			return array;
+	}
+
+	if (!create)
+		return NULL;
+
+	array = P4_SDE_CALLOC(1, sizeof(*array));
+	if (!array)
+		return NULL;
+
+	strncpy(array->name, name, P4_SDE_TABLE_NAME_LEN - 1);
+	P4_SDE_MAP_INIT(&array->idx_map);
+	array->next = meter_ctx->arrays;
+	meter_ctx->arrays = array;
+	return array;
+}
+
+static bf_status_t
+dal_meter_spec_to_key(pipe_meter_spec_t *spec,
+		      struct dal_meter_profile_key *key)
+{
+	if (spec->cir.type != METER_RATE_TYPE_KBPS ||
+	    spec->pir.type != METER_RATE_TYPE_KBPS) {
+		LOG_ERROR("only byte based meters are supported");
+		return BF_NOT_SUPPORTED;
+	}
+
+	memset(key, 0, sizeof(*key));
+	key->cir = DAL_METER_KBITS_TO_BYTES(spec->cir.value.kbps);
+	key->pir = DAL_METER_KBITS_TO_BYTES(spec->pir.value.kbps);
+	key->cbs = DAL_METER_KBITS_TO_BYTES(spec->cburst);
+	key->pbs = DAL_METER_KBITS_TO_BYTES(spec->pburst);
+	return BF_SUCCESS;
+}
+
+/* Take a reference on the profile matching key, creating it in the
+ * DPDK pipeline if no meter index uses this spec yet.
+ */
+static struct dal_meter_profile *
+dal_meter_profile_get(struct pipeline *pipe,
+		      struct dal_meter_ctx *meter_ctx,
+		      struct dal_meter_profile_key *key)
+{
+	struct rte_meter_trtcm_params params;
+	struct dal_meter_profile *prof;
+	int status;
+	uint32_t i;
+
+	prof = bf_hashtbl_search(&meter_ctx->prof_htbl, key);
+	if (prof) {
+		prof->ref_cnt++;
+		return prof;
+	}
+
+	prof = P4_SDE_CALLOC(1, sizeof(*prof));
+	if (!prof)
+		return NULL;
+
+	prof->key = *key;
+	snprintf(prof->name, sizeof(prof->name), "%s_%u",
+		 DAL_METER_PROFILE_PREFIX, meter_ctx->next_prof_id++);
+
+	/* RSS spreads the traffic evenly over the instances of a sharded
+	 * pipeline, each of them meters its share of the rates.
+	 */
+	params.cir = key->cir / pipe->n_instances;
+	params.pir = key->pir / pipe->n_instances;
+	params.cbs = key->cbs;
+	params.pbs = key->pbs;
+	for (i = 0; i < pipe->n_instances; i++) {
+		status = rte_swx_ctl_meter_profile_add(pipe->instance[i]->p,
+						       prof->name, &params);
+		if (status) {
+			LOG_ERROR("meter profile %s add failed, err %d",
+				  prof->name, status);
+			goto error;
+		}
+	}
+
+	if (bf_hashtbl_insert(&meter_ctx->prof_htbl, prof, key) !=
+	    BF_HASHTBL_OK) {
+		LOG_ERROR("meter profile %s insert failed", prof->name);
+		goto error;
+	}
+
+	prof->ref_cnt = 1;
+	return prof;
+
+error:
+	while (i--)
+		rte_swx_ctl_meter_profile_delete(pipe->instance[i]->p,
+						 prof->name);
+	P4_SDE_FREE(prof);
+	return NULL;
+}
+
+/* Drop a reference on the profile, deleting it from the DPDK pipeline
+ * once no meter index uses it anymore.
+ */
+static void
+dal_meter_profile_put(struct pipeline *pipe,
+		      struct dal_meter_ctx *meter_ctx,
+		      struct dal_meter_profile *prof)
+{
+	uint32_t i;
+
+	if (--prof->ref_cnt)
+		return;
+
+	for (i = 0; i < pipe->n_instances; i++)
+		if (rte_swx_ctl_meter_profile_delete(pipe->instance[i]->p,
+						     prof->name))
+			LOG_ERROR("meter profile %s delete failed on %s",
+				  prof->name, pipe->instance[i]->name);
+
+	prof = bf_hashtbl_get_remove(&meter_ctx->prof_htbl, &prof->key);
+	P4_SDE_FREE(prof);
+}
+
+/* Set a meter index of the first n_instances instances of the pipeline
+ * back to the profile it is bound to, or to the default profile.
+ */
+static void
+dal_meter_restore(struct pipeline *pipe,
+		  struct dal_meter_array *array,
+		  const char *target_name,
+		  uint64_t idx,
+		  uint32_t n_instances)
+{
+	struct dal_meter_profile *prof = NULL;
+	uint32_t i;
+	int status;
+
+	P4_SDE_MAP_GET(&array->idx_map, idx, (void **)&prof);
+	for (i = 0; i < n_instances; i++) {
+		if (prof)
+			status = rte_swx_ctl_meter_set(pipe->instance[i]->p,
+						       target_name, idx,
+						       prof->name);
+		else
+			status = rte_swx_ctl_meter_reset(pipe->instance[i]->p,
+							 target_name, idx);
+		if (status)
+			LOG_ERROR("%s:Meter restore failed for Name[%s][%lu]\n",
+				  __func__, target_name, idx);
+	}
+}
+
+/*!
+ * Program a meter index with the given spec. Meter entries with
+ * identical specs share a single meter profile.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx meter index to be programmed
+ * @param spec meter spec to be applied
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_ent_set(bf_dev_target_t dev_tgt,
+		  const char *table_name,
+		  uint32_t idx,
+		  pipe_meter_spec_t *spec)
+{
+	return dal_meter_ent_set_range(dev_tgt, table_name, idx, idx, spec);
+}
+
+/*!
+ * Program a range of meter indexes with the same spec. All the
+ * indexes of the range are bound to a single meter profile. On failure
+ * no index of the range is changed.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx_start first meter index to be programmed
+ * @param idx_end last meter index to be programmed
+ * @param spec meter spec to be applied
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_ent_set_range(bf_dev_target_t dev_tgt,
+			const char *table_name,
+			uint32_t idx_start,
+			uint32_t idx_end,
+			pipe_meter_spec_t *spec)
+{
+	struct pipe_mgr_externs_ctx *externs_entry = NULL;
+	struct dal_meter_ctx *meter_ctx = NULL;
+	struct dal_meter_profile *old_prof;
+	struct dal_meter_profile_key key;
+	struct dal_meter_profile *prof;
+	struct dal_meter_array *array;
+	struct pipeline *pipe = NULL;
+	bf_status_t status;
+	uint64_t idx;
+	uint32_t i;
+
+	if (idx_start > idx_end)
+		return BF_INVALID_ARG;
+
+	status = dal_meter_lookup(dev_tgt, table_name, &pipe, &meter_ctx,
+				  &externs_entry);
+	if (status)
+		return status;
+
+	status = dal_meter_spec_to_key(spec, &key);
+	if (status)
+		return status;
+
+	P4_SDE_MUTEX_LOCK(&meter_ctx->lock);
+
+	array = dal_meter_array_get(meter_ctx, externs_entry->target_name,
+				    true);
+	if (!array) {
+		status = BF_NO_SYS_RESOURCES;
+		goto unlock;
+	}
+
+	/* Hold a reference for the duration of the loop so that the
+	 * profile is created once and released if no index binds to it.
+	 */
+	prof = dal_meter_profile_get(pipe, meter_ctx, &key);
+	if (!prof) {
+		status = BF_NO_SYS_RESOURCES;
+		goto unlock;
+	}
+
+	for (idx = idx_start; idx <= idx_end; idx++) {
+		old_prof = NULL;
+		P4_SDE_MAP_GET(&array->idx_map, idx, (void **)&old_prof);
+		if (old_prof == prof)
+			continue;
+
+		for (i = 0; i < pipe->n_instances; i++) {
+			if (rte_swx_ctl_meter_set(pipe->instance[i]->p,
+						  externs_entry->target_name,
+						  idx, prof->name)) {
+				LOG_ERROR("%s:Meter set failed for Name[%s][%lu]\n",
+					  __func__, externs_entry->target_name,
+					  idx);
+				status = BF_INVALID_ARG;
+				break;
+			}
+		}
+		if (status) {
+			dal_meter_restore(pipe, array,
+					  externs_entry->target_name, idx, i);
+			break;
+		}
+	}
+
+	/* The range is set as a whole: on failure, the indexes already
+	 * programmed go back to their profiles, which keep their references.
+	 */
+	if (status) {
+		while (idx-- > idx_start)
+			dal_meter_restore(pipe, array,
+					  externs_entry->target_name, idx,
+					  pipe->n_instances);
+		goto put;
+	}
+
+	for (idx = idx_start; idx <= idx_end; idx++) {
+		old_prof = NULL;
+		P4_SDE_MAP_GET(&array->idx_map, idx, (void **)&old_prof);
+		if (old_prof == prof)
+			continue;
+
+		if (old_prof) {
+			P4_SDE_MAP_RMV(&array->idx_map, idx);
+			dal_meter_profile_put(pipe, meter_ctx, old_prof);
+		}
+		prof->ref_cnt++;
+		P4_SDE_MAP_ADD(&array->idx_map, idx, prof);
+	}
+
+put:
+	dal_meter_profile_put(pipe, meter_ctx, prof);
+
+unlock:
+	P4_SDE_MUTEX_UNLOCK(&meter_ctx->lock);
+	return status;
+}
+
+/*!
+ * Reset all the meter indexes of a meter table to the default
+ * profile and release the profiles held by them.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_reset(bf_dev_target_t dev_tgt,
+		const char *table_name)
+{
+	struct pipe_mgr_externs_ctx *externs_entry = NULL;
+	struct dal_meter_ctx *meter_ctx = NULL;
+	struct dal_meter_profile *prof = NULL;
+	struct dal_meter_array *array;
+	struct pipeline *pipe = NULL;
+	p4_sde_map_key idx;
+	bf_status_t status;
+	uint32_t i;
+
+	status = dal_meter_lookup(dev_tgt, table_name, &pipe, &meter_ctx,
+				  &externs_entry);
+	if (status)
+		return status;
+
+	P4_SDE_MUTEX_LOCK(&meter_ctx->lock);
+
+	array = dal_meter_array_get(meter_ctx, externs_entry->target_name,
+				    false);
+	if (!array)
+		goto unlock;
+
+	while (P4_SDE_MAP_GET_FIRST_RMV(&array->idx_map, &idx,
+					(void **)&prof) == BF_MAP_OK) {
+		for (i = 0; i < pipe->n_instances; i++) {
+			if (rte_swx_ctl_meter_reset(pipe->instance[i]->p,
+						    externs_entry->target_name,
+						    idx)) {
+				LOG_ERROR("%s:Meter reset failed for Name[%s][%lu]\n",
+					  __func__, externs_entry->target_name,
+					  idx);
+				status = BF_INTERNAL_ERROR;
+			}
+		}
+		dal_meter_profile_put(pipe, meter_ctx, prof);
+	}
+
+unlock:
+	P4_SDE_MUTEX_UNLOCK(&meter_ctx->lock);
+	return status;
+}
+
+/*!
+ * Read back the meter spec programmed on a meter index.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx meter index to be read
+ * @param spec buffer to fill the meter spec
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_ent_get(bf_dev_target_t dev_tgt,
+		  const char *table_name,
+		  uint32_t idx,
+		  pipe_meter_spec_t *spec)
+{
+	struct pipe_mgr_externs_ctx *externs_entry = NULL;
+	struct dal_meter_ctx *meter_ctx = NULL;
+	struct dal_meter_profile *prof = NULL;
+	struct dal_meter_array *array;
+	struct pipeline *pipe = NULL;
+	bf_status_t status;
+
+	status = dal_meter_lookup(dev_tgt, table_name, &pipe, &meter_ctx,
+				  &externs_entry);
+	if (status)
+		return status;
+
+	/* Meter indexes never programmed are reported with a zero spec. */
+	memset(spec, 0, sizeof(*spec));
+	spec->meter_type = METER_TYPE_COLOR_UNAWARE;
+	spec->cir.type = METER_RATE_TYPE_KBPS;
+	spec->pir.type = METER_RATE_TYPE_KBPS;
+
+	P4_SDE_MUTEX_LOCK(&meter_ctx->lock);
+	array = dal_meter_array_get(meter_ctx, externs_entry->target_name,
+				    false);
+	if (array &&
+	    P4_SDE_MAP_GET(&array->idx_map, idx, (void **)&prof) == BF_MAP_OK) {
+		spec->cir.value.kbps = DAL_METER_BYTES_TO_KBITS(prof->key.cir);
+		spec->pir.value.kbps = DAL_METER_BYTES_TO_KBITS(prof->key.pir);
+		spec->cburst = DAL_METER_BYTES_TO_KBITS(prof->key.cbs);
+		spec->pburst = DAL_METER_BYTES_TO_KBITS(prof->key.pbs);
+	}
+	P4_SDE_MUTEX_UNLOCK(&meter_ctx->lock);
+
+	return BF_SUCCESS;
+}
+
+/*!
+ * Read the per color statistics of a meter index.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx meter index to be read
+ * @param stats buffer to fill the meter stats
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_stats_read(bf_dev_target_t dev_tgt,
+		     const char *table_name,
+		     uint32_t idx,
+		     pipe_meter_stats_t *stats)
+{
+	return dal_meter_stats_read_range(dev_tgt, table_name, idx, idx,
+					  stats);
+}
+
+/*!
+ * Read the per color statistics of a range of meter indexes.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param idx_start first meter index to be read
+ * @param idx_end last meter index to be read
+ * @param stats array of (idx_end - idx_start + 1) entries to fill
+ * @return Status of the API call
+ */
+bf_status_t
+dal_meter_stats_read_range(bf_dev_target_t dev_tgt,
+			   const char *table_name,
+			   uint32_t idx_start,
+			   uint32_t idx_end,
+			   pipe_meter_stats_t *stats)
+{
+	struct pipe_mgr_externs_ctx *externs_entry = NULL;
+	struct dal_meter_ctx *meter_ctx = NULL;
+	struct rte_swx_ctl_meter_stats mstats;
+	struct pipeline *pipe = NULL;
+	pipe_meter_stats_t *ent;
+	bf_status_t status;
+	uint64_t idx;
+	uint32_t i;
+
+	if (idx_start > idx_end)
+		return BF_INVALID_ARG;
+
+	status = dal_meter_lookup(dev_tgt, table_name, &pipe, &meter_ctx,
+				  &externs_entry);
+	if (status)
+		return status;
+
+	for (idx = idx_start; idx <= idx_end; idx++) {
+		ent = &stats[idx - idx_start];
+		memset(ent, 0, sizeof(*ent));
+
+		for (i = 0; i < pipe->n_instances; i++) {
+			status = rte_swx_ctl_meter_stats_read(
+						pipe->instance[i]->p,
+						externs_entry->target_name,
+						idx, &mstats);
+			if (status) {
+				LOG_ERROR("%s:Meter stats read failed for Name[%s][%lu]\n",
+					  __func__, externs_entry->target_name,
+					  idx);
+				return BF_OBJECT_NOT_FOUND;
+			}
+
+			ent->pkts[METER_COLOR_GREEN] +=
+				mstats.n_pkts[RTE_COLOR_GREEN];
+			ent->pkts[METER_COLOR_YELLOW] +=
+				mstats.n_pkts[RTE_COLOR_YELLOW];
+			ent->pkts[METER_COLOR_RED] +=
+				mstats.n_pkts[RTE_COLOR_RED];
+			ent->bytes[METER_COLOR_GREEN] +=
+				mstats.n_bytes[RTE_COLOR_GREEN];
+			ent->bytes[METER_COLOR_YELLOW] +=
+				mstats.n_bytes[RTE_COLOR_YELLOW];
+			ent->bytes[METER_COLOR_RED] +=
+				mstats.n_bytes[RTE_COLOR_RED];
+		}
+	}
+
+	return BF_SUCCESS;
+}
@@ -80,7 +80,9 @@ dal_reg_read_indirect_register_set(bf_dev_target_t dev_tgt,
 		return BF_OBJECT_NOT_FOUND;
 	}
 
-	/* read register value from dpdk pipeline */
+	/* read register value from dpdk pipeline, registers written by the
+	 * data path of sharded instances are read from the first instance
+	 */
 	status = rte_swx_ctl_pipeline_regarray_read(pipe->p,
 						    externs_entry->target_name,
 						    id,
@@ -113,6 +115,8 @@ dal_reg_write_assignable_register_set(bf_dev_target_t dev_tgt,
 	bf_status_t  status = BF_SUCCESS;
 	struct  pipeline *pipe;
 	const char  *ptr    = NULL;
+	uint64_t prev[PIPELINE_INSTANCES_MAX];
+	uint32_t i;
 
 	status = pipe_mgr_get_profile(dev_tgt.device_id,
 				      dev_tgt.dev_pipe_id, &profile);
@@ -148,14 +152,32 @@ dal_reg_write_assignable_register_set(bf_dev_target_t dev_tgt,
 			  name);
 		return BF_OBJECT_NOT_FOUND;
 	}
-	status = rte_swx_ctl_pipeline_regarray_write(pipe->p,
+	/* Every instance gets the value or none: the previous values are
+	 * written back to the instances already written on failure.
+	 */
+	for (i = 0; i < pipe->n_instances; i++) {
+		status = rte_swx_ctl_pipeline_regarray_read(
+						     pipe->instance[i]->p,
+						     externs_entry->target_name,
+						     id,
+						     &prev[i]);
+		if (!status)
+			status = rte_swx_ctl_pipeline_regarray_write(
+						     pipe->instance[i]->p,
 						     externs_entry->target_name,
 						     id,
 						     stful_spec->dbl);
-	if (status) {
-		LOG_ERROR("%s:Register write failed for Name[%s][%d]\n",
-			  __func__, name, id);
-		return BF_OBJECT_NOT_FOUND;
+		if (status) {
+			LOG_ERROR("%s:Register write failed for Name[%s][%d]\n",
+				  __func__, name, id);
+			while (i--)
+				rte_swx_ctl_pipeline_regarray_write(
+						     pipe->instance[i]->p,
+						     externs_entry->target_name,
+						     id,
+						     prev[i]);
+			return BF_OBJECT_NOT_FOUND;
+		}
 	}
 
 	return BF_SUCCESS;
@@ -36,6 +36,7 @@ int dal_table_sel_ent_add_del(u32 sess_hdl,
 	struct rte_swx_ctl_pipeline *ctl;
 	int status = BF_SUCCESS;
 	struct pipeline *pipe;
+	uint32_t grp_id, k;
 
 	status = pipe_mgr_get_profile(dev_tgt.device_id,
 				      dev_tgt.dev_pipe_id, &profile);
@@ -59,32 +60,53 @@ int dal_table_sel_ent_add_del(u32 sess_hdl,
 		return BF_OBJECT_NOT_FOUND;
 	}
 
-	ctl = pipe->ctl;
-
-	if (!del_grp)
-		status =
-		rte_swx_ctl_pipeline_selector_group_add(ctl, mat_ctx->name,
-			tbl_ent_hdl);
-	else
-		status =
-		rte_swx_ctl_pipeline_selector_group_delete(ctl, mat_ctx->name,
-			*tbl_ent_hdl);
+	/* All the instances get the same sequence of group operations, so
+	 * they allocate the same group ids.
+	 */
+	for (k = 0; k < pipe->n_instances; k++) {
+		ctl = pipe->instance[k]->ctl;
+		if (!ctl) {
+			LOG_ERROR("dpdk pipeline %s ctl is null",
+					pipe->instance[k]->name);
+			return BF_OBJECT_NOT_FOUND;
+		}
 
-	if (status) {
 		if (!del_grp)
-			LOG_ERROR(
-			"rte_swx_ctl_pipeline_selector_group_add failed");
+			status =
+			rte_swx_ctl_pipeline_selector_group_add(ctl,
+				mat_ctx->name, &grp_id);
 		else
-			LOG_ERROR(
-			"rte_swx_ctl_pipeline_selector_group_delete failed");
+			status =
+			rte_swx_ctl_pipeline_selector_group_delete(ctl,
+				mat_ctx->name, *tbl_ent_hdl);
 
-		return BF_UNEXPECTED;
-	}
+		if (status) {
+			if (!del_grp)
+				LOG_ERROR(
+				"rte_swx_ctl_pipeline_selector_group_add failed");
+			else
+				LOG_ERROR(
+				"rte_swx_ctl_pipeline_selector_group_delete failed");
 
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		return BF_UNEXPECTED;
+			return BF_UNEXPECTED;
+		}
+
+		if (!del_grp) {
+			if (k == 0) {
+				*tbl_ent_hdl = grp_id;
+			} else if (grp_id != *tbl_ent_hdl) {
+				LOG_ERROR("pipeline %s group id %u differs "
+					  "from %u", pipe->instance[k]->name,
+					  grp_id, *tbl_ent_hdl);
+				return BF_UNEXPECTED;
+			}
+		}
+
+		status = rte_swx_ctl_pipeline_commit(ctl, 1);
+		if (status) {
+			LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
+			return BF_UNEXPECTED;
+		}
 	}
 
 	return status;
@@ -104,7 +126,7 @@ int dal_table_sel_member_add_del(u32 sess_hdl,
 	struct rte_swx_ctl_pipeline *ctl;
 	int status = BF_SUCCESS;
 	struct pipeline *pipe;
-	uint32_t i;
+	uint32_t i, k;
 
 	status = pipe_mgr_get_profile(dev_tgt.device_id,
 				      dev_tgt.dev_pipe_id, &profile);
@@ -128,36 +150,44 @@ int dal_table_sel_member_add_del(u32 sess_hdl,
 		return BF_OBJECT_NOT_FOUND;
 	}
 
-	ctl = pipe->ctl;
-	for (i = 0; i < num_mbrs; i++) {
-		if (!delete_members)
-			status =
-			rte_swx_ctl_pipeline_selector_group_member_add(ctl,
-					mat_ctx->name, sel_grp_hdl, mbrs[i],
-					(uint32_t)1);
-		else
-			status =
-			rte_swx_ctl_pipeline_selector_group_member_delete(ctl,
-					mat_ctx->name, sel_grp_hdl, mbrs[i]);
+	for (k = 0; k < pipe->n_instances; k++) {
+		ctl = pipe->instance[k]->ctl;
+		if (!ctl) {
+			LOG_ERROR("dpdk pipeline %s ctl is null",
+					pipe->instance[k]->name);
+			return BF_OBJECT_NOT_FOUND;
+		}
 
-		if (status) {
+		for (i = 0; i < num_mbrs; i++) {
 			if (!delete_members)
-				LOG_ERROR(
-				"rte_swx_ctl_pipeline_selector_group_add"
-				" failed %d", status);
+				status =
+				rte_swx_ctl_pipeline_selector_group_member_add(ctl,
+						mat_ctx->name, sel_grp_hdl, mbrs[i],
+						(uint32_t)1);
 			else
-				LOG_ERROR(
-				"rte_swx_ctl_pipeline_selector_"
-				"group_member_delete"
-				" failed %d", status);
+				status =
+				rte_swx_ctl_pipeline_selector_group_member_delete(ctl,
+						mat_ctx->name, sel_grp_hdl, mbrs[i]);
+
+			if (status) {
+				if (!delete_members)
+					LOG_ERROR(
+					"rte_swx_ctl_pipeline_selector_group_add"
+					" failed %d", status);
+				else
+					LOG_ERROR(
+					"rte_swx_ctl_pipeline_selector_"
+					"group_member_delete"
+					" failed %d", status);
+				return BF_UNEXPECTED;
+			}
+		}
+		status = rte_swx_ctl_pipeline_commit(ctl, 1);
+		if (status) {
+			LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
 			return BF_UNEXPECTED;
 		}
 	}
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		return BF_UNEXPECTED;
-	}
 
 	return status;
 }
@@ -472,3 +472,84 @@ error:
 	P4_SDE_FREE(meta);
 	return status;
 }
+
+static int dal_dpdk_table_entry_stage(struct rte_swx_ctl_pipeline *ctl,
+				      const char *table_name,
+				      struct rte_swx_table_entry *entry,
+				      enum dal_dpdk_table_op op)
+{
+	switch (op) {
+	case DAL_DPDK_TABLE_ENTRY_ADD:
+		return rte_swx_ctl_pipeline_table_entry_add(ctl, table_name,
+							    entry);
+	case DAL_DPDK_TABLE_DEFAULT_ENTRY_ADD:
+		return rte_swx_ctl_pipeline_table_default_entry_add(ctl,
+				table_name, entry);
+	case DAL_DPDK_TABLE_ENTRY_DELETE:
+		return rte_swx_ctl_pipeline_table_entry_delete(ctl, table_name,
+							       entry);
+	}
+
+	return -1;
+}
+
+int dal_dpdk_table_entry_write(struct pipeline *pipe, const char *table_name,
+			       struct rte_swx_table_entry *entry,
+			       enum dal_dpdk_table_op op)
+{
+	struct rte_swx_ctl_pipeline *ctl;
+	uint32_t i, k;
+
+	for (i = 0; i < pipe->n_instances; i++) {
+		if (!pipe->instance[i]->ctl) {
+			LOG_ERROR("dpdk pipeline %s ctl is null",
+				  pipe->instance[i]->name);
+			return BF_OBJECT_NOT_FOUND;
+		}
+	}
+
+	/* Stage the operation on all the instances before committing any,
+	 * so that an entry refused by one instance is applied to none.
+	 */
+	for (i = 0; i < pipe->n_instances; i++) {
+		ctl = pipe->instance[i]->ctl;
+		if (dal_dpdk_table_entry_stage(ctl, table_name, entry, op)) {
+			LOG_ERROR("dpdk table %s entry op %d failed on %s",
+				  table_name, op, pipe->instance[i]->name);
+			for (k = 0; k <= i; k++)
+				rte_swx_ctl_pipeline_abort(
+					pipe->instance[k]->ctl);
+			return BF_UNEXPECTED;
+		}
+	}
+
+	for (i = 0; i < pipe->n_instances; i++) {
+		ctl = pipe->instance[i]->ctl;
+		if (!rte_swx_ctl_pipeline_commit(ctl, 1))
+			continue;
+
+		LOG_ERROR("rte_swx_ctl_pipeline_commit failed on %s",
+			  pipe->instance[i]->name);
+		for (k = i + 1; k < pipe->n_instances; k++)
+			rte_swx_ctl_pipeline_abort(pipe->instance[k]->ctl);
+
+		/* An added entry is new to the table, it is deleted from the
+		 * instances already committed. The previous state of a
+		 * deleted entry or of the default entry is not known here,
+		 * those instances are left out of sync.
+		 */
+		for (k = 0; k < i; k++) {
+			ctl = pipe->instance[k]->ctl;
+			if ((op != DAL_DPDK_TABLE_ENTRY_ADD) ||
+			    rte_swx_ctl_pipeline_table_entry_delete(ctl,
+					table_name, entry) ||
+			    rte_swx_ctl_pipeline_commit(ctl, 1))
+				LOG_ERROR("dpdk table %s entry op %d not undone "
+					  "on %s", table_name, op,
+					  pipe->instance[k]->name);
+		}
+		return BF_UNEXPECTED;
+	}
+
+	return BF_SUCCESS;
+}
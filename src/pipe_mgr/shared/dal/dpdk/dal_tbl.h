@@ -32,4 +32,29 @@ int dal_dpdk_table_entry_alloc(struct rte_swx_table_entry **ent,
 			       struct dal_dpdk_table_metadata *meta,
 			       int match_type);
 
+enum dal_dpdk_table_op {
+	DAL_DPDK_TABLE_ENTRY_ADD,
+	DAL_DPDK_TABLE_DEFAULT_ENTRY_ADD,
+	DAL_DPDK_TABLE_ENTRY_DELETE,
+};
+
+/* Apply a table entry operation to all the instances of a pipeline and
+ * commit it on each of them. The operation is staged on every instance
+ * first, so that an entry refused by one of them is applied to none. An
+ * added entry is also removed again from the instances already committed
+ * if a later commit fails.
+ */
+int dal_dpdk_table_entry_write(struct pipeline *pipe, const char *table_name,
+			       struct rte_swx_table_entry *entry,
+			       enum dal_dpdk_table_op op);
+
+/* Read the regarray entry of a table key, summed over the instances of a
+ * pipeline. Defined with the counters, which keep it per instance.
+ */
+int dal_dpdk_regarray_read_with_key(struct pipeline *pipe,
+				    const char *regarray_name,
+				    const char *table_name,
+				    const uint8_t *table_key,
+				    uint64_t *value);
+
 #endif /* __DAL_DPDK_TBL_H__ */
@@ -90,6 +90,7 @@ dal_value_lookup_ent_add(uint32_t sess_hdl,
 	struct pipeline *pipe = NULL;
 	int status = BF_SUCCESS;
 	uint8_t mirror_id = 0;
+	uint32_t k;
 
 	LOG_TRACE("Entering %s", __func__);
 
@@ -151,10 +152,13 @@ dal_value_lookup_ent_add(uint32_t sess_hdl,
 			LOG_ERROR("Could not fill the mirror session params.");
 			goto cleanup;
 		}
-		status = dal_mirror_session_set(mirror_id, &mir_params, pipe->p);
-		if (status) {
-			LOG_ERROR("Could not configure the mirror session.");
-			goto cleanup;
+		for (k = 0; k < pipe->n_instances; k++) {
+			status = dal_mirror_session_set(mirror_id, &mir_params,
+							pipe->instance[k]->p);
+			if (status) {
+				LOG_ERROR("Could not configure the mirror session.");
+				goto cleanup;
+			}
 		}
 		break;
 	default:
@@ -163,10 +167,14 @@ dal_value_lookup_ent_add(uint32_t sess_hdl,
 		goto cleanup;
 	}
 
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		status = BF_UNEXPECTED;
+	for (k = 0; k < pipe->n_instances; k++) {
+		ctl = pipe->instance[k]->ctl;
+		status = rte_swx_ctl_pipeline_commit(ctl, 1);
+		if (status) {
+			LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
+			status = BF_UNEXPECTED;
+			break;
+		}
 	}
 
 cleanup:
@@ -186,6 +194,7 @@ dal_value_lookup_ent_del(uint32_t sess_hdl,
 	struct pipeline *pipe = NULL;
 	int status = BF_SUCCESS;
 	uint8_t mirror_id = 0;
+	uint32_t k;
 
 	LOG_TRACE("Entering %s", __func__);
 
@@ -226,10 +235,13 @@ dal_value_lookup_ent_del(uint32_t sess_hdl,
 			LOG_ERROR("Could not fill the mirror session id.");
 			goto cleanup;
 		}
-		status = dal_mirror_session_clear(mirror_id, pipe->p);
-		if (status) {
-			LOG_ERROR("Could not clear the mirror session.");
-			goto cleanup;
+		for (k = 0; k < pipe->n_instances; k++) {
+			status = dal_mirror_session_clear(mirror_id,
+							  pipe->instance[k]->p);
+			if (status) {
+				LOG_ERROR("Could not clear the mirror session.");
+				goto cleanup;
+			}
 		}
 		break;
 	default:
@@ -238,10 +250,14 @@ dal_value_lookup_ent_del(uint32_t sess_hdl,
 		goto cleanup;
 	}
 
-	status = rte_swx_ctl_pipeline_commit(ctl, 1);
-	if (status) {
-		LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
-		status = BF_UNEXPECTED;
+	for (k = 0; k < pipe->n_instances; k++) {
+		ctl = pipe->instance[k]->ctl;
+		status = rte_swx_ctl_pipeline_commit(ctl, 1);
+		if (status) {
+			LOG_ERROR("rte_swx_ctl_pipeline_commit failed");
+			status = BF_UNEXPECTED;
+			break;
+		}
 	}
 
 cleanup:
@@ -0,0 +1,1183 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file pipe_mgr_idle.c
+ *
+ * @description Idle timeout (entry aging) for MatchAction tables.
+ *
+ * In notify mode every entry with a TTL sits on a hierarchical timer
+ * wheel of its table. An entry is only looked at when its slot comes
+ * due, at which point the hit counts of all the due entries are read
+ * from the target in bursts. Entries that were hit are rescheduled,
+ * the others are reported to the registered callback. Expirations are
+ * collected in batches while the table locks are held and delivered
+ * once the locks are released, so the callbacks are free to delete
+ * the expired entries.
+ */
+#include <pthread.h>
+#include <time.h>
+
+#include <osdep/p4_sde_osdep_utils.h>
+#include "pipe_mgr/shared/pipe_mgr_infra.h"
+#include "pipe_mgr/shared/pipe_mgr_mat.h"
+#include "../dal/dal_mat.h"
+#include "../../core/pipe_mgr_log.h"
+#include "../infra/pipe_mgr_ctx_util.h"
+#include "../infra/pipe_mgr_tbl.h"
+#include "../infra/pipe_mgr_int.h"
+#include "../infra/pipe_mgr_session.h"
+#include "../pipe_mgr_shared_intf.h"
+#include "pipe_mgr_idle.h"
+
+/* Expired entries of a table waiting to be delivered to its callback. */
+struct pipe_mgr_idle_notify {
+	bf_dev_id_t dev_id;
+	pipe_idle_tmo_expiry_cb cb;
+	pipe_idle_tmo_expiry_cb_with_match_spec_copy cb2;
+	void *client_data;
+	int num;
+	u32 ent_hdls[PIPE_MGR_IDLE_NOTIFY_BATCH];
+	struct pipe_tbl_match_spec *match_specs[PIPE_MGR_IDLE_NOTIFY_BATCH];
+	struct pipe_mgr_idle_notify *next;
+};
+
+/* Tables in notify mode, swept by the aging thread. */
+static struct pipe_mgr_idle_tbl *pipe_mgr_idle_tbls;
+/* Mutex to protect the table list. Taken before any table lock. */
+static p4_sde_mutex pipe_mgr_idle_lock;
+static pthread_t pipe_mgr_idle_thread_id;
+static volatile bool pipe_mgr_idle_thread_run;
+
+static u64 pipe_mgr_idle_now_ms(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static u64 pipe_mgr_idle_ttl_to_ticks(struct pipe_mgr_idle_tbl *idle, u32 ttl)
+{
+	u64 ticks;
+
+	ticks = (ttl + idle->tick_ms - 1) / idle->tick_ms;
+	return ticks ? ticks : 1;
+}
+
+static void pipe_mgr_idle_wheel_unlink(struct pipe_mgr_mat_entry_info *entry)
+{
+	if (!entry->idle_slot)
+		return;
+
+	if (entry->idle_prev)
+		entry->idle_prev->idle_next = entry->idle_next;
+	else
+		*entry->idle_slot = entry->idle_next;
+	if (entry->idle_next)
+		entry->idle_next->idle_prev = entry->idle_prev;
+
+	entry->idle_next = NULL;
+	entry->idle_prev = NULL;
+	entry->idle_slot = NULL;
+}
+
+/* Link an entry on the wheel slot matching its expiry tick. Entries due
+ * beyond the span of the wheel are parked on the last level and linked
+ * again when that slot comes due.
+ */
+static void pipe_mgr_idle_wheel_link(struct pipe_mgr_idle_tbl *idle,
+				     struct pipe_mgr_mat_entry_info *entry)
+{
+	struct pipe_mgr_mat_entry_info **slot;
+	u64 expiry;
+	u64 delta;
+	int level;
+
+	pipe_mgr_idle_wheel_unlink(entry);
+
+	if (entry->idle_expiry_tick <= idle->cur_tick)
+		entry->idle_expiry_tick = idle->cur_tick + 1;
+
+	expiry = entry->idle_expiry_tick;
+	delta = expiry - idle->cur_tick;
+	if (delta >= PIPE_MGR_IDLE_WHEEL_SPAN) {
+		delta = PIPE_MGR_IDLE_WHEEL_SPAN - 1;
+		expiry = idle->cur_tick + delta;
+	}
+
+	for (level = 0; level < PIPE_MGR_IDLE_WHEEL_LEVELS - 1; level++)
+		if (delta < (1ULL << (PIPE_MGR_IDLE_WHEEL_BITS * (level + 1))))
+			break;
+
+	slot = &idle->wheel[level][(expiry >> (PIPE_MGR_IDLE_WHEEL_BITS *
+				    level)) & PIPE_MGR_IDLE_WHEEL_MASK];
+	entry->idle_prev = NULL;
+	entry->idle_next = *slot;
+	if (*slot)
+		(*slot)->idle_prev = entry;
+	*slot = entry;
+	entry->idle_slot = slot;
+}
+
+static void pipe_mgr_idle_wheel_schedule(struct pipe_mgr_idle_tbl *idle,
+					 struct pipe_mgr_mat_entry_info *entry)
+{
+	if (!entry->idle_ttl) {
+		pipe_mgr_idle_wheel_unlink(entry);
+		return;
+	}
+
+	entry->idle_expiry_tick = idle->cur_tick +
+		pipe_mgr_idle_ttl_to_ticks(idle, entry->idle_ttl);
+	pipe_mgr_idle_wheel_link(idle, entry);
+}
+
+static void pipe_mgr_idle_wheel_clear(struct pipe_mgr_idle_tbl *idle)
+{
+	int level, slot;
+
+	for (level = 0; level < PIPE_MGR_IDLE_WHEEL_LEVELS; level++)
+		for (slot = 0; slot < PIPE_MGR_IDLE_WHEEL_SLOTS; slot++)
+			while (idle->wheel[level][slot])
+				pipe_mgr_idle_wheel_unlink
+					(idle->wheel[level][slot]);
+}
+
+/* Read the hit counts of a burst of entries from the target and mark the
+ * entries whose count moved as active.
+ */
+static void pipe_mgr_idle_hits_read(struct pipe_mgr_idle_tbl *idle,
+				    struct pipe_mgr_mat_entry_info **entries,
+				    int n)
+{
+	struct pipe_tbl_match_spec *match_specs[PIPE_MGR_IDLE_HIT_READ_BURST];
+	u64 hit_cnts[PIPE_MGR_IDLE_HIT_READ_BURST];
+	int status;
+	int i;
+
+	if (!idle->hw_hits || !n)
+		return;
+
+	for (i = 0; i < n; i++)
+		match_specs[i] = entries[i]->match_spec;
+
+	status = dal_mat_ent_hit_cnt_read(idle->dev_tgt, &idle->tbl->ctx, n,
+					  match_specs, hit_cnts);
+	if (status == BF_NOT_SUPPORTED) {
+		LOG_TRACE("Hits of table %s are not reported by the target",
+			  idle->tbl->ctx.name);
+		idle->hw_hits = false;
+		return;
+	}
+	if (status) {
+		LOG_ERROR("Reading hits of table %s failed with err: %d",
+			  idle->tbl->ctx.name, status);
+		return;
+	}
+
+	for (i = 0; i < n; i++) {
+		if (hit_cnts[i] == entries[i]->idle_hit_cnt)
+			continue;
+		entries[i]->idle_hit_cnt = hit_cnts[i];
+		entries[i]->idle_hit_state = ENTRY_ACTIVE;
+	}
+}
+
+/* Take the current hit counts of a burst of entries as their baseline. */
+static void pipe_mgr_idle_hits_reset(struct pipe_mgr_idle_tbl *idle,
+				     struct pipe_mgr_mat_entry_info **entries,
+				     int n)
+{
+	int i;
+
+	pipe_mgr_idle_hits_read(idle, entries, n);
+	for (i = 0; i < n; i++)
+		entries[i]->idle_hit_state = ENTRY_IDLE;
+}
+
+static int pipe_mgr_idle_notify_queue(struct pipe_mgr_idle_tbl *idle,
+				      struct pipe_mgr_mat_entry_info *entry,
+				      struct pipe_mgr_idle_notify **head,
+				      struct pipe_mgr_idle_notify **tail)
+{
+	pipe_idle_tmo_expiry_cb_with_match_spec_copy cb2 = NULL;
+	pipe_idle_tmo_expiry_cb cb = NULL;
+	struct pipe_mgr_idle_notify *batch;
+	int status;
+
+	if (idle->params.u.notify.default_callback_choice)
+		cb2 = idle->params.u.notify.callback_fn2;
+	else
+		cb = idle->params.u.notify.callback_fn;
+	if (!cb && !cb2)
+		return BF_SUCCESS;
+
+	batch = *tail;
+	if (!batch || batch->num == PIPE_MGR_IDLE_NOTIFY_BATCH ||
+	    batch->cb != cb || batch->cb2 != cb2 ||
+	    batch->client_data != idle->params.u.notify.client_data ||
+	    batch->dev_id != idle->dev_tgt.device_id) {
+		batch = P4_SDE_CALLOC(1, sizeof(*batch));
+		if (!batch)
+			return BF_NO_SYS_RESOURCES;
+		batch->dev_id = idle->dev_tgt.device_id;
+		batch->cb = cb;
+		batch->cb2 = cb2;
+		batch->client_data = idle->params.u.notify.client_data;
+		if (*tail)
+			(*tail)->next = batch;
+		else
+			*head = batch;
+		*tail = batch;
+	}
+
+	batch->match_specs[batch->num] = NULL;
+	if (cb2) {
+		status = pipe_mgr_match_spec_duplicate
+				(&batch->match_specs[batch->num],
+				 entry->match_spec);
+		if (status)
+			return status;
+	}
+	batch->ent_hdls[batch->num++] = entry->mat_ent_hdl;
+	return BF_SUCCESS;
+}
+
+static void pipe_mgr_idle_notify_deliver(struct pipe_mgr_idle_notify *batch)
+{
+	struct pipe_mgr_idle_notify *next;
+	int i;
+
+	while (batch) {
+		for (i = 0; i < batch->num; i++) {
+			if (batch->cb2)
+				batch->cb2(batch->dev_id, batch->ent_hdls[i],
+					   batch->match_specs[i],
+					   batch->client_data);
+			else
+				batch->cb(batch->dev_id, batch->ent_hdls[i],
+					  batch->client_data);
+		}
+		next = batch->next;
+		P4_SDE_FREE(batch);
+		batch = next;
+	}
+}
+
+/* Sweep a burst of due entries: entries hit since their last sweep get a
+ * fresh TTL, the others are reported once and then kept on the wheel so
+ * that they are re-armed if they are hit again.
+ */
+static void pipe_mgr_idle_sweep_burst(struct pipe_mgr_idle_tbl *idle,
+				      struct pipe_mgr_mat_entry_info **entries,
+				      int n,
+				      struct pipe_mgr_idle_notify **head,
+				      struct pipe_mgr_idle_notify **tail)
+{
+	struct pipe_mgr_mat_entry_info *entry;
+	int i;
+
+	pipe_mgr_idle_hits_read(idle, entries, n);
+
+	for (i = 0; i < n; i++) {
+		entry = entries[i];
+		if (entry->idle_hit_state == ENTRY_ACTIVE) {
+			entry->idle_notified = false;
+		} else if (!entry->idle_notified) {
+			entry->idle_notified = true;
+			if (pipe_mgr_idle_notify_queue(idle, entry, head, tail))
+				LOG_ERROR("Queueing expiry of entry %u of table "
+					  "%s failed", entry->mat_ent_hdl,
+					  idle->tbl->ctx.name);
+		}
+		entry->idle_hit_state = ENTRY_IDLE;
+		pipe_mgr_idle_wheel_schedule(idle, entry);
+	}
+}
+
+/* Advance the wheel of a table by one tick. */
+static void pipe_mgr_idle_tick(struct pipe_mgr_idle_tbl *idle,
+			       struct pipe_mgr_idle_notify **head,
+			       struct pipe_mgr_idle_notify **tail)
+{
+	struct pipe_mgr_mat_entry_info *due[PIPE_MGR_IDLE_HIT_READ_BURST];
+	struct pipe_mgr_mat_entry_info *entry, *list;
+	int level, slot;
+	int n = 0;
+
+	idle->cur_tick++;
+
+	/* Find the highest level whose slot comes due with this tick and
+	 * cascade the entries of that slot and of the levels below it.
+	 */
+	for (level = 1; level < PIPE_MGR_IDLE_WHEEL_LEVELS; level++)
+		if (idle->cur_tick &
+		    ((1ULL << (PIPE_MGR_IDLE_WHEEL_BITS * level)) - 1))
+			break;
+	for (level = level - 1; level > 0; level--) {
+		slot = (idle->cur_tick >> (PIPE_MGR_IDLE_WHEEL_BITS * level)) &
+			PIPE_MGR_IDLE_WHEEL_MASK;
+		list = idle->wheel[level][slot];
+		while (list) {
+			entry = list;
+			list = list->idle_next;
+			pipe_mgr_idle_wheel_link(idle, entry);
+		}
+	}
+
+	slot = idle->cur_tick & PIPE_MGR_IDLE_WHEEL_MASK;
+	list = idle->wheel[0][slot];
+	while (list) {
+		entry = list;
+		list = list->idle_next;
+		if (entry->idle_expiry_tick > idle->cur_tick) {
+			pipe_mgr_idle_wheel_link(idle, entry);
+			continue;
+		}
+		pipe_mgr_idle_wheel_unlink(entry);
+		due[n++] = entry;
+		if (n == PIPE_MGR_IDLE_HIT_READ_BURST) {
+			pipe_mgr_idle_sweep_burst(idle, due, n, head, tail);
+			n = 0;
+		}
+	}
+	pipe_mgr_idle_sweep_burst(idle, due, n, head, tail);
+}
+
+/* Advance the wheels of the tables which are due. Hits are read from the
+ * pipelines, so each table is swept under the read lock of its profile,
+ * the same lock pipe_mgr_api_prologue takes for the commits of the API.
+ * Called with the table list lock held.
+ */
+static void pipe_mgr_idle_sweep(struct pipe_mgr_idle_notify **head,
+				struct pipe_mgr_idle_notify **tail)
+{
+	struct pipe_mgr_profile *profile;
+	struct pipe_mgr_idle_tbl *idle;
+	u64 now;
+
+	for (idle = pipe_mgr_idle_tbls; idle; idle = idle->next) {
+		if (pipe_mgr_get_profile(idle->dev_tgt.device_id,
+					 idle->dev_tgt.dev_pipe_id, &profile))
+			continue;
+		if (P4_SDE_RWLOCK_RDLOCK(&profile->lock))
+			continue;
+		if (P4_SDE_MUTEX_LOCK(&idle->lock)) {
+			P4_SDE_RWLOCK_UNLOCK(&profile->lock);
+			continue;
+		}
+		now = pipe_mgr_idle_now_ms();
+		while (idle->enabled && now >= idle->next_tick_ms) {
+			pipe_mgr_idle_tick(idle, head, tail);
+			idle->next_tick_ms += idle->tick_ms;
+		}
+		P4_SDE_MUTEX_UNLOCK(&idle->lock);
+		P4_SDE_RWLOCK_UNLOCK(&profile->lock);
+	}
+}
+
+static void *pipe_mgr_idle_thread(void *arg)
+{
+	struct pipe_mgr_idle_notify *head, *tail;
+	int sess_hdl;
+
+	(void)arg;
+
+	while (pipe_mgr_idle_thread_run) {
+		head = NULL;
+		tail = NULL;
+
+		/* Locks are taken in the order of the API: the API lock of the
+		 * internal session, then the table list lock, then the profile
+		 * and idle locks of each table.
+		 */
+		if (pipe_mgr_get_int_sess_hdl(&sess_hdl) ||
+		    pipe_mgr_api_enter(sess_hdl)) {
+			P4_SDE_USLEEP(PIPE_MGR_IDLE_THREAD_PERIOD_US);
+			continue;
+		}
+
+		if (P4_SDE_MUTEX_LOCK(&pipe_mgr_idle_lock)) {
+			LOG_ERROR("Acquiring idle table list lock failed");
+			pipe_mgr_api_exit(sess_hdl);
+			P4_SDE_USLEEP(PIPE_MGR_IDLE_THREAD_PERIOD_US);
+			continue;
+		}
+
+		pipe_mgr_idle_sweep(&head, &tail);
+
+		P4_SDE_MUTEX_UNLOCK(&pipe_mgr_idle_lock);
+		pipe_mgr_api_exit(sess_hdl);
+
+		pipe_mgr_idle_notify_deliver(head);
+		P4_SDE_USLEEP(PIPE_MGR_IDLE_THREAD_PERIOD_US);
+	}
+
+	return NULL;
+}
+
+int pipe_mgr_idle_init(void)
+{
+	int status;
+
+	status = P4_SDE_MUTEX_INIT(&pipe_mgr_idle_lock);
+	if (status) {
+		LOG_ERROR("Initializing idle table list lock failed");
+		return BF_UNEXPECTED;
+	}
+
+	pipe_mgr_idle_thread_run = true;
+	status = pthread_create(&pipe_mgr_idle_thread_id, NULL,
+				pipe_mgr_idle_thread, NULL);
+	if (status) {
+		LOG_ERROR("Idle timeout thread creation failed (%d)", status);
+		pipe_mgr_idle_thread_run = false;
+		P4_SDE_MUTEX_DESTROY(&pipe_mgr_idle_lock);
+		return BF_NO_SYS_RESOURCES;
+	}
+	pthread_setname_np(pipe_mgr_idle_thread_id, "pipe_mgr_idle");
+
+	return BF_SUCCESS;
+}
+
+void pipe_mgr_idle_cleanup(void)
+{
+	if (!pipe_mgr_idle_thread_run)
+		return;
+
+	pipe_mgr_idle_thread_run = false;
+	pthread_join(pipe_mgr_idle_thread_id, NULL);
+	pipe_mgr_idle_tbls = NULL;
+	P4_SDE_MUTEX_DESTROY(&pipe_mgr_idle_lock);
+}
+
+void pipe_mgr_idle_entry_add(struct pipe_mgr_mat *tbl,
+			     struct pipe_mgr_mat_entry_info *entry,
+			     u32 ttl)
+{
+	struct pipe_mgr_idle_tbl *idle = tbl->state->idle;
+
+	entry->idle_ttl = ttl;
+	entry->idle_hit_state = ENTRY_IDLE;
+	if (!idle)
+		return;
+
+	if (P4_SDE_MUTEX_LOCK(&idle->lock)) {
+		LOG_ERROR("Acquiring idle lock of table %s failed",
+			  tbl->ctx.name);
+		return;
+	}
+
+	if (idle->enabled) {
+		pipe_mgr_idle_hits_reset(idle, &entry, 1);
+		if (idle->params.mode == NOTIFY_MODE)
+			pipe_mgr_idle_wheel_schedule(idle, entry);
+	}
+
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+}
+
+void pipe_mgr_idle_entry_del(struct pipe_mgr_mat *tbl,
+			     struct pipe_mgr_mat_entry_info *entry)
+{
+	struct pipe_mgr_idle_tbl *idle = tbl->state->idle;
+
+	if (!idle)
+		return;
+
+	if (P4_SDE_MUTEX_LOCK(&idle->lock)) {
+		LOG_ERROR("Acquiring idle lock of table %s failed",
+			  tbl->ctx.name);
+		return;
+	}
+	pipe_mgr_idle_wheel_unlink(entry);
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+}
+
+static void pipe_mgr_idle_tbl_unlist(struct pipe_mgr_idle_tbl *idle)
+{
+	struct pipe_mgr_idle_tbl **p;
+
+	for (p = &pipe_mgr_idle_tbls; *p; p = &(*p)->next) {
+		if (*p == idle) {
+			*p = idle->next;
+			break;
+		}
+	}
+	idle->next = NULL;
+}
+
+void pipe_mgr_idle_tbl_free(struct pipe_mgr_mat_state *mat_state)
+{
+	struct pipe_mgr_idle_tbl *idle = mat_state->idle;
+
+	if (!idle)
+		return;
+
+	if (pipe_mgr_idle_thread_run) {
+		P4_SDE_MUTEX_LOCK(&pipe_mgr_idle_lock);
+		pipe_mgr_idle_tbl_unlist(idle);
+		P4_SDE_MUTEX_UNLOCK(&pipe_mgr_idle_lock);
+	}
+
+	P4_SDE_MUTEX_DESTROY(&idle->lock);
+	P4_SDE_FREE(idle);
+	mat_state->idle = NULL;
+}
+
+/* Run a callback over all the entries of a table in bursts. The default
+ * entry never ages and is skipped. Called with the idle lock of the table
+ * held.
+ */
+static int pipe_mgr_idle_for_each_burst(struct pipe_mgr_idle_tbl *idle,
+		void (*fn)(struct pipe_mgr_idle_tbl *idle,
+			   struct pipe_mgr_mat_entry_info **entries,
+			   int n))
+{
+	struct pipe_mgr_mat_entry_info *burst[PIPE_MGR_IDLE_HIT_READ_BURST];
+	struct pipe_mgr_mat_state *state = idle->tbl->state;
+	struct pipe_mgr_mat_entry_info *entry;
+	p4_sde_map_sts map_sts;
+	p4_sde_map_key key;
+	int n = 0;
+
+	if (P4_SDE_MUTEX_LOCK(&state->lock)) {
+		LOG_ERROR("Acquiring lock for table %s failed",
+			  idle->tbl->ctx.name);
+		return BF_UNEXPECTED;
+	}
+
+	map_sts = P4_SDE_MAP_GET_FIRST(&state->entry_info_htbl, &key,
+				       (void **)&entry);
+	while (map_sts == BF_MAP_OK) {
+		if (!entry->is_default)
+			burst[n++] = entry;
+		if (n == PIPE_MGR_IDLE_HIT_READ_BURST) {
+			fn(idle, burst, n);
+			n = 0;
+		}
+		map_sts = P4_SDE_MAP_GET_NEXT(&state->entry_info_htbl, &key,
+					      (void **)&entry);
+	}
+	if (n)
+		fn(idle, burst, n);
+
+	if (P4_SDE_MUTEX_UNLOCK(&state->lock))
+		LOG_ERROR("Unlock of table %s failed", idle->tbl->ctx.name);
+
+	return BF_SUCCESS;
+}
+
+static void pipe_mgr_idle_arm_burst(struct pipe_mgr_idle_tbl *idle,
+				    struct pipe_mgr_mat_entry_info **entries,
+				    int n)
+{
+	int i;
+
+	pipe_mgr_idle_hits_reset(idle, entries, n);
+	if (idle->params.mode != NOTIFY_MODE)
+		return;
+
+	for (i = 0; i < n; i++) {
+		entries[i]->idle_notified = false;
+		pipe_mgr_idle_wheel_schedule(idle, entries[i]);
+	}
+}
+
+/* Validate the target and the table and take the API locks. On success
+ * the caller must release them with pipe_mgr_idle_api_end. The idle state
+ * of the table is allocated on first use.
+ */
+static int pipe_mgr_idle_api_begin(u32 sess_hdl,
+				   bf_dev_id_t device_id,
+				   u32 mat_tbl_hdl,
+				   struct bf_dev_target_t *dev_tgt,
+				   struct pipe_mgr_idle_tbl **idle_p)
+{
+	struct pipe_mgr_idle_tbl *idle;
+	struct pipe_mgr_mat *tbl;
+	int status;
+
+	dev_tgt->device_id = device_id;
+	dev_tgt->dev_pipe_id = PIPE_MGR_DEFAULT_PIPE_ID;
+
+	status = pipe_mgr_is_pipe_valid(dev_tgt->device_id,
+					dev_tgt->dev_pipe_id);
+	if (status)
+		return status;
+
+	status = pipe_mgr_api_prologue(sess_hdl, *dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		return status;
+	}
+
+	status = pipe_mgr_ctx_get_table(*dev_tgt, mat_tbl_hdl,
+					PIPE_MGR_TABLE_TYPE_MAT, (void *)&tbl);
+	if (status) {
+		LOG_ERROR("Retrieving context json object for table %d failed",
+			  mat_tbl_hdl);
+		goto epilogue;
+	}
+
+	if (!tbl->ctx.store_entries || !tbl->state) {
+		LOG_ERROR("Not supported. Rule entries are not stored");
+		status = BF_NOT_SUPPORTED;
+		goto epilogue;
+	}
+
+	status = P4_SDE_MUTEX_LOCK(&tbl->state->lock);
+	if (status) {
+		LOG_ERROR("Acquiring lock for table %d failed", mat_tbl_hdl);
+		status = BF_UNEXPECTED;
+		goto epilogue;
+	}
+
+	idle = tbl->state->idle;
+	if (!idle) {
+		idle = P4_SDE_CALLOC(1, sizeof(*idle));
+		if (!idle) {
+			status = BF_NO_SYS_RESOURCES;
+		} else if (P4_SDE_MUTEX_INIT(&idle->lock)) {
+			P4_SDE_FREE(idle);
+			status = BF_UNEXPECTED;
+		} else {
+			idle->dev_tgt = *dev_tgt;
+			idle->tbl = tbl;
+			idle->params.mode = POLL_MODE;
+			idle->params.u.notify.ttl_query_interval =
+				PIPE_MGR_IDLE_DEFAULT_QUERY_INTERVAL;
+			idle->tick_ms = PIPE_MGR_IDLE_DEFAULT_QUERY_INTERVAL;
+			idle->hw_hits = true;
+			tbl->state->idle = idle;
+		}
+	}
+
+	P4_SDE_MUTEX_UNLOCK(&tbl->state->lock);
+	if (status)
+		goto epilogue;
+
+	*idle_p = idle;
+	return BF_SUCCESS;
+
+epilogue:
+	pipe_mgr_api_epilogue(sess_hdl, *dev_tgt);
+	return status;
+}
+
+static void pipe_mgr_idle_api_end(u32 sess_hdl, struct bf_dev_target_t dev_tgt)
+{
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+}
+
+/* Lookup an entry of the table. Called with the idle lock held. */
+static int pipe_mgr_idle_entry_get(struct pipe_mgr_idle_tbl *idle,
+				   u32 mat_ent_hdl,
+				   struct pipe_mgr_mat_entry_info **entry)
+{
+	int status;
+
+	status = pipe_mgr_table_get(idle->tbl, PIPE_MGR_TABLE_TYPE_MAT,
+				    idle->dev_tgt.dev_pipe_id, mat_ent_hdl,
+				    (void **)entry);
+	if (status)
+		LOG_ERROR("Failed to retrieve entry for hdl: %d", mat_ent_hdl);
+	return status;
+}
+
+/* Lookup an entry of the table which can age, the default entry can't.
+ * Called with the idle lock held.
+ */
+static int pipe_mgr_idle_aging_entry_get(struct pipe_mgr_idle_tbl *idle,
+					 u32 mat_ent_hdl,
+					 struct pipe_mgr_mat_entry_info **entry)
+{
+	int status;
+
+	status = pipe_mgr_idle_entry_get(idle, mat_ent_hdl, entry);
+	if (status)
+		return status;
+
+	if ((*entry)->is_default) {
+		LOG_ERROR("Default entry %u of table %s does not age",
+			  mat_ent_hdl, idle->tbl->ctx.name);
+		return BF_INVALID_ARG;
+	}
+	return BF_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_idle_get_params(pipe_sess_hdl_t sess_hdl,
+				       bf_dev_id_t device_id,
+				       pipe_mat_tbl_hdl_t mat_tbl_hdl,
+				       pipe_idle_time_params_t *params)
+{
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	if (!params)
+		return BF_INVALID_ARG;
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	*params = idle->params;
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return BF_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_idle_set_params(pipe_sess_hdl_t sess_hdl,
+				       bf_dev_id_t device_id,
+				       pipe_mat_tbl_hdl_t mat_tbl_hdl,
+				       pipe_idle_time_params_t params)
+{
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	if (params.mode != POLL_MODE && params.mode != NOTIFY_MODE) {
+		LOG_ERROR("Invalid idle time mode %d", params.mode);
+		return BF_INVALID_ARG;
+	}
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	if (idle->enabled) {
+		LOG_ERROR("Idle time of table %s must be disabled to change "
+			  "its params", idle->tbl->ctx.name);
+		status = BF_IN_USE;
+	} else {
+		if (!params.u.notify.ttl_query_interval)
+			params.u.notify.ttl_query_interval =
+				PIPE_MGR_IDLE_DEFAULT_QUERY_INTERVAL;
+		idle->params = params;
+		idle->tick_ms = params.u.notify.ttl_query_interval;
+	}
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_idle_tmo_set_enable(pipe_sess_hdl_t sess_hdl,
+					   bf_dev_id_t device_id,
+					   pipe_mat_tbl_hdl_t mat_tbl_hdl,
+					   bool enable)
+{
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	/* The table list lock is taken first, same as the aging thread. */
+	P4_SDE_MUTEX_LOCK(&pipe_mgr_idle_lock);
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+
+	if (enable == idle->enabled)
+		goto unlock;
+
+	if (enable) {
+		idle->cur_tick = 0;
+		idle->next_tick_ms = pipe_mgr_idle_now_ms() + idle->tick_ms;
+		status = pipe_mgr_idle_for_each_burst(idle,
+						      pipe_mgr_idle_arm_burst);
+		if (status) {
+			pipe_mgr_idle_wheel_clear(idle);
+			goto unlock;
+		}
+		if (idle->params.mode == NOTIFY_MODE) {
+			idle->next = pipe_mgr_idle_tbls;
+			pipe_mgr_idle_tbls = idle;
+		}
+	} else {
+		pipe_mgr_idle_tbl_unlist(idle);
+		pipe_mgr_idle_wheel_clear(idle);
+	}
+	idle->enabled = enable;
+
+unlock:
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+	P4_SDE_MUTEX_UNLOCK(&pipe_mgr_idle_lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_idle_tmo_get_enable(pipe_sess_hdl_t sess_hdl,
+					   bf_dev_id_t device_id,
+					   pipe_mat_tbl_hdl_t mat_tbl_hdl,
+					   bool *enable)
+{
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	if (!enable)
+		return BF_INVALID_ARG;
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	*enable = idle->enabled;
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return BF_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_idle_register_tmo_cb(pipe_sess_hdl_t sess_hdl,
+					    bf_dev_id_t device_id,
+					    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+					    pipe_idle_tmo_expiry_cb cb,
+					    void *client_data)
+{
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	idle->params.u.notify.callback_fn = cb;
+	idle->params.u.notify.client_data = client_data;
+	idle->params.u.notify.default_callback_choice = 0;
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return BF_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_idle_register_tmo_cb_with_match_spec_copy(
+		pipe_sess_hdl_t sess_hdl,
+		bf_dev_id_t device_id,
+		pipe_mat_tbl_hdl_t mat_tbl_hdl,
+		pipe_idle_tmo_expiry_cb_with_match_spec_copy cb,
+		void *client_data)
+{
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	idle->params.u.notify.callback_fn2 = cb;
+	idle->params.u.notify.client_data = client_data;
+	idle->params.u.notify.default_callback_choice = 1;
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return BF_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_idle_time_get_hit_state(
+		pipe_sess_hdl_t sess_hdl,
+		bf_dev_id_t device_id,
+		pipe_mat_tbl_hdl_t mat_tbl_hdl,
+		pipe_mat_ent_hdl_t mat_ent_hdl,
+		pipe_idle_time_hit_state_e *idle_time_data)
+{
+	struct pipe_mgr_mat_entry_info *entry;
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	if (!idle_time_data)
+		return BF_INVALID_ARG;
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	status = pipe_mgr_idle_entry_get(idle, mat_ent_hdl, &entry);
+	if (!status)
+		*idle_time_data = entry->idle_hit_state;
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_idle_time_set_hit_state(
+		pipe_sess_hdl_t sess_hdl,
+		bf_dev_id_t device_id,
+		pipe_mat_tbl_hdl_t mat_tbl_hdl,
+		pipe_mat_ent_hdl_t mat_ent_hdl,
+		pipe_idle_time_hit_state_e idle_time_data)
+{
+	struct pipe_mgr_mat_entry_info *entry;
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	if (idle_time_data != ENTRY_IDLE && idle_time_data != ENTRY_ACTIVE)
+		return BF_INVALID_ARG;
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	status = pipe_mgr_idle_entry_get(idle, mat_ent_hdl, &entry);
+	if (!status)
+		entry->idle_hit_state = idle_time_data;
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_idle_time_update_hit_state(
+		pipe_sess_hdl_t sess_hdl,
+		bf_dev_id_t device_id,
+		pipe_mat_tbl_hdl_t mat_tbl_hdl,
+		pipe_idle_tmo_update_complete_cb callback_fn,
+		void *cb_data)
+{
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	if (!idle->enabled || idle->params.mode != POLL_MODE) {
+		LOG_ERROR("Idle time of table %s is not enabled in poll mode",
+			  idle->tbl->ctx.name);
+		status = BF_INVALID_ARG;
+	} else {
+		status = pipe_mgr_idle_for_each_burst(idle,
+						      pipe_mgr_idle_hits_read);
+	}
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+
+	if (!status && callback_fn)
+		callback_fn(device_id, cb_data);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_mat_ent_set_idle_ttl(pipe_sess_hdl_t sess_hdl,
+					    bf_dev_id_t device_id,
+					    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+					    pipe_mat_ent_hdl_t mat_ent_hdl,
+					    uint32_t ttl,
+					    uint32_t pipe_api_flags,
+					    bool reset)
+{
+	struct pipe_mgr_mat_entry_info *entry;
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	u64 expiry;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	status = pipe_mgr_idle_aging_entry_get(idle, mat_ent_hdl, &entry);
+	if (status)
+		goto unlock;
+
+	entry->idle_ttl = ttl;
+	if (!idle->enabled || idle->params.mode != NOTIFY_MODE)
+		goto unlock;
+
+	/* Without reset an entry already counting down keeps the earlier of
+	 * its current and its new expiry.
+	 */
+	expiry = entry->idle_expiry_tick;
+	if (reset || !entry->idle_slot || entry->idle_notified) {
+		entry->idle_notified = false;
+		pipe_mgr_idle_wheel_schedule(idle, entry);
+	} else if (ttl) {
+		pipe_mgr_idle_wheel_schedule(idle, entry);
+		if (expiry < entry->idle_expiry_tick) {
+			entry->idle_expiry_tick = expiry;
+			pipe_mgr_idle_wheel_link(idle, entry);
+		}
+	} else {
+		pipe_mgr_idle_wheel_unlink(entry);
+	}
+
+unlock:
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_mat_ent_reset_idle_ttl(pipe_sess_hdl_t sess_hdl,
+					      bf_dev_id_t device_id,
+					      pipe_mat_tbl_hdl_t mat_tbl_hdl,
+					      pipe_mat_ent_hdl_t mat_ent_hdl)
+{
+	struct pipe_mgr_mat_entry_info *entry;
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	status = pipe_mgr_idle_aging_entry_get(idle, mat_ent_hdl, &entry);
+	if (!status && idle->enabled && idle->params.mode == NOTIFY_MODE) {
+		entry->idle_notified = false;
+		pipe_mgr_idle_wheel_schedule(idle, entry);
+	}
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_mat_ent_get_idle_ttl(pipe_sess_hdl_t sess_hdl,
+					    bf_dev_id_t device_id,
+					    pipe_mat_tbl_hdl_t mat_tbl_hdl,
+					    pipe_mat_ent_hdl_t mat_ent_hdl,
+					    uint32_t *ttl)
+{
+	struct pipe_mgr_mat_entry_info *entry;
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_idle_tbl *idle;
+	u64 remaining;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	if (!ttl)
+		return BF_INVALID_ARG;
+
+	status = pipe_mgr_idle_api_begin(sess_hdl, device_id, mat_tbl_hdl,
+					 &dev_tgt, &idle);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	P4_SDE_MUTEX_LOCK(&idle->lock);
+	status = pipe_mgr_idle_entry_get(idle, mat_ent_hdl, &entry);
+	if (status)
+		goto unlock;
+
+	if (!idle->enabled || idle->params.mode != NOTIFY_MODE ||
+	    !entry->idle_slot) {
+		*ttl = entry->idle_ttl;
+	} else if (entry->idle_notified) {
+		*ttl = 0;
+	} else {
+		/* The TTL is only as accurate as the query interval. */
+		remaining = (entry->idle_expiry_tick - idle->cur_tick) *
+			    idle->tick_ms;
+		*ttl = remaining < entry->idle_ttl ? remaining : entry->idle_ttl;
+	}
+
+unlock:
+	P4_SDE_MUTEX_UNLOCK(&idle->lock);
+	pipe_mgr_idle_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file pipe_mgr_idle.h
+ *
+ * @description Idle timeout (entry aging) for MatchAction tables
+ */
+
+#ifndef __PIPE_MGR_IDLE_H__
+#define __PIPE_MGR_IDLE_H__
+
+#include <pipe_mgr/pipe_mgr_intf.h>
+#include "../infra/pipe_mgr_int.h"
+
+/* Number of levels of the idle timer wheel. */
+#define PIPE_MGR_IDLE_WHEEL_LEVELS 4
+/* Each level of the idle timer wheel has 2^PIPE_MGR_IDLE_WHEEL_BITS slots. */
+#define PIPE_MGR_IDLE_WHEEL_BITS 6
+#define PIPE_MGR_IDLE_WHEEL_SLOTS (1 << PIPE_MGR_IDLE_WHEEL_BITS)
+#define PIPE_MGR_IDLE_WHEEL_MASK (PIPE_MGR_IDLE_WHEEL_SLOTS - 1)
+/* Longest delay (in ticks) the idle timer wheel can hold. */
+#define PIPE_MGR_IDLE_WHEEL_SPAN \
+	(1ULL << (PIPE_MGR_IDLE_WHEEL_BITS * PIPE_MGR_IDLE_WHEEL_LEVELS))
+
+/* Tick of the idle timer wheel in msecs if no query interval is given. */
+#define PIPE_MGR_IDLE_DEFAULT_QUERY_INTERVAL 1000
+/* Number of entries whose hit counts are read from the target at once. */
+#define PIPE_MGR_IDLE_HIT_READ_BURST 256
+/* Number of expired entries delivered to the callbacks per batch. */
+#define PIPE_MGR_IDLE_NOTIFY_BATCH 256
+/* Period of the aging thread in usecs. */
+#define PIPE_MGR_IDLE_THREAD_PERIOD_US 10000
+
+/* Idle timeout state of a MatchAction table. */
+struct pipe_mgr_idle_tbl {
+	/* Mutex to protect all members of this structure and the idle
+	 * state of the table entries.
+	 */
+	p4_sde_mutex lock;
+	struct bf_dev_target_t dev_tgt;
+	/* Table this state belongs to. */
+	struct pipe_mgr_mat *tbl;
+	pipe_idle_time_params_t params;
+	bool enabled;
+	/* Cleared once the target reports it can't read hits of the table,
+	 * only hits set through pipe_mgr_idle_time_set_hit_state are seen
+	 * from then on.
+	 */
+	bool hw_hits;
+
+	/* Hierarchical timer wheel of the entries, used in notify mode. */
+	u32 tick_ms;
+	u64 cur_tick;
+	u64 next_tick_ms;
+	struct pipe_mgr_mat_entry_info *
+		wheel[PIPE_MGR_IDLE_WHEEL_LEVELS][PIPE_MGR_IDLE_WHEEL_SLOTS];
+
+	/* Next table swept by the aging thread. */
+	struct pipe_mgr_idle_tbl *next;
+};
+
+/*!
+ * Start the aging thread.
+ *
+ * @return Status of the API call
+ */
+int pipe_mgr_idle_init(void);
+
+/*!
+ * Stop the aging thread.
+ */
+void pipe_mgr_idle_cleanup(void);
+
+/*!
+ * Start aging a newly added entry.
+ *
+ * @param tbl MatchAction table of the entry
+ * @param entry entry added to the table
+ * @param ttl TTL of the entry in msecs, 0 if the entry does not age
+ */
+void pipe_mgr_idle_entry_add(struct pipe_mgr_mat *tbl,
+			     struct pipe_mgr_mat_entry_info *entry,
+			     u32 ttl);
+
+/*!
+ * Stop aging an entry which is about to be deleted.
+ *
+ * @param tbl MatchAction table of the entry
+ * @param entry entry deleted from the table
+ */
+void pipe_mgr_idle_entry_del(struct pipe_mgr_mat *tbl,
+			     struct pipe_mgr_mat_entry_info *entry);
+
+/*!
+ * Release the idle timeout state of a table.
+ *
+ * @param mat_state table state holding the idle timeout state
+ */
+void pipe_mgr_idle_tbl_free(struct pipe_mgr_mat_state *mat_state);
+
+#endif /* __PIPE_MGR_IDLE_H__ */
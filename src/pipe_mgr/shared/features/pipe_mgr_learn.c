@@ -0,0 +1,775 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file pipe_mgr_learn.c
+ *
+ * @description Learn digest notifications.
+ *
+ * The pipeline sends the digests of a field list to a ring, named in
+ * the digest config of the pipeline. The learn thread drains the rings of
+ * all the field lists from the enable of their pipeline until the device
+ * is removed, since the pipeline stalls on a full ring. Without a
+ * registered callback the digests are dropped and counted. With one, the
+ * thread drops the digests already seen within the dedup window and
+ * collects the others in a batch. A batch is delivered to the callback when it is full or
+ * when its oldest digest has waited for the flush timeout, so a burst
+ * of learns from the datapath turns into a few notifications. Batches
+ * are built while the learn lock is held and delivered once it is
+ * released, and stay owned by the client until pipe_mgr_flow_lrn_notify_ack.
+ */
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include <osdep/p4_sde_osdep_utils.h>
+#include "../dal/dal_digest.h"
+#include "../../core/pipe_mgr_log.h"
+#include "../infra/pipe_mgr_int.h"
+#include "../pipe_mgr_shared_intf.h"
+#include "pipe_mgr_learn.h"
+
+/* Batch of digests handed to a callback. */
+struct pipe_mgr_lrn_msg {
+	/* Must be first, the client acks with a pointer to it. */
+	pipe_flow_lrn_msg_t msg;
+	pipe_sess_hdl_t sess_hdl;
+	pipe_flow_lrn_notify_cb cb;
+	void *cookie;
+	struct pipe_mgr_lrn_msg *next;
+	u8 entries[];
+};
+
+/* Field lists of the enabled pipelines, drained by the learn thread. */
+static struct pipe_mgr_lrn_list *pipe_mgr_lrn_lists;
+/* Mutex to protect the field lists and all their members. */
+static p4_sde_mutex pipe_mgr_lrn_lock;
+static pthread_t pipe_mgr_lrn_thread_id;
+static volatile bool pipe_mgr_lrn_thread_run;
+/* Scratch buffer the rings are read into, only used by the thread. */
+static u8 *pipe_mgr_lrn_scratch;
+static u32 pipe_mgr_lrn_scratch_size;
+
+static u64 pipe_mgr_lrn_now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static u32 pipe_mgr_lrn_hash(const u8 *entry, u32 size)
+{
+	u32 hash = 2166136261u;
+	u32 i;
+
+	for (i = 0; i < size; i++) {
+		hash ^= entry[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static struct pipe_mgr_lrn_list *pipe_mgr_lrn_list_find(
+		bf_dev_id_t device_id,
+		pipe_fld_lst_hdl_t fld_lst_hdl)
+{
+	struct pipe_mgr_lrn_list *list;
+
+	for (list = pipe_mgr_lrn_lists; list; list = list->next) {
+		if (list->dev_tgt.device_id == device_id &&
+		    list->fld_lst_hdl == fld_lst_hdl)
+			return list;
+	}
+	return NULL;
+}
+
+/* Find the digest config of a field list in the pipelines of a device. */
+static int pipe_mgr_lrn_cfg_find(bf_dev_id_t device_id,
+				 pipe_fld_lst_hdl_t fld_lst_hdl,
+				 struct pipe_mgr_profile **profile_p,
+				 struct digest_list_config_s **cfg_p)
+{
+	struct pipe_mgr_profile *profile;
+	u32 num_profiles, i;
+	int status, j;
+
+	status = pipe_mgr_get_num_profiles(device_id, &num_profiles);
+	if (status)
+		return status;
+
+	for (i = 0; i < num_profiles; i++) {
+		status = pipe_mgr_get_profile(device_id, i, &profile);
+		if (status)
+			return status;
+		for (j = 0; j < profile->digest_cfg.num_lists; j++) {
+			if (profile->digest_cfg.lists[j].handle != fld_lst_hdl)
+				continue;
+			*profile_p = profile;
+			*cfg_p = &profile->digest_cfg.lists[j];
+			return BF_SUCCESS;
+		}
+	}
+	return BF_OBJECT_NOT_FOUND;
+}
+
+static void pipe_mgr_lrn_list_free(struct pipe_mgr_lrn_list *list)
+{
+	P4_SDE_FREE(list->pending);
+	P4_SDE_FREE(list->dedup_entries);
+	P4_SDE_FREE(list);
+}
+
+/* Add the learn state of a field list, without a callback. Called with
+ * the learn lock held.
+ */
+static struct pipe_mgr_lrn_list *pipe_mgr_lrn_list_create(
+		bf_dev_id_t device_id,
+		struct pipe_mgr_profile *profile,
+		struct digest_list_config_s *cfg)
+{
+	struct pipe_mgr_lrn_list *list;
+	u32 scratch_size;
+	u8 *scratch;
+
+	scratch_size = PIPE_MGR_LRN_READ_BURST * cfg->entry_size;
+	if (scratch_size > pipe_mgr_lrn_scratch_size) {
+		scratch = P4_SDE_MALLOC(scratch_size);
+		if (!scratch)
+			return NULL;
+		P4_SDE_FREE(pipe_mgr_lrn_scratch);
+		pipe_mgr_lrn_scratch = scratch;
+		pipe_mgr_lrn_scratch_size = scratch_size;
+	}
+
+	list = P4_SDE_CALLOC(1, sizeof(*list));
+	if (!list)
+		return NULL;
+	list->dedup_entries = P4_SDE_CALLOC(PIPE_MGR_LRN_DEDUP_SLOTS,
+					    cfg->entry_size);
+	if (!list->dedup_entries) {
+		pipe_mgr_lrn_list_free(list);
+		return NULL;
+	}
+
+	list->dev_tgt.device_id = device_id;
+	list->dev_tgt.dev_pipe_id = profile->profile_id;
+	list->fld_lst_hdl = cfg->handle;
+	strncpy(list->ring_name, cfg->ring, DIGEST_RING_NAME_LEN - 1);
+	list->entry_size = cfg->entry_size;
+	list->batch_size = profile->digest_cfg.batch_size;
+	if (list->batch_size > UINT16_MAX)
+		list->batch_size = UINT16_MAX;
+	list->flush_timeout_us = profile->digest_cfg.flush_timeout_us;
+	list->dedup_window_us = profile->digest_cfg.dedup_window_us;
+
+	list->next = pipe_mgr_lrn_lists;
+	pipe_mgr_lrn_lists = list;
+	return list;
+}
+
+/* Returns true if the digest was seen within the dedup window, else
+ * remembers it.
+ */
+static bool pipe_mgr_lrn_dedup(struct pipe_mgr_lrn_list *list,
+			       const u8 *entry,
+			       u64 now)
+{
+	u32 slot;
+	u8 *cached;
+
+	if (!list->dedup_window_us)
+		return false;
+
+	slot = pipe_mgr_lrn_hash(entry, list->entry_size) &
+	       (PIPE_MGR_LRN_DEDUP_SLOTS - 1);
+	cached = list->dedup_entries + (size_t)slot * list->entry_size;
+	if (list->dedup_ts[slot] &&
+	    now - list->dedup_ts[slot] < list->dedup_window_us &&
+	    !memcmp(cached, entry, list->entry_size))
+		return true;
+
+	memcpy(cached, entry, list->entry_size);
+	list->dedup_ts[slot] = now;
+	return false;
+}
+
+/* Move the pending digests of a field list into a notification. */
+static void pipe_mgr_lrn_flush(struct pipe_mgr_lrn_list *list,
+			       struct pipe_mgr_lrn_msg **head,
+			       struct pipe_mgr_lrn_msg **tail)
+{
+	struct pipe_mgr_lrn_msg *m;
+	size_t size;
+
+	if (!list->num_pending)
+		return;
+
+	size = (size_t)list->num_pending * list->entry_size;
+	m = P4_SDE_MALLOC(sizeof(*m) + size);
+	if (!m) {
+		LOG_ERROR("Dropping %d digests of field list %d, no memory",
+			  list->num_pending, list->fld_lst_hdl);
+		list->num_pending = 0;
+		return;
+	}
+
+	memcpy(m->entries, list->pending, size);
+	m->msg.dev_tgt = list->dev_tgt;
+	m->msg.num_entries = list->num_pending;
+	m->msg.entries = m->entries;
+	m->msg.flow_lrn_fld_lst_hdl = list->fld_lst_hdl;
+	m->sess_hdl = list->sess_hdl;
+	m->cb = list->cb;
+	m->cookie = list->cookie;
+	m->next = NULL;
+	if (*tail)
+		(*tail)->next = m;
+	else
+		*head = m;
+	*tail = m;
+
+	list->num_pending = 0;
+	list->unacked++;
+	list->num_msgs++;
+}
+
+/* Size the pending batch for the current batch size. Pending digests
+ * are flushed first.
+ */
+static int pipe_mgr_lrn_resize(struct pipe_mgr_lrn_list *list,
+			       struct pipe_mgr_lrn_msg **head,
+			       struct pipe_mgr_lrn_msg **tail)
+{
+	u8 *pending;
+
+	pipe_mgr_lrn_flush(list, head, tail);
+
+	pending = P4_SDE_MALLOC((size_t)list->batch_size * list->entry_size);
+	if (!pending)
+		return BF_NO_SYS_RESOURCES;
+
+	P4_SDE_FREE(list->pending);
+	list->pending = pending;
+	list->pending_cap = list->batch_size;
+	return BF_SUCCESS;
+}
+
+static void pipe_mgr_lrn_drain(struct pipe_mgr_lrn_list *list,
+			       struct pipe_mgr_lrn_msg **head,
+			       struct pipe_mgr_lrn_msg **tail)
+{
+	u32 drained = 0, num, max, i;
+	u8 *entry;
+	u64 now;
+
+	now = pipe_mgr_lrn_now_us();
+	if (!list->ring) {
+		if (now < list->next_attach_us)
+			return;
+		if (dal_digest_ring_attach(list->ring_name, &list->ring)) {
+			list->next_attach_us = now + PIPE_MGR_LRN_ATTACH_RETRY_US;
+			return;
+		}
+	}
+
+	max = pipe_mgr_lrn_scratch_size / list->entry_size;
+	if (max > PIPE_MGR_LRN_READ_BURST)
+		max = PIPE_MGR_LRN_READ_BURST;
+
+	/* Without a callback the digests have nowhere to go, they are
+	 * dropped so that the ring never fills up.
+	 */
+	if (!list->cb) {
+		while (drained < PIPE_MGR_LRN_MAX_DRAIN) {
+			if (dal_digest_read(list->ring, pipe_mgr_lrn_scratch,
+					    list->entry_size, max, &num) ||
+			    !num)
+				break;
+			drained += num;
+			list->num_digests += num;
+			list->num_no_cb_drops += num;
+		}
+		return;
+	}
+
+	if (list->pending_cap != list->batch_size &&
+	    pipe_mgr_lrn_resize(list, head, tail))
+		return;
+
+	/* The ring is drained even when the client is behind on its acks,
+	 * so the pipeline never stalls on a full ring. Digests which can't
+	 * be queued are dropped and counted.
+	 */
+	while (drained < PIPE_MGR_LRN_MAX_DRAIN) {
+		if (dal_digest_read(list->ring, pipe_mgr_lrn_scratch,
+				    list->entry_size, max, &num) || !num)
+			break;
+		drained += num;
+		list->num_digests += num;
+
+		for (i = 0; i < num; i++) {
+			if (list->unacked >= PIPE_MGR_LRN_MAX_UNACKED) {
+				list->num_drops += num - i;
+				break;
+			}
+			entry = pipe_mgr_lrn_scratch +
+				(size_t)i * list->entry_size;
+			if (pipe_mgr_lrn_dedup(list, entry, now)) {
+				list->num_dups++;
+				continue;
+			}
+			if (!list->num_pending)
+				list->first_pending_us = now;
+			memcpy(list->pending +
+			       (size_t)list->num_pending * list->entry_size,
+			       entry, list->entry_size);
+			if (++list->num_pending == list->pending_cap)
+				pipe_mgr_lrn_flush(list, head, tail);
+		}
+	}
+
+	if (list->num_pending && list->unacked < PIPE_MGR_LRN_MAX_UNACKED &&
+	    now - list->first_pending_us >= list->flush_timeout_us)
+		pipe_mgr_lrn_flush(list, head, tail);
+}
+
+static void pipe_mgr_lrn_deliver(struct pipe_mgr_lrn_msg *m)
+{
+	struct pipe_mgr_lrn_msg *next;
+
+	for (; m; m = next) {
+		next = m->next;
+		m->cb(m->sess_hdl, &m->msg, m->cookie);
+	}
+}
+
+static void *pipe_mgr_lrn_thread(void *arg)
+{
+	struct pipe_mgr_lrn_msg *head, *tail;
+	struct pipe_mgr_lrn_list *list;
+
+	(void)arg;
+
+	while (pipe_mgr_lrn_thread_run) {
+		head = NULL;
+		tail = NULL;
+
+		if (P4_SDE_MUTEX_LOCK(&pipe_mgr_lrn_lock)) {
+			LOG_ERROR("Acquiring learn lock failed");
+			P4_SDE_USLEEP(PIPE_MGR_LRN_THREAD_PERIOD_US);
+			continue;
+		}
+
+		for (list = pipe_mgr_lrn_lists; list; list = list->next)
+			pipe_mgr_lrn_drain(list, &head, &tail);
+
+		P4_SDE_MUTEX_UNLOCK(&pipe_mgr_lrn_lock);
+
+		pipe_mgr_lrn_deliver(head);
+		P4_SDE_USLEEP(PIPE_MGR_LRN_THREAD_PERIOD_US);
+	}
+
+	return NULL;
+}
+
+int pipe_mgr_lrn_init(void)
+{
+	int status;
+
+	status = P4_SDE_MUTEX_INIT(&pipe_mgr_lrn_lock);
+	if (status) {
+		LOG_ERROR("Initializing learn lock failed");
+		return BF_UNEXPECTED;
+	}
+
+	pipe_mgr_lrn_thread_run = true;
+	status = pthread_create(&pipe_mgr_lrn_thread_id, NULL,
+				pipe_mgr_lrn_thread, NULL);
+	if (status) {
+		LOG_ERROR("Learn thread creation failed (%d)", status);
+		pipe_mgr_lrn_thread_run = false;
+		P4_SDE_MUTEX_DESTROY(&pipe_mgr_lrn_lock);
+		return BF_NO_SYS_RESOURCES;
+	}
+	pthread_setname_np(pipe_mgr_lrn_thread_id, "pipe_mgr_lrn");
+
+	return BF_SUCCESS;
+}
+
+void pipe_mgr_lrn_cleanup(void)
+{
+	struct pipe_mgr_lrn_list *list;
+
+	if (!pipe_mgr_lrn_thread_run)
+		return;
+
+	pipe_mgr_lrn_thread_run = false;
+	pthread_join(pipe_mgr_lrn_thread_id, NULL);
+
+	while (pipe_mgr_lrn_lists) {
+		list = pipe_mgr_lrn_lists;
+		pipe_mgr_lrn_lists = list->next;
+		pipe_mgr_lrn_list_free(list);
+	}
+	P4_SDE_FREE(pipe_mgr_lrn_scratch);
+	pipe_mgr_lrn_scratch = NULL;
+	pipe_mgr_lrn_scratch_size = 0;
+	P4_SDE_MUTEX_DESTROY(&pipe_mgr_lrn_lock);
+}
+
+int pipe_mgr_lrn_profile_add(bf_dev_id_t device_id, int profile_id)
+{
+	struct pipe_mgr_profile *profile;
+	struct digest_list_config_s *cfg;
+	int status, j;
+
+	if (!pipe_mgr_lrn_thread_run)
+		return BF_SUCCESS;
+
+	status = pipe_mgr_get_profile(device_id, profile_id, &profile);
+	if (status)
+		return status;
+
+	if (P4_SDE_MUTEX_LOCK(&pipe_mgr_lrn_lock)) {
+		LOG_ERROR("Acquiring learn lock failed");
+		return BF_UNEXPECTED;
+	}
+
+	for (j = 0; j < profile->digest_cfg.num_lists; j++) {
+		cfg = &profile->digest_cfg.lists[j];
+		/* Already there when registered before the enable */
+		if (pipe_mgr_lrn_list_find(device_id, cfg->handle))
+			continue;
+		if (!pipe_mgr_lrn_list_create(device_id, profile, cfg)) {
+			LOG_ERROR("No memory for the learn state of field "
+				  "list %d", cfg->handle);
+			status = BF_NO_SYS_RESOURCES;
+			break;
+		}
+	}
+
+	P4_SDE_MUTEX_UNLOCK(&pipe_mgr_lrn_lock);
+	return status;
+}
+
+void pipe_mgr_lrn_device_remove(bf_dev_id_t device_id)
+{
+	struct pipe_mgr_lrn_list **prev, *list;
+
+	if (!pipe_mgr_lrn_thread_run)
+		return;
+
+	if (P4_SDE_MUTEX_LOCK(&pipe_mgr_lrn_lock)) {
+		LOG_ERROR("Acquiring learn lock failed");
+		return;
+	}
+
+	prev = &pipe_mgr_lrn_lists;
+	while (*prev) {
+		list = *prev;
+		if (list->dev_tgt.device_id != device_id) {
+			prev = &list->next;
+			continue;
+		}
+		*prev = list->next;
+		pipe_mgr_lrn_list_free(list);
+	}
+
+	P4_SDE_MUTEX_UNLOCK(&pipe_mgr_lrn_lock);
+}
+
+static int pipe_mgr_lrn_api_begin(u32 sess_hdl,
+				  bf_dev_id_t device_id,
+				  struct bf_dev_target_t *dev_tgt)
+{
+	int status;
+
+	dev_tgt->device_id = device_id;
+	dev_tgt->dev_pipe_id = PIPE_MGR_DEFAULT_PIPE_ID;
+
+	status = pipe_mgr_is_pipe_valid(dev_tgt->device_id,
+					dev_tgt->dev_pipe_id);
+	if (status)
+		return status;
+
+	status = pipe_mgr_api_prologue(sess_hdl, *dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		return status;
+	}
+
+	status = P4_SDE_MUTEX_LOCK(&pipe_mgr_lrn_lock);
+	if (status) {
+		LOG_ERROR("Acquiring learn lock failed");
+		pipe_mgr_api_epilogue(sess_hdl, *dev_tgt);
+		return BF_UNEXPECTED;
+	}
+	return BF_SUCCESS;
+}
+
+static void pipe_mgr_lrn_api_end(u32 sess_hdl, struct bf_dev_target_t dev_tgt)
+{
+	P4_SDE_MUTEX_UNLOCK(&pipe_mgr_lrn_lock);
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+}
+
+pipe_status_t pipe_mgr_lrn_digest_notification_register(
+		pipe_sess_hdl_t sess_hdl,
+		bf_dev_id_t device_id,
+		pipe_fld_lst_hdl_t flow_lrn_fld_lst_hdl,
+		pipe_flow_lrn_notify_cb callback_fn,
+		void *callback_fn_cookie)
+{
+	struct digest_list_config_s *cfg;
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_profile *profile;
+	struct pipe_mgr_lrn_list *list;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	if (!callback_fn)
+		return BF_INVALID_ARG;
+
+	status = pipe_mgr_lrn_api_begin(sess_hdl, device_id, &dev_tgt);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	/* The list is created by the enable of its pipeline, or here when
+	 * the callback comes first.
+	 */
+	list = pipe_mgr_lrn_list_find(device_id, flow_lrn_fld_lst_hdl);
+	if (!list) {
+		status = pipe_mgr_lrn_cfg_find(device_id, flow_lrn_fld_lst_hdl,
+					       &profile, &cfg);
+		if (status) {
+			LOG_ERROR("No digest ring configured for field list %d",
+				  flow_lrn_fld_lst_hdl);
+			goto end;
+		}
+
+		list = pipe_mgr_lrn_list_create(device_id, profile, cfg);
+		if (!list) {
+			status = BF_NO_SYS_RESOURCES;
+			goto end;
+		}
+	}
+
+	list->sess_hdl = sess_hdl;
+	list->cb = callback_fn;
+	list->cookie = callback_fn_cookie;
+
+end:
+	pipe_mgr_lrn_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_lrn_digest_notification_deregister(
+		pipe_sess_hdl_t sess_hdl,
+		bf_dev_id_t device_id,
+		pipe_fld_lst_hdl_t flow_lrn_fld_lst_hdl)
+{
+	struct pipe_mgr_lrn_list *list;
+	struct bf_dev_target_t dev_tgt;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_lrn_api_begin(sess_hdl, device_id, &dev_tgt);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	/* The ring is still drained, the digests pending and the next ones
+	 * are dropped until a callback is registered again.
+	 */
+	list = pipe_mgr_lrn_list_find(device_id, flow_lrn_fld_lst_hdl);
+	if (list && list->cb) {
+		list->num_no_cb_drops += list->num_pending;
+		list->num_pending = 0;
+		list->cb = NULL;
+		list->cookie = NULL;
+		list->sess_hdl = 0;
+	} else {
+		status = BF_OBJECT_NOT_FOUND;
+	}
+
+	pipe_mgr_lrn_api_end(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_flow_lrn_notify_ack(
+		pipe_sess_hdl_t sess_hdl,
+		pipe_fld_lst_hdl_t flow_lrn_fld_lst_hdl,
+		pipe_flow_lrn_msg_t *pipe_flow_lrn_msg)
+{
+	struct pipe_mgr_lrn_list *list;
+
+	(void)sess_hdl;
+
+	if (!pipe_flow_lrn_msg)
+		return BF_INVALID_ARG;
+
+	if (!P4_SDE_MUTEX_LOCK(&pipe_mgr_lrn_lock)) {
+		list = pipe_mgr_lrn_list_find(
+				pipe_flow_lrn_msg->dev_tgt.device_id,
+				flow_lrn_fld_lst_hdl);
+		if (list && list->unacked)
+			list->unacked--;
+		P4_SDE_MUTEX_UNLOCK(&pipe_mgr_lrn_lock);
+	}
+
+	P4_SDE_FREE((struct pipe_mgr_lrn_msg *)pipe_flow_lrn_msg);
+	return BF_SUCCESS;
+}
+
+static void pipe_mgr_lrn_cfg_timeout_set(struct digest_config_s *cfg,
+					 u32 usecs)
+{
+	cfg->flush_timeout_us = usecs;
+}
+
+static void pipe_mgr_lrn_list_timeout_set(struct pipe_mgr_lrn_list *list,
+					  u32 usecs)
+{
+	list->flush_timeout_us = usecs;
+}
+
+static void pipe_mgr_lrn_cfg_batch_size_set(struct digest_config_s *cfg,
+					    u32 batch_size)
+{
+	cfg->batch_size = batch_size;
+}
+
+/* The learn thread resizes the pending batch on its next drain. */
+static void pipe_mgr_lrn_list_batch_size_set(struct pipe_mgr_lrn_list *list,
+					     u32 batch_size)
+{
+	list->batch_size = batch_size;
+}
+
+/* Apply a tunable to the digest config of all the pipelines of a device
+ * and to the field lists already registered on it.
+ */
+static pipe_status_t pipe_mgr_lrn_tunable_set(
+		pipe_sess_hdl_t sess_hdl,
+		bf_dev_id_t device_id,
+		void (*cfg_set)(struct digest_config_s *cfg, u32 value),
+		void (*list_set)(struct pipe_mgr_lrn_list *list, u32 value),
+		u32 value)
+{
+	struct bf_dev_target_t dev_tgt;
+	struct pipe_mgr_profile *profile;
+	struct pipe_mgr_lrn_list *list;
+	u32 num_profiles, i;
+	int status;
+
+	status = pipe_mgr_lrn_api_begin(sess_hdl, device_id, &dev_tgt);
+	if (status)
+		return status;
+
+	status = pipe_mgr_get_num_profiles(device_id, &num_profiles);
+	for (i = 0; !status && i < num_profiles; i++) {
+		status = pipe_mgr_get_profile(device_id, i, &profile);
+		if (!status)
+			cfg_set(&profile->digest_cfg, value);
+	}
+
+	for (list = pipe_mgr_lrn_lists; list; list = list->next) {
+		if (list->dev_tgt.device_id == device_id)
+			list_set(list, value);
+	}
+
+	pipe_mgr_lrn_api_end(sess_hdl, dev_tgt);
+	return status;
+}
+
+pipe_status_t pipe_mgr_flow_lrn_set_timeout(pipe_sess_hdl_t sess_hdl,
+					    bf_dev_id_t device_id,
+					    uint32_t usecs)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+	status = pipe_mgr_lrn_tunable_set(sess_hdl, device_id,
+					  pipe_mgr_lrn_cfg_timeout_set,
+					  pipe_mgr_lrn_list_timeout_set,
+					  usecs);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_flow_lrn_get_timeout(bf_dev_id_t device_id,
+					    uint32_t *usecs)
+{
+	struct pipe_mgr_profile *profile;
+	int status;
+
+	if (!usecs)
+		return BF_INVALID_ARG;
+
+	status = pipe_mgr_get_profile(device_id, PIPE_MGR_DEFAULT_PIPE_ID,
+				      &profile);
+	if (status)
+		return status;
+
+	*usecs = profile->digest_cfg.flush_timeout_us;
+	return BF_SUCCESS;
+}
+
+pipe_status_t pipe_mgr_flow_lrn_set_batch_size(pipe_sess_hdl_t sess_hdl,
+					       bf_dev_id_t device_id,
+					       uint32_t batch_size)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+	if (!batch_size || batch_size > UINT16_MAX) {
+		LOG_ERROR("Invalid digest batch size %d", batch_size);
+		return BF_INVALID_ARG;
+	}
+
+	status = pipe_mgr_lrn_tunable_set(sess_hdl, device_id,
+					  pipe_mgr_lrn_cfg_batch_size_set,
+					  pipe_mgr_lrn_list_batch_size_set,
+					  batch_size);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_flow_lrn_get_batch_size(bf_dev_id_t device_id,
+					       uint32_t *batch_size)
+{
+	struct pipe_mgr_profile *profile;
+	int status;
+
+	if (!batch_size)
+		return BF_INVALID_ARG;
+
+	status = pipe_mgr_get_profile(device_id, PIPE_MGR_DEFAULT_PIPE_ID,
+				      &profile);
+	if (status)
+		return status;
+
+	*batch_size = profile->digest_cfg.batch_size;
+	return BF_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file pipe_mgr_learn.h
+ *
+ * @description Learn digest notifications
+ */
+
+#ifndef __PIPE_MGR_LEARN_H__
+#define __PIPE_MGR_LEARN_H__
+
+#include <pipe_mgr/pipe_mgr_intf.h>
+#include "../infra/pipe_mgr_int.h"
+
+/* Number of digests read from a ring at once. */
+#define PIPE_MGR_LRN_READ_BURST 256
+/* Max number of digests read from a ring per period of the thread. */
+#define PIPE_MGR_LRN_MAX_DRAIN 4096
+/* Number of slots of the per field list dedup cache. */
+#define PIPE_MGR_LRN_DEDUP_SLOTS 1024
+/* Max number of notifications of a field list waiting for an ack. Once
+ * reached, digests are still drained from the ring but dropped until the
+ * client catches up.
+ */
+#define PIPE_MGR_LRN_MAX_UNACKED 64
+/* Period of the learn thread in usecs. */
+#define PIPE_MGR_LRN_THREAD_PERIOD_US 100
+/* Interval in usecs between attempts to find a ring not created yet. */
+#define PIPE_MGR_LRN_ATTACH_RETRY_US 1000000
+
+/* Learn state of a digest field list, from the enable of its pipeline
+ * until the device is removed. cb is NULL while no callback is registered.
+ */
+struct pipe_mgr_lrn_list {
+	struct bf_dev_target_t dev_tgt;
+	pipe_fld_lst_hdl_t fld_lst_hdl;
+	char ring_name[DIGEST_RING_NAME_LEN];
+	/* Ring handle from the DAL, NULL until the ring port is created. */
+	void *ring;
+	u64 next_attach_us;
+	u32 entry_size;
+
+	pipe_sess_hdl_t sess_hdl;
+	pipe_flow_lrn_notify_cb cb;
+	void *cookie;
+
+	/* Tunables, taken from the pipeline profile. */
+	u32 batch_size;
+	u32 flush_timeout_us;
+	u32 dedup_window_us;
+
+	/* Batch being filled, room for pending_cap entries. */
+	u8 *pending;
+	u32 pending_cap;
+	u32 num_pending;
+	u64 first_pending_us;
+
+	/* Direct mapped cache of the recently seen digests. */
+	u8 *dedup_entries;
+	u64 dedup_ts[PIPE_MGR_LRN_DEDUP_SLOTS];
+
+	u32 unacked;
+	u64 num_digests;
+	u64 num_dups;
+	u64 num_msgs;
+	/* Digests dropped while PIPE_MGR_LRN_MAX_UNACKED were unacked. */
+	u64 num_drops;
+	/* Digests dropped while no callback was registered. */
+	u64 num_no_cb_drops;
+
+	struct pipe_mgr_lrn_list *next;
+};
+
+/*!
+ * Start the learn thread.
+ *
+ * @return Status of the API call
+ */
+int pipe_mgr_lrn_init(void);
+
+/*!
+ * Stop the learn thread and release the learn state of all the field
+ * lists.
+ */
+void pipe_mgr_lrn_cleanup(void);
+
+/*!
+ * Start draining the digest rings of the field lists of an enabled
+ * pipeline, whether or not a callback is registered for them.
+ *
+ * @param device_id Device ID
+ * @param profile_id Profile of the pipeline
+ * @return Status of the API call
+ */
+int pipe_mgr_lrn_profile_add(bf_dev_id_t device_id, int profile_id);
+
+/*!
+ * Release the learn state of the field lists of a device.
+ *
+ * @param device_id Device ID
+ */
+void pipe_mgr_lrn_device_remove(bf_dev_id_t device_id);
+
+#endif /* __PIPE_MGR_LEARN_H__ */
@@ -21,7 +21,10 @@
 #include "../infra/pipe_mgr_ctx_util.h"
 #include "../infra/pipe_mgr_tbl.h"
 #include "../infra/pipe_mgr_int.h"
+#include "../infra/pipe_mgr_session.h"
+#include "../pipe_mgr_shared_intf.h"
 #include "pipe_mgr_counters.h"
+#include "pipe_mgr_idle.h"
 
 void pipe_mgr_delete_act_data_spec(struct pipe_action_spec *ads)
 {
@@ -218,6 +221,26 @@ error_match_spec:
 	return status;
 }
 
+pipe_status_t pipe_mgr_match_spec_duplicate(
+		pipe_tbl_match_spec_t **match_spec_dest,
+		pipe_tbl_match_spec_t const *match_spec_src)
+{
+	if (!match_spec_dest || !match_spec_src)
+		return BF_INVALID_ARG;
+
+	return pipe_mgr_mat_pack_match_spec(match_spec_dest,
+			(struct pipe_tbl_match_spec *)match_spec_src);
+}
+
+pipe_status_t pipe_mgr_match_spec_free(pipe_tbl_match_spec_t *match_spec)
+{
+	if (!match_spec)
+		return BF_INVALID_ARG;
+
+	pipe_mgr_delete_match_spec(match_spec);
+	return BF_SUCCESS;
+}
+
 static void pipe_mgr_mat_delete_entry_data(
 		struct pipe_mgr_mat_entry_info *entry)
 {
@@ -434,6 +457,7 @@ int pipe_mgr_mat_ent_add(u32 sess_hdl,
 			LOG_ERROR("Error in inserting entry in table");
 			goto cleanup_entry;
 		}
+		pipe_mgr_idle_entry_add(tbl, entry, ttl);
 	}
 
 	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
@@ -515,6 +539,7 @@ int pipe_mgr_mat_default_ent_add(u32 sess_hdl,
 		LOG_ERROR("Entry encoding failed");
 		goto cleanup;
 	}
+	entry->is_default = true;
 
 	status = dal_table_default_ent_add(sess_hdl, dev_tgt, mat_tbl_hdl,
 					   act_fn_hdl, act_data_spec,
@@ -637,6 +662,7 @@ int pipe_mgr_mat_ent_del_by_match_spec(u32 sess_hdl,
 			LOG_ERROR("table entry del failed");
 			goto cleanup;
 		}
+		pipe_mgr_idle_entry_del(tbl, entry);
 		pipe_mgr_mat_delete_entry_data(entry);
 	}
 
@@ -783,6 +809,62 @@ cleanup:
         return status;
 }
 
+pipe_status_t pipe_mgr_get_entry_count(pipe_sess_hdl_t sess_hdl,
+				       dev_target_t dev_tgt,
+				       pipe_mat_tbl_hdl_t tbl_hdl,
+				       bool read_from_hw,
+				       uint32_t *count)
+{
+	struct pipe_mgr_mat *tbl;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_is_pipe_valid(dev_tgt.device_id, dev_tgt.dev_pipe_id);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = pipe_mgr_ctx_get_table(dev_tgt, tbl_hdl,
+					PIPE_MGR_TABLE_TYPE_MAT, (void *)&tbl);
+	if (status) {
+		LOG_ERROR("Retrieving context json object for table %d failed",
+			  tbl_hdl);
+		goto cleanup;
+	}
+
+	/* Learner tables are filled by the pipeline itself and the
+	 * target has no way to count or walk their entries.
+	 */
+	if (!tbl->ctx.store_entries) {
+		LOG_TRACE("Entries of table %s are not stored in SDE",
+			  tbl->ctx.name);
+		status = BF_NOT_SUPPORTED;
+		goto cleanup;
+	}
+
+	/* The count is kept up to date by every entry add/delete, so
+	 * reading it does not depend on the size of the table.
+	 */
+	P4_SDE_MUTEX_LOCK(&tbl->state->lock);
+	*count = tbl->state->num_entries;
+	P4_SDE_MUTEX_UNLOCK(&tbl->state->lock);
+
+cleanup:
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
 int pipe_mgr_get_first_entry(u32 sess_hdl,
                              u32 mat_tbl_hdl,
                              struct bf_dev_target_t dev_tgt,
@@ -872,7 +954,9 @@ int pipe_mgr_get_next_n_by_key(u32 sess_hdl,
                                            cur_match_spec, n, match_specs,
                                            act_specs, act_fn_hdls, num,
                                            &tbl->ctx);
-        if (status)
+	if (status != BF_SUCCESS &&
+	    status != BF_OBJECT_NOT_FOUND &&
+	    status != BF_NOT_SUPPORTED)
                 LOG_ERROR("Getting next n entries failed for table %d",
                           mat_tbl_hdl);
 
@@ -882,3 +966,78 @@ cleanup:
         LOG_TRACE("Exiting %s", __func__);
         return status;
 }
+
+pipe_status_t pipe_mgr_learner_timeout_set(pipe_sess_hdl_t sess_hdl,
+					   dev_target_t dev_tgt,
+					   uint32_t timeout_id,
+					   uint32_t timeout)
+{
+	struct pipe_mgr_profile *profile;
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_is_pipe_valid(dev_tgt.device_id, dev_tgt.dev_pipe_id);
+	if (status) {
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = pipe_mgr_api_enter(sess_hdl);
+	if (status) {
+		LOG_ERROR("API enter failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = pipe_mgr_get_profile(dev_tgt.device_id,
+				      dev_tgt.dev_pipe_id, &profile);
+	if (status)
+		goto api_exit;
+
+	/* The timer profiles are kept in the profile, write lock it rather
+	 * than taking the read lock of pipe_mgr_api_prologue.
+	 */
+	if (P4_SDE_RWLOCK_WRLOCK(&profile->lock)) {
+		status = BF_UNEXPECTED;
+		goto api_exit;
+	}
+
+	status = dal_learner_timeout_set(dev_tgt, timeout_id, timeout);
+	if (status)
+		LOG_ERROR("Setting learner timer profile %d failed",
+			  timeout_id);
+
+	if (P4_SDE_RWLOCK_UNLOCK(&profile->lock))
+		LOG_ERROR("Unlocking profile %d failed", dev_tgt.dev_pipe_id);
+
+api_exit:
+	pipe_mgr_api_exit(sess_hdl);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_learner_timeout_get(pipe_sess_hdl_t sess_hdl,
+					   dev_target_t dev_tgt,
+					   uint32_t timeout_id,
+					   uint32_t *timeout)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = dal_learner_timeout_get(dev_tgt, timeout_id, timeout);
+
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
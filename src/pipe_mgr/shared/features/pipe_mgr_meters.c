@@ -0,0 +1,239 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file pipe_mgr_meters.c
+ *
+ * @description Utilities for meters
+ */
+#include <pipe_mgr/pipe_mgr_intf.h>
+#include "../infra/pipe_mgr_int.h"
+#include "pipe_mgr_meters.h"
+#include "../dal/dal_meters.h"
+#include "../../shared/pipe_mgr_shared_intf.h"
+#include "../../core/pipe_mgr_ctx_json.h"
+
+/*!
+ * Program a meter index with the given spec.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param meter_idx meter index to be programmed
+ * @param meter_spec meter spec to be applied
+ * @return Status of the API call
+ */
+bf_status_t pipe_mgr_meter_mod_indirect_meter_set(dev_target_t dev_tgt,
+						  const char *table_name,
+						  pipe_meter_idx_t meter_idx,
+						  pipe_meter_spec_t *meter_spec)
+{
+	return dal_meter_ent_set(dev_tgt, table_name, meter_idx, meter_spec);
+}
+
+/*!
+ * Read back the meter spec programmed on a meter index.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param meter_idx meter index to be read
+ * @param meter_spec buffer to fill the meter spec
+ * @return Status of the API call
+ */
+bf_status_t pipe_mgr_meter_read_indirect_meter_set(dev_target_t dev_tgt,
+						   const char *table_name,
+						   pipe_meter_idx_t meter_idx,
+						   pipe_meter_spec_t *meter_spec)
+{
+	return dal_meter_ent_get(dev_tgt, table_name, meter_idx, meter_spec);
+}
+
+/*!
+ * routine to reset a meter table
+ */
+bf_status_t pipe_mgr_meter_reset(pipe_sess_hdl_t sess_hdl,
+				 dev_target_t dev_tgt,
+				 const char *table_name,
+				 uint32_t pipe_api_flags)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = dal_meter_reset(dev_tgt, table_name);
+
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+/*!
+ * routine to update a meter entry specification
+ */
+bf_status_t pipe_mgr_meter_ent_set(pipe_sess_hdl_t sess_hdl,
+				   dev_target_t dev_tgt,
+				   const char *table_name,
+				   pipe_meter_idx_t meter_idx,
+				   pipe_meter_spec_t *meter_spec,
+				   uint32_t pipe_api_flags)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = pipe_mgr_meter_mod_indirect_meter_set(dev_tgt,
+						       table_name,
+						       meter_idx,
+						       meter_spec);
+
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+/*!
+ * routine to read a meter entry specification
+ */
+bf_status_t pipe_mgr_meter_read_entry_idx(pipe_sess_hdl_t sess_hdl,
+					  dev_target_t dev_tgt,
+					  const char *table_name,
+					  pipe_meter_idx_t index,
+					  pipe_meter_spec_t *meter_spec)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = pipe_mgr_meter_read_indirect_meter_set(dev_tgt,
+							table_name,
+							index,
+							meter_spec);
+
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+/*!
+ * routine to read the per color statistics of a meter entry
+ */
+bf_status_t pipe_mgr_meter_stats_read(pipe_sess_hdl_t sess_hdl,
+				      dev_target_t dev_tgt,
+				      const char *table_name,
+				      pipe_meter_idx_t index,
+				      pipe_meter_stats_t *meter_stats)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = dal_meter_stats_read(dev_tgt, table_name, index, meter_stats);
+
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+/*!
+ * routine to apply one meter specification to a range of meter entries
+ */
+bf_status_t pipe_mgr_meter_ent_set_range(pipe_sess_hdl_t sess_hdl,
+					 dev_target_t dev_tgt,
+					 const char *table_name,
+					 pipe_meter_idx_t start_idx,
+					 pipe_meter_idx_t end_idx,
+					 pipe_meter_spec_t *meter_spec)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = dal_meter_ent_set_range(dev_tgt, table_name, start_idx,
+					 end_idx, meter_spec);
+
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+/*!
+ * routine to read the per color statistics of a range of meter entries
+ */
+bf_status_t pipe_mgr_meter_stats_read_range(pipe_sess_hdl_t sess_hdl,
+					     dev_target_t dev_tgt,
+					     const char *table_name,
+					     pipe_meter_idx_t start_idx,
+					     pipe_meter_idx_t end_idx,
+					     pipe_meter_stats_t *meter_stats)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = dal_meter_stats_read_range(dev_tgt, table_name, start_idx,
+					    end_idx, meter_stats);
+
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*!
+ * @file pipe_mgr_meters.h
+ *
+ * @description Utilities for meters
+ */
+
+#ifndef __PIPE_MGR_METERS_H__
+#define __PIPE_MGR_METERS_H__
+
+#include <bf_types/bf_types.h>
+
+/*!
+ * Program a meter index with the given spec.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param meter_idx meter index to be programmed
+ * @param meter_spec meter spec to be applied
+ * @return Status of the API call
+ */
+bf_status_t pipe_mgr_meter_mod_indirect_meter_set(dev_target_t dev_tgt,
+						  const char *table_name,
+						  pipe_meter_idx_t meter_idx,
+						  pipe_meter_spec_t *meter_spec);
+
+/*!
+ * Read back the meter spec programmed on a meter index.
+ *
+ * @param dev_tgt device target
+ * @param table_name meter table name
+ * @param meter_idx meter index to be read
+ * @param meter_spec buffer to fill the meter spec
+ * @return Status of the API call
+ */
+bf_status_t pipe_mgr_meter_read_indirect_meter_set(dev_target_t dev_tgt,
+						   const char *table_name,
+						   pipe_meter_idx_t meter_idx,
+						   pipe_meter_spec_t *meter_spec);
+#endif /* __PIPE_MGR_METERS_H__ */
@@ -159,6 +159,25 @@ struct pipe_mgr_mat_entry_info {
 	struct pipe_tbl_match_spec *match_spec;
 	struct pipe_action_spec *act_data_spec;
 	void *dal_data;
+	/* Set for the default entry of the table, which never ages. */
+	bool is_default;
+
+	/* Idle timeout state of the entry, maintained by pipe_mgr_idle. */
+	/* Configured TTL in msecs, 0 if the entry does not age. */
+	u32 idle_ttl;
+	/* Hit state as last read from the pipeline or set by the user. */
+	u32 idle_hit_state;
+	/* Set once the expiry of the entry has been notified. */
+	bool idle_notified;
+	/* Pipeline hit count seen at the last sweep of the entry. */
+	u64 idle_hit_cnt;
+	/* Idle wheel tick at which the entry is due to be swept. */
+	u64 idle_expiry_tick;
+	/* Links into the idle wheel slot the entry is scheduled on. */
+	struct pipe_mgr_mat_entry_info *idle_next;
+	struct pipe_mgr_mat_entry_info *idle_prev;
+	/* Idle wheel slot list the entry is linked on, NULL if none. */
+	struct pipe_mgr_mat_entry_info **idle_slot;
 };
 
 struct pipe_mgr_mat_key_htbl_node {
@@ -264,6 +283,15 @@ struct pipe_mgr_mat_state {
 	 * For each pipeline, a separate hash table is maintained.
 	 */
 	int num_htbls;
+	/* Number of entries in the table across all the pipelines, not
+	 * counting the default entries.
+	 */
+	u32 num_entries;
+
+	/* Idle timeout state of the table, allocated on first use of
+	 * the idle timeout APIs.
+	 */
+	struct pipe_mgr_idle_tbl *idle;
 };
 
 struct pipe_mgr_mat {
@@ -385,6 +413,8 @@ struct pipe_mgr_p4_pipeline {
 	 * pipeline.
 	 */
 	bf_hashtable_t *bf_externs_htbl;
+	/* Run-time meter profile bookkeeping, owned by the DAL. */
+	void *dal_meter_ctx;
 };
 
 /* P4 Program Pipeline Profile  */
@@ -394,6 +424,9 @@ struct pipe_mgr_profile {
 
 	int profile_id;
 	int core_id;
+	/* Instruction quanta of the pipeline, taken from config file. */
+	uint32_t instr_quanta;
+	int instr_quanta_adaptive;
 	int fast_clone; /* Mirror Fast/Slow Clone, taken from config file per pipeline */
 
 	char prog_name[P4_SDE_PROG_NAME_LEN];
@@ -411,6 +444,17 @@ struct pipe_mgr_profile {
 	/* Currently mod_addr action has 24 bit to specify */
         int num_ct_timer_profiles;
         int bf_ct_timeout[MAX_CT_TIMER_PROFILES];
+
+	/* Learn digest rings and batching, taken from config file. */
+	struct digest_config_s digest_cfg;
+
+	/* Load balancing of the pipeline over the cores, taken from config
+	 * file.
+	 */
+	struct balance_config_s balance_cfg;
+
+	/* Idle polling policy of the pipeline cores, taken from config file. */
+	struct idle_config_s idle_cfg;
 };
 
 struct pipe_mgr_dev {
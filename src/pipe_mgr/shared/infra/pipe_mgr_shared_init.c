@@ -27,6 +27,9 @@
 #include "pipe_mgr_session.h"
 #include "../dal/dal_mat.h"
 #include "../dal/dal_counters.h"
+#include "../dal/dal_meters.h"
+#include "../features/pipe_mgr_idle.h"
+#include "../features/pipe_mgr_learn.h"
 
 /* Pointer to global pipe_mgr context */
 static struct pipe_mgr_ctx *pipe_mgr_ctx_obj;
@@ -154,11 +157,17 @@ int pipe_mgr_set_profile(int dev_id,
 			p4_pipeline->cfg_file,
 			PIPE_MGR_CFG_FILE_LEN - 1);
 		profile->core_id = p4_pipeline->core_id;
+		profile->instr_quanta = p4_pipeline->instr_quanta;
+		profile->instr_quanta_adaptive =
+			p4_pipeline->instr_quanta_adaptive;
 		profile->fast_clone = p4_pipeline->mir_cfg.fast_clone;
 		profile->num_ct_timer_profiles =
 			p4_pipeline->num_ct_timer_profiles;
 		memcpy(profile->bf_ct_timeout, p4_pipeline->bf_ct_timeout,
 				sizeof(int) * profile->num_ct_timer_profiles);
+		profile->digest_cfg = p4_pipeline->digest_cfg;
+		profile->idle_cfg = p4_pipeline->idle_cfg;
+		profile->balance_cfg = p4_pipeline->balance_cfg;
 	}
 	if (parsed_pipe_ctx)
 		profile->pipe_ctx = *parsed_pipe_ctx;
@@ -257,6 +266,9 @@ int pipe_mgr_shared_remove_device(int dev_id)
 		return BF_OBJECT_NOT_FOUND;
 	}
 
+	/* The digest rings go away with the pipelines */
+	pipe_mgr_lrn_device_remove(dev_id);
+
 	status = dal_remove_device(dev_id);
 	if (status != BF_SUCCESS) {
 		LOG_ERROR("%s: failed to de-instantiate device %d",
@@ -283,6 +295,56 @@ bf_status_t pipe_mgr_shared_enable_pipeline(bf_dev_id_t dev_id,
 	LOG_TRACE("Entering %s device %u", __func__, dev_id);
 	status = dal_enable_pipeline(dev_id, profile_id, spec_file,
 				     warm_init_mode);
+	if (status == BF_SUCCESS)
+		status = pipe_mgr_lrn_profile_add(dev_id, profile_id);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_pipeline_thread_stats_get(
+		pipe_sess_hdl_t sess_hdl,
+		dev_target_t dev_tgt,
+		pipe_mgr_pipeline_thread_stats_t *stats)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	if (!stats)
+		return BF_INVALID_ARG;
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = dal_pipeline_thread_stats_get(dev_tgt, stats);
+
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
+	LOG_TRACE("Exiting %s", __func__);
+	return status;
+}
+
+pipe_status_t pipe_mgr_pipeline_migrate(pipe_sess_hdl_t sess_hdl,
+					dev_target_t dev_tgt,
+					uint32_t core_id)
+{
+	int status;
+
+	LOG_TRACE("Entering %s", __func__);
+
+	status = pipe_mgr_api_prologue(sess_hdl, dev_tgt);
+	if (status) {
+		LOG_ERROR("API prologue failed with err: %d", status);
+		LOG_TRACE("Exiting %s", __func__);
+		return status;
+	}
+
+	status = dal_pipeline_migrate(dev_tgt, core_id);
+
+	pipe_mgr_api_epilogue(sess_hdl, dev_tgt);
 	LOG_TRACE("Exiting %s", __func__);
 	return status;
 }
@@ -342,10 +404,28 @@ int pipe_mgr_shared_init(void)
 		goto cleanup_dev_map;
 	}
 
+	status = pipe_mgr_idle_init();
+	if (status) {
+		LOG_ERROR("Starting idle timeout thread failed");
+		goto cleanup_session;
+	}
+
+	status = pipe_mgr_lrn_init();
+	if (status) {
+		LOG_ERROR("Starting learn thread failed");
+		goto cleanup_idle;
+	}
+
 	P4_SDE_RWLOCK_UNLOCK(&pipe_mgr_lock);
 	LOG_TRACE("Exiting %s", __func__);
 	return BF_SUCCESS;
 
+cleanup_idle:
+	pipe_mgr_idle_cleanup();
+
+cleanup_session:
+	pipe_mgr_session_destroy(pipe_mgr_int_sess_hndl);
+
 cleanup_dev_map:
 	P4_SDE_MAP_DESTROY(&ctx->dev_map);
 
@@ -363,6 +443,10 @@ void pipe_mgr_shared_cleanup(void)
 {
 	LOG_TRACE("Entering %s", __func__);
 
+	/* Stop aging before the tables it sweeps are released. */
+	pipe_mgr_idle_cleanup();
+	pipe_mgr_lrn_cleanup();
+
 	if (P4_SDE_RWLOCK_WRLOCK(&pipe_mgr_lock))
 		LOG_ERROR("Acquiring pipe_mgr_lock failed");
 
@@ -517,6 +601,8 @@ void pipe_mgr_free_mat_state(struct pipe_mgr_mat_state *mat_state)
 	if (!mat_state)
 		return;
 
+	pipe_mgr_idle_tbl_free(mat_state);
+
 	if (mat_state->entry_handle_array)
 		P4_SDE_ID_DESTROY(mat_state->entry_handle_array);
 
@@ -568,6 +654,8 @@ void pipe_mgr_free_pipe_ctx(struct pipe_mgr_p4_pipeline *pipe_ctx)
     pipe_mgr_free_mat_table(pipe_ctx);
     /* free externs hash map table*/
     pipe_mgr_free_externs_htbl(pipe_ctx);
+    /* free meter profile pool */
+    dal_meter_destroy(pipe_ctx);
 }
 
 int pipe_mgr_client_init(u32 *sess_hdl)
@@ -32,6 +32,7 @@
 		match_type = ((tbl_struct *)tbl)->ctx.match_attr.match_type;    \
 		ent_hdl_arr = ((tbl_struct *)tbl)->state->entry_handle_array;   \
 		ent_info_htbl = &((tbl_struct *)tbl)->state->entry_info_htbl;   \
+		num_entries = &((tbl_struct *)tbl)->state->num_entries;         \
 	} while (0)                                                             \
 
 #define GET_TBL_INFO_FOR_KEY_EXIST(tbl_struct, tbl)                             \
@@ -46,6 +47,7 @@
 	do {                                                                    \
 		ent_hdl_arr = ((tbl_struct *)tbl)->state->entry_handle_array;   \
 		ent_info_htbl = &((tbl_struct *)tbl)->state->entry_info_htbl;   \
+		num_entries = &((tbl_struct *)tbl)->state->num_entries;         \
 	} while (0)                                                             \
 
 #define GET_TBL_INFO_FOR_INSERT_INTERNAL(tbl_struct, tbl)                       \
@@ -451,6 +453,17 @@ int pipe_mgr_table_key_exists(void *tbl,
 	return status;
 }
 
+/* The default entry of a MatchAction table takes no space in the table
+ * and is left out of its entry count.
+ */
+static bool pipe_mgr_table_entry_counted(enum pipe_mgr_table_type tbl_type,
+					 void *entry)
+{
+	if (tbl_type != PIPE_MGR_TABLE_TYPE_MAT)
+		return true;
+	return !((struct pipe_mgr_mat_entry_info *)entry)->is_default;
+}
+
 int pipe_mgr_table_key_delete_internal(struct bf_dev_target_t dev_tgt,
 				       void *tbl,
 				       enum pipe_mgr_table_type tbl_type,
@@ -463,6 +476,8 @@ int pipe_mgr_table_key_delete_internal(struct bf_dev_target_t dev_tgt,
 	bf_hashtable_t *key_htbl;
 	int status = BF_SUCCESS;
 	p4_sde_id *ent_hdl_arr;
+	u32 *num_entries;
+	void *entry;
 	uint8_t *key_p = NULL;
 	uint8_t pipe_idx = 0;
 	uint32_t key_sz = 0;
@@ -521,6 +536,10 @@ int pipe_mgr_table_key_delete_internal(struct bf_dev_target_t dev_tgt,
 		goto cleanup_key;
 
 	key = (u64)mat_ent_hdl;
+	if (P4_SDE_MAP_GET(ent_info_htbl, key, &entry) == BF_MAP_OK &&
+	    pipe_mgr_table_entry_counted(tbl_type, entry))
+		(*num_entries)--;
+
 	map_sts = P4_SDE_MAP_RMV(ent_info_htbl, key);
 	if (map_sts != BF_MAP_OK) {
 		LOG_ERROR("table entry handle/entry map del failed");
@@ -566,6 +585,7 @@ int pipe_mgr_table_key_insert(struct bf_dev_target_t dev_tgt,
 	p4_sde_map *ent_info_htbl;
 	p4_sde_id *ent_hdl_arr;
 	p4_sde_mutex *lock;
+	u32 *num_entries;
 	u32 new_ent_hdl;
 	uint32_t *entry_hdl;
 	int handle;
@@ -621,6 +641,8 @@ int pipe_mgr_table_key_insert(struct bf_dev_target_t dev_tgt,
 	}
 
 	*ent_hdl = new_ent_hdl;
+	if (pipe_mgr_table_entry_counted(tbl_type, entry))
+		(*num_entries)++;
 	if (P4_SDE_MUTEX_UNLOCK(lock)) {
 		LOG_ERROR("Unlock of table %d failed", handle);
 		status = BF_UNEXPECTED;
@@ -96,18 +96,6 @@ pipe_status_t pipe_mgr_ent_hdl_to_match_spec(pipe_sess_hdl_t sess_hdl, dev_targe
     return PIPE_SUCCESS;
 }
 
-pipe_status_t pipe_mgr_match_spec_free(pipe_tbl_match_spec_t* match_spec)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_match_spec_duplicate(pipe_tbl_match_spec_t** match_spec_dest, pipe_tbl_match_spec_t const* match_spec_src)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
 pipe_status_t pipe_mgr_match_key_mask_spec_set(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_tbl_match_spec_t* match_spec)
 {
     LOG_TRACE("STUB:%s\n",__func__);
@@ -246,30 +234,6 @@ pipe_status_t pipe_mgr_sel_fallback_mbr_reset(pipe_sess_hdl_t sess_hdl, dev_targ
     return PIPE_SUCCESS;
 }
 
-pipe_status_t pipe_mgr_lrn_digest_notification_register(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_fld_lst_hdl_t flow_lrn_fld_lst_hdl, pipe_flow_lrn_notify_cb callback_fn, void* callback_fn_cookie)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_lrn_digest_notification_deregister(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_fld_lst_hdl_t flow_lrn_fld_lst_hdl)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_flow_lrn_notify_ack(pipe_sess_hdl_t sess_hdl, pipe_fld_lst_hdl_t flow_lrn_fld_lst_hdl, pipe_flow_lrn_msg_t* pipe_flow_lrn_msg)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_flow_lrn_set_timeout(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, uint32_t usecs)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
 pipe_status_t pipe_mgr_flow_lrn_set_network_order_digest(bf_dev_id_t device_id, bool network_order)
 {
     LOG_TRACE("STUB:%s\n",__func__);
@@ -330,18 +294,6 @@ pipe_status_t pipe_mgr_direct_stat_ent_database_sync(pipe_sess_hdl_t sess_hdl, d
     return PIPE_SUCCESS;
 }
 
-pipe_status_t pipe_mgr_meter_reset(pipe_sess_hdl_t sess_hdl, dev_target_t dev_tgt, pipe_meter_tbl_hdl_t meter_tbl_hdl, uint32_t pipe_api_flags)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_meter_ent_set(pipe_sess_hdl_t sess_hdl, dev_target_t dev_tgt, pipe_meter_tbl_hdl_t meter_tbl_hdl, pipe_meter_idx_t meter_idx, pipe_meter_spec_t* meter_spec, uint32_t pipe_api_flags)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
 pipe_status_t pipe_mgr_meter_set_bytecount_adjust(pipe_sess_hdl_t sess_hdl, dev_target_t dev_tgt, pipe_meter_tbl_hdl_t meter_tbl_hdl, int bytecount)
 {
     LOG_TRACE("STUB:%s\n",__func__);
@@ -360,12 +312,6 @@ pipe_status_t pipe_mgr_meter_read_entry(pipe_sess_hdl_t sess_hdl, dev_target_t d
     return PIPE_SUCCESS;
 }
 
-pipe_status_t pipe_mgr_meter_read_entry_idx(pipe_sess_hdl_t sess_hdl, dev_target_t dev_tgt, pipe_meter_tbl_hdl_t meter_tbl_hdl, pipe_meter_idx_t index, pipe_meter_spec_t* meter_spec)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
 
 pipe_status_t pipe_mgr_exm_entry_activate(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_mat_ent_hdl_t mat_ent_hdl)
 {
@@ -379,66 +325,6 @@ pipe_status_t pipe_mgr_exm_entry_deactivate(pipe_sess_hdl_t sess_hdl, bf_dev_id_
     return PIPE_SUCCESS;
 }
 
-pipe_status_t pipe_mgr_mat_ent_set_idle_ttl(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_mat_ent_hdl_t mat_ent_hdl, uint32_t ttl, uint32_t pipe_api_flags, bool reset)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_mat_ent_reset_idle_ttl(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_mat_ent_hdl_t mat_ent_hdl)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_idle_params_get(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_idle_time_params_t* params)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_idle_tmo_enable(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_idle_time_params_t params)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_idle_register_tmo_cb(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_idle_tmo_expiry_cb cb, void* client_data)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_idle_register_tmo_cb_with_match_spec_copy(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_idle_tmo_expiry_cb_with_match_spec_copy cb, void* client_data)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_idle_tmo_disable(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_idle_time_get_hit_state(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_mat_ent_hdl_t mat_ent_hdl, pipe_idle_time_hit_state_e* idle_time_data)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_idle_time_update_hit_state(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_idle_tmo_update_complete_cb callback_fn, void* cb_data)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
-pipe_status_t pipe_mgr_mat_ent_get_idle_ttl(pipe_sess_hdl_t sess_hdl, bf_dev_id_t device_id, pipe_mat_tbl_hdl_t mat_tbl_hdl, pipe_mat_ent_hdl_t mat_ent_hdl, uint32_t* ttl)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_SUCCESS;
-}
-
 pipe_status_t pipe_stful_database_sync(pipe_sess_hdl_t sess_hdl, dev_target_t dev_tgt, pipe_stful_tbl_hdl_t stful_tbl_hdl, pipe_stful_tbl_sync_cback_fn cback_fn, void* cookie)
 {
     LOG_TRACE("STUB:%s\n",__func__);
@@ -535,12 +421,6 @@ pipe_status_t pipe_mgr_get_word_llp_active_members(pipe_sess_hdl_t sess_hdl, dev
     return PIPE_SUCCESS;
 }
 
-pipe_status_t pipe_mgr_get_entry_count(pipe_sess_hdl_t sess_hdl, dev_target_t dev_tgt, pipe_mat_tbl_hdl_t tbl_hdl, bool read_from_hw, uint32_t* count)
-{
-    LOG_TRACE("STUB:%s\n",__func__);
-    return PIPE_NOT_SUPPORTED;
-}
-
 pipe_status_t pipe_mgr_tbl_set_property(pipe_sess_hdl_t sess_hdl, bf_dev_id_t dev_id, pipe_mat_tbl_hdl_t tbl_hdl, pipe_mgr_tbl_prop_type_t property, pipe_mgr_tbl_prop_value_t value, pipe_mgr_tbl_prop_args_t args)
 {
     LOG_TRACE("STUB:%s\n",__func__);
@@ -278,6 +278,22 @@ bf_status_t port_mgr_populate_port_attributes(
 		port_attr->ring.size = data_fields->size;
 		break;
 	}
+	case BF_DPDK_VIRTIO_USER:
+	{
+		port_attr->virtio_user.mtu = data_fields->mtu;
+		break;
+	}
+	case BF_DPDK_MEMIF:
+	{
+		/* The socket path is optional, the server role on the
+		 * default socket is used otherwise.
+		 */
+		strncpy(port_attr->memif.socket_path,
+			data_fields->file_name,
+			PCAP_FILE_NAME_LEN - 1);
+		port_attr->memif.socket_path[PCAP_FILE_NAME_LEN - 1] = '\0';
+		break;
+	}
 	default:
 		port_mgr_log_error
 		("%s:%d Incorrect Port Type", __func__, __LINE__);
@@ -12,6 +12,7 @@
  */
 
 #include <stdio.h>
+#include "port_mgr/port_mgr_port.h"
 
 void port_mgr_platform_init(void)
 {
@@ -20,5 +21,6 @@ void port_mgr_platform_init(void)
 
 void port_mgr_platform_cleanup(void)
 {
-	printf("STUB:%s DPDK\n", __func__);
+	/* Stop the stats refresh thread */
+	port_mgr_port_stats_poll_intvl_set(0, 0);
 }
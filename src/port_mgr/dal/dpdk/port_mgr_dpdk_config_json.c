@@ -23,7 +23,12 @@
 
 /* Global Headers */
 #include <sys/stat.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
 #include <stdio.h>
+#include <string.h>
 
 /* P4 SDE Headers */
 #include <cjson/cJSON.h>
@@ -51,14 +56,33 @@
 #define PORT_CONFIG_JSON_SOURCE_PORT_ATTRIB_NODE "source_port_attributes"
 #define PORT_CONFIG_JSON_SINK_PORT_ATTRIB_NODE "sink_port_attributes"
 #define PORT_CONFIG_JSON_RING_PORT_ATTRIB_NODE "ring_port_attributes"
+#define PORT_CONFIG_JSON_VIRTIO_USER_PORT_ATTRIB_NODE \
+	"virtio_user_port_attributes"
+#define PORT_CONFIG_JSON_MEMIF_PORT_ATTRIB_NODE "memif_port_attributes"
 #define PORT_CONFIG_JSON_PORT_MTU "mtu"
 #define PORT_CONFIG_JSON_PORT_PCIE_BDF "pcie_bdf"
 #define PORT_CONFIG_JSON_PORT_DEV_ARGS "dev_args"
 #define PORT_CONFIG_JSON_PORT_DEV_HOTPLUG_ENABLED "dev_hotplug_enabled"
+#define PORT_CONFIG_JSON_PORT_NUM_RXQ "num_rx_queues"
+#define PORT_CONFIG_JSON_PORT_NUM_TXQ "num_tx_queues"
+#define PORT_CONFIG_JSON_PORT_RX_BURST_SIZE "rx_burst_size"
+#define PORT_CONFIG_JSON_PORT_TX_BURST_SIZE "tx_burst_size"
 #define PORT_CONFIG_JSON_PORT_FILE_NAME "file_name"
 #define PORT_CONFIG_JSON_PORT_SIZE "size"
+#define PORT_CONFIG_JSON_PORT_QUEUE_SIZE "queue_size"
+#define PORT_CONFIG_JSON_PORT_BURST_SIZE "burst_size"
+#define PORT_CONFIG_JSON_PORT_SOCKET_PATH "socket_path"
+#define PORT_CONFIG_JSON_PORT_ID "id"
+#define PORT_CONFIG_JSON_PORT_ROLE "role"
+#define PORT_CONFIG_JSON_PORT_ZERO_COPY "zero_copy"
+#define PORT_CONFIG_JSON_PORT_RING_SIZE "ring_size"
+#define PORT_CONFIG_JSON_PORT_BUFFER_SIZE "buffer_size"
+#define PORT_CONFIG_JSON_PORT_PIPELINE_LINK "pipeline_link"
 #define PORT_CONFIG_JSON_NET_PORT "net_port"
 
+/* Workers creating the port devices at startup */
+#define PORT_CONFIG_CREATE_WORKERS_MAX 16
+
 #define PORT_CONFIG_JSON_FOR_EACH(it, parent) \
 	for ((it) = (parent)->child; (it) != NULL; (it) = (it)->next)
 
@@ -80,7 +104,9 @@ static struct port_mgr_port_type_map port_type_map[] = {
 	{"link", BF_DPDK_LINK},		/*!< DPDK Link Port */
 	{"source", BF_DPDK_SOURCE},	/*!< DPDK Source Port */
 	{"sink", BF_DPDK_SINK},		/*!< DPDK Sink Port */
-	{"ring", BF_DPDK_RING}      /*!< DPDK Ring Port */
+	{"ring", BF_DPDK_RING},      /*!< DPDK Ring Port */
+	{"virtio_user", BF_DPDK_VIRTIO_USER}, /*!< DPDK Virtio-user Port */
+	{"memif", BF_DPDK_MEMIF}	/*!< DPDK Memif Port */
 };
 
 /**
@@ -188,6 +214,8 @@ static int port_config_json_parse_link_port(cJSON *port_cjson,
 	char *pcie_bdf = NULL;
 	char *dev_args = NULL;
 	int dev_hotplug_enabled = 0;
+	int n_rxq = 0, n_txq = 0;
+	int rx_burst_size = 0, tx_burst_size = 0;
 	cJSON *link_port_attrib_cjson = NULL;
 	int err = 0;
 
@@ -206,9 +234,29 @@ static int port_config_json_parse_link_port(cJSON *port_cjson,
 	err |= bf_cjson_try_get_int(link_port_attrib_cjson,
 				PORT_CONFIG_JSON_PORT_DEV_HOTPLUG_ENABLED,
 				&dev_hotplug_enabled);
+
+	err |= bf_cjson_try_get_int(link_port_attrib_cjson,
+				PORT_CONFIG_JSON_PORT_NUM_RXQ,
+				&n_rxq);
+
+	err |= bf_cjson_try_get_int(link_port_attrib_cjson,
+				PORT_CONFIG_JSON_PORT_NUM_TXQ,
+				&n_txq);
+
+	err |= bf_cjson_try_get_int(link_port_attrib_cjson,
+				PORT_CONFIG_JSON_PORT_RX_BURST_SIZE,
+				&rx_burst_size);
+
+	err |= bf_cjson_try_get_int(link_port_attrib_cjson,
+				PORT_CONFIG_JSON_PORT_TX_BURST_SIZE,
+				&tx_burst_size);
 	if (err)
 		return BF_UNEXPECTED;
 
+	if ((n_rxq < 0) || (n_txq < 0) ||
+	    (rx_burst_size < 0) || (tx_burst_size < 0))
+		return BF_INVALID_ARG;
+
 	strncpy(link->pcie_domain_bdf, pcie_bdf, PCIE_BDF_LEN - 1);
 	link->pcie_domain_bdf[PCIE_BDF_LEN - 1] = '\0';
 	if (dev_args) {
@@ -216,6 +264,10 @@ static int port_config_json_parse_link_port(cJSON *port_cjson,
 		link->dev_args[DEV_ARGS_LEN - 1] = '\0';
 	}
 	link->dev_hotplug_enabled = dev_hotplug_enabled;
+	link->n_rxq = n_rxq;
+	link->n_txq = n_txq;
+	link->rx_burst_size = rx_burst_size;
+	link->tx_burst_size = tx_burst_size;
 
 	return BF_SUCCESS;
 }
@@ -288,6 +340,7 @@ static int port_config_json_parse_ring_port(cJSON *port_cjson,
 							struct ring_port_attributes_t *ring)
 {
 		int size;
+		int burst_size = 0, pipeline_link = 0;
 		cJSON *ring_port_attrib_cjson = NULL;
 		int err = 0;
 
@@ -299,13 +352,137 @@ static int port_config_json_parse_ring_port(cJSON *port_cjson,
 					PORT_CONFIG_JSON_PORT_SIZE,
 					&size);
 
+		err |= bf_cjson_try_get_int(ring_port_attrib_cjson,
+					PORT_CONFIG_JSON_PORT_BURST_SIZE,
+					&burst_size);
+
+		err |= bf_cjson_try_get_int(ring_port_attrib_cjson,
+					PORT_CONFIG_JSON_PORT_PIPELINE_LINK,
+					&pipeline_link);
+
 		if (err)
 			return BF_UNEXPECTED;
 
+		if (burst_size < 0)
+			return BF_INVALID_ARG;
+
 		ring->size = size;
+		ring->burst_size = burst_size;
+		ring->pipeline_link = pipeline_link ? 1 : 0;
 		return BF_SUCCESS;
 }
 
+/**
+ * Parse Virtio-user Port Attributes
+ * @param port_cjson Port cJSON Object
+ * @param virtio_user Virtio-user Port Attributes
+ * @return Status of the API call
+ */
+static int port_config_json_parse_virtio_user_port(cJSON *port_cjson,
+		struct virtio_user_port_attributes_t *virtio_user)
+{
+	int mtu;
+	int queue_size = 0, burst_size = 0;
+	cJSON *virtio_user_port_attrib_cjson = NULL;
+	int err = 0;
+
+	err |= bf_cjson_get_object(port_cjson,
+				   PORT_CONFIG_JSON_VIRTIO_USER_PORT_ATTRIB_NODE,
+				   &virtio_user_port_attrib_cjson);
+
+	err |= bf_cjson_get_int(virtio_user_port_attrib_cjson,
+				PORT_CONFIG_JSON_PORT_MTU,
+				&mtu);
+
+	err |= bf_cjson_try_get_int(virtio_user_port_attrib_cjson,
+				    PORT_CONFIG_JSON_PORT_QUEUE_SIZE,
+				    &queue_size);
+
+	err |= bf_cjson_try_get_int(virtio_user_port_attrib_cjson,
+				    PORT_CONFIG_JSON_PORT_BURST_SIZE,
+				    &burst_size);
+	if (err)
+		return BF_UNEXPECTED;
+
+	if ((mtu < 0) || (queue_size < 0) || (burst_size < 0))
+		return BF_INVALID_ARG;
+
+	virtio_user->mtu = mtu;
+	virtio_user->queue_size = queue_size;
+	virtio_user->burst_size = burst_size;
+	return BF_SUCCESS;
+}
+
+/**
+ * Parse Memif Port Attributes
+ * @param port_cjson Port cJSON Object
+ * @param memif Memif Port Attributes
+ * @return Status of the API call
+ */
+static int port_config_json_parse_memif_port(cJSON *port_cjson,
+		struct memif_port_attributes_t *memif)
+{
+	char *socket_path = NULL;
+	char *role = NULL;
+	int id = 0, zero_copy = 0;
+	int ring_size = 0, buffer_size = 0, burst_size = 0;
+	cJSON *memif_port_attrib_cjson = NULL;
+	int err = 0;
+
+	err |= bf_cjson_get_object(port_cjson,
+				   PORT_CONFIG_JSON_MEMIF_PORT_ATTRIB_NODE,
+				   &memif_port_attrib_cjson);
+
+	err |= bf_cjson_try_get_string(memif_port_attrib_cjson,
+				       PORT_CONFIG_JSON_PORT_SOCKET_PATH,
+				       &socket_path);
+
+	err |= bf_cjson_try_get_int(memif_port_attrib_cjson,
+				    PORT_CONFIG_JSON_PORT_ID,
+				    &id);
+
+	err |= bf_cjson_try_get_string(memif_port_attrib_cjson,
+				       PORT_CONFIG_JSON_PORT_ROLE,
+				       &role);
+
+	err |= bf_cjson_try_get_int(memif_port_attrib_cjson,
+				    PORT_CONFIG_JSON_PORT_ZERO_COPY,
+				    &zero_copy);
+
+	err |= bf_cjson_try_get_int(memif_port_attrib_cjson,
+				    PORT_CONFIG_JSON_PORT_RING_SIZE,
+				    &ring_size);
+
+	err |= bf_cjson_try_get_int(memif_port_attrib_cjson,
+				    PORT_CONFIG_JSON_PORT_BUFFER_SIZE,
+				    &buffer_size);
+
+	err |= bf_cjson_try_get_int(memif_port_attrib_cjson,
+				    PORT_CONFIG_JSON_PORT_BURST_SIZE,
+				    &burst_size);
+	if (err)
+		return BF_UNEXPECTED;
+
+	if ((id < 0) || (ring_size < 0) || (buffer_size < 0) ||
+	    (burst_size < 0))
+		return BF_INVALID_ARG;
+
+	if (role && strcmp(role, "server") && strcmp(role, "client"))
+		return BF_INVALID_ARG;
+
+	if (socket_path) {
+		strncpy(memif->socket_path, socket_path, SOCK_PATH_LEN - 1);
+		memif->socket_path[SOCK_PATH_LEN - 1] = '\0';
+	}
+	memif->id = id;
+	memif->client = role && !strcmp(role, "client");
+	memif->zero_copy = zero_copy ? 1 : 0;
+	memif->ring_size = ring_size;
+	memif->buffer_size = buffer_size;
+	memif->burst_size = burst_size;
+	return BF_SUCCESS;
+}
+
 /**
  * Parse each individual Port Object
  * @param dev_id The Device ID
@@ -447,6 +624,20 @@ static int port_config_json_parse_port(int dev_id,
 				&port_info->port_attrib.ring);
 		break;
 	}
+	case BF_DPDK_VIRTIO_USER:
+	{
+		status = port_config_json_parse_virtio_user_port
+			 (port_cjson,
+			  &port_info->port_attrib.virtio_user);
+		break;
+	}
+	case BF_DPDK_MEMIF:
+	{
+		status = port_config_json_parse_memif_port
+			 (port_cjson,
+			  &port_info->port_attrib.memif);
+		break;
+	}
 	default:
 		port_mgr_log_error
 		("%s:%d Incorrect Port Type", __func__, __LINE__);
@@ -462,9 +653,91 @@ static int port_config_json_parse_port(int dev_id,
 	return status;
 }
 
+/**
+ * Ports created in parallel from the Port Config JSON File
+ */
+struct port_config_create_ctx {
+	int dev_id;
+	struct port_info_t *ports;     /*!< Ports in Port Config JSON order */
+	int *status;                   /*!< Creation status of each port */
+	uint64_t *create_ns;           /*!< Creation time of each port */
+	uint32_t n_ports;
+	uint32_t next;                 /*!< Next port to create */
+};
+
+static uint64_t port_config_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * Port creation worker, creates ports until none is left
+ * @param arg Port creation context
+ * @return NULL
+ */
+static void *port_config_create_worker(void *arg)
+{
+	struct port_config_create_ctx *ctx = arg;
+	uint64_t start;
+	uint32_t i;
+
+	for (;;) {
+		i = __atomic_fetch_add(&ctx->next, 1, __ATOMIC_RELAXED);
+		if (i >= ctx->n_ports)
+			break;
+
+		start = port_config_time_ns();
+		ctx->status[i] = port_mgr_port_create
+				 (ctx->dev_id,
+				  ctx->ports[i].dev_port,
+				  &ctx->ports[i].port_attrib);
+		ctx->create_ns[i] = port_config_time_ns() - start;
+	}
+
+	return NULL;
+}
+
+/**
+ * Create the devices of the ports (link ports, taps) with a pool of
+ * workers, as each one can take milliseconds to set up. The device probing
+ * of the link ports is serialized by the lld, only their setup overlaps
+ * @param ctx Port creation context
+ */
+static void port_config_create_ports(struct port_config_create_ctx *ctx)
+{
+	pthread_t workers[PORT_CONFIG_CREATE_WORKERS_MAX];
+	uint32_t n_workers, i;
+	long n_cpus;
+
+	n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	n_workers = (n_cpus > 0) ? (uint32_t)n_cpus : 1;
+	if (n_workers > PORT_CONFIG_CREATE_WORKERS_MAX)
+		n_workers = PORT_CONFIG_CREATE_WORKERS_MAX;
+	if (n_workers > ctx->n_ports)
+		n_workers = ctx->n_ports;
+
+	/* Workers that fail to start are made up for by the others */
+	for (i = 0; i < n_workers; i++)
+		if (pthread_create(&workers[i], NULL,
+				   port_config_create_worker, ctx))
+			break;
+	n_workers = i;
+
+	if (!n_workers)
+		port_config_create_worker(ctx);
+
+	for (i = 0; i < n_workers; i++)
+		pthread_join(workers[i], NULL);
+}
+
 /**
  * Parse Port Objects from the Port Config JSON File
- * and configure the DPDK Target
+ * and configure the DPDK Target. The port devices are created in parallel,
+ * then the ports are added to their pipelines one by one in the order of
+ * the file, which keeps the pipeline I/O spec deterministic.
  * @param dev_id The Device ID
  * @param root Root cJSON Object
  * @return Status of the API call
@@ -472,10 +745,13 @@ static int port_config_json_parse_port(int dev_id,
 static int port_config_json_parse_ports(int dev_id,
 					cJSON *root)
 {
-	struct port_info_t port_info;
+	struct port_config_create_ctx ctx;
+	struct port_info_t *port_info;
 	cJSON *ports_cjson = NULL;
 	cJSON *port_cjson = NULL;
+	uint64_t start, create_ns, add_ns;
 	int status = BF_SUCCESS;
+	uint32_t i;
 	int err = 0;
 
 	err |= bf_cjson_get_object
@@ -484,31 +760,71 @@ static int port_config_json_parse_ports(int dev_id,
 	if (err)
 		return BF_UNEXPECTED;
 
-	PORT_CONFIG_JSON_FOR_EACH(port_cjson, ports_cjson) {
-		memset(&port_info, 0, sizeof(port_info));
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.dev_id = dev_id;
+	ctx.n_ports = cJSON_GetArraySize(ports_cjson);
+	if (!ctx.n_ports)
+		return BF_SUCCESS;
+
+	ctx.ports = P4_SDE_CALLOC(ctx.n_ports, sizeof(*ctx.ports));
+	ctx.status = P4_SDE_CALLOC(ctx.n_ports, sizeof(*ctx.status));
+	ctx.create_ns = P4_SDE_CALLOC(ctx.n_ports, sizeof(*ctx.create_ns));
+	if (!ctx.ports || !ctx.status || !ctx.create_ns) {
+		status = BF_NO_SYS_RESOURCES;
+		goto cleanup;
+	}
 
+	i = 0;
+	PORT_CONFIG_JSON_FOR_EACH(port_cjson, ports_cjson) {
 		status = port_config_json_parse_port(dev_id,
 						     port_cjson,
-						     &port_info);
+						     &ctx.ports[i]);
 		if (status != BF_SUCCESS) {
 			port_mgr_log_error
 			("%s:%d: Failed to parse port from Port Config JSON",
 			 __func__, __LINE__);
-			return status;
+			goto cleanup;
 		}
+		i++;
+	}
+
+	start = port_config_time_ns();
+	port_config_create_ports(&ctx);
+	create_ns = port_config_time_ns() - start;
 
-		status = port_mgr_port_add(dev_id,
-					   port_info.dev_port,
-					   &port_info.port_attrib);
+	start = port_config_time_ns();
+	for (i = 0; i < ctx.n_ports; i++) {
+		port_info = &ctx.ports[i];
+
+		port_mgr_log_trace
+		("%s: port %s created in %" PRIu64 " us",
+		 __func__, port_info->port_attrib.port_name,
+		 ctx.create_ns[i] / 1000);
+
+		status = ctx.status[i];
+		if (status == BF_SUCCESS)
+			status = port_mgr_port_add(dev_id,
+						   port_info->dev_port,
+						   &port_info->port_attrib);
 
 		if (status != BF_SUCCESS) {
 			port_mgr_log_error
 			("%s:%d: Failed to add port %s",
-			 __func__, __LINE__, port_info.port_attrib.port_name);
-			return status;
+			 __func__, __LINE__, port_info->port_attrib.port_name);
+			goto cleanup;
 		}
 	}
-	return BF_SUCCESS;
+	add_ns = port_config_time_ns() - start;
+
+	port_mgr_log_trace
+	("%s: %u ports created in %" PRIu64 " us, added in %" PRIu64 " us",
+	 __func__, ctx.n_ports, create_ns / 1000, add_ns / 1000);
+
+cleanup:
+	P4_SDE_FREE(ctx.ports);
+	P4_SDE_FREE(ctx.status);
+	P4_SDE_FREE(ctx.create_ns);
+	return status;
 }
 
 /**
@@ -21,10 +21,17 @@
  * Definitions for DPDK Port Manager APIs.
  */
 
+#include <pthread.h>
 #include "port_mgr/port_mgr_port.h"
 #include "lld/dpdk/lld_dpdk_port.h"
 #include "port_mgr/port_mgr.h"
 
+/* Period of the stats refresh thread in usecs. */
+#define PORT_MGR_STATS_THREAD_PERIOD_US 10000
+
+static pthread_t port_mgr_stats_thread_id;
+static volatile bool port_mgr_stats_thread_run;
+
 bf_status_t port_mgr_port_add(bf_dev_id_t dev_id, bf_dev_port_t dev_port,
 			      struct port_attributes_t *port_attrib)
 {
@@ -56,23 +63,102 @@ bf_status_t port_mgr_port_add(bf_dev_id_t dev_id, bf_dev_port_t dev_port,
 	return status;
 }
 
+bf_status_t port_mgr_port_create(bf_dev_id_t dev_id, bf_dev_port_t dev_port,
+				 struct port_attributes_t *port_attrib)
+{
+	/* Invoke LLD DPDK API to Create the Port Device */
+	return lld_dpdk_port_create(dev_port, port_attrib);
+}
+
+bf_status_t port_mgr_port_del(bf_dev_id_t dev_id, bf_dev_port_t dev_port)
+{
+	struct port_info_t *port_info;
+	struct port_mgr_ctx_t *ctx;
+	p4_sde_map_sts map_sts;
+	bf_status_t status;
+
+	port_mgr_log_trace("Entering %s", __func__);
+
+	ctx = get_port_mgr_ctx();
+	if (!ctx)
+		return BF_OBJECT_NOT_FOUND;
+
+	/* The stats refresh thread reads the port info under the lock, it
+	 * must not find the port half deleted or freed.
+	 */
+	P4_SDE_MUTEX_LOCK(&ctx->port_info_lock);
+
+	port_info = port_mgr_get_port_info(dev_port);
+	if (!port_info) {
+		P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	/* Invoke LLD DPDK API to Delete Port */
+	status = lld_dpdk_port_del(dev_port, &port_info->port_attrib);
+	if (status != BF_SUCCESS) {
+		P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
+		return status;
+	}
+
+	port_mgr_remove_name(port_info->port_attrib.port_name);
+
+	/* Remove Port Info from Hash Map */
+	map_sts = P4_SDE_MAP_RMV(&ctx->port_info_map, dev_port);
+	P4_SDE_FREE(port_info);
+	P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
+	if (map_sts != BF_MAP_OK) {
+		port_mgr_log_error("%s: failed to remove object from map",
+				   __func__);
+		return BF_UNEXPECTED;
+	}
+
+	port_mgr_log_trace("Exiting %s", __func__);
+	return BF_SUCCESS;
+}
+
+/* Read the stats of a port, from the cache if it is refreshed in the
+ * background. Called with the port info lock held.
+ */
+static bf_status_t port_mgr_port_stats_read(struct port_mgr_ctx_t *ctx,
+					    struct port_info_t *port_info,
+					    u64 *stats)
+{
+	if (ctx->stats_poll_intvl_ms && port_info->stats_valid) {
+		memcpy(stats, port_info->stats,
+		       BF_PORT_NUM_COUNTERS * sizeof(u64));
+		return BF_SUCCESS;
+	}
+
+	/* Invoke LLD DPDK API to get Port Stats */
+	return lld_dpdk_port_stats_get(port_info, stats);
+}
+
 bf_status_t port_mgr_port_all_stats_get(bf_dev_id_t dev_id,
 					bf_dev_port_t dev_port,
 					u64 *stats)
 {
 	struct port_info_t *port_info = NULL;
+	struct port_mgr_ctx_t *ctx;
 	bf_status_t status = BF_SUCCESS;
 
 	port_mgr_log_trace("Entering %s", __func__);
 
+	ctx = get_port_mgr_ctx();
+	if (!ctx)
+		return BF_OBJECT_NOT_FOUND;
+
+	P4_SDE_MUTEX_LOCK(&ctx->port_info_lock);
+
 	/* Get the Port Info from Hash Map */
 	port_info = port_mgr_get_port_info(dev_port);
-	if (!port_info)
+	if (!port_info) {
+		P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
 		return BF_OBJECT_NOT_FOUND;
+	}
 
-	/* Invoke LLD DPDK API to get Port Stats */
-	status = lld_dpdk_port_stats_get(dev_port, &port_info->port_attrib,
-					 stats);
+	status = port_mgr_port_stats_read(ctx, port_info, stats);
+	P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
 	if (status != BF_SUCCESS)
 		return status;
 
@@ -81,6 +167,215 @@ bf_status_t port_mgr_port_all_stats_get(bf_dev_id_t dev_id,
 	return status;
 }
 
+bf_status_t port_mgr_port_all_stats_get_next_n(bf_dev_id_t dev_id,
+					       bf_dev_port_t dev_port,
+					       bool first,
+					       u32 n,
+					       bf_dev_port_t *dev_ports,
+					       u64 *stats,
+					       u32 *num_returned)
+{
+	struct port_info_t *port_info = NULL;
+	struct port_mgr_ctx_t *ctx;
+	p4_sde_map_sts map_sts;
+	p4_sde_map_key key;
+	bf_status_t status = BF_SUCCESS;
+
+	port_mgr_log_trace("Entering %s", __func__);
+
+	if (!dev_ports || !stats || !num_returned)
+		return BF_INVALID_ARG;
+
+	*num_returned = 0;
+
+	ctx = get_port_mgr_ctx();
+	if (!ctx)
+		return BF_OBJECT_NOT_FOUND;
+
+	P4_SDE_MUTEX_LOCK(&ctx->port_info_lock);
+
+	/* Ports come out of the map in ascending order */
+	key = dev_port;
+	if (first)
+		map_sts = P4_SDE_MAP_GET_FIRST(&ctx->port_info_map, &key,
+					       (void **)&port_info);
+	else
+		map_sts = P4_SDE_MAP_GET_NEXT(&ctx->port_info_map, &key,
+					      (void **)&port_info);
+
+	while ((map_sts == BF_MAP_OK) && (*num_returned < n)) {
+		u64 *port_stats = &stats[*num_returned * BF_PORT_NUM_COUNTERS];
+
+		memset(port_stats, 0, BF_PORT_NUM_COUNTERS * sizeof(u64));
+		status = port_mgr_port_stats_read(ctx, port_info, port_stats);
+		if (status != BF_SUCCESS)
+			break;
+
+		dev_ports[(*num_returned)++] = port_info->dev_port;
+		map_sts = P4_SDE_MAP_GET_NEXT(&ctx->port_info_map, &key,
+					      (void **)&port_info);
+	}
+
+	P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
+
+	port_mgr_log_trace("Exiting %s", __func__);
+
+	return status;
+}
+
+bf_status_t port_mgr_port_queue_stats_get(bf_dev_id_t dev_id,
+					  bf_dev_port_t dev_port,
+					  u32 queue_id,
+					  u64 *stats)
+{
+	struct port_info_t *port_info = NULL;
+	struct port_mgr_ctx_t *ctx;
+	bf_status_t status;
+
+	if (!stats)
+		return BF_INVALID_ARG;
+
+	ctx = get_port_mgr_ctx();
+	if (!ctx)
+		return BF_OBJECT_NOT_FOUND;
+
+	P4_SDE_MUTEX_LOCK(&ctx->port_info_lock);
+
+	port_info = port_mgr_get_port_info(dev_port);
+	if (!port_info) {
+		P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
+		return BF_OBJECT_NOT_FOUND;
+	}
+
+	/* Queue stats are not cached, always read them live */
+	status = lld_dpdk_port_queue_stats_get(port_info, queue_id, stats);
+	P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
+
+	return status;
+}
+
+/* Refresh the stats cached in all the port infos. Ports whose stats can't
+ * be read keep the stats of the previous refresh.
+ */
+static void port_mgr_port_stats_refresh(struct port_mgr_ctx_t *ctx)
+{
+	struct port_info_t *port_info = NULL;
+	u64 stats[BF_PORT_NUM_COUNTERS];
+	p4_sde_map_sts map_sts;
+	p4_sde_map_key key;
+
+	P4_SDE_MUTEX_LOCK(&ctx->port_info_lock);
+
+	map_sts = P4_SDE_MAP_GET_FIRST(&ctx->port_info_map, &key,
+				       (void **)&port_info);
+	while (map_sts == BF_MAP_OK) {
+		memset(stats, 0, sizeof(stats));
+		if (lld_dpdk_port_stats_get(port_info, stats) == BF_SUCCESS) {
+			memcpy(port_info->stats, stats, sizeof(stats));
+			port_info->stats_valid = true;
+		}
+
+		map_sts = P4_SDE_MAP_GET_NEXT(&ctx->port_info_map, &key,
+					      (void **)&port_info);
+	}
+
+	P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
+}
+
+static void *port_mgr_port_stats_thread(void *arg)
+{
+	struct port_mgr_ctx_t *ctx = arg;
+	u32 elapsed_ms = 0;
+
+	while (port_mgr_stats_thread_run) {
+		P4_SDE_USLEEP(PORT_MGR_STATS_THREAD_PERIOD_US);
+
+		/* The interval may change while the thread runs */
+		elapsed_ms += PORT_MGR_STATS_THREAD_PERIOD_US / 1000;
+		if (elapsed_ms < ctx->stats_poll_intvl_ms)
+			continue;
+
+		elapsed_ms = 0;
+		port_mgr_port_stats_refresh(ctx);
+	}
+
+	return NULL;
+}
+
+bf_status_t port_mgr_port_stats_poll_intvl_set(bf_dev_id_t dev_id,
+					       u32 poll_intvl_ms)
+{
+	struct port_info_t *port_info = NULL;
+	struct port_mgr_ctx_t *ctx;
+	p4_sde_map_sts map_sts;
+	p4_sde_map_key key;
+	int status;
+
+	ctx = get_port_mgr_ctx();
+	if (!ctx)
+		return BF_OBJECT_NOT_FOUND;
+
+	if (!poll_intvl_ms) {
+		if (port_mgr_stats_thread_run) {
+			port_mgr_stats_thread_run = false;
+			pthread_join(port_mgr_stats_thread_id, NULL);
+		}
+
+		/* Drop the cached stats, they go stale from now on */
+		P4_SDE_MUTEX_LOCK(&ctx->port_info_lock);
+		ctx->stats_poll_intvl_ms = 0;
+		map_sts = P4_SDE_MAP_GET_FIRST(&ctx->port_info_map, &key,
+					       (void **)&port_info);
+		while (map_sts == BF_MAP_OK) {
+			port_info->stats_valid = false;
+			map_sts = P4_SDE_MAP_GET_NEXT(&ctx->port_info_map,
+						      &key,
+						      (void **)&port_info);
+		}
+		P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
+
+		return BF_SUCCESS;
+	}
+
+	ctx->stats_poll_intvl_ms = poll_intvl_ms;
+	if (port_mgr_stats_thread_run)
+		return BF_SUCCESS;
+
+	/* Fill the cache before the first reads are served from it */
+	port_mgr_port_stats_refresh(ctx);
+
+	port_mgr_stats_thread_run = true;
+	status = pthread_create(&port_mgr_stats_thread_id, NULL,
+				port_mgr_port_stats_thread, ctx);
+	if (status) {
+		port_mgr_log_error("%s: stats thread creation failed (%d)",
+				   __func__, status);
+		port_mgr_stats_thread_run = false;
+		ctx->stats_poll_intvl_ms = 0;
+		return BF_NO_SYS_RESOURCES;
+	}
+	pthread_setname_np(port_mgr_stats_thread_id, "port_mgr_stats");
+
+	return BF_SUCCESS;
+}
+
+bf_status_t port_mgr_port_stats_poll_intvl_get(bf_dev_id_t dev_id,
+					       u32 *poll_intvl_ms)
+{
+	struct port_mgr_ctx_t *ctx;
+
+	if (!poll_intvl_ms)
+		return BF_INVALID_ARG;
+
+	ctx = get_port_mgr_ctx();
+	if (!ctx)
+		return BF_OBJECT_NOT_FOUND;
+
+	*poll_intvl_ms = ctx->stats_poll_intvl_ms;
+
+	return BF_SUCCESS;
+}
+
 bf_status_t port_mgr_get_port_id_from_mac(bf_dev_id_t dev_id, char *mac,
 					  u32 *port_id)
 {
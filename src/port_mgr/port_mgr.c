@@ -33,6 +33,7 @@ void port_mgr_ctx_cleanup(struct port_mgr_ctx_t *ctx)
 
 	P4_SDE_MAP_DESTROY(&ctx->port_info_map);
 	P4_SDE_MAP_DESTROY(&ctx->port_name_map);
+	P4_SDE_MUTEX_DESTROY(&ctx->port_info_lock);
 
 	port_mgr_log_trace("Exiting %s", __func__);
 }
@@ -65,7 +66,9 @@ int port_mgr_set_port_info(bf_dev_port_t dev_port,
 	map = &ctx->port_info_map;
 
 	/* Insert Port Info to Hash Map */
+	P4_SDE_MUTEX_LOCK(&ctx->port_info_lock);
 	status = P4_SDE_MAP_ADD(map, dev_port, (void *)port_info);
+	P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
 	if (status != BF_MAP_OK) {
 		P4_SDE_FREE(port_info);
 		port_mgr_log_error("Failed to save port info,"
@@ -95,14 +98,18 @@ int port_mgr_remove_port_info(bf_dev_port_t dev_port)
 
 	map = &ctx->port_info_map;
 
+	P4_SDE_MUTEX_LOCK(&ctx->port_info_lock);
 	port_info = port_mgr_get_port_info(dev_port);
-	if (!port_info)
+	if (!port_info) {
+		P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
 		return BF_OBJECT_NOT_FOUND;
+	}
 
 	P4_SDE_FREE(port_info);
 
 	/* Remove Port Info from Hash Map */
 	status = P4_SDE_MAP_RMV(map, dev_port);
+	P4_SDE_MUTEX_UNLOCK(&ctx->port_info_lock);
 	if (status != BF_MAP_OK) {
 		port_mgr_log_error("%s: failed to remove object from map",
 				   __func__);
@@ -295,6 +302,13 @@ int port_mgr_shared_init(void)
 		return BF_NO_SYS_RESOURCES;
 	}
 
+	if (P4_SDE_MUTEX_INIT(&ctx->port_info_lock)) {
+		port_mgr_log_error("%s: failed to initialize port info lock",
+				   __func__);
+		P4_SDE_FREE(ctx);
+		return BF_NO_SYS_RESOURCES;
+	}
+
 	P4_SDE_MAP_INIT(&ctx->port_info_map);
 	P4_SDE_MAP_INIT(&ctx->port_name_map);
 
@@ -351,6 +365,7 @@ void port_mgr_cleanup(void)
 		return;
 	}
 
+	port_mgr_platform_cleanup();
 	port_mgr_ctx_cleanup(port_mgr_ctx_obj);
 	P4_SDE_FREE(port_mgr_ctx_obj);
 	port_mgr_ctx_obj = NULL;
@@ -45,6 +45,12 @@ struct port_mgr_ctx_t {
 	 * to port id 
          */
 	p4_sde_map port_name_map;         /*!< Port Name Hash to ID Map */
+	/* Protects port_info_map against the stats refresh thread and
+	 * the stats cached in the port infos
+	 */
+	p4_sde_mutex port_info_lock;
+	/* Stats cache refresh interval in msecs, 0 if stats are read live */
+	u32 stats_poll_intvl_ms;
 };
 
 /**
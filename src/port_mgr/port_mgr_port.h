@@ -38,6 +38,29 @@ bf_status_t port_mgr_port_add(bf_dev_id_t dev_id,
 			      bf_dev_port_t dev_port,
 			      struct port_attributes_t *port_attrib);
 
+/**
+ * Create the device of a Port (Tap, Link, Virtio-user or Memif) ahead of
+ * port_mgr_port_add, which then only adds the port to its pipelines. Safe
+ * to call concurrently for different ports.
+ * @param dev_id The Device ID
+ * @param dev_port The Port ID
+ * @param port_attrib The Port Attributes Eg. Port Name, Port Type etc
+ * @return Status of the API call.
+ */
+bf_status_t port_mgr_port_create(bf_dev_id_t dev_id,
+				 bf_dev_port_t dev_port,
+				 struct port_attributes_t *port_attrib);
+
+/**
+ * Delete a Port. Only ports added once their pipelines were built can be
+ * deleted.
+ * @param dev_id The Device ID
+ * @param dev_port The Port ID
+ * @return Status of the API call.
+ */
+bf_status_t port_mgr_port_del(bf_dev_id_t dev_id,
+			      bf_dev_port_t dev_port);
+
 /**
  * Get all statistics for a port
  * @param dev_id The Device ID
@@ -49,6 +72,60 @@ bf_status_t port_mgr_port_all_stats_get(bf_dev_id_t dev_id,
 					bf_dev_port_t dev_port,
 					u64 *stats);
 
+/**
+ * Get all statistics for the next n ports, in ascending port order, in a
+ * single pass over the ports
+ * @param dev_id The Device ID
+ * @param dev_port The Port ID to start after, ignored if first is set
+ * @param first Start from the first port
+ * @param n Max number of ports to read
+ * @param dev_ports Array of n entries to hold the IDs of the ports read
+ * @param stats Array of n * BF_PORT_NUM_COUNTERS entries to hold the stats
+ * @param num_returned Number of ports read
+ * @return Status of the API call.
+ */
+bf_status_t port_mgr_port_all_stats_get_next_n(bf_dev_id_t dev_id,
+					       bf_dev_port_t dev_port,
+					       bool first,
+					       u32 n,
+					       bf_dev_port_t *dev_ports,
+					       u64 *stats,
+					       u32 *num_returned);
+
+/**
+ * Get the statistics of one RX/TX queue of a port. Link ports with several
+ * queues have a pipeline port per queue.
+ * @param dev_id The Device ID
+ * @param dev_port The Port ID
+ * @param queue_id The Queue ID
+ * @param stats Array to hold all the stats read from hardware
+ * @return Status of the API call.
+ */
+bf_status_t port_mgr_port_queue_stats_get(bf_dev_id_t dev_id,
+					  bf_dev_port_t dev_port,
+					  u32 queue_id,
+					  u64 *stats);
+
+/**
+ * Set the interval at which the stats of all the ports are refreshed in
+ * the background. Once set, stats reads are served from the last refresh
+ * instead of reading the target.
+ * @param dev_id The Device ID
+ * @param poll_intvl_ms Refresh interval in msecs, 0 to read stats live
+ * @return Status of the API call.
+ */
+bf_status_t port_mgr_port_stats_poll_intvl_set(bf_dev_id_t dev_id,
+					       u32 poll_intvl_ms);
+
+/**
+ * Get the interval at which the stats of all the ports are refreshed
+ * @param dev_id The Device ID
+ * @param poll_intvl_ms Refresh interval in msecs, 0 if stats are read live
+ * @return Status of the API call.
+ */
+bf_status_t port_mgr_port_stats_poll_intvl_get(bf_dev_id_t dev_id,
+					       u32 *poll_intvl_ms);
+
 /**
  * Get Port ID from MAC address
  * @param dev_id The Device ID
@@ -502,14 +502,14 @@ class IPipeMgrIntf {
 
   virtual pipe_status_t pipeMgrMeterEntSet(pipe_sess_hdl_t sess_hdl,
                                            dev_target_t dev_tgt,
-                                           pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                           const char *table_name,
                                            pipe_meter_idx_t meter_idx,
                                            pipe_meter_spec_t *meter_spec,
                                            uint32_t pipe_api_flags) = 0;
 
   virtual pipe_status_t pipeMgrMeterReset(pipe_sess_hdl_t sess_hdl,
                                           dev_target_t dev_tgt,
-                                          pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                          const char *table_name,
                                           uint32_t pipe_api_flags) = 0;
 
   virtual pipe_status_t pipeMgrMeterReadEntry(
@@ -522,10 +522,33 @@ class IPipeMgrIntf {
   virtual pipe_status_t pipeMgrMeterReadEntryIdx(
       pipe_sess_hdl_t sess_hdl,
       dev_target_t dev_tgt,
-      pipe_meter_tbl_hdl_t meter_tbl_hdl,
+      const char *table_name,
       pipe_meter_idx_t index,
       pipe_meter_spec_t *meter_spec) = 0;
 
+  virtual pipe_status_t pipeMgrMeterEntSetRange(
+      pipe_sess_hdl_t sess_hdl,
+      dev_target_t dev_tgt,
+      const char *table_name,
+      pipe_meter_idx_t start_idx,
+      pipe_meter_idx_t end_idx,
+      pipe_meter_spec_t *meter_spec) = 0;
+
+  virtual pipe_status_t pipeMgrMeterStatsRead(
+      pipe_sess_hdl_t sess_hdl,
+      dev_target_t dev_tgt,
+      const char *table_name,
+      pipe_meter_idx_t index,
+      pipe_meter_stats_t *meter_stats) = 0;
+
+  virtual pipe_status_t pipeMgrMeterStatsReadRange(
+      pipe_sess_hdl_t sess_hdl,
+      dev_target_t dev_tgt,
+      const char *table_name,
+      pipe_meter_idx_t start_idx,
+      pipe_meter_idx_t end_idx,
+      pipe_meter_stats_t *meter_stats) = 0;
+
   virtual pipe_status_t pipeMgrMeterByteCountSet(
       pipe_sess_hdl_t sess_hdl,
       dev_target_t dev_tgt,
@@ -551,6 +574,16 @@ class IPipeMgrIntf {
       pipe_mat_tbl_hdl_t mat_tbl_hdl,
       pipe_mat_ent_hdl_t mat_ent_hdl) = 0;
 
+  virtual pipe_status_t pipeMgrLearnerTimeoutSet(pipe_sess_hdl_t sess_hdl,
+                                                 dev_target_t dev_tgt,
+                                                 uint32_t timeout_id,
+                                                 uint32_t timeout) = 0;
+
+  virtual pipe_status_t pipeMgrLearnerTimeoutGet(pipe_sess_hdl_t sess_hdl,
+                                                 dev_target_t dev_tgt,
+                                                 uint32_t timeout_id,
+                                                 uint32_t *timeout) = 0;
+
   virtual pipe_status_t pipeMgrMatEntSetIdleTtl(
       pipe_sess_hdl_t sess_hdl,
       tdi_dev_id_t device_id,
@@ -1387,7 +1420,7 @@ class PipeMgrIntf : public IPipeMgrIntf {
 
   pipe_status_t pipeMgrMeterEntSet(pipe_sess_hdl_t sess_hdl,
                                    dev_target_t dev_tgt,
-                                   pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                   const char *table_name,
                                    pipe_meter_idx_t meter_idx,
                                    pipe_meter_spec_t *meter_spec,
                                    uint32_t pipe_api_flags);
@@ -1398,7 +1431,7 @@ class PipeMgrIntf : public IPipeMgrIntf {
 
   pipe_status_t pipeMgrMeterReset(pipe_sess_hdl_t sess_hdl,
                                   dev_target_t dev_tgt,
-                                  pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                  const char *table_name,
                                   uint32_t pipe_api_flags);
 
   pipe_status_t pipeMgrMeterReadEntry(pipe_sess_hdl_t sess_hdl,
@@ -1409,10 +1442,30 @@ class PipeMgrIntf : public IPipeMgrIntf {
 
   pipe_status_t pipeMgrMeterReadEntryIdx(pipe_sess_hdl_t sess_hdl,
                                          dev_target_t dev_tgt,
-                                         pipe_meter_tbl_hdl_t meter_tbl_hdl,
+                                         const char *table_name,
                                          pipe_meter_idx_t index,
                                          pipe_meter_spec_t *meter_spec);
 
+  pipe_status_t pipeMgrMeterEntSetRange(pipe_sess_hdl_t sess_hdl,
+                                        dev_target_t dev_tgt,
+                                        const char *table_name,
+                                        pipe_meter_idx_t start_idx,
+                                        pipe_meter_idx_t end_idx,
+                                        pipe_meter_spec_t *meter_spec);
+
+  pipe_status_t pipeMgrMeterStatsRead(pipe_sess_hdl_t sess_hdl,
+                                      dev_target_t dev_tgt,
+                                      const char *table_name,
+                                      pipe_meter_idx_t index,
+                                      pipe_meter_stats_t *meter_stats);
+
+  pipe_status_t pipeMgrMeterStatsReadRange(pipe_sess_hdl_t sess_hdl,
+                                           dev_target_t dev_tgt,
+                                           const char *table_name,
+                                           pipe_meter_idx_t start_idx,
+                                           pipe_meter_idx_t end_idx,
+                                           pipe_meter_stats_t *meter_stats);
+
   pipe_status_t pipeMgrMeterByteCountSet(pipe_sess_hdl_t sess_hdl,
                                          dev_target_t dev_tgt,
                                          pipe_meter_tbl_hdl_t meter_tbl_hdl,
@@ -1433,6 +1486,16 @@ class PipeMgrIntf : public IPipeMgrIntf {
                                           pipe_mat_tbl_hdl_t mat_tbl_hdl,
                                           pipe_mat_ent_hdl_t mat_ent_hdl);
 
+  pipe_status_t pipeMgrLearnerTimeoutSet(pipe_sess_hdl_t sess_hdl,
+                                         dev_target_t dev_tgt,
+                                         uint32_t timeout_id,
+                                         uint32_t timeout);
+
+  pipe_status_t pipeMgrLearnerTimeoutGet(pipe_sess_hdl_t sess_hdl,
+                                         dev_target_t dev_tgt,
+                                         uint32_t timeout_id,
+                                         uint32_t *timeout);
+
   pipe_status_t pipeMgrMatEntSetIdleTtl(pipe_sess_hdl_t sess_hdl,
                                         tdi_dev_id_t device_id,
                                         pipe_mat_tbl_hdl_t mat_tbl_hdl,
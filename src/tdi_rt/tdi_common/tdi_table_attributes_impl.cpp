@@ -78,6 +78,16 @@ tdi_status_t TableAttributesImpl::setValue(const tdi_attributes_field_type_e &ty
       }
       break;
     }
+    case TDI_RT_ATTRIBUTES_TYPE_PORT_STAT_POLL_INTVL_MS: {
+      auto port_stat_field_type =
+          static_cast<tdi_rt_attributes_port_stat_poll_intvl_field_type_e>(type);
+      if (port_stat_field_type !=
+          TDI_RT_ATTRIBUTES_PORT_STAT_POLL_INTVL_FIELD_TYPE_MS) {
+        return TDI_INVALID_ARG;
+      }
+      port_stat_poll_intvl_ms_ = static_cast<uint32_t>(value);
+      break;
+    }
     default:
       LOG_TRACE(
           "%s:%d %s Invalid Attribute type (%d) encountered while trying to "
@@ -127,6 +137,16 @@ tdi_status_t TableAttributesImpl::getValue(const tdi_attributes_field_type_e &ty
       }
       break;
     }
+    case TDI_RT_ATTRIBUTES_TYPE_PORT_STAT_POLL_INTVL_MS: {
+      auto port_stat_field_type =
+          static_cast<tdi_rt_attributes_port_stat_poll_intvl_field_type_e>(type);
+      if (port_stat_field_type !=
+          TDI_RT_ATTRIBUTES_PORT_STAT_POLL_INTVL_FIELD_TYPE_MS) {
+        return TDI_INVALID_ARG;
+      }
+      *value = static_cast<uint64_t>(port_stat_poll_intvl_ms_);
+      break;
+    }
     default:
       LOG_TRACE(
           "%s:%d %s Invalid Attribute type (%d) encountered while trying to "
@@ -137,8 +137,15 @@ class TableAttributesImpl : public tdi::TableAttributes {
   };
   bool getIpsecSadbExpireTableEnabled() { return ipsec_sadb_expire_.getEnable(); };
 
+  uint32_t getPortStatPollIntvlMs() const { return port_stat_poll_intvl_ms_; };
+  void setPortStatPollIntvlMs(const uint32_t &poll_intvl_ms) {
+    port_stat_poll_intvl_ms_ = poll_intvl_ms;
+  };
+
   // IpsecSadbExpire ipsec_sadb_expire_
   TableAttributesIpsecSadbExpireReg ipsec_sadb_expire_;
+  // Port stats cache refresh interval
+  uint32_t port_stat_poll_intvl_ms_{0};
 };
 
 }  // namespace rt
@@ -24,6 +24,8 @@
 //#include <tdi_rt/tdi_port/dpdk/tdi_port_table_data_impl.hpp>
 #include <tdi_rt/tdi_port/tdi_port_table_key_impl.hpp>
 #include <bf_rt_port/bf_rt_port_mgr_intf.hpp>
+#include <tdi_rt/tdi_common/tdi_table_attributes_impl.hpp>
+#include <tdi_rt/tdi_rt_defs.h>
 
 // porting from src/bf_rt/bf_rt_port/bf_rt_port_table.cpp
 
@@ -56,6 +58,8 @@ void PortCfgTable::mapInit() {
   portTypeMap["BF_DPDK_SOURCE"] = BF_DPDK_SOURCE;
   portTypeMap["BF_DPDK_SINK"] = BF_DPDK_SINK;
   portTypeMap["BF_DPDK_RING"] = BF_DPDK_RING;
+  portTypeMap["BF_DPDK_VIRTIO_USER"] = BF_DPDK_VIRTIO_USER;
+  portTypeMap["BF_DPDK_MEMIF"] = BF_DPDK_MEMIF;
 }
 
 // call with flag method below
@@ -277,6 +281,26 @@ tdi_status_t PortCfgTable::entryAdd_internal(const Session & /*session*/,
           return BF_INVALID_ARG;
       }
       break;
+    case BF_DPDK_VIRTIO_USER:
+      if (u32Data.find(MTU_ID) != u32Data.end()) {
+          port_attrib.virtio_user.mtu =  u32Data.at(MTU_ID);
+      } else {
+          LOG_ERROR("%s:%d %s ERROR : Virtio-user Port needs mtu",
+                     __func__,
+                     __LINE__,
+                     tableInfoGet()->nameGet().c_str());
+          return BF_INVALID_ARG;
+      }
+      break;
+    case BF_DPDK_MEMIF:
+      // The file name is the memif control socket path, if any
+      if (strData.find(FILE_NAME_ID) != strData.end()) {
+          strncpy(port_attrib.memif.socket_path,
+                  strData.at(FILE_NAME_ID).c_str(),
+                  SOCK_PATH_LEN - 1);
+	  port_attrib.memif.socket_path[SOCK_PATH_LEN - 1] = '\0';
+      }
+      break;
     default:
       LOG_ERROR("%s:%d ERROR : Incorrect Port Type",
                  __func__,
@@ -303,7 +327,23 @@ tdi_status_t PortCfgTable::entryDel(const Session & /*session*/,
                                     const Target &dev_tgt,
                                     const Flags & /*flags*/,
                                     const TableKey &key) const {
-  return BF_SUCCESS;
+  const PortCfgTableKey &port_key =
+      static_cast<const PortCfgTableKey &>(key);
+  const uint32_t dev_port = port_key.getId();
+  auto *portMgr = PortMgrIntf::getInstance();
+  uint64_t dev_id = 0;
+
+  dev_tgt.getValue(TDI_TARGET_CORE, &dev_id);
+  tdi_status_t status =
+      portMgr->portMgrPortDel(static_cast<uint32_t>(dev_id), dev_port);
+  if (BF_SUCCESS != status) {
+      LOG_ERROR("%s:%d %s: Error in deleting port %d",
+              __func__,
+              __LINE__,
+              tableInfoGet()->nameGet().c_str(),
+              dev_port);
+  }
+  return status;
 }
 
 tdi_status_t PortCfgTable::keyReset(TableKey *key) const {
@@ -494,6 +534,93 @@ tdi_status_t PortStatTable::entryGet_internal(
   return status;
 }
 
+tdi_status_t PortStatTable::entryGetFirst(
+    const Session & /*session*/,
+    const Target &dev_tgt,
+    const Flags & /*flags*/,
+    TableKey *key,
+    TableData *data) const {
+  auto *portMgr = bfrt::PortMgrIntf::getInstance();
+  uint64_t stats[BF_PORT_NUM_COUNTERS];
+  bf_dev_port_t dev_port = 0;
+  uint32_t num_returned = 0;
+  uint64_t dev_id = 0;
+
+  memset(stats, 0, BF_PORT_NUM_COUNTERS * sizeof(uint64_t));
+  dev_tgt.getValue(TDI_TARGET_DEVICE, &dev_id);
+  tdi_status_t status =
+      portMgr->portMgrPortAllStatsGetNextN(static_cast<uint32_t>(dev_id),
+                                           0,
+                                           true,
+                                           1,
+                                           &dev_port,
+                                           stats,
+                                           &num_returned);
+  if (status != BF_SUCCESS) {
+    LOG_ERROR("%s:%d %s: Error getting stats of the first port",
+              __func__,
+              __LINE__,
+              tableInfoGet()->nameGet().c_str());
+    return status;
+  }
+  if (num_returned == 0) {
+    return BF_OBJECT_NOT_FOUND;
+  }
+
+  static_cast<PortStatTableKey *>(key)->setId(dev_port);
+  static_cast<PortStatTableData *>(data)->setAllValues(stats);
+  return BF_SUCCESS;
+}
+
+tdi_status_t PortStatTable::entryGetNextN(
+    const Session & /*session*/,
+    const Target &dev_tgt,
+    const Flags & /*flags*/,
+    const TableKey &key,
+    const uint32_t &n,
+    keyDataPairs *key_data_pairs,
+    uint32_t *num_returned) const {
+  auto *portMgr = bfrt::PortMgrIntf::getInstance();
+  const PortStatTableKey &port_key =
+      static_cast<const PortStatTableKey &>(key);
+  uint64_t dev_id = 0;
+
+  *num_returned = 0;
+  if (key_data_pairs == nullptr || key_data_pairs->size() < n) {
+    return BF_INVALID_ARG;
+  }
+
+  std::vector<bf_dev_port_t> dev_ports(n);
+  std::vector<uint64_t> stats(static_cast<size_t>(n) * BF_PORT_NUM_COUNTERS);
+  dev_tgt.getValue(TDI_TARGET_DEVICE, &dev_id);
+  tdi_status_t status =
+      portMgr->portMgrPortAllStatsGetNextN(static_cast<uint32_t>(dev_id),
+                                           port_key.getId(),
+                                           false,
+                                           n,
+                                           dev_ports.data(),
+                                           stats.data(),
+                                           num_returned);
+  if (status != BF_SUCCESS) {
+    LOG_ERROR("%s:%d %s: Error getting stats of the ports after dev_port %d",
+              __func__,
+              __LINE__,
+              tableInfoGet()->nameGet().c_str(),
+              port_key.getId());
+    *num_returned = 0;
+    return status;
+  }
+
+  for (uint32_t i = 0; i < *num_returned; i++) {
+    auto this_key = static_cast<PortStatTableKey *>((*key_data_pairs)[i].first);
+    auto this_data =
+        static_cast<PortStatTableData *>((*key_data_pairs)[i].second);
+    this_key->setId(dev_ports[i]);
+    this_data->setAllValues(&stats[i * BF_PORT_NUM_COUNTERS]);
+  }
+  return BF_SUCCESS;
+}
+
 tdi_status_t PortStatTable::dataReset(const std::vector<tdi_id_t> &fields,
                                      TableData *data) const {
   if (data == nullptr) {
@@ -541,6 +668,91 @@ tdi_status_t PortStatTable::dataAllocate(
   }
   return BF_SUCCESS;
 }
+tdi_status_t PortStatTable::attributeAllocate(
+    const tdi_attributes_type_e &attr_type,
+    std::unique_ptr<tdi::TableAttributes> *table_attr) const {
+  auto op_found = tableInfoGet()->attributesSupported().find(attr_type);
+  if (op_found == tableInfoGet()->attributesSupported().end()) {
+    *table_attr = nullptr;
+    LOG_ERROR("%s:%d %s Attribute %d not supported for this table",
+              __func__,
+              __LINE__,
+              tableInfoGet()->nameGet().c_str(),
+              static_cast<int>(attr_type));
+    return TDI_NOT_SUPPORTED;
+  }
+
+  *table_attr = std::unique_ptr<tdi::TableAttributes>(
+      new tdi::pna::rt::TableAttributesImpl(this, attr_type));
+  return TDI_SUCCESS;
+}
+
+tdi_status_t PortStatTable::tableAttributesSet(
+    const tdi::Session & /*session*/,
+    const tdi::Target &dev_tgt,
+    const tdi::Flags & /*flags*/,
+    const tdi::TableAttributes &tableAttributes) const {
+  auto tbl_attr_impl =
+      static_cast<const tdi::pna::rt::TableAttributesImpl *>(&tableAttributes);
+  const auto attr_type = static_cast<tdi_rt_attributes_type_e>(
+      tbl_attr_impl->attributeTypeGet());
+  auto attribute_type_set = tableInfoGet()->attributesSupported();
+  if (attribute_type_set.find(static_cast<tdi_attributes_type_e>(attr_type)) ==
+      attribute_type_set.end()) {
+    LOG_ERROR("%s:%d Attribute %d is not supported",
+              __func__,
+              __LINE__,
+              static_cast<int>(attr_type));
+    return TDI_NOT_SUPPORTED;
+  }
+
+  if (attr_type != TDI_RT_ATTRIBUTES_TYPE_PORT_STAT_POLL_INTVL_MS) {
+    LOG_ERROR("%s:%d Invalid Attribute type (%d) encountered while trying "
+              "to set attributes",
+              __func__,
+              __LINE__,
+              static_cast<int>(attr_type));
+    return TDI_NOT_SUPPORTED;
+  }
+
+  uint64_t dev_id = 0;
+  dev_tgt.getValue(TDI_TARGET_DEVICE, &dev_id);
+  auto *portMgr = bfrt::PortMgrIntf::getInstance();
+  return portMgr->portMgrPortStatsPollIntvlSet(
+      static_cast<uint32_t>(dev_id), tbl_attr_impl->getPortStatPollIntvlMs());
+}
+
+tdi_status_t PortStatTable::tableAttributesGet(
+    const tdi::Session & /*session*/,
+    const tdi::Target &dev_tgt,
+    const tdi::Flags & /*flags*/,
+    tdi::TableAttributes *tableAttributes) const {
+  auto tbl_attr_impl =
+      static_cast<tdi::pna::rt::TableAttributesImpl *>(tableAttributes);
+  const auto attr_type = static_cast<tdi_rt_attributes_type_e>(
+      tbl_attr_impl->attributeTypeGet());
+  if (attr_type != TDI_RT_ATTRIBUTES_TYPE_PORT_STAT_POLL_INTVL_MS) {
+    LOG_ERROR("%s:%d Invalid Attribute type (%d) encountered while trying "
+              "to get attributes",
+              __func__,
+              __LINE__,
+              static_cast<int>(attr_type));
+    return TDI_NOT_SUPPORTED;
+  }
+
+  uint64_t dev_id = 0;
+  uint32_t poll_intvl_ms = 0;
+  dev_tgt.getValue(TDI_TARGET_DEVICE, &dev_id);
+  auto *portMgr = bfrt::PortMgrIntf::getInstance();
+  auto status = portMgr->portMgrPortStatsPollIntvlGet(
+      static_cast<uint32_t>(dev_id), &poll_intvl_ms);
+  if (status != BF_SUCCESS) {
+    return status;
+  }
+  tbl_attr_impl->setPortStatPollIntvlMs(poll_intvl_ms);
+  return TDI_SUCCESS;
+}
+
 #ifdef __TDI_FROM_BFRT
 tdi_status_t PortStatTable::attributeAllocate(
     const TableAttributesType &type,
@@ -108,6 +108,10 @@ class PortStatTable : public Table {
             tdi_info,
             tdi::SupportedApis({
                 {TDI_TABLE_API_TYPE_GET, {"dev_id", "pipe_id", "pipe_all"}},
+                {TDI_TABLE_API_TYPE_GET_FIRST,
+                 {"dev_id", "pipe_id", "pipe_all"}},
+                {TDI_TABLE_API_TYPE_GET_NEXT_N,
+                 {"dev_id", "pipe_id", "pipe_all"}},
             }),
             table_info) {
     LOG_DBG("Creating PortStatTable table for %s", table_info->nameGet().c_str());
@@ -119,6 +123,23 @@ class PortStatTable : public Table {
                         const TableKey &key,
                         //const Table::TableGetFlag &flag,
                         TableData *data) const override;
+
+  // Ports are read in ascending dev_port order, the stats of all the ports
+  // returned by a call are read in a single pass.
+  tdi_status_t entryGetFirst(const Session &session,
+                             const Target &dev_tgt,
+                             const Flags &flags,
+                             TableKey *key,
+                             TableData *data) const override;
+
+  tdi_status_t entryGetNextN(const Session &session,
+                             const Target &dev_tgt,
+                             const Flags &flags,
+                             const TableKey &key,
+                             const uint32_t &n,
+                             keyDataPairs *key_data_pairs,
+                             uint32_t *num_returned) const override;
+
   tdi_status_t keyAllocate(
       std::unique_ptr<TableKey> *key_ret) const override;
 
@@ -132,12 +153,22 @@ class PortStatTable : public Table {
   tdi_status_t dataReset(TableData *data) const override final;
   tdi_status_t dataReset(const std::vector<tdi_id_t> &fields,
                          TableData *data) const override final;
-#if 0
   // Attribute APIs
   tdi_status_t attributeAllocate(
-      const TableAttributesType &type,
-      std::unique_ptr<TableAttributes> *attr) const override;
-#endif
+      const tdi_attributes_type_e &attr_type,
+      std::unique_ptr<tdi::TableAttributes> *table_attr) const override;
+
+  tdi_status_t tableAttributesSet(
+      const tdi::Session & /*session*/,
+      const tdi::Target &dev_tgt,
+      const tdi::Flags & /*flags*/,
+      const tdi::TableAttributes &tableAttributes) const override;
+
+  tdi_status_t tableAttributesGet(
+      const tdi::Session & /*session*/,
+      const tdi::Target &dev_tgt,
+      const tdi::Flags & /*flags*/,
+      tdi::TableAttributes *tableAttributes) const override;
 
  private:
   tdi_status_t entryGet_internal(const Target &dev_tgt,
@@ -0,0 +1,248 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*Each testcase file can atmost have 5k checks
+ *Note: Please update the number of checks included in the below field
+ *Number of checks = 16*/
+
+#include <gmock/gmock.h>
+#include <string.h>
+#include <stdlib.h>
+#include <gmock-global.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C"{
+    #include "infra/dpdk_balancer.c"
+    #include "mock.h"
+}
+
+using namespace std;
+using ::testing::AnyNumber;
+using ::testing::AtLeast;
+using ::testing::Return;
+using ::testing::_;
+
+MOCK_GLOBAL_FUNC1(pipeline_next,
+		  struct pipeline *(struct pipeline *pipeline));
+MOCK_GLOBAL_FUNC2(thread_pipeline_stats_read,
+		  int(const char *pipeline_name,
+		  struct thread_pipeline_stats *stats));
+MOCK_GLOBAL_FUNC2(thread_stats_read,
+		  int(uint32_t thread_id, struct thread_stats *stats));
+MOCK_GLOBAL_FUNC2(thread_pipeline_migrate,
+		  int(const char *pipeline_name, uint32_t thread_id));
+MOCK_GLOBAL_FUNC3(rte_get_next_lcore,
+		  unsigned int(unsigned int i, int skip_main, int wrap));
+MOCK_GLOBAL_FUNC1(rte_lcore_is_enabled, int(unsigned int lcore_id));
+MOCK_GLOBAL_FUNC0(rte_get_main_lcore, unsigned int());
+MOCK_GLOBAL_FUNC1(rte_eal_get_lcore_state,
+		  enum rte_lcore_state_t(unsigned int lcore_id));
+
+/* Variadic, gmock can't mock it: the moves are logged to nowhere. */
+int rte_log(uint32_t level __rte_unused, uint32_t logtype __rte_unused,
+	    const char *format __rte_unused, ...)
+{
+	return 0;
+}
+
+/* Worker threads 1 to 3, pipelines 0 and 1 on thread 1, 2 on thread 2. */
+#define UT_N_WORKERS 3
+#define UT_N_PIPES 3
+
+static struct pipeline ut_pipes[UT_N_PIPES];
+/* Cycles each pipeline spends on packets per period. */
+static uint64_t ut_load[UT_N_PIPES];
+static uint64_t ut_run_cycles[UT_N_PIPES];
+static uint64_t ut_n_pkts[UT_N_PIPES];
+static std::vector<std::pair<std::string, uint32_t> > ut_migrations;
+
+static struct pipeline *ut_pipe_find(const char *name)
+{
+	for (int i = 0; i < UT_N_PIPES; i++)
+		if (!strcmp(ut_pipes[i].name, name))
+			return &ut_pipes[i];
+	return NULL;
+}
+
+struct pipeline *pipeline_next_dummy(struct pipeline *pipeline)
+{
+	if (!pipeline)
+		return &ut_pipes[0];
+	if (pipeline == &ut_pipes[UT_N_PIPES - 1])
+		return NULL;
+	return pipeline + 1;
+}
+
+int pipeline_stats_read_dummy(const char *pipeline_name,
+			      struct thread_pipeline_stats *stats)
+{
+	struct pipeline *p = ut_pipe_find(pipeline_name);
+	int i = p - ut_pipes;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->thread_id = p->thread_id;
+	stats->enabled = 1;
+	stats->run_cycles = ut_run_cycles[i];
+	stats->n_pkts_in = ut_n_pkts[i];
+	return 0;
+}
+
+int balancer_migrate_dummy(const char *pipeline_name, uint32_t thread_id)
+{
+	ut_migrations.push_back(std::make_pair(std::string(pipeline_name),
+					       thread_id));
+	ut_pipe_find(pipeline_name)->thread_id = thread_id;
+	return 0;
+}
+
+unsigned int next_lcore_dummy(unsigned int i, int skip_main, int wrap)
+{
+	unsigned int next = i + 1;
+
+	/* Lcore 0 is the main one, the walk starts from -1. */
+	if (!next)
+		next = 1;
+	return (next <= UT_N_WORKERS) ? next : RTE_MAX_LCORE;
+}
+
+static void ut_balancer_setup()
+{
+	static const uint32_t threads[UT_N_PIPES] = {1, 1, 2};
+
+	memset(ut_pipes, 0, sizeof(ut_pipes));
+	for (int i = 0; i < UT_N_PIPES; i++) {
+		snprintf(ut_pipes[i].name, sizeof(ut_pipes[i].name), "pipe%d",
+			 i);
+		ut_pipes[i].enabled = 1;
+		ut_pipes[i].thread_id = threads[i];
+		ut_pipes[i].n_instances = 1;
+		ut_pipes[i].instance[0] = &ut_pipes[i];
+		ut_run_cycles[i] = 0;
+		ut_n_pkts[i] = 0;
+	}
+
+	/* Only pipeline 0 is balanced, at 50% of a 1000 cycles period. */
+	ut_pipes[0].balance.threshold = 50;
+	ut_pipes[0].balance.hysteresis = 3;
+	ut_pipes[0].balance.hold = 2;
+	ut_load[0] = 400;
+	ut_load[1] = 300;
+	ut_load[2] = 100;
+	balancer_period = 1000;
+	ut_migrations.clear();
+
+	EXPECT_GLOBAL_CALL(pipeline_next, pipeline_next(_))
+		.WillRepeatedly(&pipeline_next_dummy);
+	EXPECT_GLOBAL_CALL(thread_pipeline_stats_read,
+			   thread_pipeline_stats_read(_,_))
+		.WillRepeatedly(&pipeline_stats_read_dummy);
+	EXPECT_GLOBAL_CALL(thread_stats_read, thread_stats_read(_,_))
+		.WillRepeatedly(Return(0));
+	EXPECT_GLOBAL_CALL(thread_pipeline_migrate, thread_pipeline_migrate(_,_))
+		.WillRepeatedly(&balancer_migrate_dummy);
+	EXPECT_GLOBAL_CALL(rte_get_next_lcore, rte_get_next_lcore(_,_,_))
+		.WillRepeatedly(&next_lcore_dummy);
+	EXPECT_GLOBAL_CALL(rte_lcore_is_enabled, rte_lcore_is_enabled(_))
+		.WillRepeatedly(Return(1));
+	EXPECT_GLOBAL_CALL(rte_get_main_lcore, rte_get_main_lcore())
+		.WillRepeatedly(Return(0));
+	EXPECT_GLOBAL_CALL(rte_eal_get_lcore_state, rte_eal_get_lcore_state(_))
+		.WillRepeatedly(Return(RUNNING));
+}
+
+/* Run one balancer period, the pipelines spending their load on packets. */
+static void ut_balancer_period()
+{
+	for (int i = 0; i < UT_N_PIPES; i++) {
+		ut_run_cycles[i] += ut_load[i];
+		ut_n_pkts[i]++;
+	}
+	balancer_run();
+}
+
+/*
+ * Test Case for a pipeline moved to the least loaded thread once its thread
+ * stayed over the threshold for hysteresis periods
+ */
+TEST(BALANCER, case0) {
+	ut_balancer_setup();
+
+	ut_balancer_period();
+	ut_balancer_period();
+	ASSERT_EQ(ut_migrations.size(), 0);
+	ASSERT_EQ(ut_pipes[0].balance_n_over, 2);
+
+	ut_balancer_period();
+	ASSERT_EQ(ut_migrations.size(), 1);
+	ASSERT_EQ(ut_migrations[0], std::make_pair(std::string("pipe0"), 3u));
+	ASSERT_EQ(balancer_load[1], 300);
+	ASSERT_EQ(balancer_load[3], 400);
+	ASSERT_EQ(ut_pipes[0].balance_n_over, 0);
+	ASSERT_EQ(ut_pipes[0].balance_n_hold, 2);
+}
+
+/*
+ * Test Case for a period under the threshold restarting the hysteresis
+ */
+TEST(BALANCER, case1) {
+	ut_balancer_setup();
+
+	ut_balancer_period();
+	ut_balancer_period();
+	ut_load[1] = 50;
+	ut_balancer_period();
+	ASSERT_EQ(ut_pipes[0].balance_n_over, 0);
+
+	ut_load[1] = 300;
+	ut_balancer_period();
+	ut_balancer_period();
+	ASSERT_EQ(ut_migrations.size(), 0);
+	ut_balancer_period();
+	ASSERT_EQ(ut_migrations.size(), 1);
+}
+
+/*
+ * Test Case for a moved pipeline held on its new thread
+ */
+TEST(BALANCER, case2) {
+	ut_balancer_setup();
+	ut_pipes[0].balance_n_hold = 2;
+	ut_pipes[0].balance.hysteresis = 1;
+
+	ut_balancer_period();
+	ut_balancer_period();
+	ASSERT_EQ(ut_migrations.size(), 0);
+	ASSERT_EQ(ut_pipes[0].balance_n_hold, 0);
+
+	ut_balancer_period();
+	ASSERT_EQ(ut_migrations.size(), 1);
+}
+
+/*
+ * Test Case for a sharded pipeline, whose instances are never moved
+ */
+TEST(BALANCER, case3) {
+	ut_balancer_setup();
+	ut_pipes[0].n_instances = 2;
+	ut_pipes[0].balance.hysteresis = 1;
+
+	for (int i = 0; i < 5; i++)
+		ut_balancer_period();
+	ASSERT_EQ(ut_migrations.size(), 0);
+	ASSERT_EQ(ut_pipes[0].balance_n_over, 0);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Microbenchmark of the object name index against the list walk it
+ * replaced, with as many rings as a large port config creates. It only
+ * reports the cycles per lookup, it is not part of the unit tests: run
+ * build/lld/dpdk/dpdk_obj_bench by hand.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+extern "C"{
+    #include "infra/dpdk_obj.c"
+    #include "mock.h"
+}
+
+/* Rings are memzones, which EAL has a few thousands of. */
+#define BENCH_N_RINGS 1024
+#define BENCH_N_LOOKUPS (64 * 1024)
+
+static char bench_names[BENCH_N_RINGS][NAME_SIZE];
+
+static struct ring *bench_ring_walk(const char *name)
+{
+	struct ring *ring;
+
+	TAILQ_FOREACH(ring, &obj->ring_list, node)
+		if (strcmp(ring->name, name) == 0)
+			return ring;
+
+	return NULL;
+}
+
+/* Average TSC cycles of a lookup, over names spread across the list. */
+static double bench_lookup_cycles(struct ring *(*find)(const char *),
+				  int *n_found)
+{
+	uint64_t start;
+
+	*n_found = 0;
+	start = rte_rdtsc();
+	for (int i = 0; i < BENCH_N_LOOKUPS; i++)
+		*n_found += find(bench_names[(i * 7919) % BENCH_N_RINGS]) !=
+			NULL;
+
+	return (double)(rte_rdtsc() - start) / BENCH_N_LOOKUPS;
+}
+
+int main()
+{
+	static const char *eal_argv[] = {"dpdk_obj_bench", "--no-huge",
+					 "--no-pci", "--no-shconf", "-m",
+					 "256", "-l", "0",
+					 "--log-level=lib.eal:error"};
+	struct ring_params params = {4, 0};
+	double index_cycles, walk_cycles;
+	int n_index, n_walk;
+
+	if (rte_eal_init(RTE_DIM(eal_argv), (char **)eal_argv) < 0 ||
+	    obj_init()) {
+		fprintf(stderr, "EAL or obj initialization failed\n");
+		return EXIT_FAILURE;
+	}
+
+	for (int i = 0; i < BENCH_N_RINGS; i++) {
+		snprintf(bench_names[i], NAME_SIZE, "BENCH_RING%d", i);
+		if (!ring_create(bench_names[i], &params)) {
+			fprintf(stderr, "Ring %s creation failed\n",
+				bench_names[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	index_cycles = bench_lookup_cycles(ring_find, &n_index);
+	walk_cycles = bench_lookup_cycles(bench_ring_walk, &n_walk);
+
+	printf("ring_find over %d rings: index %.1f cycles (%d found), "
+	       "list walk %.1f cycles (%d found) per lookup\n",
+	       BENCH_N_RINGS, index_cycles, n_index, walk_cycles, n_walk);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*Each testcase file can atmost have 5k checks
+ *Note: Please update the number of checks included in the below field
+ *Number of checks = 12*/
+
+#include <gmock/gmock.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <gmock-global.h>
+
+extern "C"{
+    #include "infra/dpdk_obj.c"
+    #include "mock.h"
+}
+
+using namespace std;
+using ::testing::AtLeast;
+using ::testing::Return;
+using ::testing::_;
+
+/* Rings are memzones, which EAL has a few thousands of. */
+#define UT_OBJ_N_RINGS 1024
+
+/* The objects are real DPDK rings, EAL runs without hugepages nor PCI. */
+static void ut_obj_setup()
+{
+	static const char *argv[] = {"dpdk_obj_ut", "--no-huge", "--no-pci",
+				     "--no-shconf", "-m", "256", "-l", "0",
+				     "--log-level=lib.eal:error"};
+	struct ring_params params = {4, 0};
+	static bool init;
+	char name[NAME_SIZE];
+
+	if (init)
+		return;
+
+	ASSERT_GE(rte_eal_init(RTE_DIM(argv), (char **)argv), 0);
+	ASSERT_EQ(obj_init(), 0);
+
+	for (int i = 0; i < UT_OBJ_N_RINGS; i++) {
+		snprintf(name, sizeof(name), "UT_RING%d", i);
+		ASSERT_NE(ring_create(name, &params), (void *)NULL);
+	}
+	init = true;
+}
+
+/* The lookup the index replaced: a walk of the list comparing names. */
+static struct ring *ut_ring_walk(const char *name)
+{
+	struct ring *ring;
+
+	TAILQ_FOREACH(ring, &obj->ring_list, node)
+		if (strcmp(ring->name, name) == 0)
+			return ring;
+
+	return NULL;
+}
+
+/*
+ * Test Case for the name index giving the same answers as the list
+ */
+TEST(OBJ_INDEX, case0) {
+	char name[NAME_SIZE + 1];
+
+	ut_obj_setup();
+
+	ASSERT_EQ(ring_find("UT_RING17"), ut_ring_walk("UT_RING17"));
+	ASSERT_EQ(ring_find("UT_RING"), (void *)NULL);
+
+	/* A name which can't fit a node matches none. */
+	memset(name, 'R', NAME_SIZE);
+	name[NAME_SIZE] = '\0';
+	ASSERT_EQ(ring_find(name), (void *)NULL);
+}
+
+/*
+ * Test Case for every ring being found through the index
+ */
+TEST(OBJ_INDEX, case1) {
+	char name[NAME_SIZE];
+	struct ring *ring;
+
+	ut_obj_setup();
+
+	for (int i = 0; i < UT_OBJ_N_RINGS; i++) {
+		snprintf(name, sizeof(name), "UT_RING%d", i);
+		ring = ring_find(name);
+		ASSERT_NE(ring, (void *)NULL);
+		ASSERT_EQ(ring, ut_ring_walk(name));
+	}
+}
+
+/*
+ * Test Case for a full index: all its entries can be used, then adding
+ * one more fails
+ */
+TEST(OBJ_INDEX, case2) {
+	struct rte_hash *index;
+	char name[NAME_SIZE];
+
+	ut_obj_setup();
+
+	index = obj_index_create("UT_INDEX");
+	ASSERT_NE(index, (void *)NULL);
+
+	for (int i = 0; i < OBJ_INDEX_SIZE; i++) {
+		snprintf(name, sizeof(name), "UT_OBJ%d", i);
+		ASSERT_EQ(obj_index_add(index, name, index), 0);
+	}
+
+	ASSERT_EQ(obj_index_add(index, "UT_OBJ_MORE", index), -ENOSPC);
+	ASSERT_EQ(obj_index_find(index, "UT_OBJ0"), (void *)index);
+
+	rte_hash_free(index);
+}
@@ -0,0 +1,344 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*Each testcase file can atmost have 5k checks
+ *Note: Please update the number of checks included in the below field
+ *Number of checks = 46*/
+
+#include <gmock/gmock.h>
+#include <string.h>
+#include <stdlib.h>
+#include <gmock-global.h>
+#include <set>
+#include <string>
+#include <vector>
+
+extern "C"{
+    #include "infra/dpdk_slot.c"
+    #include "mock.h"
+}
+
+using namespace std;
+using ::testing::AnyNumber;
+using ::testing::AtLeast;
+using ::testing::Return;
+using ::testing::_;
+
+MOCK_GLOBAL_FUNC1(ring_find, struct ring *(const char *name));
+MOCK_GLOBAL_FUNC2(ring_create,
+		  struct ring *(const char *name, struct ring_params *params));
+MOCK_GLOBAL_FUNC2(pipeline_iospec_add,
+		  int(struct pipeline *pipeline, const char *line));
+MOCK_GLOBAL_FUNC1(rte_ring_lookup, struct rte_ring *(const char *name));
+
+/* The out ring port of the slots, and the ports bound to them. */
+struct rte_swx_port_in_ops rte_swx_port_ring_reader_ops;
+static struct rte_swx_port_in_ops ut_in_ops;
+static struct rte_swx_port_out_ops ut_out_ops;
+
+static std::set<std::string> ut_rings;
+static struct ring ut_ring;
+/* The in ring of all the slots, a real one holding UT_IN_RING_SIZE - 1. */
+#define UT_IN_RING_SIZE 8
+static struct rte_ring *ut_in_ring;
+/* I/O spec lines added before one fails, -1 for no failure. */
+static int ut_iospec_ok;
+/* Packets of the in port and of the out ring, sent to the in ring and to
+ * the out port.
+ */
+static std::vector<struct rte_mbuf *> ut_port_in, ut_ring_out;
+static int ut_port_out_n_pkts, ut_port_out_n_flush;
+static int ut_n_ports;
+
+struct ring *ring_find_dummy(const char *name)
+{
+	return ut_rings.count(name) ? &ut_ring : NULL;
+}
+
+struct ring *ring_create_dummy(const char *name, struct ring_params *params)
+{
+	if (ut_rings.count(name))
+		return NULL;
+	ut_rings.insert(name);
+	return &ut_ring;
+}
+
+/* Append a line to the I/O spec, as the obj library does. */
+int iospec_add_dummy(struct pipeline *pipeline, const char *line)
+{
+	size_t len = strlen(line);
+
+	if (ut_iospec_ok == 0)
+		return -1;
+	if (ut_iospec_ok > 0)
+		ut_iospec_ok--;
+
+	pipeline->iospec = (char *)realloc(pipeline->iospec,
+					   pipeline->iospec_len + len + 1);
+	memcpy(&pipeline->iospec[pipeline->iospec_len], line, len + 1);
+	pipeline->iospec_len += len;
+	return 0;
+}
+
+static void *ut_port_create(void *args)
+{
+	ut_n_ports++;
+	return &ut_n_ports;
+}
+
+static void ut_port_free(void *port)
+{
+	ut_n_ports--;
+}
+
+static int ut_pkt_pop(std::vector<struct rte_mbuf *> &q,
+		      struct rte_swx_pkt *pkt)
+{
+	if (q.empty())
+		return 0;
+	memset(pkt, 0, sizeof(*pkt));
+	pkt->handle = q.back();
+	q.pop_back();
+	return 1;
+}
+
+static int ut_port_in_rx(void *port, struct rte_swx_pkt *pkt)
+{
+	return ut_pkt_pop(ut_port_in, pkt);
+}
+
+static int ut_ring_out_rx(void *port, struct rte_swx_pkt *pkt)
+{
+	return ut_pkt_pop(ut_ring_out, pkt);
+}
+
+struct rte_ring *ring_lookup_dummy(const char *name)
+{
+	return ut_in_ring;
+}
+
+static void ut_port_out_tx(void *port, struct rte_swx_pkt *pkt)
+{
+	ut_port_out_n_pkts++;
+}
+
+static void ut_port_out_flush(void *port)
+{
+	ut_port_out_n_flush++;
+}
+
+/* An mbuf referenced twice, so that freeing it only drops a reference. */
+static void ut_mbuf_init(struct rte_mbuf *m)
+{
+	memset(m, 0, sizeof(*m));
+	m->nb_segs = 1;
+	rte_mbuf_refcnt_set(m, 2);
+}
+
+static void ut_slot_setup(struct pipeline *p, char *iospec)
+{
+	memset(slots, 0, sizeof(slots));
+	n_slots = 0;
+	/* The slots are run by the test, not by the slot thread. */
+	slot_thread_running = 1;
+
+	memset(p, 0, sizeof(*p));
+	strcpy(p->name, "pipe");
+	p->iospec = (char *)malloc(strlen(iospec) + 1);
+	strcpy(p->iospec, iospec);
+	p->iospec_len = strlen(iospec);
+	p->n_slots = 2;
+
+	ut_rings.clear();
+	ut_iospec_ok = -1;
+	ut_port_in.clear();
+	ut_ring_out.clear();
+	ut_port_out_n_pkts = 0;
+	ut_port_out_n_flush = 0;
+	ut_n_ports = 0;
+
+	if (!ut_in_ring)
+		ASSERT_EQ(posix_memalign((void **)&ut_in_ring,
+					 RTE_CACHE_LINE_SIZE,
+					 rte_ring_get_memsize(UT_IN_RING_SIZE)),
+			  0);
+	ASSERT_EQ(rte_ring_init(ut_in_ring, "UT_IN_RING", UT_IN_RING_SIZE,
+				RING_F_SP_ENQ | RING_F_SC_DEQ), 0);
+
+	rte_swx_port_ring_reader_ops.create = ut_port_create;
+	rte_swx_port_ring_reader_ops.free = ut_port_free;
+	rte_swx_port_ring_reader_ops.pkt_rx = ut_ring_out_rx;
+	ut_in_ops.create = ut_port_create;
+	ut_in_ops.free = ut_port_free;
+	ut_in_ops.pkt_rx = ut_port_in_rx;
+	ut_out_ops.create = ut_port_create;
+	ut_out_ops.free = ut_port_free;
+	ut_out_ops.pkt_tx = ut_port_out_tx;
+	ut_out_ops.flush = ut_port_out_flush;
+
+	EXPECT_GLOBAL_CALL(ring_find, ring_find(_))
+		.WillRepeatedly(&ring_find_dummy);
+	EXPECT_GLOBAL_CALL(ring_create, ring_create(_,_))
+		.WillRepeatedly(&ring_create_dummy);
+	EXPECT_GLOBAL_CALL(pipeline_iospec_add, pipeline_iospec_add(_,_))
+		.WillRepeatedly(&iospec_add_dummy);
+	EXPECT_GLOBAL_CALL(rte_ring_lookup, rte_ring_lookup(_))
+		.WillRepeatedly(&ring_lookup_dummy);
+}
+
+/* A pass of the slot thread over the first slot. */
+static uint32_t ut_slot_run()
+{
+	static struct slot_ports run[SLOTS_MAX];
+	uint32_t n_pkts;
+
+	slot_snapshot(run);
+	n_pkts = slot_run(&run[0]);
+	slot_pass_end();
+
+	return n_pkts;
+}
+
+/*
+ * Test Case for a reservation failing half way: nothing is left in the I/O
+ * spec nor in the slots, and the next one reuses the rings
+ */
+TEST(PIPELINE_SLOTS, case0) {
+	char iospec[] = "port in 0 fd 5 mtu 1500 mempool MEMPOOL0 bsz 32\n"
+			"port out 1 fd 5 bsz 32\n";
+	struct pipeline p;
+
+	ut_slot_setup(&p, iospec);
+	ut_iospec_ok = 3;
+
+	ASSERT_EQ(pipeline_slots_reserve(&p), -1);
+	ASSERT_EQ(n_slots, 0);
+	ASSERT_EQ(ut_n_ports, 0);
+	ASSERT_EQ(p.iospec_len, strlen(iospec));
+	ASSERT_STREQ(p.iospec, iospec);
+	ASSERT_EQ(slots[0].pipeline, (void *)NULL);
+
+	ut_iospec_ok = -1;
+	ASSERT_EQ(pipeline_slots_reserve(&p), 0);
+	ASSERT_EQ(n_slots, 2);
+	ASSERT_EQ(ut_rings.size(), 4);
+	ASSERT_EQ(slots[1].port_in_id, 2);
+	ASSERT_EQ(slots[1].port_out_id, 3);
+	ASSERT_TRUE(strstr(p.iospec, "port out 3 ring slot1_out bsz") != NULL);
+	free(p.iospec);
+}
+
+/*
+ * Test Case for ports bound to and unbound from the slots
+ */
+TEST(PIPELINE_SLOTS, case1) {
+	char iospec[] = "port in 0 fd 5 mtu 1500 mempool MEMPOOL0 bsz 32\n";
+	struct rte_mbuf mbufs[3];
+	struct pipeline p;
+	int params;
+
+	ut_slot_setup(&p, iospec);
+	ASSERT_EQ(pipeline_slots_reserve(&p), 0);
+
+	ASSERT_EQ(pipeline_slot_in_bind(&p, 1, &ut_in_ops, &params), 0);
+	ASSERT_EQ(pipeline_slot_in_bind(&p, 1, &ut_in_ops, &params), -1);
+	/* Port 0 is not a reserved one. */
+	ASSERT_EQ(pipeline_slot_in_bind(&p, 0, &ut_in_ops, &params), -1);
+
+	for (int i = 0; i < 3; i++) {
+		ut_mbuf_init(&mbufs[i]);
+		ut_port_in.push_back(&mbufs[i]);
+	}
+	ASSERT_EQ(ut_slot_run(), 3);
+	ASSERT_EQ(rte_ring_count(ut_in_ring), 3);
+
+	ASSERT_EQ(pipeline_slot_in_unbind(&p, 1), 0);
+	ASSERT_EQ(pipeline_slot_in_unbind(&p, 1), -1);
+	ASSERT_EQ(slots[0].in, (void *)NULL);
+	free(p.iospec);
+}
+
+/*
+ * Test Case for the out ring of a slot: sent to the bound port, dropped
+ * while no port is bound
+ */
+TEST(PIPELINE_SLOTS, case2) {
+	char iospec[] = "port out 0 fd 5 bsz 32\n";
+	struct rte_mbuf mbufs[4];
+	struct pipeline p;
+	int params;
+
+	ut_slot_setup(&p, iospec);
+	ASSERT_EQ(pipeline_slots_reserve(&p), 0);
+
+	for (int i = 0; i < 4; i++)
+		ut_mbuf_init(&mbufs[i]);
+
+	ut_ring_out.push_back(&mbufs[0]);
+	ut_ring_out.push_back(&mbufs[1]);
+	ASSERT_EQ(ut_slot_run(), 2);
+	ASSERT_TRUE(ut_ring_out.empty());
+	ASSERT_EQ(rte_mbuf_refcnt_read(&mbufs[0]), 1);
+
+	ASSERT_EQ(pipeline_slot_out_bind(&p, 1, &ut_out_ops, &params), 0);
+	ut_ring_out.push_back(&mbufs[2]);
+	ut_ring_out.push_back(&mbufs[3]);
+	ASSERT_EQ(ut_slot_run(), 2);
+	ASSERT_EQ(ut_port_out_n_pkts, 2);
+	ASSERT_EQ(rte_mbuf_refcnt_read(&mbufs[2]), 2);
+
+	ASSERT_EQ(pipeline_slot_out_unbind(&p, 1), 0);
+	ASSERT_EQ(ut_port_out_n_flush, 2);
+	free(p.iospec);
+}
+
+/*
+ * Test Case for a full in ring: the packets that don't fit are dropped and
+ * counted, the slot thread doesn't wait for the pipeline
+ */
+TEST(PIPELINE_SLOTS, case3) {
+	char iospec[] = "port in 0 fd 5 mtu 1500 mempool MEMPOOL0 bsz 32\n";
+	struct rte_mbuf mbufs[UT_IN_RING_SIZE + 1];
+	struct pipeline p;
+	uint64_t n_drops;
+	int params;
+
+	ut_slot_setup(&p, iospec);
+	ASSERT_EQ(pipeline_slots_reserve(&p), 0);
+	ASSERT_EQ(pipeline_slot_in_bind(&p, 1, &ut_in_ops, &params), 0);
+
+	for (int i = 0; i < UT_IN_RING_SIZE + 1; i++) {
+		ut_mbuf_init(&mbufs[i]);
+		ut_port_in.push_back(&mbufs[i]);
+	}
+	ASSERT_EQ(ut_slot_run(), UT_IN_RING_SIZE + 1);
+	ASSERT_EQ(rte_ring_count(ut_in_ring), UT_IN_RING_SIZE - 1);
+
+	/* The port gives its packets last in first out. */
+	ASSERT_EQ(rte_mbuf_refcnt_read(&mbufs[0]), 1);
+	ASSERT_EQ(rte_mbuf_refcnt_read(&mbufs[1]), 1);
+	ASSERT_EQ(rte_mbuf_refcnt_read(&mbufs[2]), 2);
+
+	ASSERT_EQ(pipeline_slot_in_drops_read(&p, 1, &n_drops), 0);
+	ASSERT_EQ(n_drops, 2);
+	ASSERT_EQ(pipeline_slot_in_drops_read(&p, 0, &n_drops), -1);
+
+	/* No pass is in progress, the port is freed right away. */
+	ASSERT_EQ(slot_pass & 1, 0);
+	ASSERT_EQ(pipeline_slot_in_unbind(&p, 1), 0);
+	ASSERT_EQ(ut_n_ports, 2);
+	free(p.iospec);
+}
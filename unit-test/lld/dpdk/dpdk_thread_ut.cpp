@@ -0,0 +1,352 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*Each testcase file can atmost have 5k checks
+ *Note: Please update the number of checks included in the below field
+ *Number of checks = 47*/
+
+#include <gmock/gmock.h>
+#include <string.h>
+#include <stdlib.h>
+#include <gmock-global.h>
+
+extern "C"{
+    #include "infra/dpdk_thread.c"
+    #include "mock.h"
+}
+
+using namespace std;
+using ::testing::AnyNumber;
+using ::testing::AtLeast;
+using ::testing::Return;
+using ::testing::_;
+
+MOCK_GLOBAL_FUNC3(rte_swx_ctl_pipeline_port_in_stats_read,
+		  int(struct rte_swx_pipeline *p, uint32_t port_id,
+		  struct rte_swx_port_in_stats *stats));
+MOCK_GLOBAL_FUNC1(pipeline_find, struct pipeline *(const char *name));
+MOCK_GLOBAL_FUNC1(rte_eal_get_lcore_state,
+		  enum rte_lcore_state_t(unsigned int lcore_id));
+MOCK_GLOBAL_FUNC0(rte_get_tsc_hz, uint64_t());
+MOCK_GLOBAL_FUNC2(rte_swx_ctl_pipeline_info_get,
+		  int(struct rte_swx_pipeline *p,
+		  struct rte_swx_ctl_pipeline_info *pipeline));
+MOCK_GLOBAL_FUNC2(pipeline_link_is_upstream,
+		  int(struct rte_swx_pipeline *src,
+		  struct rte_swx_pipeline *dst));
+MOCK_GLOBAL_FUNC3(pipeline_links_out,
+		  uint32_t(struct rte_swx_pipeline *src,
+		  struct pipeline_link **out, uint32_t n_max));
+
+/* Counters of the single input port of the pipeline. */
+static uint64_t ut_n_pkts;
+static uint64_t ut_n_empty;
+
+int port_in_stats_read_dummy(struct rte_swx_pipeline *p, uint32_t port_id,
+			     struct rte_swx_port_in_stats *stats)
+{
+	memset(stats, 0, sizeof(*stats));
+	stats->n_pkts = ut_n_pkts;
+	stats->n_empty = ut_n_empty;
+	return 0;
+}
+
+/* Run one adaptation period with the given polls on a pipeline whose quanta
+ * is the given one, and return the new quanta.
+ */
+static uint32_t ut_quanta_adapt(struct pipeline_data *pd, uint32_t quanta,
+				uint64_t n_pkts, uint64_t n_empty)
+{
+	pd->instr_quanta = quanta;
+	ut_n_pkts += n_pkts;
+	ut_n_empty += n_empty;
+	pipeline_data_quanta_adapt(pd);
+	return pd->instr_quanta;
+}
+
+static void ut_quanta_setup(struct pipeline_data *pd)
+{
+	memset(pd, 0, sizeof(*pd));
+	pd->adaptive = 1;
+	pd->n_ports_in = 1;
+	ut_n_pkts = 0;
+	ut_n_empty = 0;
+
+	EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_port_in_stats_read,
+			   rte_swx_ctl_pipeline_port_in_stats_read(_,0,_))
+		.WillRepeatedly(&port_in_stats_read_dummy);
+}
+
+/*
+ * Test Case for the quanta halved when mostly idle, doubled when nearly
+ * always busy and kept in between
+ */
+TEST(THREAD_QUANTA, case0) {
+	struct pipeline_data pd;
+
+	ut_quanta_setup(&pd);
+
+	ASSERT_EQ(ut_quanta_adapt(&pd, 1000, 10, 90), 500);
+	ASSERT_EQ(ut_quanta_adapt(&pd, 1000, 100, 1), 2000);
+	ASSERT_EQ(ut_quanta_adapt(&pd, 1000, 80, 20), 1000);
+	/* Exactly half of the polls empty is not mostly idle. */
+	ASSERT_EQ(ut_quanta_adapt(&pd, 1000, 50, 50), 1000);
+}
+
+/*
+ * Test Case for the quanta kept within its bounds
+ */
+TEST(THREAD_QUANTA, case1) {
+	struct pipeline_data pd;
+
+	ut_quanta_setup(&pd);
+
+	ASSERT_EQ(ut_quanta_adapt(&pd, PIPELINE_INSTR_QUANTA_MIN, 0, 100),
+		  PIPELINE_INSTR_QUANTA_MIN);
+	ASSERT_EQ(ut_quanta_adapt(&pd, PIPELINE_INSTR_QUANTA_MAX, 100, 0),
+		  PIPELINE_INSTR_QUANTA_MAX);
+	ASSERT_EQ(ut_quanta_adapt(&pd, PIPELINE_INSTR_QUANTA_MAX * 2, 80, 20),
+		  PIPELINE_INSTR_QUANTA_MAX);
+}
+
+/*
+ * Test Case for each period judged on its own polls only
+ */
+TEST(THREAD_QUANTA, case2) {
+	struct pipeline_data pd;
+
+	ut_quanta_setup(&pd);
+	pd.adapt_runs = PIPELINE_QUANTA_ADAPT_RUNS;
+
+	/* A long idle history doesn't weigh on a busy period. */
+	ASSERT_EQ(ut_quanta_adapt(&pd, 1000, 0, 100000), 500);
+	ASSERT_EQ(pd.adapt_runs, 0);
+	ASSERT_EQ(pd.adapt_n_empty, 100000);
+	ASSERT_EQ(ut_quanta_adapt(&pd, 1000, 1000, 0), 2000);
+
+	/* No poll at all leaves the quanta as it is. */
+	ASSERT_EQ(ut_quanta_adapt(&pd, 1000, 0, 0), 1000);
+}
+
+/*
+ * Test Case for the pipelines of a thread keeping their run order when one
+ * of them is removed
+ */
+TEST(THREAD_PIPELINES, case0) {
+	struct rte_swx_pipeline *pipes[4];
+	struct thread_data td;
+	uint32_t i;
+
+	memset(&td, 0, sizeof(td));
+	for (i = 0; i < 4; i++) {
+		pipes[i] = (struct rte_swx_pipeline *)&pipes[i];
+		td.p[i] = pipes[i];
+		td.pipeline_data[i].p = pipes[i];
+		td.pipeline_data[i].instr_quanta = i;
+	}
+	td.n_pipelines = 4;
+
+	thread_data_pipeline_remove(&td, pipes[1]);
+	ASSERT_EQ(td.n_pipelines, 3);
+	ASSERT_EQ(td.p[0], pipes[0]);
+	ASSERT_EQ(td.p[1], pipes[2]);
+	ASSERT_EQ(td.p[2], pipes[3]);
+	ASSERT_EQ(td.pipeline_data[1].instr_quanta, 2);
+	ASSERT_EQ(td.pipeline_data[2].p, pipes[3]);
+
+	/* A pipeline the thread doesn't run is left alone. */
+	thread_data_pipeline_remove(&td, pipes[1]);
+	ASSERT_EQ(td.n_pipelines, 3);
+
+	thread_data_pipeline_remove(&td, pipes[3]);
+	ASSERT_EQ(td.n_pipelines, 2);
+	ASSERT_EQ(td.p[1], pipes[2]);
+}
+
+/*
+ * Test Case for an enable refused by a full thread: the pipeline keeps its
+ * instruction quanta
+ */
+TEST(THREAD_PIPELINES, case1) {
+	struct pipeline p;
+
+	memset(&p, 0, sizeof(p));
+	strcpy(p.name, "pipe");
+	p.instr_quanta = 8;
+	thread[1].enabled = 1;
+	memset(&thread_data[1], 0, sizeof(thread_data[1]));
+	thread_data[1].n_pipelines = THREAD_PIPELINES_MAX;
+
+	EXPECT_GLOBAL_CALL(pipeline_find, pipeline_find(_))
+		.WillRepeatedly(Return(&p));
+	EXPECT_GLOBAL_CALL(rte_eal_get_lcore_state, rte_eal_get_lcore_state(_))
+		.WillRepeatedly(Return(WAIT));
+
+	ASSERT_EQ(thread_pipeline_enable(1, "pipe", 64, 1), -1);
+	ASSERT_EQ(p.instr_quanta, 8);
+	ASSERT_EQ(p.instr_quanta_adaptive, 0);
+	ASSERT_EQ(p.enabled, 0);
+}
+
+/* Pipelines a, b and c, with a link from a to b. */
+#define UT_N_PIPES 3
+static struct pipeline ut_pipes[UT_N_PIPES];
+static struct rte_swx_pipeline *ut_swx[UT_N_PIPES];
+
+struct pipeline *ut_pipe_find(const char *name)
+{
+	for (int i = 0; i < UT_N_PIPES; i++)
+		if (!strcmp(ut_pipes[i].name, name))
+			return &ut_pipes[i];
+	return NULL;
+}
+
+int ut_link_upstream(struct rte_swx_pipeline *src,
+		     struct rte_swx_pipeline *dst)
+{
+	return (src == ut_pipes[0].p) &&
+	       ((dst == NULL) || (dst == ut_pipes[1].p));
+}
+
+/* Thread 1 runs no pipeline, it is full when asked, so that the enables
+ * which get to it fail.
+ */
+static void ut_batch_setup(bool full)
+{
+	memset(ut_pipes, 0, sizeof(ut_pipes));
+	for (int i = 0; i < UT_N_PIPES; i++) {
+		snprintf(ut_pipes[i].name, sizeof(ut_pipes[i].name), "pipe%c",
+			 'a' + i);
+		ut_pipes[i].p = (struct rte_swx_pipeline *)&ut_swx[i];
+	}
+
+	thread[1].enabled = 1;
+	memset(&thread_data[1], 0, sizeof(thread_data[1]));
+	if (full)
+		thread_data[1].n_pipelines = THREAD_PIPELINES_MAX;
+
+	EXPECT_GLOBAL_CALL(pipeline_find, pipeline_find(_))
+		.WillRepeatedly(&ut_pipe_find);
+	EXPECT_GLOBAL_CALL(pipeline_link_is_upstream,
+			   pipeline_link_is_upstream(_,_))
+		.WillRepeatedly(&ut_link_upstream);
+	EXPECT_GLOBAL_CALL(pipeline_links_out, pipeline_links_out(_,_,_))
+		.WillRepeatedly(Return(0));
+	EXPECT_GLOBAL_CALL(rte_get_tsc_hz, rte_get_tsc_hz())
+		.WillRepeatedly(Return(0));
+	EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_info_get,
+			   rte_swx_ctl_pipeline_info_get(_,_))
+		.WillRepeatedly(Return(-1));
+	EXPECT_GLOBAL_CALL(rte_eal_get_lcore_state, rte_eal_get_lcore_state(_))
+		.WillRepeatedly(Return(WAIT));
+}
+
+/*
+ * Test Case for a batch with two operations on a pipeline: refused, none of
+ * its operations is done
+ */
+TEST(THREAD_PIPELINES, case2) {
+	struct thread_pipeline_op ops[3] = {
+		{"pipec", 0, 0, 0, 0},
+		{"pipea", 1, 0, 0, 0},
+		{"pipec", 1, 0, 0, 0},
+	};
+
+	ut_batch_setup(false);
+	ut_pipes[2].enabled = 1;
+	ut_pipes[2].thread_id = 1;
+
+	ASSERT_EQ(thread_pipelines_update(1, ops, 3), -1);
+	ASSERT_EQ(ops[0].status, -1);
+	ASSERT_EQ(ops[1].status, -1);
+	ASSERT_EQ(ut_pipes[0].enabled, 0);
+	ASSERT_EQ(ut_pipes[2].enabled, 1);
+	ASSERT_EQ(thread_data[1].n_pipelines, 0);
+}
+
+/*
+ * Test Case for linked pipelines enabled on one thread: the upstream
+ * pipeline runs before the pipeline it feeds, the others keep their order
+ */
+TEST(THREAD_PIPELINES, case3) {
+	struct thread_pipeline_op ops[3] = {
+		{"pipec", 1, 0, 0, 0},
+		{"pipeb", 1, 0, 0, 0},
+		{"pipea", 1, 0, 0, 0},
+	};
+
+	ut_batch_setup(false);
+	ASSERT_EQ(thread_pipelines_update(1, ops, 3), 0);
+	ASSERT_EQ(thread_data[1].n_pipelines, 3);
+	ASSERT_EQ(thread_data[1].p[0], ut_pipes[2].p);
+	ASSERT_EQ(thread_data[1].p[1], ut_pipes[0].p);
+	ASSERT_EQ(thread_data[1].p[2], ut_pipes[1].p);
+	ASSERT_EQ(thread_data[1].pipeline_data[1].p, ut_pipes[0].p);
+	ASSERT_EQ(ut_pipes[0].enabled, 1);
+	ASSERT_EQ(ut_pipes[1].enabled, 1);
+}
+
+/* Ring of the given capacity holding count packets. */
+static void ut_ring_fill(struct rte_ring *r, uint32_t capacity,
+			 uint32_t count)
+{
+	memset(r, 0, sizeof(*r));
+	r->size = capacity + 1;
+	r->mask = capacity;
+	r->capacity = capacity;
+	r->prod.tail = count;
+	r->cons.tail = 0;
+}
+
+/*
+ * Test Case for the runs of a pipeline feeding links cut to the room left
+ * in their rings, and held back while a ring has less than a burst of room
+ */
+TEST(THREAD_LINK, case0) {
+	struct rte_ring rings[2];
+	struct pipeline_link links[2];
+	struct pipeline_data pd;
+
+	memset(&pd, 0, sizeof(pd));
+	memset(links, 0, sizeof(links));
+	pd.instr_quanta = 1000;
+	for (int i = 0; i < 2; i++) {
+		links[i].r = &rings[i];
+		links[i].burst_size = 32;
+		pd.links[i] = &links[i];
+	}
+
+	/* Without link, the quanta is left as it is. */
+	ASSERT_EQ(pipeline_data_link_quanta(&pd), 1000);
+
+	pd.n_links = 2;
+	ut_ring_fill(&rings[0], 1023, 0);
+	ut_ring_fill(&rings[1], 1023, 0);
+	ASSERT_EQ(pipeline_data_link_quanta(&pd), 1000);
+
+	/* The fullest ring sets the quanta. */
+	ut_ring_fill(&rings[1], 1023, 1023 - 100);
+	ASSERT_EQ(pipeline_data_link_quanta(&pd), 100);
+	ut_ring_fill(&rings[0], 1023, 1023 - 32);
+	ASSERT_EQ(pipeline_data_link_quanta(&pd), 32);
+	ASSERT_EQ(links[0].n_runs_held, 0);
+
+	/* Less than a burst of room holds the run back. */
+	ut_ring_fill(&rings[1], 1023, 1023 - 31);
+	ASSERT_EQ(pipeline_data_link_quanta(&pd), 0);
+	ASSERT_EQ(links[1].n_runs_held, 1);
+	ASSERT_EQ(links[0].n_runs_held, 0);
+}
@@ -16,7 +16,7 @@
 
 /*Each testcase file can atmost have 5k checks
  *Note: Please update the number of checks included in the below field
- *Number of checks = 5*/
+ *Number of checks = 14*/
 
 #include <gmock/gmock.h>
 #include <string.h>
@@ -276,3 +276,93 @@ TEST(CompileMode, case4) {
     ASSERT_EQ(ret, expected_result);
 
 }
+
+/* Iospec of a pipeline whose startup config already added a two queue link
+ * on ports 0 and 1 and a sink on output port 3.
+ */
+static char ut_iospec[] =
+	"port in 0 ethdev 0000:00:01.0 rxq 0 bsz 32\n"
+	"port in 1 ethdev 0000:00:01.0 rxq 1 bsz 32\n"
+	"port out 0 ethdev 0000:00:01.0 txq 0 bsz 32\n"
+	"port out 3 sink file none\n";
+
+static void ut_port_id_setup(struct pipeline *pipe,
+			     struct port_attributes_t *port_attrib,
+			     struct mempool *mempool)
+{
+    memset(pipe, 0, sizeof(struct pipeline));
+    pipe->iospec = ut_iospec;
+    pipe->iospec_len = strlen(ut_iospec);
+
+    memset(port_attrib, 0, sizeof(struct port_attributes_t));
+    strcpy(port_attrib->port_name, "port");
+    strcpy(port_attrib->pipe_in, "pipe");
+    strcpy(port_attrib->pipe_out, "pipe");
+    port_attrib->port_dir = PM_PORT_DIR_DEFAULT;
+
+    EXPECT_GLOBAL_CALL(pipeline_find, pipeline_find(_))
+	    .WillRepeatedly(Return(pipe));
+    EXPECT_GLOBAL_CALL(mempool_find, mempool_find(_))
+	    .WillRepeatedly(Return(mempool));
+}
+
+TEST(PortIdOverlap, case0) {
+    struct pipeline pipe;
+    struct port_attributes_t port_attrib;
+    struct mempool mempool;
+    int ret;
+
+    /* A source port on the second queue of the link */
+    ut_port_id_setup(&pipe, &port_attrib, &mempool);
+    port_attrib.port_type = BF_DPDK_SOURCE;
+    port_attrib.port_in_id = 1;
+    ret = lld_dpdk_port_add(1, &port_attrib);
+    ASSERT_EQ(ret, BF_INVALID_ARG);
+
+    /* A sink port on the output of the sink */
+    ut_port_id_setup(&pipe, &port_attrib, &mempool);
+    port_attrib.port_type = BF_DPDK_SINK;
+    port_attrib.port_out_id = 3;
+    ret = lld_dpdk_port_add(3, &port_attrib);
+    ASSERT_EQ(ret, BF_INVALID_ARG);
+
+    /* A second link whose queues end on input port 0, its device must
+     * not be created.
+     */
+    ut_port_id_setup(&pipe, &port_attrib, &mempool);
+    port_attrib.port_type = BF_DPDK_LINK;
+    port_attrib.link.n_rxq = 4;
+    port_attrib.link.n_txq = 1;
+    port_attrib.port_in_id = 0;
+    port_attrib.port_out_id = 4;
+    ret = lld_dpdk_port_add(4, &port_attrib);
+    ASSERT_EQ(ret, BF_INVALID_ARG);
+}
+
+TEST(PortIdOverlap, case1) {
+    struct pipeline pipe;
+    struct port_attributes_t port_attrib;
+    struct mempool mempool;
+
+    ut_port_id_setup(&pipe, &port_attrib, &mempool);
+
+    /* The ports right after the ones taken are free */
+    port_attrib.port_type = BF_DPDK_LINK;
+    port_attrib.link.n_rxq = 2;
+    port_attrib.link.n_txq = 2;
+    port_attrib.port_in_id = 2;
+    port_attrib.port_out_id = 1;
+    ASSERT_EQ(lld_dpdk_port_ids_check(&port_attrib, &pipe, &pipe),
+	      BF_SUCCESS);
+
+    /* One queue more and the tx queues reach the sink */
+    port_attrib.link.n_txq = 3;
+    ASSERT_EQ(lld_dpdk_port_ids_check(&port_attrib, &pipe, &pipe),
+	      BF_INVALID_ARG);
+
+    /* A source has no output port, its output id is not checked */
+    port_attrib.port_type = BF_DPDK_SOURCE;
+    port_attrib.port_out_id = 0;
+    ASSERT_EQ(lld_dpdk_port_ids_check(&port_attrib, &pipe, &pipe),
+	      BF_SUCCESS);
+}
@@ -115,6 +115,8 @@ TEST(DPDK_DIRECT_CNT, case0) {
         ctx_obj = calloc(1, sizeof(*ctx_obj));
         externs_entry = calloc(1, sizeof(*externs_entry));
         pipe = calloc(1, sizeof(*pipe));
+        pipe->n_instances = 1;
+        pipe->instance[0] = pipe;
         stat_data = calloc(1, sizeof(*stat_data));
         stat_data->packets = 5;
         match_spec.num_match_bytes = 4 ;
@@ -0,0 +1,601 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*Each testcase file can atmost have 5k checks
+ *Note: Please update the number of checks included in the below field
+ *Number of checks = 68*/
+
+#include <stdio.h>
+#include <gmock/gmock.h>
+#include <string.h>
+#include <stdlib.h>
+#include <gmock-global.h>
+#include <map>
+#include <string>
+
+extern "C"{
+    #include <osdep/p4_sde_osdep.h>
+    #include <osdep/p4_sde_osdep_utils.h>
+}
+
+/* The meter index maps are kept in std::map, indexed by the address of
+ * the SDE map, so that the profile bindings can be checked.
+ */
+static std::map<void *, std::map<unsigned long, void *> > ut_maps;
+
+static bf_map_sts_t ut_map_add(void *map, unsigned long key, void *data)
+{
+  ut_maps[map][key] = data;
+  return BF_MAP_OK;
+}
+
+static bf_map_sts_t ut_map_get(void *map, unsigned long key, void **data)
+{
+  std::map<unsigned long, void *>::iterator it = ut_maps[map].find(key);
+
+  if (it == ut_maps[map].end())
+    return BF_MAP_NO_KEY;
+  *data = it->second;
+  return BF_MAP_OK;
+}
+
+static bf_map_sts_t ut_map_rmv(void *map, unsigned long key)
+{
+  return ut_maps[map].erase(key) ? BF_MAP_OK : BF_MAP_NO_KEY;
+}
+
+static bf_map_sts_t ut_map_get_first_rmv(void *map, unsigned long *key,
+                                         void **data)
+{
+  if (ut_maps[map].empty())
+    return BF_MAP_NO_KEY;
+  *key = ut_maps[map].begin()->first;
+  *data = ut_maps[map].begin()->second;
+  ut_maps[map].erase(ut_maps[map].begin());
+  return BF_MAP_OK;
+}
+
+#undef P4_SDE_MAP_INIT
+#undef P4_SDE_MAP_ADD
+#undef P4_SDE_MAP_GET
+#undef P4_SDE_MAP_RMV
+#undef P4_SDE_MAP_GET_FIRST_RMV
+#undef P4_SDE_MAP_DESTROY
+#define P4_SDE_MAP_INIT(MAP) ut_maps[(void *)(MAP)].clear()
+#define P4_SDE_MAP_ADD(MAP, key, data) ut_map_add((void *)(MAP), (key), (data))
+#define P4_SDE_MAP_GET(MAP, key, data) ut_map_get((void *)(MAP), (key), (data))
+#define P4_SDE_MAP_RMV(MAP, key) ut_map_rmv((void *)(MAP), (key))
+#define P4_SDE_MAP_GET_FIRST_RMV(MAP, key, data) \
+  ut_map_get_first_rmv((void *)(MAP), (key), (data))
+#define P4_SDE_MAP_DESTROY(MAP) ut_maps.erase((void *)(MAP))
+
+#undef P4_SDE_CALLOC
+#undef P4_SDE_FREE
+#undef P4_SDE_MUTEX_LOCK
+#undef P4_SDE_MUTEX_UNLOCK
+#define P4_SDE_CALLOC(num, size) calloc((num), (size))
+#define P4_SDE_FREE(ptr) free(ptr)
+#define P4_SDE_MUTEX_LOCK(mtx) ((void)(mtx))
+#define P4_SDE_MUTEX_UNLOCK(mtx) ((void)(mtx))
+
+extern "C"{
+    #include "dal_meters.c"
+    #include "mock.h"
+}
+
+using namespace std;
+using ::testing::AnyNumber;
+using ::testing::AtLeast;
+using ::testing::Return;
+using ::testing::_;
+
+MOCK_GLOBAL_FUNC2(bf_hashtbl_search,
+                   void *(bf_hashtable_t *htbl, void *key));
+MOCK_GLOBAL_FUNC1(pipeline_find,
+                  struct pipeline *(const char *name));
+MOCK_GLOBAL_FUNC3(pipe_mgr_get_profile,
+                  int(int dev_id, int profile_id,
+                  struct pipe_mgr_profile **profile));
+MOCK_GLOBAL_FUNC2(pipe_mgr_get_profile_ctx,
+                  int(struct bf_dev_target_t dev_tgt,
+                  struct pipe_mgr_p4_pipeline **parsed_pipe_ctx));
+MOCK_GLOBAL_FUNC4(rte_swx_ctl_meter_stats_read,
+                  int(struct rte_swx_pipeline *p,
+                  const char *metarray_name,
+                  uint32_t metarray_index,
+                  struct rte_swx_ctl_meter_stats *stats));
+MOCK_GLOBAL_FUNC1(trim_classifier_str, char *(char *str));
+MOCK_GLOBAL_FUNC3(bf_hashtbl_insert,
+                  bf_hashtbl_sts_t(bf_hashtable_t *htbl, void *data,
+                  void *key));
+MOCK_GLOBAL_FUNC2(bf_hashtbl_get_remove,
+                  void *(bf_hashtable_t *htbl, void *key));
+MOCK_GLOBAL_FUNC3(rte_swx_ctl_meter_profile_add,
+                  int(struct rte_swx_pipeline *p, const char *name,
+                  struct rte_meter_trtcm_params *params));
+MOCK_GLOBAL_FUNC2(rte_swx_ctl_meter_profile_delete,
+                  int(struct rte_swx_pipeline *p, const char *name));
+MOCK_GLOBAL_FUNC4(rte_swx_ctl_meter_set,
+                  int(struct rte_swx_pipeline *p,
+                  const char *metarray_name,
+                  uint32_t metarray_index,
+                  const char *profile_name));
+MOCK_GLOBAL_FUNC3(rte_swx_ctl_meter_reset,
+                  int(struct rte_swx_pipeline *p,
+                  const char *metarray_name,
+                  uint32_t metarray_index));
+
+static struct pipe_mgr_profile meter_profile;
+static struct pipe_mgr_p4_pipeline meter_ctx_obj;
+static struct dal_meter_ctx meter_ctx;
+
+int pipe_mgr_get_profile_meter_dummy(int dev_id, int profile_id,
+                                     struct pipe_mgr_profile **profile)
+{
+  *profile = &meter_profile;
+  return 0;
+}
+
+int pipe_mgr_get_profile_ctx_meter_dummy(struct bf_dev_target_t dev_tgt,
+                                         struct pipe_mgr_p4_pipeline **ctx_obj)
+{
+  meter_ctx_obj.dal_meter_ctx = &meter_ctx;
+  *ctx_obj = &meter_ctx_obj;
+  return 0;
+}
+
+// meter stats read
+TEST(DPDK_INDIRECT_METER, case0) {
+
+   struct pipe_mgr_externs_ctx *counter_entry  = NULL;
+   struct pipe_mgr_externs_ctx *meter_entry  = NULL;
+   const char *table_name = "ip.meter";
+   pipe_meter_stats_t stats = {0};
+   struct pipeline *pipe = NULL;
+   bf_dev_target_t dev_tgt = {0};
+   char *name = "ip.meter";
+   int a_res, e_res = 0;
+   int id = 0;
+
+   pipe = (struct pipeline *)calloc(1, sizeof(*pipe));
+   pipe->n_instances = 1;
+   pipe->instance[0] = pipe;
+   counter_entry = (struct pipe_mgr_externs_ctx *)
+     calloc(1, sizeof(*counter_entry));
+   counter_entry->type = EXTERNS_COUNTER;
+   meter_entry = (struct pipe_mgr_externs_ctx *)
+     calloc(1, sizeof(*meter_entry));
+   meter_entry->type = EXTERNS_METER;
+   memcpy(meter_entry->target_name, "meters",
+     sizeof("meters"));
+
+   EXPECT_GLOBAL_CALL(pipe_mgr_get_profile, pipe_mgr_get_profile(_,_,_))
+     .Times(AtLeast(1)).
+     WillOnce(Return(1)).WillRepeatedly(&pipe_mgr_get_profile_meter_dummy);
+   EXPECT_GLOBAL_CALL(pipeline_find, pipeline_find(_))
+     .Times(AtLeast(1)).
+     WillOnce(Return(NULL)).WillRepeatedly(Return(pipe));
+   EXPECT_GLOBAL_CALL(pipe_mgr_get_profile_ctx, pipe_mgr_get_profile_ctx(_,_))
+     .Times(AtLeast(1)).
+     WillRepeatedly(&pipe_mgr_get_profile_ctx_meter_dummy);
+   EXPECT_GLOBAL_CALL(bf_hashtbl_search, bf_hashtbl_search(_,_))
+     .Times(AtLeast(1)).
+     WillOnce(Return((struct pipe_mgr_externs_ctx *)NULL))
+     .WillOnce(Return((struct pipe_mgr_externs_ctx *)counter_entry))
+     .WillRepeatedly(Return((struct pipe_mgr_externs_ctx *)meter_entry));
+   EXPECT_GLOBAL_CALL(trim_classifier_str, trim_classifier_str(_))
+       .Times(AtLeast(1)).
+        WillRepeatedly(Return(name));
+   EXPECT_GLOBAL_CALL(rte_swx_ctl_meter_stats_read,
+                     rte_swx_ctl_meter_stats_read(_,_,_,_))
+     .Times(AtLeast(1)).
+     WillOnce(Return(1)).WillRepeatedly(Return(0));
+
+   a_res = dal_meter_stats_read(dev_tgt, table_name, id, &stats);
+   ASSERT_EQ(a_res, BF_OBJECT_NOT_FOUND);
+   a_res = dal_meter_stats_read(dev_tgt, table_name, id, &stats);
+   ASSERT_EQ(a_res, BF_OBJECT_NOT_FOUND);
+   a_res = dal_meter_stats_read(dev_tgt, table_name, id, &stats);
+   ASSERT_EQ(a_res, BF_OBJECT_NOT_FOUND);
+   a_res = dal_meter_stats_read(dev_tgt, table_name, id, &stats);
+   ASSERT_EQ(a_res, BF_INVALID_ARG);
+   a_res = dal_meter_stats_read(dev_tgt, table_name, id, &stats);
+   ASSERT_EQ(a_res, BF_OBJECT_NOT_FOUND);
+   a_res = dal_meter_stats_read(dev_tgt, table_name, id, &stats);
+   ASSERT_EQ(a_res, e_res);
+   free(pipe);
+   free(counter_entry);
+   free(meter_entry);
+}
+
+// pps meters are not supported by the DPDK trTCM meter
+TEST(DPDK_INDIRECT_METER, case1) {
+
+   struct dal_meter_profile_key key;
+   pipe_meter_spec_t spec = {};
+
+   spec.cir.type = METER_RATE_TYPE_PPS;
+   spec.pir.type = METER_RATE_TYPE_KBPS;
+   ASSERT_EQ(dal_meter_spec_to_key(&spec, &key), BF_NOT_SUPPORTED);
+
+   spec.cir.type = METER_RATE_TYPE_KBPS;
+   spec.cir.value.kbps = 8;
+   spec.pir.value.kbps = 16;
+   spec.cburst = 80;
+   spec.pburst = 160;
+   ASSERT_EQ(dal_meter_spec_to_key(&spec, &key), BF_SUCCESS);
+   ASSERT_EQ(key.cir, 1000);
+   ASSERT_EQ(key.pbs, 20000);
+}
+
+// meter range APIs reject inverted ranges
+TEST(DPDK_INDIRECT_METER, case2) {
+
+   const char *table_name = "ip.meter";
+   pipe_meter_stats_t stats[2] = {};
+   pipe_meter_spec_t spec = {};
+   bf_dev_target_t dev_tgt = {0};
+
+   ASSERT_EQ(dal_meter_stats_read_range(dev_tgt, table_name, 2, 1, stats),
+             BF_INVALID_ARG);
+   ASSERT_EQ(dal_meter_ent_set_range(dev_tgt, table_name, 2, 1, &spec),
+             BF_INVALID_ARG);
+}
+
+/* Meter profile pool of the tests: the profile hash table, the profiles
+ * added to the DPDK pipeline and the profile of each DPDK meter index.
+ */
+static std::map<std::string, void *> ut_prof_htbl;
+static std::map<std::string, int> ut_dpdk_profiles;
+static std::map<uint32_t, std::string> ut_dpdk_meters;
+/* Meter index the DPDK meter set fails on, -1 for none, and the instance
+ * it fails on, NULL for all of them.
+ */
+static int64_t ut_meter_set_fail_idx = -1;
+static struct rte_swx_pipeline *ut_meter_set_fail_p;
+/* Committed rate of the last profile added to an instance. */
+static uint64_t ut_meter_prof_cir;
+static struct pipe_mgr_externs_ctx ut_meter_entry;
+static struct pipeline ut_meter_pipe;
+static struct pipeline ut_meter_pipe1;
+static char ut_meter_name[] = "ip.meter";
+
+static std::string ut_prof_key(void *key)
+{
+  return std::string((char *)key, sizeof(struct dal_meter_profile_key));
+}
+
+void *bf_hashtbl_search_prof_dummy(bf_hashtable_t *htbl, void *key)
+{
+  std::map<std::string, void *>::iterator it;
+
+  /* Any other table is the externs table of the pipeline. */
+  if (htbl != &meter_ctx.prof_htbl)
+    return &ut_meter_entry;
+
+  it = ut_prof_htbl.find(ut_prof_key(key));
+  return (it == ut_prof_htbl.end()) ? NULL : it->second;
+}
+
+bf_hashtbl_sts_t bf_hashtbl_insert_prof_dummy(bf_hashtable_t *htbl,
+                                              void *data, void *key)
+{
+  ut_prof_htbl[ut_prof_key(key)] = data;
+  return BF_HASHTBL_OK;
+}
+
+void *bf_hashtbl_get_remove_prof_dummy(bf_hashtable_t *htbl, void *key)
+{
+  void *data = bf_hashtbl_search_prof_dummy(htbl, key);
+
+  ut_prof_htbl.erase(ut_prof_key(key));
+  return data;
+}
+
+int meter_profile_add_dummy(struct rte_swx_pipeline *p, const char *name,
+                            struct rte_meter_trtcm_params *params)
+{
+  ut_dpdk_profiles[name]++;
+  ut_meter_prof_cir = params->cir;
+  return 0;
+}
+
+int meter_profile_delete_dummy(struct rte_swx_pipeline *p, const char *name)
+{
+  ut_dpdk_profiles.erase(name);
+  return 0;
+}
+
+int meter_set_dummy(struct rte_swx_pipeline *p, const char *metarray_name,
+                    uint32_t metarray_index, const char *profile_name)
+{
+  if ((metarray_index == ut_meter_set_fail_idx) &&
+      (!ut_meter_set_fail_p || (p == ut_meter_set_fail_p)))
+    return -1;
+  ut_dpdk_meters[metarray_index] = profile_name;
+  return 0;
+}
+
+int meter_reset_dummy(struct rte_swx_pipeline *p, const char *metarray_name,
+                      uint32_t metarray_index)
+{
+  ut_dpdk_meters.erase(metarray_index);
+  return 0;
+}
+
+static void ut_meter_setup(void)
+{
+  struct dal_meter_array *array;
+
+  while (meter_ctx.arrays) {
+    array = meter_ctx.arrays;
+    meter_ctx.arrays = array->next;
+    free(array);
+  }
+  memset(&meter_ctx, 0, sizeof(meter_ctx));
+  ut_maps.clear();
+  ut_prof_htbl.clear();
+  ut_dpdk_profiles.clear();
+  ut_dpdk_meters.clear();
+  ut_meter_set_fail_idx = -1;
+  ut_meter_set_fail_p = NULL;
+  ut_meter_prof_cir = 0;
+
+  memset(&ut_meter_pipe, 0, sizeof(ut_meter_pipe));
+  memset(&ut_meter_pipe1, 0, sizeof(ut_meter_pipe1));
+  ut_meter_pipe.n_instances = 1;
+  ut_meter_pipe.instance[0] = &ut_meter_pipe;
+  memset(&ut_meter_entry, 0, sizeof(ut_meter_entry));
+  ut_meter_entry.type = EXTERNS_METER;
+  memcpy(ut_meter_entry.target_name, "meters", sizeof("meters"));
+
+  EXPECT_GLOBAL_CALL(pipe_mgr_get_profile, pipe_mgr_get_profile(_,_,_))
+    .Times(AnyNumber())
+    .WillRepeatedly(&pipe_mgr_get_profile_meter_dummy);
+  EXPECT_GLOBAL_CALL(pipeline_find, pipeline_find(_))
+    .Times(AnyNumber())
+    .WillRepeatedly(Return(&ut_meter_pipe));
+  EXPECT_GLOBAL_CALL(pipe_mgr_get_profile_ctx, pipe_mgr_get_profile_ctx(_,_))
+    .Times(AnyNumber())
+    .WillRepeatedly(&pipe_mgr_get_profile_ctx_meter_dummy);
+  EXPECT_GLOBAL_CALL(trim_classifier_str, trim_classifier_str(_))
+    .Times(AnyNumber())
+    .WillRepeatedly(Return(ut_meter_name));
+  EXPECT_GLOBAL_CALL(bf_hashtbl_search, bf_hashtbl_search(_,_))
+    .Times(AnyNumber())
+    .WillRepeatedly(&bf_hashtbl_search_prof_dummy);
+  EXPECT_GLOBAL_CALL(bf_hashtbl_insert, bf_hashtbl_insert(_,_,_))
+    .Times(AnyNumber())
+    .WillRepeatedly(&bf_hashtbl_insert_prof_dummy);
+  EXPECT_GLOBAL_CALL(bf_hashtbl_get_remove, bf_hashtbl_get_remove(_,_))
+    .Times(AnyNumber())
+    .WillRepeatedly(&bf_hashtbl_get_remove_prof_dummy);
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_meter_profile_add,
+                     rte_swx_ctl_meter_profile_add(_,_,_))
+    .Times(AnyNumber())
+    .WillRepeatedly(&meter_profile_add_dummy);
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_meter_profile_delete,
+                     rte_swx_ctl_meter_profile_delete(_,_))
+    .Times(AnyNumber())
+    .WillRepeatedly(&meter_profile_delete_dummy);
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_meter_set,
+                     rte_swx_ctl_meter_set(_,_,_,_))
+    .Times(AnyNumber())
+    .WillRepeatedly(&meter_set_dummy);
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_meter_reset,
+                     rte_swx_ctl_meter_reset(_,_,_))
+    .Times(AnyNumber())
+    .WillRepeatedly(&meter_reset_dummy);
+}
+
+static void ut_meter_spec(pipe_meter_spec_t *spec, uint64_t kbps)
+{
+  memset(spec, 0, sizeof(*spec));
+  spec->cir.type = METER_RATE_TYPE_KBPS;
+  spec->pir.type = METER_RATE_TYPE_KBPS;
+  spec->cir.value.kbps = kbps;
+  spec->pir.value.kbps = 2 * kbps;
+  spec->cburst = 80;
+  spec->pburst = 160;
+}
+
+/* Profile of the pool matching spec, NULL if there is none. */
+static struct dal_meter_profile *ut_meter_prof(pipe_meter_spec_t *spec)
+{
+  struct dal_meter_profile_key key;
+
+  if (dal_meter_spec_to_key(spec, &key))
+    return NULL;
+
+  return (struct dal_meter_profile *)
+    bf_hashtbl_search_prof_dummy(&meter_ctx.prof_htbl, &key);
+}
+
+// meter indexes with the same spec share one profile
+TEST(DPDK_METER_PROFILE, case0) {
+
+   bf_dev_target_t dev_tgt = {0};
+   struct dal_meter_profile *prof;
+   pipe_meter_spec_t spec_a;
+
+   ut_meter_setup();
+   ut_meter_spec(&spec_a, 8);
+
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 0, &spec_a),
+             BF_SUCCESS);
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 1, &spec_a),
+             BF_SUCCESS);
+
+   prof = ut_meter_prof(&spec_a);
+   ASSERT_TRUE(prof != NULL);
+   EXPECT_EQ(prof->ref_cnt, 2u);
+   EXPECT_EQ(ut_dpdk_profiles.size(), 1u);
+   EXPECT_EQ(ut_dpdk_meters[0], std::string(prof->name));
+   EXPECT_EQ(ut_dpdk_meters[1], std::string(prof->name));
+
+   /* Setting the same spec again takes no new reference. */
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 1, &spec_a),
+             BF_SUCCESS);
+   EXPECT_EQ(prof->ref_cnt, 2u);
+   EXPECT_EQ(ut_dpdk_profiles.size(), 1u);
+}
+
+// reprogramming an index drops its reference on the old profile, which
+// is deleted along with its last user
+TEST(DPDK_METER_PROFILE, case1) {
+
+   bf_dev_target_t dev_tgt = {0};
+   struct dal_meter_profile *prof_a, *prof_b;
+   pipe_meter_spec_t spec_a, spec_b;
+
+   ut_meter_setup();
+   ut_meter_spec(&spec_a, 8);
+   ut_meter_spec(&spec_b, 16);
+
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 0, &spec_a),
+             BF_SUCCESS);
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 1, &spec_a),
+             BF_SUCCESS);
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 1, &spec_b),
+             BF_SUCCESS);
+
+   prof_a = ut_meter_prof(&spec_a);
+   prof_b = ut_meter_prof(&spec_b);
+   ASSERT_TRUE(prof_a != NULL);
+   ASSERT_TRUE(prof_b != NULL);
+   EXPECT_EQ(prof_a->ref_cnt, 1u);
+   EXPECT_EQ(prof_b->ref_cnt, 1u);
+   EXPECT_EQ(ut_dpdk_profiles.size(), 2u);
+   EXPECT_EQ(ut_dpdk_meters[1], std::string(prof_b->name));
+
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 0, &spec_b),
+             BF_SUCCESS);
+   EXPECT_TRUE(ut_meter_prof(&spec_a) == NULL);
+   EXPECT_EQ(ut_dpdk_profiles.size(), 1u);
+   EXPECT_EQ(ut_dpdk_profiles.count(prof_b->name), 1u);
+   EXPECT_EQ(prof_b->ref_cnt, 2u);
+}
+
+// a table reset releases every profile
+TEST(DPDK_METER_PROFILE, case2) {
+
+   bf_dev_target_t dev_tgt = {0};
+   pipe_meter_spec_t spec_a, spec_b;
+
+   ut_meter_setup();
+   ut_meter_spec(&spec_a, 8);
+   ut_meter_spec(&spec_b, 16);
+
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 0, &spec_a),
+             BF_SUCCESS);
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 1, &spec_b),
+             BF_SUCCESS);
+   ASSERT_EQ(dal_meter_reset(dev_tgt, ut_meter_name), BF_SUCCESS);
+
+   EXPECT_TRUE(ut_prof_htbl.empty());
+   EXPECT_TRUE(ut_dpdk_profiles.empty());
+   EXPECT_TRUE(ut_dpdk_meters.empty());
+}
+
+// a range is bound to one profile, one reference per index
+TEST(DPDK_METER_PROFILE, case3) {
+
+   bf_dev_target_t dev_tgt = {0};
+   struct dal_meter_profile *prof;
+   pipe_meter_spec_t spec_a;
+   uint32_t idx;
+
+   ut_meter_setup();
+   ut_meter_spec(&spec_a, 8);
+
+   ASSERT_EQ(dal_meter_ent_set_range(dev_tgt, ut_meter_name, 2, 5, &spec_a),
+             BF_SUCCESS);
+
+   prof = ut_meter_prof(&spec_a);
+   ASSERT_TRUE(prof != NULL);
+   EXPECT_EQ(prof->ref_cnt, 4u);
+   EXPECT_EQ(ut_dpdk_profiles.size(), 1u);
+   for (idx = 2; idx <= 5; idx++)
+     EXPECT_EQ(ut_dpdk_meters[idx], std::string(prof->name));
+   EXPECT_EQ(ut_dpdk_meters.count(1), 0u);
+   EXPECT_EQ(ut_dpdk_meters.count(6), 0u);
+}
+
+// a range failing partway leaves every index of the range as it was
+TEST(DPDK_METER_PROFILE, case4) {
+
+   bf_dev_target_t dev_tgt = {0};
+   struct dal_meter_profile *prof_b;
+   pipe_meter_spec_t spec_a, spec_b;
+   std::string name_b;
+
+   ut_meter_setup();
+   ut_meter_spec(&spec_a, 8);
+   ut_meter_spec(&spec_b, 16);
+
+   ASSERT_EQ(dal_meter_ent_set_range(dev_tgt, ut_meter_name, 0, 1, &spec_b),
+             BF_SUCCESS);
+   prof_b = ut_meter_prof(&spec_b);
+   ASSERT_TRUE(prof_b != NULL);
+   name_b = prof_b->name;
+
+   ut_meter_set_fail_idx = 2;
+   ASSERT_EQ(dal_meter_ent_set_range(dev_tgt, ut_meter_name, 0, 3, &spec_a),
+             BF_INVALID_ARG);
+
+   EXPECT_EQ(ut_dpdk_meters[0], name_b);
+   EXPECT_EQ(ut_dpdk_meters[1], name_b);
+   EXPECT_EQ(ut_dpdk_meters.count(2), 0u);
+   EXPECT_EQ(ut_dpdk_meters.count(3), 0u);
+   EXPECT_EQ(prof_b->ref_cnt, 2u);
+   EXPECT_TRUE(ut_meter_prof(&spec_a) == NULL);
+   EXPECT_EQ(ut_dpdk_profiles.size(), 1u);
+}
+
+// a sharded pipeline gets the profile on every instance with its share of
+// the rates, and a set failing on one instance is undone on the others
+TEST(DPDK_METER_PROFILE, case5) {
+
+   bf_dev_target_t dev_tgt = {0};
+   struct dal_meter_profile *prof_a;
+   pipe_meter_spec_t spec_a, spec_b;
+   std::string name_a;
+
+   ut_meter_setup();
+   ut_meter_pipe.p = (struct rte_swx_pipeline *)0x1000;
+   ut_meter_pipe1.p = (struct rte_swx_pipeline *)0x2000;
+   ut_meter_pipe.n_instances = 2;
+   ut_meter_pipe.instance[1] = &ut_meter_pipe1;
+   ut_meter_spec(&spec_a, 8);
+   ut_meter_spec(&spec_b, 16);
+
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 0, &spec_a),
+             BF_SUCCESS);
+   prof_a = ut_meter_prof(&spec_a);
+   ASSERT_TRUE(prof_a != NULL);
+   name_a = prof_a->name;
+   EXPECT_EQ(ut_dpdk_profiles[name_a], 2);
+   EXPECT_EQ(ut_meter_prof_cir, prof_a->key.cir / 2);
+
+   ut_meter_set_fail_idx = 0;
+   ut_meter_set_fail_p = ut_meter_pipe1.p;
+   ASSERT_EQ(dal_meter_ent_set(dev_tgt, ut_meter_name, 0, &spec_b),
+             BF_INVALID_ARG);
+   EXPECT_EQ(ut_dpdk_meters[0], name_a);
+   EXPECT_EQ(prof_a->ref_cnt, 1u);
+   EXPECT_TRUE(ut_meter_prof(&spec_b) == NULL);
+   EXPECT_EQ(ut_dpdk_profiles.size(), 1u);
+}
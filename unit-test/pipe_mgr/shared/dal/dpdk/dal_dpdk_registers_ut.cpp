@@ -16,7 +16,7 @@
 
 /*Each testcase file can atmost have 5k checks
  *Note: Please update the number of checks included in the below field
- *Number of checks = 2*/
+ *Number of checks = 16*/
 
 #include <stdio.h>
 #include <gmock/gmock.h>
@@ -163,6 +163,8 @@ TEST(DPDK_INDIRECT_REG, case1) {
    int id;
 
    pipe = (struct pipeline *)calloc(1, sizeof(*pipe));
+   pipe->n_instances = 1;
+   pipe->instance[0] = pipe;
    ctx_obj = calloc(1, sizeof(*ctx_obj));
    ctx_obj->mat_tables = calloc(1, sizeof(*ctx_obj->mat_tables));
    externs_entry = calloc(1, sizeof(*externs_entry));
@@ -187,6 +189,10 @@ TEST(DPDK_INDIRECT_REG, case1) {
    EXPECT_GLOBAL_CALL(trim_classifier_str, trim_classifier_str(_))
        .Times(AtLeast(1)).
         WillRepeatedly(Return(name));
+   EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_regarray_read,
+                     rte_swx_ctl_pipeline_regarray_read(_,_,_,_))
+     .Times(AtLeast(1)).
+     WillRepeatedly(Return(0));
    EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_regarray_write,
                      rte_swx_ctl_pipeline_regarray_write(_,_,_,_))
      .Times(AtLeast(1)).
@@ -206,3 +212,86 @@ TEST(DPDK_INDIRECT_REG, case1) {
    free(externs_entry);
 }
 
+
+/* Register value of each instance and the instance writes fail on. */
+static uint64_t ut_reg_values[2];
+static struct pipeline ut_reg_pipes[2];
+static struct rte_swx_pipeline *ut_reg_fail_p;
+
+static int ut_reg_instance(struct rte_swx_pipeline *p)
+{
+  return (p == ut_reg_pipes[0].p) ? 0 : 1;
+}
+
+int regarray_read_instance_dummy(struct rte_swx_pipeline *p,
+                                 const char *regarray_name,
+                                 uint32_t regarray_index,
+                                 uint64_t *value)
+{
+  *value = ut_reg_values[ut_reg_instance(p)];
+  return 0;
+}
+
+int regarray_write_instance_dummy(struct rte_swx_pipeline *p,
+                                  const char *regarray_name,
+                                  uint32_t regarray_index,
+                                  uint64_t value)
+{
+  if (p == ut_reg_fail_p)
+    return -1;
+  ut_reg_values[ut_reg_instance(p)] = value;
+  return 0;
+}
+
+// register write on a sharded pipeline: all the instances or none
+TEST(DPDK_INDIRECT_REG, case2) {
+
+   struct pipe_mgr_externs_ctx externs_entry;
+   pipe_stful_mem_spec_t stful_spec = {0};
+   bf_dev_target_t dev_tgt = {0};
+   char name[] = "ip.reg";
+
+   memset(&externs_entry, 0, sizeof(externs_entry));
+   memcpy(externs_entry.target_name, "registers", sizeof("registers"));
+   memset(ut_reg_pipes, 0, sizeof(ut_reg_pipes));
+   ut_reg_pipes[0].p = (struct rte_swx_pipeline *)0x1000;
+   ut_reg_pipes[1].p = (struct rte_swx_pipeline *)0x2000;
+   ut_reg_pipes[0].n_instances = 2;
+   ut_reg_pipes[0].instance[0] = &ut_reg_pipes[0];
+   ut_reg_pipes[0].instance[1] = &ut_reg_pipes[1];
+   ut_reg_values[0] = 5;
+   ut_reg_values[1] = 5;
+   ut_reg_fail_p = NULL;
+
+   EXPECT_GLOBAL_CALL(pipe_mgr_get_profile, pipe_mgr_get_profile(_,_,_))
+     .WillRepeatedly(&pipe_mgr_get_profile_dummy);
+   EXPECT_GLOBAL_CALL(pipeline_find, pipeline_find(_))
+     .WillRepeatedly(Return(&ut_reg_pipes[0]));
+   EXPECT_GLOBAL_CALL(pipe_mgr_get_profile_ctx, pipe_mgr_get_profile_ctx(_,_))
+     .WillRepeatedly(&pipe_mgr_get_profile_ctx_dummy);
+   EXPECT_GLOBAL_CALL(bf_hashtbl_search, bf_hashtbl_search(_,_))
+     .WillRepeatedly(Return((void *)&externs_entry));
+   EXPECT_GLOBAL_CALL(trim_classifier_str, trim_classifier_str(_))
+     .WillRepeatedly(Return(name));
+   EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_regarray_read,
+                     rte_swx_ctl_pipeline_regarray_read(_,_,_,_))
+     .WillRepeatedly(&regarray_read_instance_dummy);
+   EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_regarray_write,
+                     rte_swx_ctl_pipeline_regarray_write(_,_,_,_))
+     .WillRepeatedly(&regarray_write_instance_dummy);
+
+   stful_spec.dbl = 7;
+   ASSERT_EQ(dal_reg_write_assignable_register_set(dev_tgt, name, 3,
+                                                   &stful_spec),
+             BF_SUCCESS);
+   ASSERT_EQ(ut_reg_values[0], 7);
+   ASSERT_EQ(ut_reg_values[1], 7);
+
+   ut_reg_fail_p = ut_reg_pipes[1].p;
+   stful_spec.dbl = 9;
+   ASSERT_EQ(dal_reg_write_assignable_register_set(dev_tgt, name, 3,
+                                                   &stful_spec),
+             BF_OBJECT_NOT_FOUND);
+   ASSERT_EQ(ut_reg_values[0], 7);
+   ASSERT_EQ(ut_reg_values[1], 7);
+}
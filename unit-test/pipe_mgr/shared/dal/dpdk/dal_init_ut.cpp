@@ -0,0 +1,459 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*Each testcase file can atmost have 5k checks
+ *Note: Please update the number of checks included in the below field
+ *Number of checks = 57
+ */
+
+#include <gmock/gmock.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <gmock-global.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C"{
+    /* The cache entries of the tests are kept apart from the real ones. */
+    #define P4_OBJ_CACHE_PATH "/tmp/dal_init_ut_cache"
+    #include "dal_init.c"
+    #include "mock.h"
+}
+
+using namespace std;
+using ::testing::AnyNumber;
+using ::testing::AtLeast;
+using ::testing::Return;
+using ::testing::_;
+
+MOCK_GLOBAL_FUNC3(pipe_mgr_get_profile,
+                  int(int dev_id, int profile_id,
+                  struct pipe_mgr_profile **profile));
+MOCK_GLOBAL_FUNC2(thread_pipeline_stats_read,
+                  int(const char *pipeline_name,
+                  struct thread_pipeline_stats *stats));
+MOCK_GLOBAL_FUNC2(thread_stats_read,
+                  int(uint32_t thread_id, struct thread_stats *stats));
+MOCK_GLOBAL_FUNC1(pipeline_find,
+                  struct pipeline *(const char *name));
+MOCK_GLOBAL_FUNC2(pipeline_iospec_add,
+                  int(struct pipeline *pipeline, const char *line));
+MOCK_GLOBAL_FUNC2(thread_pipeline_migrate,
+                  int(const char *pipeline_name, uint32_t thread_id));
+MOCK_GLOBAL_FUNC0(thread_pipeline_migrate_lock, void());
+MOCK_GLOBAL_FUNC0(thread_pipeline_migrate_unlock, void());
+
+static struct pipe_mgr_profile ut_init_profile;
+static int ut_pipeline_enabled;
+
+int init_get_profile_dummy(int dev_id, int profile_id,
+                           struct pipe_mgr_profile **profile)
+{
+  *profile = &ut_init_profile;
+  return 0;
+}
+
+int pipeline_stats_read_dummy(const char *pipeline_name,
+                              struct thread_pipeline_stats *stats)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->thread_id = 3;
+  stats->enabled = ut_pipeline_enabled;
+  stats->n_runs = 100;
+  stats->run_cycles = 200;
+  stats->n_pkts_in = 300;
+  stats->n_empty_polls = 400;
+  return 0;
+}
+
+int thread_stats_read_dummy(uint32_t thread_id, struct thread_stats *stats)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->tsc_hz = 2000000000;
+  stats->cycles = 10;
+  stats->n_iterations = 20;
+  stats->run_cycles = 30;
+  stats->ctrl_cycles = 40;
+  stats->n_ctrl_msgs = 50;
+  return 0;
+}
+
+static void ut_init_setup()
+{
+  memset(&ut_init_profile, 0, sizeof(ut_init_profile));
+  strcpy(ut_init_profile.pipeline_name, "pipe");
+  ut_pipeline_enabled = 1;
+
+  EXPECT_GLOBAL_CALL(pipe_mgr_get_profile, pipe_mgr_get_profile(_,_,_))
+      .WillRepeatedly(&init_get_profile_dummy);
+}
+
+/*
+ * Test Case for the telemetry of a pipeline and of the thread it runs on
+ */
+TEST(DPDK_PIPELINE_STATS, case0) {
+  pipe_mgr_pipeline_thread_stats_t stats;
+  struct bf_dev_target_t dev_tgt = {0};
+
+  ut_init_setup();
+  EXPECT_GLOBAL_CALL(thread_pipeline_stats_read,
+                     thread_pipeline_stats_read(_,_))
+      .Times(1)
+      .WillOnce(&pipeline_stats_read_dummy);
+  EXPECT_GLOBAL_CALL(thread_stats_read, thread_stats_read(3,_))
+      .Times(1)
+      .WillOnce(&thread_stats_read_dummy);
+
+  memset(&stats, 0, sizeof(stats));
+  ASSERT_EQ(dal_pipeline_thread_stats_get(dev_tgt, &stats), BF_SUCCESS);
+  ASSERT_EQ(stats.thread_id, 3);
+  ASSERT_EQ(stats.tsc_hz, 2000000000);
+  ASSERT_EQ(stats.thread_cycles, 10);
+  ASSERT_EQ(stats.thread_iterations, 20);
+  ASSERT_EQ(stats.thread_run_cycles, 30);
+  ASSERT_EQ(stats.thread_ctrl_cycles, 40);
+  ASSERT_EQ(stats.thread_ctrl_msgs, 50);
+  ASSERT_EQ(stats.pipeline_runs, 100);
+  ASSERT_EQ(stats.pipeline_run_cycles, 200);
+  ASSERT_EQ(stats.pipeline_pkts_in, 300);
+  ASSERT_EQ(stats.pipeline_empty_polls, 400);
+}
+
+/*
+ * Test Case for a pipeline not running on any thread, or not found
+ */
+TEST(DPDK_PIPELINE_STATS, case1) {
+  pipe_mgr_pipeline_thread_stats_t stats;
+  struct bf_dev_target_t dev_tgt = {0};
+
+  ut_init_setup();
+  ut_pipeline_enabled = 0;
+  EXPECT_GLOBAL_CALL(thread_pipeline_stats_read,
+                     thread_pipeline_stats_read(_,_))
+      .Times(2)
+      .WillOnce(&pipeline_stats_read_dummy)
+      .WillOnce(Return(-1));
+  EXPECT_GLOBAL_CALL(thread_stats_read, thread_stats_read(_,_))
+      .Times(0);
+
+  ASSERT_EQ(dal_pipeline_thread_stats_get(dev_tgt, &stats), BF_NOT_READY);
+  ASSERT_EQ(dal_pipeline_thread_stats_get(dev_tgt, &stats),
+            BF_OBJECT_NOT_FOUND);
+}
+
+/*
+ * Test Case for a pipeline whose thread can't be read
+ */
+TEST(DPDK_PIPELINE_STATS, case2) {
+  pipe_mgr_pipeline_thread_stats_t stats;
+  struct bf_dev_target_t dev_tgt = {0};
+
+  ut_init_setup();
+  EXPECT_GLOBAL_CALL(thread_pipeline_stats_read,
+                     thread_pipeline_stats_read(_,_))
+      .Times(1)
+      .WillOnce(&pipeline_stats_read_dummy);
+  EXPECT_GLOBAL_CALL(thread_stats_read, thread_stats_read(3,_))
+      .Times(1)
+      .WillOnce(Return(-1));
+
+  ASSERT_EQ(dal_pipeline_thread_stats_get(dev_tgt, &stats), BF_UNEXPECTED);
+}
+
+/* Lines of the iospec written for an instance. */
+static std::vector<std::string> ut_iospec;
+
+int iospec_add_dummy(struct pipeline *pipeline, const char *line)
+{
+  ut_iospec.push_back(line);
+  return 0;
+}
+
+/*
+ * Test Case for the iospec of a secondary instance: the ethdev ports are
+ * bound to the queues of the instance, the other lines are kept
+ */
+TEST(DPDK_IOSPEC_INSTANCE, case0) {
+  struct pipeline pipes[3];
+  char iospec[] = "mirroring slots 4 sessions 64\n"
+                  "port in 0 ethdev net0 rxq 0 bsz 32\n"
+                  "port out 0 ethdev net0 txq 0 bsz 32\n";
+
+  memset(pipes, 0, sizeof(pipes));
+  pipes[0].iospec = iospec;
+  pipes[0].n_instances = 3;
+  pipes[0].instance[0] = &pipes[0];
+  pipes[0].instance[1] = &pipes[1];
+  pipes[0].instance[2] = &pipes[2];
+  ut_iospec.clear();
+
+  EXPECT_GLOBAL_CALL(pipeline_iospec_add, pipeline_iospec_add(&pipes[2],_))
+      .Times(3)
+      .WillRepeatedly(&iospec_add_dummy);
+
+  ASSERT_EQ(dal_iospec_instance_write(&pipes[0], 2), BF_SUCCESS);
+  ASSERT_EQ(ut_iospec.size(), 3);
+  ASSERT_EQ(ut_iospec[0], "mirroring slots 4 sessions 64\n");
+  ASSERT_EQ(ut_iospec[1], "port in 0 ethdev net0 rxq 2 bsz 32\n");
+  ASSERT_EQ(ut_iospec[2], "port out 0 ethdev net0 txq 2 bsz 32\n");
+}
+
+/*
+ * Test Case for the iospec of a pipeline with a port instances can't share
+ */
+TEST(DPDK_IOSPEC_INSTANCE, case1) {
+  struct pipeline pipes[2];
+  char iospec[] = "port in 0 ethdev net0 rxq 0 bsz 32\n"
+                  "port in 1 ring RING0 bsz 32\n";
+
+  memset(pipes, 0, sizeof(pipes));
+  pipes[0].iospec = iospec;
+  pipes[0].n_instances = 2;
+  pipes[0].instance[0] = &pipes[0];
+  pipes[0].instance[1] = &pipes[1];
+  ut_iospec.clear();
+
+  EXPECT_GLOBAL_CALL(pipeline_iospec_add, pipeline_iospec_add(&pipes[1],_))
+      .WillRepeatedly(&iospec_add_dummy);
+
+  ASSERT_EQ(dal_iospec_instance_write(&pipes[0], 1), BF_NOT_SUPPORTED);
+  ASSERT_EQ(ut_iospec.size(), 1);
+}
+
+static struct pipeline ut_migrate_pipes[2];
+
+/* Thread each pipeline was moved to, and the pipeline refusing to move. */
+static std::vector<std::pair<std::string, uint32_t> > ut_migrations;
+static std::string ut_migrate_fail;
+
+int pipeline_migrate_dummy(const char *pipeline_name, uint32_t thread_id)
+{
+  if (ut_migrate_fail == pipeline_name)
+    return -1;
+  ut_migrations.push_back(std::make_pair(std::string(pipeline_name),
+                                         thread_id));
+  /* The first instance carries the hook of the profile. */
+  if (!strcmp(pipeline_name, "pipe"))
+    dal_pipeline_migrated(NULL, thread_id, &ut_init_profile);
+  return 0;
+}
+
+static void ut_migrate_setup()
+{
+  ut_init_setup();
+  ut_init_profile.core_id = 2;
+  memset(ut_migrate_pipes, 0, sizeof(ut_migrate_pipes));
+  strcpy(ut_migrate_pipes[0].name, "pipe");
+  strcpy(ut_migrate_pipes[1].name, "pipe_1");
+  ut_migrate_pipes[0].n_instances = 2;
+  ut_migrate_pipes[0].instance[0] = &ut_migrate_pipes[0];
+  ut_migrate_pipes[0].instance[1] = &ut_migrate_pipes[1];
+  ut_migrations.clear();
+  ut_migrate_fail.clear();
+
+  EXPECT_GLOBAL_CALL(pipeline_find, pipeline_find(_))
+      .WillRepeatedly(Return(&ut_migrate_pipes[0]));
+  EXPECT_GLOBAL_CALL(thread_pipeline_migrate, thread_pipeline_migrate(_,_))
+      .WillRepeatedly(&pipeline_migrate_dummy);
+  EXPECT_GLOBAL_CALL(thread_pipeline_migrate_lock,
+                     thread_pipeline_migrate_lock())
+      .Times(1);
+  EXPECT_GLOBAL_CALL(thread_pipeline_migrate_unlock,
+                     thread_pipeline_migrate_unlock())
+      .Times(1);
+}
+
+/*
+ * Test Case for the instances of a pipeline moved to consecutive cores
+ */
+TEST(DPDK_PIPELINE_MIGRATE, case0) {
+  struct bf_dev_target_t dev_tgt = {0};
+
+  ut_migrate_setup();
+
+  ASSERT_EQ(dal_pipeline_migrate(dev_tgt, 5), BF_SUCCESS);
+  ASSERT_EQ(ut_migrations.size(), 2);
+  ASSERT_EQ(ut_migrations[0], std::make_pair(std::string("pipe"), 5u));
+  ASSERT_EQ(ut_migrations[1], std::make_pair(std::string("pipe_1"), 6u));
+  ASSERT_EQ(ut_init_profile.core_id, 5);
+}
+
+/*
+ * Test Case for an instance refusing to move: the others are moved back
+ */
+TEST(DPDK_PIPELINE_MIGRATE, case1) {
+  struct bf_dev_target_t dev_tgt = {0};
+
+  ut_migrate_setup();
+  ut_migrate_fail = "pipe_1";
+
+  ASSERT_EQ(dal_pipeline_migrate(dev_tgt, 5), BF_UNEXPECTED);
+  ASSERT_EQ(ut_migrations.size(), 2);
+  ASSERT_EQ(ut_migrations[1], std::make_pair(std::string("pipe"), 2u));
+  ASSERT_EQ(ut_init_profile.core_id, 2);
+}
+
+#define UT_CACHE_INCLUDE_DIR "/tmp/dal_init_ut_include/"
+
+static void ut_file_write(const char *path, const char *buf, size_t len)
+{
+  FILE *fd = fopen(path, "w");
+
+  ASSERT_NE(fd, (void *)NULL);
+  fwrite(buf, 1, len, fd);
+  fclose(fd);
+}
+
+/* Forget the toolchain part of the key, as a new process would */
+static void ut_toolchain_reset(void)
+{
+  dal_lib_cache_toolchain.valid = 0;
+}
+
+/* A spec file, and an include directory with one header */
+static FILE *ut_cache_setup(const char *spec)
+{
+  FILE *spec_file = tmpfile();
+
+  mkdir(UT_CACHE_INCLUDE_DIR, 0700);
+  mkdir(UT_CACHE_INCLUDE_DIR "sub", 0700);
+  unlink(UT_CACHE_INCLUDE_DIR "sub/rte_ut_sub.h");
+  ut_file_write(UT_CACHE_INCLUDE_DIR "rte_ut.h", "#define UT 1\n", 13);
+  unsetenv("SDE_P4_NO_CACHE");
+  ut_toolchain_reset();
+
+  fputs(spec, spec_file);
+  rewind(spec_file);
+  return spec_file;
+}
+
+/* Fill in an entry as dal_lib_cache_store() does, minus the compilation */
+static void ut_cache_entry_write(struct dal_lib_cache *cache)
+{
+  ut_file_write(cache->so_filepath, "so", 2);
+  ut_file_write(cache->key_filepath, cache->key, cache->key_len);
+}
+
+/*
+ * Test Case for a program found in the cache by a later enable
+ */
+TEST(DPDK_LIB_CACHE, case0) {
+  struct dal_lib_cache cache, cache2;
+  FILE *spec_file = ut_cache_setup("struct s {\n}\n");
+
+  ASSERT_EQ(dal_lib_cache_init(&cache, "pipe", spec_file,
+                               UT_CACHE_INCLUDE_DIR), 0);
+  dal_lib_cache_invalidate(&cache);
+  ASSERT_EQ(dal_lib_cache_lookup(&cache), 0);
+  ut_cache_entry_write(&cache);
+  ASSERT_EQ(dal_lib_cache_lookup(&cache), 1);
+
+  /* The spec is rewound for the code generator */
+  ASSERT_EQ(ftell(spec_file), 0);
+
+  ASSERT_EQ(dal_lib_cache_init(&cache2, "pipe", spec_file,
+                               UT_CACHE_INCLUDE_DIR), 0);
+  ASSERT_STREQ(cache2.so_filepath, cache.so_filepath);
+  ASSERT_EQ(dal_lib_cache_lookup(&cache2), 1);
+  dal_lib_cache_free(&cache2);
+
+  /* The headers are only read by the first enable of the process */
+  ut_file_write(UT_CACHE_INCLUDE_DIR "rte_ut.h", "#define UT 2\n", 13);
+  ASSERT_EQ(dal_lib_cache_init(&cache2, "pipe", spec_file,
+                               UT_CACHE_INCLUDE_DIR), 0);
+  ASSERT_STREQ(cache2.so_filepath, cache.so_filepath);
+
+  dal_lib_cache_invalidate(&cache);
+  dal_lib_cache_free(&cache);
+  dal_lib_cache_free(&cache2);
+  fclose(spec_file);
+}
+
+/*
+ * Test Case for the changes which make the cached program stale: the spec,
+ * a header of the install, and a truncated key
+ */
+TEST(DPDK_LIB_CACHE, case1) {
+  struct dal_lib_cache cache, cache2;
+  FILE *spec_file = ut_cache_setup("struct s {\n}\n");
+  FILE *spec_file2 = ut_cache_setup("struct t {\n}\n");
+
+  ASSERT_EQ(dal_lib_cache_init(&cache, "pipe", spec_file,
+                               UT_CACHE_INCLUDE_DIR), 0);
+  ut_cache_entry_write(&cache);
+
+  ASSERT_EQ(dal_lib_cache_init(&cache2, "pipe", spec_file2,
+                               UT_CACHE_INCLUDE_DIR), 0);
+  ASSERT_STRNE(cache2.so_filepath, cache.so_filepath);
+  ASSERT_EQ(dal_lib_cache_lookup(&cache2), 0);
+  dal_lib_cache_free(&cache2);
+
+  ut_file_write(UT_CACHE_INCLUDE_DIR "rte_ut.h", "#define UT 2\n", 13);
+  ut_toolchain_reset();
+  ASSERT_EQ(dal_lib_cache_init(&cache2, "pipe", spec_file,
+                               UT_CACHE_INCLUDE_DIR), 0);
+  ASSERT_EQ(dal_lib_cache_lookup(&cache2), 0);
+  dal_lib_cache_free(&cache2);
+
+  /* Headers of the subdirectories count too */
+  ut_file_write(UT_CACHE_INCLUDE_DIR "rte_ut.h", "#define UT 1\n", 13);
+  ut_file_write(UT_CACHE_INCLUDE_DIR "sub/rte_ut_sub.h", "\n", 1);
+  ut_toolchain_reset();
+  ASSERT_EQ(dal_lib_cache_init(&cache2, "pipe", spec_file,
+                               UT_CACHE_INCLUDE_DIR), 0);
+  ASSERT_EQ(dal_lib_cache_lookup(&cache2), 0);
+  dal_lib_cache_free(&cache2);
+
+  /* A key cut short is a miss, even under the right name */
+  unlink(UT_CACHE_INCLUDE_DIR "sub/rte_ut_sub.h");
+  ut_file_write(cache.key_filepath, cache.key, cache.key_len - 1);
+  ASSERT_EQ(dal_lib_cache_lookup(&cache), 0);
+
+  dal_lib_cache_invalidate(&cache);
+  dal_lib_cache_free(&cache);
+  fclose(spec_file);
+  fclose(spec_file2);
+}
+
+/*
+ * Test Case for a dropped entry, and for the cache turned off
+ */
+TEST(DPDK_LIB_CACHE, case2) {
+  struct dal_lib_cache cache;
+  FILE *spec_file = ut_cache_setup("struct s {\n}\n");
+
+  ASSERT_EQ(dal_lib_cache_init(&cache, "pipe", spec_file,
+                               UT_CACHE_INCLUDE_DIR), 0);
+  ut_cache_entry_write(&cache);
+  ASSERT_EQ(dal_lib_cache_lookup(&cache), 1);
+
+  dal_lib_cache_invalidate(&cache);
+  ASSERT_EQ(dal_lib_cache_lookup(&cache), 0);
+  ASSERT_NE(access(cache.so_filepath, F_OK), 0);
+  ASSERT_NE(access(cache.key_filepath, F_OK), 0);
+  dal_lib_cache_free(&cache);
+
+  setenv("SDE_P4_NO_CACHE", "1", 1);
+  ASSERT_EQ(dal_lib_cache_init(&cache, "pipe", spec_file,
+                               UT_CACHE_INCLUDE_DIR), -1);
+  ASSERT_EQ(cache.key, (void *)NULL);
+  unsetenv("SDE_P4_NO_CACHE");
+  fclose(spec_file);
+}
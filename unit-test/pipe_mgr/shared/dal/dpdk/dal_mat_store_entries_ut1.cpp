@@ -16,13 +16,16 @@
 
 /*Each testcase file can atmost have 5k checks
  *Note: Please update the number of checks included in the below field
- *Number of checks = 1*/
+ *Number of checks = 19*/
 
 
+#include <errno.h>
 #include <gmock/gmock.h>
 #include <string.h>
 #include <stdlib.h>
 #include <gmock-global.h>
+#include <map>
+#include <utility>
 
 extern "C"{
     #include "dal_mat.c"
@@ -34,6 +37,104 @@ using ::testing::AtLeast;
 using ::testing::Return;
 using ::testing::_;
 
+MOCK_GLOBAL_FUNC3(pipe_mgr_get_profile,
+                  int(int dev_id, int profile_id,
+                  struct pipe_mgr_profile **profile));
+MOCK_GLOBAL_FUNC1(pipeline_find,
+                  struct pipeline *(const char *name));
+MOCK_GLOBAL_FUNC2(rte_swx_ctl_pipeline_info_get,
+                  int(struct rte_swx_pipeline *p,
+                  struct rte_swx_ctl_pipeline_info *pipeline));
+MOCK_GLOBAL_FUNC3(rte_swx_ctl_learner_info_get,
+                  int(struct rte_swx_pipeline *p, uint32_t learner_id,
+                  struct rte_swx_ctl_learner_info *learner));
+MOCK_GLOBAL_FUNC4(rte_swx_ctl_pipeline_learner_timeout_set,
+                  int(struct rte_swx_pipeline *p, uint32_t learner_id,
+                  uint32_t key_timeout_id, uint32_t key_timeout));
+
+/* A pipeline of two instances with two learners each. The timeouts set
+ * are kept per instance and learner so that they can be checked.
+ */
+static struct pipe_mgr_profile ut_lrn_profile;
+static struct pipeline ut_lrn_pipe[2];
+static std::map<std::pair<struct rte_swx_pipeline *, uint32_t>, uint32_t>
+    ut_lrn_timeouts;
+static uint32_t ut_lrn_n_key_timeouts;
+static int ut_lrn_set_calls;
+static int ut_lrn_set_fail_call;
+
+int lrn_get_profile_dummy(int dev_id, int profile_id,
+                          struct pipe_mgr_profile **profile)
+{
+  *profile = &ut_lrn_profile;
+  return 0;
+}
+
+struct pipeline *lrn_pipeline_find_dummy(const char *name)
+{
+  return &ut_lrn_pipe[0];
+}
+
+int lrn_info_get_dummy(struct rte_swx_pipeline *p,
+                       struct rte_swx_ctl_pipeline_info *pipeline)
+{
+  memset(pipeline, 0, sizeof(*pipeline));
+  pipeline->n_learners = 2;
+  return 0;
+}
+
+int lrn_learner_info_get_dummy(struct rte_swx_pipeline *p,
+                               uint32_t learner_id,
+                               struct rte_swx_ctl_learner_info *learner)
+{
+  memset(learner, 0, sizeof(*learner));
+  strcpy(learner->name, "learner");
+  learner->n_key_timeouts = ut_lrn_n_key_timeouts;
+  return 0;
+}
+
+int lrn_timeout_set_dummy(struct rte_swx_pipeline *p, uint32_t learner_id,
+                          uint32_t key_timeout_id, uint32_t key_timeout)
+{
+  if (ut_lrn_set_calls++ == ut_lrn_set_fail_call)
+    return -EINVAL;
+  ut_lrn_timeouts[std::make_pair(p, learner_id)] = key_timeout;
+  return 0;
+}
+
+static void ut_lrn_setup()
+{
+  memset(&ut_lrn_profile, 0, sizeof(ut_lrn_profile));
+  strcpy(ut_lrn_profile.pipeline_name, "pipe");
+  memset(ut_lrn_pipe, 0, sizeof(ut_lrn_pipe));
+  ut_lrn_pipe[0].p = (struct rte_swx_pipeline *)0x1000;
+  ut_lrn_pipe[1].p = (struct rte_swx_pipeline *)0x2000;
+  ut_lrn_pipe[0].n_instances = 2;
+  ut_lrn_pipe[0].instance[0] = &ut_lrn_pipe[0];
+  ut_lrn_pipe[0].instance[1] = &ut_lrn_pipe[1];
+  ut_lrn_timeouts.clear();
+  ut_lrn_n_key_timeouts = 4;
+  ut_lrn_set_calls = 0;
+  ut_lrn_set_fail_call = -1;
+
+  EXPECT_GLOBAL_CALL(pipe_mgr_get_profile, pipe_mgr_get_profile(_,_,_))
+      .WillRepeatedly(&lrn_get_profile_dummy);
+  EXPECT_GLOBAL_CALL(pipeline_find, pipeline_find(_))
+      .WillRepeatedly(&lrn_pipeline_find_dummy);
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_info_get,
+                     rte_swx_ctl_pipeline_info_get(_,_))
+      .WillRepeatedly(&lrn_info_get_dummy);
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_learner_info_get,
+                     rte_swx_ctl_learner_info_get(_,_,_))
+      .WillRepeatedly(&lrn_learner_info_get_dummy);
+}
+
+static uint32_t ut_lrn_timeout(int instance, uint32_t learner_id)
+{
+  return ut_lrn_timeouts[std::make_pair(ut_lrn_pipe[instance].p,
+                                        learner_id)];
+}
+
 /*
  * Test Case for Exact Match Table with Add-on-Miss Enabled
  */
@@ -88,3 +189,65 @@ TEST(DPDK_MAT_CTX, case3) {
         ASSERT_EQ(actual_result, expected_result);
 }
 
+
+/*
+ * Test Case for a learner timer profile set on all the learners
+ */
+TEST(DPDK_LEARNER_TIMEOUT, case0) {
+  struct bf_dev_target_t dev_tgt = {0};
+
+  ut_lrn_setup();
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_learner_timeout_set,
+                     rte_swx_ctl_pipeline_learner_timeout_set(_,_,_,_))
+      .Times(4)
+      .WillRepeatedly(&lrn_timeout_set_dummy);
+
+  ASSERT_EQ(dal_learner_timeout_set(dev_tgt, 1, 30), BF_SUCCESS);
+  ASSERT_EQ(ut_lrn_timeout(0, 0), 30);
+  ASSERT_EQ(ut_lrn_timeout(0, 1), 30);
+  ASSERT_EQ(ut_lrn_timeout(1, 0), 30);
+  ASSERT_EQ(ut_lrn_timeout(1, 1), 30);
+  ASSERT_EQ(ut_lrn_profile.bf_ct_timeout[1], 30);
+  ASSERT_EQ(ut_lrn_profile.num_ct_timer_profiles, 2);
+}
+
+/*
+ * Test Case for a timer profile the learners don't have: nothing is set
+ */
+TEST(DPDK_LEARNER_TIMEOUT, case1) {
+  struct bf_dev_target_t dev_tgt = {0};
+
+  ut_lrn_setup();
+  ut_lrn_n_key_timeouts = 2;
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_learner_timeout_set,
+                     rte_swx_ctl_pipeline_learner_timeout_set(_,_,_,_))
+      .Times(0);
+
+  ASSERT_EQ(dal_learner_timeout_set(dev_tgt, 2, 30), BF_INVALID_ARG);
+  ASSERT_EQ(ut_lrn_profile.num_ct_timer_profiles, 0);
+  ASSERT_EQ(dal_learner_timeout_set(dev_tgt, 0, 0), BF_INVALID_ARG);
+}
+
+/*
+ * Test Case for a failure on the third learner: the profile timeout is
+ * put back on all the learners
+ */
+TEST(DPDK_LEARNER_TIMEOUT, case2) {
+  struct bf_dev_target_t dev_tgt = {0};
+
+  ut_lrn_setup();
+  ut_lrn_profile.num_ct_timer_profiles = 1;
+  ut_lrn_profile.bf_ct_timeout[0] = 10;
+  ut_lrn_set_fail_call = 2;
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_learner_timeout_set,
+                     rte_swx_ctl_pipeline_learner_timeout_set(_,_,_,_))
+      .Times(7)
+      .WillRepeatedly(&lrn_timeout_set_dummy);
+
+  ASSERT_EQ(dal_learner_timeout_set(dev_tgt, 0, 30), BF_UNEXPECTED);
+  ASSERT_EQ(ut_lrn_timeout(0, 0), 10);
+  ASSERT_EQ(ut_lrn_timeout(0, 1), 10);
+  ASSERT_EQ(ut_lrn_timeout(1, 0), 10);
+  ASSERT_EQ(ut_lrn_timeout(1, 1), 10);
+  ASSERT_EQ(ut_lrn_profile.bf_ct_timeout[0], 10);
+}
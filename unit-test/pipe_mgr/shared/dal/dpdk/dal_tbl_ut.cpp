@@ -0,0 +1,183 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*Each testcase file can atmost have 5k checks
+ *Note: Please update the number of checks included in the below field
+ *Number of checks = 17
+ */
+
+#include <gmock/gmock.h>
+#include <string.h>
+#include <stdlib.h>
+#include <gmock-global.h>
+#include <map>
+
+extern "C"{
+    #include "dal_tbl.c"
+    #include "mock.h"
+}
+
+using namespace std;
+using ::testing::AnyNumber;
+using ::testing::AtLeast;
+using ::testing::Return;
+using ::testing::_;
+
+MOCK_GLOBAL_FUNC3(rte_swx_ctl_pipeline_table_entry_add,
+                  int(struct rte_swx_ctl_pipeline *ctl,
+                  const char *table_name,
+                  struct rte_swx_table_entry *entry));
+MOCK_GLOBAL_FUNC3(rte_swx_ctl_pipeline_table_default_entry_add,
+                  int(struct rte_swx_ctl_pipeline *ctl,
+                  const char *table_name,
+                  struct rte_swx_table_entry *entry));
+MOCK_GLOBAL_FUNC3(rte_swx_ctl_pipeline_table_entry_delete,
+                  int(struct rte_swx_ctl_pipeline *ctl,
+                  const char *table_name,
+                  struct rte_swx_table_entry *entry));
+MOCK_GLOBAL_FUNC2(rte_swx_ctl_pipeline_commit,
+                  int(struct rte_swx_ctl_pipeline *ctl, int abort_on_fail));
+MOCK_GLOBAL_FUNC1(rte_swx_ctl_pipeline_abort,
+                  void(struct rte_swx_ctl_pipeline *ctl));
+
+/* Operations seen by the control object of each instance. */
+struct ut_tbl_ops {
+  int staged_adds;
+  int staged_dels;
+  int commits;
+  int aborts;
+};
+
+static std::map<struct rte_swx_ctl_pipeline *, struct ut_tbl_ops> ut_tbl;
+static struct pipeline ut_tbl_pipes[2];
+/* Instances refusing the staged operation and the commit, if any. */
+static struct rte_swx_ctl_pipeline *ut_stage_fail_ctl;
+static struct rte_swx_ctl_pipeline *ut_commit_fail_ctl;
+
+int entry_add_dummy(struct rte_swx_ctl_pipeline *ctl, const char *table_name,
+                    struct rte_swx_table_entry *entry)
+{
+  if (ctl == ut_stage_fail_ctl)
+    return -1;
+  ut_tbl[ctl].staged_adds++;
+  return 0;
+}
+
+int entry_delete_dummy(struct rte_swx_ctl_pipeline *ctl,
+                       const char *table_name,
+                       struct rte_swx_table_entry *entry)
+{
+  if (ctl == ut_stage_fail_ctl)
+    return -1;
+  ut_tbl[ctl].staged_dels++;
+  return 0;
+}
+
+int commit_dummy(struct rte_swx_ctl_pipeline *ctl, int abort_on_fail)
+{
+  if (ctl == ut_commit_fail_ctl)
+    return -1;
+  ut_tbl[ctl].commits++;
+  return 0;
+}
+
+void abort_dummy(struct rte_swx_ctl_pipeline *ctl)
+{
+  ut_tbl[ctl].aborts++;
+}
+
+static struct pipeline *ut_tbl_setup()
+{
+  memset(ut_tbl_pipes, 0, sizeof(ut_tbl_pipes));
+  ut_tbl_pipes[0].ctl = (struct rte_swx_ctl_pipeline *)0x1000;
+  ut_tbl_pipes[1].ctl = (struct rte_swx_ctl_pipeline *)0x2000;
+  ut_tbl_pipes[0].n_instances = 2;
+  ut_tbl_pipes[0].instance[0] = &ut_tbl_pipes[0];
+  ut_tbl_pipes[0].instance[1] = &ut_tbl_pipes[1];
+  ut_tbl.clear();
+  ut_stage_fail_ctl = NULL;
+  ut_commit_fail_ctl = NULL;
+
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_table_entry_add,
+                     rte_swx_ctl_pipeline_table_entry_add(_,_,_))
+      .WillRepeatedly(&entry_add_dummy);
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_table_entry_delete,
+                     rte_swx_ctl_pipeline_table_entry_delete(_,_,_))
+      .WillRepeatedly(&entry_delete_dummy);
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_commit,
+                     rte_swx_ctl_pipeline_commit(_,_))
+      .WillRepeatedly(&commit_dummy);
+  EXPECT_GLOBAL_CALL(rte_swx_ctl_pipeline_abort,
+                     rte_swx_ctl_pipeline_abort(_))
+      .WillRepeatedly(&abort_dummy);
+  return &ut_tbl_pipes[0];
+}
+
+/*
+ * Test Case for an entry added to and committed on every instance
+ */
+TEST(DPDK_TBL_FANOUT, case0) {
+  struct rte_swx_table_entry entry;
+  struct pipeline *pipe = ut_tbl_setup();
+
+  memset(&entry, 0, sizeof(entry));
+  ASSERT_EQ(dal_dpdk_table_entry_write(pipe, "t", &entry,
+                                       DAL_DPDK_TABLE_ENTRY_ADD),
+            BF_SUCCESS);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[0].ctl].staged_adds, 1);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[1].ctl].staged_adds, 1);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[0].ctl].commits, 1);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[1].ctl].commits, 1);
+}
+
+/*
+ * Test Case for an entry refused by an instance: it is committed on none
+ */
+TEST(DPDK_TBL_FANOUT, case1) {
+  struct rte_swx_table_entry entry;
+  struct pipeline *pipe = ut_tbl_setup();
+
+  memset(&entry, 0, sizeof(entry));
+  ut_stage_fail_ctl = ut_tbl_pipes[1].ctl;
+  ASSERT_EQ(dal_dpdk_table_entry_write(pipe, "t", &entry,
+                                       DAL_DPDK_TABLE_ENTRY_DELETE),
+            BF_UNEXPECTED);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[0].ctl].staged_dels, 1);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[0].ctl].aborts, 1);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[1].ctl].aborts, 1);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[0].ctl].commits, 0);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[1].ctl].commits, 0);
+}
+
+/*
+ * Test Case for a commit failing on an instance: an added entry is deleted
+ * again from the instances already committed
+ */
+TEST(DPDK_TBL_FANOUT, case2) {
+  struct rte_swx_table_entry entry;
+  struct pipeline *pipe = ut_tbl_setup();
+
+  memset(&entry, 0, sizeof(entry));
+  ut_commit_fail_ctl = ut_tbl_pipes[1].ctl;
+  ASSERT_EQ(dal_dpdk_table_entry_write(pipe, "t", &entry,
+                                       DAL_DPDK_TABLE_ENTRY_ADD),
+            BF_UNEXPECTED);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[0].ctl].staged_adds, 1);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[0].ctl].staged_dels, 1);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[0].ctl].commits, 2);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[1].ctl].staged_dels, 0);
+  ASSERT_EQ(ut_tbl[ut_tbl_pipes[1].ctl].commits, 0);
+}
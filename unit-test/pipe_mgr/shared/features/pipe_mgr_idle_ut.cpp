@@ -0,0 +1,249 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*Each testcase file can atmost have 5k checks
+ *Note: Please update the number of checks included in the below field
+ *Number of checks = 30
+ */
+
+#include <gmock/gmock.h>
+#include <string.h>
+#include <stdlib.h>
+#include <gmock-global.h>
+#include <map>
+#include <vector>
+
+extern "C"{
+    #include "pipe_mgr_idle.c"
+    #include "mock.h"
+}
+
+using namespace std;
+using ::testing::AnyNumber;
+using ::testing::AtLeast;
+using ::testing::Return;
+using ::testing::_;
+
+MOCK_GLOBAL_FUNC5(dal_mat_ent_hit_cnt_read,
+                  int(struct bf_dev_target_t dev_tgt,
+                  struct pipe_mgr_mat_ctx *mat_ctx, int n,
+                  struct pipe_tbl_match_spec **match_specs,
+                  u64 *hit_cnts));
+
+/* Hit counts reported by the target, indexed by the match spec of the
+ * entry, and the entries reported as expired.
+ */
+static std::map<struct pipe_tbl_match_spec *, u64> ut_hits;
+static std::vector<u32> ut_expired;
+static int ut_hits_read_entries;
+
+int hit_cnt_read_dummy(struct bf_dev_target_t dev_tgt,
+                       struct pipe_mgr_mat_ctx *mat_ctx, int n,
+                       struct pipe_tbl_match_spec **match_specs,
+                       u64 *hit_cnts)
+{
+  for (int i = 0; i < n; i++)
+    hit_cnts[i] = ut_hits[match_specs[i]];
+  ut_hits_read_entries += n;
+  return 0;
+}
+
+static void ut_idle_expiry_cb(bf_dev_id_t dev_id,
+                              pipe_mat_ent_hdl_t mat_ent_hdl,
+                              void *client_data)
+{
+  ut_expired.push_back(mat_ent_hdl);
+}
+
+static struct pipe_mgr_mat ut_idle_mat;
+static struct pipe_mgr_idle_tbl ut_idle;
+
+static struct pipe_mgr_idle_tbl *ut_idle_setup()
+{
+  memset(&ut_idle_mat, 0, sizeof(ut_idle_mat));
+  strcpy(ut_idle_mat.ctx.name, "ut_table");
+  memset(&ut_idle, 0, sizeof(ut_idle));
+  ut_idle.tbl = &ut_idle_mat;
+  ut_idle.tick_ms = 1000;
+  ut_idle.hw_hits = true;
+  ut_idle.enabled = true;
+  ut_idle.params.mode = NOTIFY_MODE;
+  ut_idle.params.u.notify.callback_fn = ut_idle_expiry_cb;
+  ut_hits.clear();
+  ut_expired.clear();
+  ut_hits_read_entries = 0;
+  return &ut_idle;
+}
+
+static void ut_idle_entry_init(struct pipe_mgr_mat_entry_info *entry,
+                               struct pipe_tbl_match_spec *match_spec,
+                               u32 hdl, u32 ttl)
+{
+  memset(entry, 0, sizeof(*entry));
+  entry->mat_ent_hdl = hdl;
+  entry->match_spec = match_spec;
+  entry->idle_ttl = ttl;
+  entry->idle_hit_state = ENTRY_IDLE;
+}
+
+/* Advance the wheel and deliver the expirations, as the aging thread. */
+static void ut_idle_advance(struct pipe_mgr_idle_tbl *idle, int ticks)
+{
+  struct pipe_mgr_idle_notify *head, *tail;
+
+  while (ticks--) {
+    head = NULL;
+    tail = NULL;
+    pipe_mgr_idle_tick(idle, &head, &tail);
+    pipe_mgr_idle_notify_deliver(head);
+  }
+}
+
+/* Entries land on the level and slot matching their TTL. */
+TEST(IDLE_WHEEL, case0) {
+  struct pipe_mgr_mat_entry_info ents[4];
+  struct pipe_tbl_match_spec specs[4];
+  struct pipe_mgr_idle_tbl *idle = ut_idle_setup();
+
+  ut_idle_entry_init(&ents[0], &specs[0], 1, 3000);
+  ut_idle_entry_init(&ents[1], &specs[1], 2, 100000);
+  ut_idle_entry_init(&ents[2], &specs[2], 3, 0);
+  ut_idle_entry_init(&ents[3], &specs[3], 4, 0xffffffff);
+
+  pipe_mgr_idle_wheel_schedule(idle, &ents[0]);
+  pipe_mgr_idle_wheel_schedule(idle, &ents[1]);
+  pipe_mgr_idle_wheel_schedule(idle, &ents[2]);
+  pipe_mgr_idle_wheel_schedule(idle, &ents[3]);
+
+  ASSERT_EQ(ents[0].idle_slot, &idle->wheel[0][3]);
+  ASSERT_EQ(ents[0].idle_expiry_tick, 3);
+  ASSERT_EQ(ents[1].idle_slot, &idle->wheel[1][1]);
+  ASSERT_EQ(ents[1].idle_expiry_tick, 100);
+  ASSERT_EQ(ents[2].idle_slot, (void *)NULL);
+  /* Beyond the span of the wheel the entry is parked on the last level. */
+  ASSERT_EQ(ents[3].idle_slot,
+            &idle->wheel[PIPE_MGR_IDLE_WHEEL_LEVELS - 1]
+                        [PIPE_MGR_IDLE_WHEEL_MASK]);
+
+  /* Scheduling again moves the entry, it is never linked twice. */
+  ents[0].idle_ttl = 5000;
+  pipe_mgr_idle_wheel_schedule(idle, &ents[0]);
+  ASSERT_EQ(idle->wheel[0][3], (void *)NULL);
+  ASSERT_EQ(ents[0].idle_slot, &idle->wheel[0][5]);
+  ASSERT_EQ(ents[0].idle_next, (void *)NULL);
+
+  pipe_mgr_idle_wheel_clear(idle);
+  ASSERT_EQ(ents[1].idle_slot, (void *)NULL);
+  ASSERT_EQ(ents[3].idle_slot, (void *)NULL);
+}
+
+/* An entry on an upper level cascades down and expires on time. */
+TEST(IDLE_WHEEL, case1) {
+  struct pipe_mgr_mat_entry_info ent;
+  struct pipe_tbl_match_spec spec;
+  struct pipe_mgr_idle_tbl *idle = ut_idle_setup();
+
+  EXPECT_GLOBAL_CALL(dal_mat_ent_hit_cnt_read,
+                     dal_mat_ent_hit_cnt_read(_,_,_,_,_))
+      .Times(AnyNumber())
+      .WillRepeatedly(&hit_cnt_read_dummy);
+
+  ut_idle_entry_init(&ent, &spec, 7, 100000);
+  pipe_mgr_idle_wheel_schedule(idle, &ent);
+
+  ut_idle_advance(idle, 63);
+  ASSERT_EQ(ent.idle_slot, &idle->wheel[1][1]);
+
+  ut_idle_advance(idle, 1);
+  ASSERT_EQ(ent.idle_slot, &idle->wheel[0][100 & PIPE_MGR_IDLE_WHEEL_MASK]);
+
+  ut_idle_advance(idle, 35);
+  ASSERT_EQ(ut_hits_read_entries, 0);
+  ASSERT_EQ(ut_expired.size(), 0);
+
+  ut_idle_advance(idle, 1);
+  ASSERT_EQ(ut_hits_read_entries, 1);
+  ASSERT_EQ(ut_expired.size(), 1);
+  ASSERT_EQ(ut_expired[0], 7);
+}
+
+/* Hit entries are rescheduled, idle ones are reported once. */
+TEST(IDLE_WHEEL, case2) {
+  struct pipe_mgr_mat_entry_info ent;
+  struct pipe_tbl_match_spec spec;
+  struct pipe_mgr_idle_tbl *idle = ut_idle_setup();
+
+  EXPECT_GLOBAL_CALL(dal_mat_ent_hit_cnt_read,
+                     dal_mat_ent_hit_cnt_read(_,_,_,_,_))
+      .Times(AnyNumber())
+      .WillRepeatedly(&hit_cnt_read_dummy);
+
+  ut_idle_entry_init(&ent, &spec, 9, 2000);
+  pipe_mgr_idle_wheel_schedule(idle, &ent);
+
+  ut_hits[&spec] = 5;
+  ut_idle_advance(idle, 2);
+  ASSERT_EQ(ut_expired.size(), 0);
+  ASSERT_EQ(ent.idle_expiry_tick, 4);
+
+  ut_idle_advance(idle, 2);
+  ASSERT_EQ(ut_expired.size(), 1);
+  ASSERT_TRUE(ent.idle_notified);
+
+  ut_idle_advance(idle, 2);
+  ASSERT_EQ(ut_expired.size(), 1);
+
+  ut_hits[&spec] = 6;
+  ut_idle_advance(idle, 2);
+  ASSERT_EQ(ut_expired.size(), 1);
+  ASSERT_FALSE(ent.idle_notified);
+
+  ut_idle_advance(idle, 2);
+  ASSERT_EQ(ut_expired.size(), 2);
+}
+
+/* The default entry of the table is never armed nor read. */
+TEST(IDLE_WHEEL, case3) {
+  struct pipe_mgr_mat_entry_info ents[2];
+  struct pipe_tbl_match_spec specs[2];
+  struct pipe_mgr_mat_state state;
+  struct pipe_mgr_idle_tbl *idle = ut_idle_setup();
+
+  EXPECT_GLOBAL_CALL(dal_mat_ent_hit_cnt_read,
+                     dal_mat_ent_hit_cnt_read(_,_,_,_,_))
+      .Times(AnyNumber())
+      .WillRepeatedly(&hit_cnt_read_dummy);
+
+  memset(&state, 0, sizeof(state));
+  P4_SDE_MUTEX_INIT(&state.lock);
+  P4_SDE_MAP_INIT(&state.entry_info_htbl);
+  ut_idle_mat.state = &state;
+
+  ut_idle_entry_init(&ents[0], &specs[0], 1, 3000);
+  ut_idle_entry_init(&ents[1], &specs[1], 2, 3000);
+  ents[1].is_default = true;
+  P4_SDE_MAP_ADD(&state.entry_info_htbl, 1, &ents[0]);
+  P4_SDE_MAP_ADD(&state.entry_info_htbl, 2, &ents[1]);
+
+  ASSERT_EQ(pipe_mgr_idle_for_each_burst(idle, pipe_mgr_idle_arm_burst), 0);
+  ASSERT_EQ(ut_hits_read_entries, 1);
+  ASSERT_EQ(ents[0].idle_slot, &idle->wheel[0][3]);
+  ASSERT_EQ(ents[1].idle_slot, (void *)NULL);
+
+  pipe_mgr_idle_wheel_clear(idle);
+  P4_SDE_MAP_DESTROY(&state.entry_info_htbl);
+  P4_SDE_MUTEX_DESTROY(&state.lock);
+}
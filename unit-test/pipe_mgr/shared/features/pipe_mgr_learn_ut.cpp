@@ -0,0 +1,290 @@
+/*
+ * Copyright(c) 2022 Intel Corporation.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*Each testcase file can atmost have 5k checks
+ *Note: Please update the number of checks included in the below field
+ *Number of checks = 38
+ */
+
+#include <gmock/gmock.h>
+#include <string.h>
+#include <stdlib.h>
+#include <gmock-global.h>
+
+extern "C"{
+    #include "pipe_mgr_learn.c"
+    #include "mock.h"
+}
+
+using namespace std;
+using ::testing::AnyNumber;
+using ::testing::AtLeast;
+using ::testing::Return;
+using ::testing::_;
+
+MOCK_GLOBAL_FUNC2(pipe_mgr_api_prologue, int(uint32_t, struct bf_dev_target_t));
+MOCK_GLOBAL_FUNC2(pipe_mgr_api_epilogue, void(uint32_t, struct bf_dev_target_t));
+MOCK_GLOBAL_FUNC2(pipe_mgr_is_pipe_valid, int(int dev_id, uint32_t dev_pipe_id));
+MOCK_GLOBAL_FUNC2(pipe_mgr_get_num_profiles,
+                  int(int dev_id, uint32_t *num_profiles));
+MOCK_GLOBAL_FUNC3(pipe_mgr_get_profile,
+                  int(int dev_id, int profile_id,
+                  struct pipe_mgr_profile **profile));
+MOCK_GLOBAL_FUNC5(dal_digest_read,
+                  int(void *ring, u8 *entries, u32 entry_size, u32 max,
+                  u32 *num));
+
+static struct pipe_mgr_profile ut_lrn_profile;
+static struct pipe_mgr_lrn_list ut_lrn_lists[2];
+/* Number of digests left in the ring, each digest holds its index. */
+static u32 ut_ring_avail;
+static u32 ut_ring_next;
+
+int lrn_num_profiles_dummy(int dev_id, uint32_t *num_profiles)
+{
+  *num_profiles = 1;
+  return 0;
+}
+
+int lrn_get_profile_dummy(int dev_id, int profile_id,
+                          struct pipe_mgr_profile **profile)
+{
+  *profile = &ut_lrn_profile;
+  return 0;
+}
+
+int lrn_digest_read_dummy(void *ring, u8 *entries, u32 entry_size, u32 max,
+                          u32 *num)
+{
+  u32 i;
+
+  *num = ut_ring_avail < max ? ut_ring_avail : max;
+  for (i = 0; i < *num; i++) {
+    memset(entries + i * entry_size, 0, entry_size);
+    memcpy(entries + i * entry_size, &ut_ring_next, sizeof(ut_ring_next));
+    ut_ring_next++;
+  }
+  ut_ring_avail -= *num;
+  return 0;
+}
+
+pipe_status_t ut_lrn_cb(pipe_sess_hdl_t sess_hdl, pipe_flow_lrn_msg_t *msg,
+                        void *cookie)
+{
+  return BF_SUCCESS;
+}
+
+static void ut_lrn_api_setup()
+{
+  EXPECT_GLOBAL_CALL(pipe_mgr_is_pipe_valid, pipe_mgr_is_pipe_valid(_,_))
+      .WillRepeatedly(Return(0));
+  EXPECT_GLOBAL_CALL(pipe_mgr_api_prologue, pipe_mgr_api_prologue(_,_))
+      .WillRepeatedly(Return(0));
+  EXPECT_GLOBAL_CALL(pipe_mgr_api_epilogue, pipe_mgr_api_epilogue(_,_))
+      .Times(AnyNumber());
+  EXPECT_GLOBAL_CALL(pipe_mgr_get_num_profiles,
+                     pipe_mgr_get_num_profiles(_,_))
+      .WillRepeatedly(&lrn_num_profiles_dummy);
+  EXPECT_GLOBAL_CALL(pipe_mgr_get_profile, pipe_mgr_get_profile(_,_,_))
+      .WillRepeatedly(&lrn_get_profile_dummy);
+}
+
+static void ut_lrn_setup()
+{
+  static bool lock_init;
+  int i;
+
+  if (!lock_init) {
+    P4_SDE_MUTEX_INIT(&pipe_mgr_lrn_lock);
+    lock_init = true;
+  }
+
+  memset(&ut_lrn_profile, 0, sizeof(ut_lrn_profile));
+  ut_lrn_profile.digest_cfg.batch_size = 16;
+  ut_lrn_profile.digest_cfg.flush_timeout_us = 1000;
+  ut_lrn_profile.digest_cfg.dedup_window_us = 7;
+
+  memset(ut_lrn_lists, 0, sizeof(ut_lrn_lists));
+  for (i = 0; i < 2; i++) {
+    ut_lrn_lists[i].dev_tgt.device_id = i;
+    ut_lrn_lists[i].fld_lst_hdl = 10 + i;
+    ut_lrn_lists[i].ring = (void *)0x1000;
+    ut_lrn_lists[i].entry_size = sizeof(u32);
+    ut_lrn_lists[i].batch_size = 16;
+    ut_lrn_lists[i].flush_timeout_us = UINT32_MAX;
+    ut_lrn_lists[i].cb = ut_lrn_cb;
+  }
+  ut_lrn_lists[0].next = &ut_lrn_lists[1];
+  pipe_mgr_lrn_lists = &ut_lrn_lists[0];
+
+  if (!pipe_mgr_lrn_scratch) {
+    pipe_mgr_lrn_scratch_size = PIPE_MGR_LRN_READ_BURST * sizeof(u32);
+    pipe_mgr_lrn_scratch = (u8 *)malloc(pipe_mgr_lrn_scratch_size);
+  }
+  ut_ring_avail = 0;
+  ut_ring_next = 0;
+}
+
+static int ut_lrn_msgs_free(struct pipe_mgr_lrn_msg *m)
+{
+  struct pipe_mgr_lrn_msg *next;
+  int n = 0;
+
+  for (; m; m = next) {
+    next = m->next;
+    P4_SDE_FREE(m);
+    n++;
+  }
+  return n;
+}
+
+/*
+ * Test Case for the learn tunables, set on the profile and on the field
+ * lists of the device only
+ */
+TEST(PIPE_MGR_LRN, case0) {
+  ut_lrn_setup();
+  ut_lrn_api_setup();
+
+  ASSERT_EQ(pipe_mgr_flow_lrn_set_timeout(0, 0, 500), BF_SUCCESS);
+  ASSERT_EQ(ut_lrn_profile.digest_cfg.flush_timeout_us, 500);
+  ASSERT_EQ(ut_lrn_lists[0].flush_timeout_us, 500);
+  ASSERT_EQ(ut_lrn_lists[1].flush_timeout_us, UINT32_MAX);
+  ASSERT_EQ(ut_lrn_profile.digest_cfg.batch_size, 16);
+
+  ASSERT_EQ(pipe_mgr_flow_lrn_set_batch_size(0, 0, 32), BF_SUCCESS);
+  ASSERT_EQ(ut_lrn_profile.digest_cfg.batch_size, 32);
+  ASSERT_EQ(ut_lrn_lists[0].batch_size, 32);
+  ASSERT_EQ(ut_lrn_lists[1].batch_size, 16);
+  ASSERT_EQ(ut_lrn_profile.digest_cfg.flush_timeout_us, 500);
+  ASSERT_EQ(ut_lrn_profile.digest_cfg.dedup_window_us, 7);
+
+  ASSERT_EQ(pipe_mgr_flow_lrn_set_batch_size(0, 0, 0), BF_INVALID_ARG);
+  pipe_mgr_lrn_lists = NULL;
+}
+
+/*
+ * Test Case for digests batched into notifications of batch size
+ */
+TEST(PIPE_MGR_LRN, case1) {
+  struct pipe_mgr_lrn_msg *head = NULL, *tail = NULL;
+  struct pipe_mgr_lrn_list *list;
+
+  ut_lrn_setup();
+  list = &ut_lrn_lists[0];
+  list->batch_size = 2;
+  ut_ring_avail = 5;
+
+  EXPECT_GLOBAL_CALL(dal_digest_read, dal_digest_read(_,_,_,_,_))
+      .WillRepeatedly(&lrn_digest_read_dummy);
+
+  pipe_mgr_lrn_drain(list, &head, &tail);
+  ASSERT_EQ(list->pending_cap, 2);
+  ASSERT_EQ(list->num_pending, 1);
+  ASSERT_EQ(list->unacked, 2);
+  ASSERT_EQ(head->msg.num_entries, 2);
+  ASSERT_EQ(((u32 *)head->msg.entries)[1], 1);
+  ASSERT_EQ(ut_lrn_msgs_free(head), 2);
+
+  P4_SDE_FREE(list->pending);
+  pipe_mgr_lrn_lists = NULL;
+}
+
+/*
+ * Test Case for a client behind on its acks: the ring is still drained
+ * and the digests which can't be queued are dropped
+ */
+TEST(PIPE_MGR_LRN, case2) {
+  struct pipe_mgr_lrn_msg *head = NULL, *tail = NULL;
+  struct pipe_mgr_lrn_list *list;
+
+  ut_lrn_setup();
+  list = &ut_lrn_lists[0];
+  list->batch_size = 2;
+  list->unacked = PIPE_MGR_LRN_MAX_UNACKED - 1;
+  ut_ring_avail = 10;
+
+  EXPECT_GLOBAL_CALL(dal_digest_read, dal_digest_read(_,_,_,_,_))
+      .WillRepeatedly(&lrn_digest_read_dummy);
+
+  pipe_mgr_lrn_drain(list, &head, &tail);
+  ASSERT_EQ(ut_ring_avail, 0);
+  ASSERT_EQ(list->num_msgs, 1);
+  ASSERT_EQ(list->num_drops, 8);
+  ASSERT_EQ(list->unacked, PIPE_MGR_LRN_MAX_UNACKED);
+
+  /* An ack makes room for the next batch. */
+  ASSERT_EQ(pipe_mgr_flow_lrn_notify_ack(0, list->fld_lst_hdl, &head->msg),
+            BF_SUCCESS);
+  ASSERT_EQ(list->unacked, PIPE_MGR_LRN_MAX_UNACKED - 1);
+
+  P4_SDE_FREE(list->pending);
+  pipe_mgr_lrn_lists = NULL;
+}
+
+/*
+ * Test Case for the ring of a field list without a callback, before the
+ * registration and after the deregistration: it is drained and the
+ * digests are dropped
+ */
+TEST(PIPE_MGR_LRN, case3) {
+  struct pipe_mgr_lrn_msg *head = NULL, *tail = NULL;
+  struct pipe_mgr_lrn_list *list;
+
+  ut_lrn_setup();
+  ut_lrn_api_setup();
+  pipe_mgr_lrn_lists = NULL;
+  ut_lrn_profile.digest_cfg.num_lists = 1;
+  ut_lrn_profile.digest_cfg.lists[0].handle = 20;
+  ut_lrn_profile.digest_cfg.lists[0].entry_size = sizeof(u32);
+  strcpy(ut_lrn_profile.digest_cfg.lists[0].ring, "RING_DIGEST");
+  /* The list API is a no-op once the thread is stopped. */
+  pipe_mgr_lrn_thread_run = true;
+
+  EXPECT_GLOBAL_CALL(dal_digest_read, dal_digest_read(_,_,_,_,_))
+      .WillRepeatedly(&lrn_digest_read_dummy);
+
+  ASSERT_EQ(pipe_mgr_lrn_profile_add(0, 0), BF_SUCCESS);
+  list = pipe_mgr_lrn_list_find(0, 20);
+  ASSERT_NE(list, (void *)NULL);
+  ASSERT_EQ(list->cb, (void *)NULL);
+  list->ring = (void *)0x1000;
+
+  /* A full ring takes more than one period to drain */
+  ut_ring_avail = PIPE_MGR_LRN_MAX_DRAIN + 100;
+  pipe_mgr_lrn_drain(list, &head, &tail);
+  ASSERT_EQ(ut_ring_avail, 100);
+  pipe_mgr_lrn_drain(list, &head, &tail);
+  ASSERT_EQ(ut_ring_avail, 0);
+  ASSERT_EQ(head, (void *)NULL);
+  ASSERT_EQ(list->num_no_cb_drops, PIPE_MGR_LRN_MAX_DRAIN + 100);
+
+  /* A deregistered list stays, and is drained again without callback */
+  ASSERT_EQ(pipe_mgr_lrn_digest_notification_register(0, 0, 20, ut_lrn_cb,
+                                                       NULL), BF_SUCCESS);
+  ASSERT_EQ(pipe_mgr_lrn_list_find(0, 20), list);
+  ASSERT_EQ(pipe_mgr_lrn_digest_notification_deregister(0, 0, 20),
+            BF_SUCCESS);
+  ASSERT_EQ(pipe_mgr_lrn_list_find(0, 20), list);
+  ut_ring_avail = 10;
+  pipe_mgr_lrn_drain(list, &head, &tail);
+  ASSERT_EQ(ut_ring_avail, 0);
+  ASSERT_EQ(list->num_no_cb_drops, PIPE_MGR_LRN_MAX_DRAIN + 110);
+
+  pipe_mgr_lrn_device_remove(0);
+  ASSERT_EQ(pipe_mgr_lrn_lists, (void *)NULL);
+  pipe_mgr_lrn_thread_run = false;
+}